@@ -384,7 +384,7 @@ AC_DEFUN([PMIX_SETUP_CORE],[
                       netdb.h ucred.h zlib.h sys/auxv.h \
                       sys/sysctl.h termio.h termios.h pty.h \
                       libutil.h util.h grp.h sys/cdefs.h utmp.h stropts.h \
-                      sys/utsname.h])
+                      sys/utsname.h sys/epoll.h])
 
     AC_CHECK_HEADERS([sys/mount.h], [], [],
                      [AC_INCLUDES_DEFAULT
@@ -633,7 +633,7 @@ AC_DEFUN([PMIX_SETUP_CORE],[
     # -lrt might be needed for clock_gettime
     PMIX_SEARCH_LIBS_CORE([clock_gettime], [rt])
 
-    AC_CHECK_FUNCS([asprintf snprintf vasprintf vsnprintf strsignal socketpair strncpy_s usleep statfs statvfs getpeereid getpeerucred strnlen posix_fallocate tcgetpgrp setpgid ptsname openpty setenv fork execve waitpid atexit])
+    AC_CHECK_FUNCS([asprintf snprintf vasprintf vsnprintf strsignal socketpair strncpy_s usleep statfs statvfs getpeereid getpeerucred strnlen posix_fallocate tcgetpgrp setpgid ptsname openpty setenv fork execve waitpid atexit accept4])
 
     # On some hosts, htonl is a define, so the AC_CHECK_FUNC will get
     # confused.  On others, it's in the standard library, but stubbed with
@@ -950,6 +950,14 @@ AC_DEFUN([PMIX_SETUP_CORE],[
     AC_CONFIG_FILES(pmix_config_prefix[test/run_tests13.pl], [chmod +x test/run_tests13.pl])
 #    AC_CONFIG_FILES(pmix_config_prefix[test/run_tests14.pl], [chmod +x test/run_tests14.pl])
 #    AC_CONFIG_FILES(pmix_config_prefix[test/run_tests15.pl], [chmod +x test/run_tests15.pl])
+    AC_CONFIG_FILES(pmix_config_prefix[test/run_tests16.pl], [chmod +x test/run_tests16.pl])
+    AC_CONFIG_FILES(pmix_config_prefix[test/util/run_bench00.pl], [chmod +x test/util/run_bench00.pl])
+    AC_CONFIG_FILES(pmix_config_prefix[test/util/run_bench01.pl], [chmod +x test/util/run_bench01.pl])
+    AC_CONFIG_FILES(pmix_config_prefix[test/util/run_bench02.pl], [chmod +x test/util/run_bench02.pl])
+    AC_CONFIG_FILES(pmix_config_prefix[test/util/run_bench03.pl], [chmod +x test/util/run_bench03.pl])
+    AC_CONFIG_FILES(pmix_config_prefix[test/util/run_bench04.pl], [chmod +x test/util/run_bench04.pl])
+    AC_CONFIG_FILES(pmix_config_prefix[test/util/run_bench05.pl], [chmod +x test/util/run_bench05.pl])
+    AC_CONFIG_FILES(pmix_config_prefix[test/util/run_bench06.pl], [chmod +x test/util/run_bench06.pl])
     if test "$WANT_PYTHON_BINDINGS" = "1"; then
         AC_CONFIG_FILES(pmix_config_prefix[test/python/run_server.sh], [chmod +x test/python/run_server.sh])
         AC_CONFIG_FILES(pmix_config_prefix[test/python/run_sched.sh], [chmod +x test/python/run_sched.sh])
@@ -133,6 +133,15 @@ PMIX_EXPORT pmix_status_t PMIx_Abort(int status, const char msg[],
 PMIX_EXPORT pmix_status_t PMIx_Put(pmix_scope_t scope, const char key[], pmix_value_t *val);
 
 
+/* Push an array of values into the client's namespace, all with the
+ * same scope. This is equivalent to calling _PMIx_Put_ for each of
+ * the provided keys, in order, but does so in a single pass through
+ * the library's progress thread. Processing stops at the first value
+ * that cannot be stored, and its status is returned. */
+PMIX_EXPORT pmix_status_t PMIx_Put_multi(pmix_scope_t scope, const pmix_info_t info[],
+                                         size_t ninfo);
+
+
 /* Push all previously _PMIx_Put_ values to the local PMIx server.
  * This is an asynchronous operation - the library will immediately
  * return to the caller while the data is transmitted to the local
@@ -214,6 +223,26 @@ PMIX_EXPORT pmix_status_t PMIx_Get_nb(const pmix_proc_t *proc, const char key[],
                                       pmix_value_cbfunc_t cbfunc, void *cbdata);
 
 
+/* Retrieve a set of values, each identified by a proc and a key, in a
+ * single operation. This is equivalent to calling _PMIx_Get_ for each
+ * pair, except that the data that must be obtained from the local
+ * server is requested in one message rather than one per proc. The
+ * info array applies to every request and is used as described above.
+ *
+ * On return, vals[i] holds the value for procs[i]/keys[i] (or NULL)
+ * and status[i] the result of retrieving it. The function returns
+ * PMIX_SUCCESS if every value was retrieved, PMIX_ERR_PARTIAL_SUCCESS
+ * if only some were, and otherwise the status of the first request.
+ *
+ * The caller is responsible for releasing each returned value unless
+ * PMIX_GET_POINTER_VALUES was given. In that case the values point
+ * directly into the client's key-value store and must neither be
+ * modified nor released. PMIX_GET_STATIC_VALUES is not supported. */
+PMIX_EXPORT pmix_status_t PMIx_Get_multi(const pmix_proc_t procs[], const char *keys[],
+                                         size_t nreqs, const pmix_info_t info[], size_t ninfo,
+                                         pmix_value_t *vals[], pmix_status_t status[]);
+
+
 /* Publish the data in the info array for lookup. By default,
  * the data will be published into the PMIX_SESSION range and
  * with PMIX_PERSIST_APP persistence. Changes to those values,
@@ -131,6 +131,38 @@ typedef pmix_status_t (*pmix_server_fencenb_fn_t)(const pmix_proc_t procs[], siz
                                                   char *data, size_t ndata,
                                                   pmix_modex_cbfunc_t cbfunc, void *cbdata);
 
+/* Optional streaming form of fencenb. Since the module structure
+ * cannot grow without breaking hosts built against an earlier
+ * release, a host provides this function by passing a pointer to
+ * it in the PMIX_SERVER_FENCE_CONTRIB attribute to PMIx_server_init.
+ * Doing so directs the server to stream fence contributions - the
+ * data of each local participant is passed up as soon as that
+ * participant enters a fence that collects data, rather than all
+ * at once after the last one has arrived. The host must still
+ * provide fencenb, which is used for fences that do not stream.
+ *
+ * Each call with _complete_ false carries a partial contribution
+ * and a NULL cbfunc - the _cbdata_ identifies the fence instance
+ * and is the same for all calls belonging to it. If such a call
+ * returns PMIX_SUCCESS, the host takes ownership of _data_ and
+ * must free() it when done. If it returns an error, the server
+ * keeps the data and passes it again in the final call.
+ *
+ * The final call has _complete_ set and is otherwise identical to
+ * a fencenb call, including that the host takes ownership of its
+ * _data_: the host is to share the concatenation of every
+ * contribution it was given for the fence, in the order received,
+ * and return the collected data in the cbfunc. Contributions may
+ * be concatenated in any order across servers.
+ *
+ * A final call with a NULL cbfunc indicates that the fence failed
+ * locally - the host is to discard any partial contributions held
+ * for it and must not call back. */
+typedef pmix_status_t (*pmix_server_fence_contrib_fn_t)(const pmix_proc_t procs[], size_t nprocs,
+                                                        const pmix_info_t info[], size_t ninfo,
+                                                        char *data, size_t ndata, bool complete,
+                                                        pmix_modex_cbfunc_t cbfunc, void *cbdata);
+
 
 /* Used by the PMIx server to request its local host contact the
  * PMIx server on the remote node that hosts the specified proc to
@@ -0,0 +1,159 @@
+/* -*- Mode: C; c-basic-offset:4 ; -*- */
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "src/class/pmix_arena.h"
+
+/* allocations are aligned as malloc would align them */
+#define PMIX_ARENA_ALIGN        16
+#define PMIX_ARENA_ROUND(s)     (((s) + PMIX_ARENA_ALIGN - 1) & ~((size_t) PMIX_ARENA_ALIGN - 1))
+#define PMIX_ARENA_FIRST_CHUNK  (64 * 1024)
+#define PMIX_ARENA_MAX_CHUNK    (4 * 1024 * 1024)
+
+typedef struct pmix_arena_chunk_t {
+    struct pmix_arena_chunk_t *next;
+    size_t size;
+} pmix_arena_chunk_t;
+
+#define PMIX_ARENA_CHUNK_HDR    PMIX_ARENA_ROUND(sizeof(pmix_arena_chunk_t))
+
+static void *arena_malloc(pmix_tma_t *tma, size_t size);
+static void *arena_realloc(pmix_tma_t *tma, void *ptr, size_t size);
+
+static void pmix_arena_construct(pmix_arena_t *arena)
+{
+    arena->tma.malloc = arena_malloc;
+    arena->tma.realloc = arena_realloc;
+    arena->tma.data = arena;
+    arena->tma.dontfree = 1;
+    arena->chunks = NULL;
+    arena->ptr = NULL;
+    arena->avail = 0;
+    arena->last = NULL;
+    arena->chunk_size = PMIX_ARENA_FIRST_CHUNK;
+    arena->nchunks = 0;
+    arena->bytes = 0;
+}
+
+static void pmix_arena_destruct(pmix_arena_t *arena)
+{
+    pmix_arena_chunk_t *chunk;
+
+    while (NULL != (chunk = arena->chunks)) {
+        arena->chunks = chunk->next;
+        free(chunk);
+    }
+    arena->ptr = NULL;
+    arena->avail = 0;
+    arena->last = NULL;
+}
+
+PMIX_CLASS_INSTANCE(pmix_arena_t, pmix_object_t, pmix_arena_construct, pmix_arena_destruct);
+
+static void *arena_malloc(pmix_tma_t *tma, size_t size)
+{
+    pmix_arena_t *arena = (pmix_arena_t *) tma->data;
+    pmix_arena_chunk_t *chunk;
+    size_t csize;
+    char *ptr;
+
+    size = PMIX_ARENA_ROUND(size);
+    if (arena->avail < size) {
+        /* chunks double in size as the arena fills, and a request
+         * larger than that gets a chunk of its own */
+        csize = arena->chunk_size;
+        if (csize < size) {
+            csize = size;
+        }
+        chunk = (pmix_arena_chunk_t *) malloc(PMIX_ARENA_CHUNK_HDR + csize);
+        if (NULL == chunk) {
+            return NULL;
+        }
+        chunk->size = csize;
+        chunk->next = arena->chunks;
+        arena->chunks = chunk;
+        arena->ptr = (char *) chunk + PMIX_ARENA_CHUNK_HDR;
+        arena->avail = csize;
+        ++arena->nchunks;
+        if (arena->chunk_size < PMIX_ARENA_MAX_CHUNK) {
+            arena->chunk_size *= 2;
+        }
+    }
+    ptr = arena->ptr;
+    arena->ptr += size;
+    arena->avail -= size;
+    arena->bytes += size;
+    arena->last = ptr;
+    return ptr;
+}
+
+static void *arena_realloc(pmix_tma_t *tma, void *ptr, size_t size)
+{
+    pmix_arena_t *arena = (pmix_arena_t *) tma->data;
+    pmix_arena_chunk_t *chunk;
+    char *old = (char *) ptr, *end, *nptr;
+    size_t cur;
+
+    if (NULL == old) {
+        return arena_malloc(tma, size);
+    }
+    /* the most recent allocation can grow in place */
+    if (old == arena->last) {
+        cur = arena->ptr - old;
+        if (PMIX_ARENA_ROUND(size) <= cur + arena->avail) {
+            size = PMIX_ARENA_ROUND(size);
+            arena->avail -= size - cur;
+            arena->bytes += size - cur;
+            arena->ptr = old + size;
+            return old;
+        }
+    }
+    /* the old size isn't recorded, but the block cannot run past the
+     * used part of its chunk - copying that much is always safe */
+    for (chunk = arena->chunks; NULL != chunk; chunk = chunk->next) {
+        end = (char *) chunk + PMIX_ARENA_CHUNK_HDR + chunk->size;
+        if ((char *) chunk < old && old < end) {
+            break;
+        }
+    }
+    if (NULL == chunk) {
+        return NULL;
+    }
+    if (chunk == arena->chunks) {
+        end = arena->ptr;
+    }
+    nptr = arena_malloc(tma, size);
+    if (NULL != nptr) {
+        cur = end - old;
+        memcpy(nptr, old, cur < size ? cur : size);
+    }
+    return nptr;
+}
+
+void pmix_arena_reset(pmix_arena_t *arena)
+{
+    pmix_arena_chunk_t *chunk, *keep;
+
+    if (NULL == (keep = arena->chunks)) {
+        return;
+    }
+    while (NULL != (chunk = keep->next)) {
+        keep->next = chunk->next;
+        free(chunk);
+    }
+    arena->ptr = (char *) keep + PMIX_ARENA_CHUNK_HDR;
+    arena->avail = keep->size;
+    arena->last = NULL;
+    arena->bytes = 0;
+}
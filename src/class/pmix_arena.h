@@ -0,0 +1,64 @@
+/* -*- Mode: C; c-basic-offset:4 ; -*- */
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/** @file
+ *
+ * A bump allocator for data that lives and dies together - e.g.,
+ * everything unpacked from one message. Memory is carved from large
+ * chunks and handed out through the arena's pmix_tma_t, so objects
+ * and unpacked data can be built in it. Nothing is freed piecemeal:
+ * the whole arena goes at once when it is destructed or reset.
+ *
+ * The tma is marked dontfree, so PMIX_RELEASE of an object built in
+ * the arena runs its destructors but leaves its memory alone.
+ */
+
+#ifndef PMIX_ARENA_H
+#define PMIX_ARENA_H
+
+#include "src/include/pmix_config.h"
+
+#include "src/class/pmix_object.h"
+
+BEGIN_C_DECLS
+
+struct pmix_arena_chunk_t;
+
+struct pmix_arena_t {
+    /** base class */
+    pmix_object_t super;
+    /** allocator handing out the arena's memory */
+    pmix_tma_t tma;
+    /** chunks, newest first */
+    struct pmix_arena_chunk_t *chunks;
+    /** next free byte in the newest chunk, and how many follow it */
+    char *ptr;
+    size_t avail;
+    /** most recent allocation - the only one that can grow in place */
+    char *last;
+    /** size of the next chunk to be allocated */
+    size_t chunk_size;
+    /** statistics */
+    size_t nchunks;
+    size_t bytes;
+};
+typedef struct pmix_arena_t pmix_arena_t;
+PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_arena_t);
+
+/**
+ * Release everything allocated from the arena, keeping its newest
+ * chunk for reuse.
+ *
+ * @param arena Pointer to the arena (IN)
+ */
+PMIX_EXPORT void pmix_arena_reset(pmix_arena_t *arena);
+
+END_C_DECLS
+
+#endif /* PMIX_ARENA_H */
@@ -216,7 +216,9 @@ typedef struct pmix_tma {
     void *(*malloc)(struct pmix_tma *, size_t);
     void *(*realloc)(struct pmix_tma *, void *, size_t);
     void *data;
-    int dontfree; /* when set, free() or realloc() cannot be used, and tma->malloc() cannot fail */
+    /* when set, free() or realloc() cannot be used. Like malloc(),
+     * tma->malloc() returns NULL if it cannot get the memory */
+    int dontfree;
 } pmix_tma_t;
 
 static inline void *pmix_tma_malloc(pmix_tma_t *tma, size_t size)
@@ -252,6 +252,8 @@ pmix_client_globals_t pmix_client_globals = {
     .singleton = false,
     .pending_requests = PMIX_LIST_STATIC_INIT,
     .peers = PMIX_POINTER_ARRAY_STATIC_INIT,
+    .putlog = PMIX_LIST_STATIC_INIT,
+    .getcache_ttl = 0,
     .get_output = -1,
     .get_verbose = 0,
     .connect_output = -1,
@@ -650,6 +652,9 @@ PMIX_EXPORT pmix_status_t PMIx_Init(pmix_proc_t *proc, pmix_info_t info[], size_
 
     /* setup the globals */
     PMIX_CONSTRUCT(&pmix_client_globals.pending_requests, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_client_globals.putlog, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_client_globals.getcache, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_client_globals.getcache, 256);
     PMIX_CONSTRUCT(&pmix_client_globals.peers, pmix_pointer_array_t);
     pmix_pointer_array_init(&pmix_client_globals.peers, 1, INT_MAX, 1);
     pmix_client_globals.myserver = PMIX_NEW(pmix_peer_t);
@@ -756,6 +761,15 @@ PMIX_EXPORT pmix_status_t PMIx_Init(pmix_proc_t *proc, pmix_info_t info[], size_
     }
     /* the server will be using the same */
     pmix_client_globals.myserver->nptr->compat.type = pmix_globals.mypeer->nptr->compat.type;
+    /* if the server offered native buffers and we match its
+     * architecture, then use them for talking to it - we request
+     * them during the connection handshake */
+    evar = getenv("PMIX_BFROP_NATIVE");
+    if (NULL != evar && pmix_bfrops_globals.native
+        && PMIX_BFROP_BUFFER_NON_DESC == pmix_globals.mypeer->nptr->compat.type
+        && 0 == strcmp(evar, pmix_bfrops_globals.arch)) {
+        pmix_client_globals.myserver->nptr->compat.type = PMIX_BFROP_BUFFER_NATIVE;
+    }
 
     /* select the gds compat module we will use to interact with
      * our server- the selection will be based
@@ -1083,6 +1097,9 @@ PMIX_EXPORT pmix_status_t PMIx_Finalize(const pmix_info_t info[], size_t ninfo)
     pmix_iof_static_dump_output(&pmix_client_globals.iof_stderr);
 
     PMIX_LIST_DESTRUCT(&pmix_client_globals.pending_requests);
+    PMIX_LIST_DESTRUCT(&pmix_client_globals.putlog);
+    pmix_client_get_cache_invalidate();
+    PMIX_DESTRUCT(&pmix_client_globals.getcache);
     for (i = 0; i < pmix_client_globals.peers.size; i++) {
         if (NULL
             != (peer = (pmix_peer_t *) pmix_pointer_array_get_item(&pmix_client_globals.peers,
@@ -1188,69 +1205,104 @@ PMIX_EXPORT pmix_status_t PMIx_Abort(int flag, const char msg[], pmix_proc_t pro
     return PMIX_SUCCESS;
 }
 
-static void _putfn(int sd, short args, void *cbdata)
+static void pucon(pmix_client_put_t *p)
+{
+    p->scope = PMIX_SCOPE_UNDEF;
+    p->kv = NULL;
+}
+static void pudes(pmix_client_put_t *p)
+{
+    if (NULL != p->kv) {
+        PMIX_RELEASE(p->kv);
+    }
+}
+PMIX_CLASS_INSTANCE(pmix_client_put_t, pmix_list_item_t, pucon, pudes);
+
+static pmix_status_t _put(pmix_scope_t scope, const char *key, pmix_value_t *val)
 {
-    pmix_cb_t *cb = (pmix_cb_t *) cbdata;
     pmix_status_t rc;
-    pmix_kval_t *kv = NULL;
+    pmix_kval_t *kv;
+    pmix_client_put_t *put;
     uint8_t *tmp;
     size_t len;
 
-    /* need to acquire the cb object from its originating thread */
-    PMIX_ACQUIRE_OBJECT(cb);
-
-    PMIX_HIDE_UNUSED_PARAMS(sd, args);
-
-
     /* no need to push info that starts with "pmix" as that is
      * info we would have been provided at startup */
-    if (0 == strncmp(cb->key, "pmix", 4)) {
-        rc = PMIX_SUCCESS;
-        goto done;
+    if (0 == strncmp(key, "pmix", 4)) {
+        return PMIX_SUCCESS;
     }
 
     /* setup to xfer the data */
     kv = PMIX_NEW(pmix_kval_t);
-    kv->key = strdup(cb->key); // need to copy as the input belongs to the user
+    kv->key = strdup(key); // need to copy as the input belongs to the user
     kv->value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
-    if (PMIX_STRING_SIZE_CHECK(cb->value)) {
+    if (PMIX_STRING_SIZE_CHECK(val)) {
         /* compress large strings */
-        if (pmix_compress.compress_string(cb->value->data.string, &tmp, &len)) {
+        if (pmix_compress.compress_string(val->data.string, &tmp, &len)) {
             if (NULL == tmp) {
-                PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
                 rc = PMIX_ERR_NOMEM;
                 PMIX_ERROR_LOG(rc);
-                goto done;
+                PMIX_RELEASE(kv);
+                return rc;
             }
             kv->value->type = PMIX_COMPRESSED_STRING;
             kv->value->data.bo.bytes = (char *) tmp;
             kv->value->data.bo.size = len;
             rc = PMIX_SUCCESS;
         } else {
-            PMIX_BFROPS_VALUE_XFER(rc, pmix_globals.mypeer, kv->value, cb->value);
+            PMIX_BFROPS_VALUE_XFER(rc, pmix_globals.mypeer, kv->value, val);
         }
     } else {
-        PMIX_BFROPS_VALUE_XFER(rc, pmix_globals.mypeer, kv->value, cb->value);
+        PMIX_BFROPS_VALUE_XFER(rc, pmix_globals.mypeer, kv->value, val);
     }
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
-        goto done;
+        PMIX_RELEASE(kv);
+        return rc;
     }
 
-    /* store it */
-    PMIX_GDS_STORE_KV(rc, pmix_globals.mypeer, &pmix_globals.myid, cb->scope, kv);
+    /* store it so we can retrieve it locally */
+    PMIX_GDS_STORE_KV(rc, pmix_globals.mypeer, &pmix_globals.myid, scope, kv);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
     }
 
+    /* log it for the next commit, if there will be one */
+    if (!PMIX_PEER_IS_SERVER(pmix_globals.mypeer) && !pmix_client_globals.singleton) {
+        put = PMIX_NEW(pmix_client_put_t);
+        put->scope = scope;
+        put->kv = kv;
+        pmix_list_append(&pmix_client_globals.putlog, &put->super);
+    } else {
+        PMIX_RELEASE(kv); // maintain accounting
+    }
+
     /* mark that fresh values have been stored so we know
      * to commit them later */
     pmix_globals.commits_pending = true;
+    return rc;
+}
 
-done:
-    if (NULL != kv) {
-        PMIX_RELEASE(kv); // maintain accounting
+static void _putfn(int sd, short args, void *cbdata)
+{
+    pmix_cb_t *cb = (pmix_cb_t *) cbdata;
+    pmix_status_t rc;
+    size_t n;
+
+    /* need to acquire the cb object from its originating thread */
+    PMIX_ACQUIRE_OBJECT(cb);
+
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    if (NULL != cb->info) {
+        rc = PMIX_SUCCESS;
+        for (n = 0; n < cb->ninfo && PMIX_SUCCESS == rc; n++) {
+            rc = _put(cb->scope, cb->info[n].key, &cb->info[n].value);
+        }
+    } else {
+        rc = _put(cb->scope, cb->key, cb->value);
     }
+
     cb->pstatus = rc;
     /* post the data so the receiving thread can acquire it */
     PMIX_POST_OBJECT(cb);
@@ -1293,14 +1345,79 @@ PMIX_EXPORT pmix_status_t PMIx_Put(pmix_scope_t scope, const char key[], pmix_va
     return rc;
 }
 
+PMIX_EXPORT pmix_status_t PMIx_Put_multi(pmix_scope_t scope, const pmix_info_t info[],
+                                         size_t ninfo)
+{
+    pmix_cb_t *cb;
+    pmix_status_t rc;
+
+    pmix_output_verbose(2, pmix_client_globals.base_output,
+                        "pmix: executing put for %lu keys", (unsigned long) ninfo);
+
+    PMIX_ACQUIRE_THREAD(&pmix_global_lock);
+    if (pmix_globals.init_cntr <= 0) {
+        PMIX_RELEASE_THREAD(&pmix_global_lock);
+        return PMIX_ERR_INIT;
+    }
+    PMIX_RELEASE_THREAD(&pmix_global_lock);
+
+    if (NULL == info || 0 == ninfo) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    /* create a callback object - all the values are
+     * put in a single pass through the event library */
+    cb = PMIX_NEW(pmix_cb_t);
+    cb->scope = scope;
+    cb->info = (pmix_info_t *) info;
+    cb->ninfo = ninfo;
+
+    /* pass this into the event library for thread protection */
+    PMIX_THREADSHIFT(cb, _putfn);
+
+    /* wait for the result */
+    PMIX_WAIT_THREAD(&cb->lock);
+    rc = cb->pstatus;
+    PMIX_RELEASE(cb);
+
+    return rc;
+}
+
+/* pack the logged values that belong to the given scope,
+ * along with the scope itself, if there are any */
+static pmix_status_t _pack_puts(pmix_buffer_t *msgout, pmix_scope_t scope)
+{
+    pmix_client_put_t *put;
+    pmix_buffer_t bkt;
+    pmix_status_t rc = PMIX_SUCCESS;
+
+    PMIX_CONSTRUCT(&bkt, pmix_buffer_t);
+    PMIX_LIST_FOREACH (put, &pmix_client_globals.putlog, pmix_client_put_t) {
+        if (scope != put->scope && PMIX_GLOBAL != put->scope) {
+            continue;
+        }
+        PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, &bkt, put->kv, 1, PMIX_KVAL);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_DESTRUCT(&bkt);
+            return rc;
+        }
+    }
+    if (0 < bkt.bytes_used) {
+        PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msgout, &scope, 1, PMIX_SCOPE);
+        if (PMIX_SUCCESS == rc) {
+            PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msgout, &bkt, 1, PMIX_BUFFER);
+        }
+    }
+    PMIX_DESTRUCT(&bkt);
+    return rc;
+}
+
 static void _commitfn(int sd, short args, void *cbdata)
 {
     pmix_cb_t *cb = (pmix_cb_t *) cbdata;
     pmix_status_t rc;
-    pmix_scope_t scope;
-    pmix_buffer_t *msgout, bkt;
+    pmix_buffer_t *msgout;
     pmix_cmd_t cmd = PMIX_COMMIT_CMD;
-    pmix_kval_t *kv, *kvn;
 
     /* need to acquire the cb object from its originating thread */
     PMIX_ACQUIRE_OBJECT(cb);
@@ -1318,81 +1435,20 @@ static void _commitfn(int sd, short args, void *cbdata)
 
     /* if we haven't already done it, ensure we have committed our values */
     if (pmix_globals.commits_pending) {
-        /* fetch and pack the local values */
-        scope = PMIX_LOCAL;
-        /* allow the GDS module to pass us this info
-         * as a local connection as this data would
-         * only go to another local client */
-        cb->proc = &pmix_globals.myid;
-        cb->scope = scope;
-        cb->copy = false;
-        PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, cb);
+        /* pack the values put since the last commit directly from
+         * the put log - the local scope goes only to other local
+         * clients, while the remote scope goes to remote procs */
+        rc = _pack_puts(msgout, PMIX_LOCAL);
         if (PMIX_SUCCESS == rc) {
-            PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msgout, &scope, 1, PMIX_SCOPE);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_RELEASE(msgout);
-                goto error;
-            }
-            PMIX_CONSTRUCT(&bkt, pmix_buffer_t);
-            PMIX_LIST_FOREACH_SAFE (kv, kvn, &cb->kvs, pmix_kval_t) {
-                PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, &bkt, kv, 1, PMIX_KVAL);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_DESTRUCT(&bkt);
-                    PMIX_RELEASE(msgout);
-                    goto error;
-                }
-                pmix_list_remove_item(&cb->kvs, &kv->super);
-                PMIX_RELEASE(kv);
-            }
-            /* now pack the result */
-            PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msgout, &bkt, 1, PMIX_BUFFER);
-            PMIX_DESTRUCT(&bkt);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_RELEASE(msgout);
-                goto error;
-            }
+            rc = _pack_puts(msgout, PMIX_REMOTE);
         }
-
-        /* fetch and pack the remote values */
-        scope = PMIX_REMOTE;
-        /* we need real copies here as this data will
-         * go to remote procs - so a connection will
-         * not suffice */
-        cb->proc = &pmix_globals.myid;
-        cb->scope = scope;
-        cb->copy = true;
-        PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, cb);
-        if (PMIX_SUCCESS == rc) {
-            PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msgout, &scope, 1, PMIX_SCOPE);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_RELEASE(msgout);
-                goto error;
-            }
-            PMIX_CONSTRUCT(&bkt, pmix_buffer_t);
-            PMIX_LIST_FOREACH_SAFE (kv, kvn, &cb->kvs, pmix_kval_t) {
-                PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, &bkt, kv, 1, PMIX_KVAL);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_DESTRUCT(&bkt);
-                    PMIX_RELEASE(msgout);
-                    goto error;
-                }
-                pmix_list_remove_item(&cb->kvs, &kv->super);
-                PMIX_RELEASE(kv);
-            }
-            /* now pack the result */
-            PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msgout, &bkt, 1, PMIX_BUFFER);
-            PMIX_DESTRUCT(&bkt);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_RELEASE(msgout);
-                goto error;
-            }
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_RELEASE(msgout);
+            goto error;
         }
+        PMIX_LIST_DESTRUCT(&pmix_client_globals.putlog);
+        PMIX_CONSTRUCT(&pmix_client_globals.putlog, pmix_list_t);
 
         /* record that all committed data to-date has been sent */
         pmix_globals.commits_pending = false;
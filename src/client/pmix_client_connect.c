@@ -386,6 +386,8 @@ static void wait_cbfunc(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr, pmix_buffer
         PMIX_ERROR_LOG(rc);
         ret = rc;
     }
+    /* the connect may have brought new data from any proc */
+    pmix_client_get_cache_invalidate();
 
 report:
     if (NULL != cb->cbfunc.opfn) {
@@ -259,6 +259,8 @@ static void wait_cbfunc(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr, pmix_buffer
     } else {
         rc = unpack_return(buf);
     }
+    /* the fence may have brought new data from any proc */
+    pmix_client_get_cache_invalidate();
 
     /* if a callback was provided, execute it */
     if (NULL != cb->cbfunc.opfn) {
@@ -28,6 +28,7 @@
 #    include <string.h>
 #endif
 #include <fcntl.h>
+#include <time.h>
 #ifdef HAVE_UNISTD_H
 #    include <unistd.h>
 #endif
@@ -66,6 +67,12 @@ static pmix_buffer_t *_pack_get(char *nspace, pmix_rank_t rank, char *key,
 
 static void get_data(int sd, short args, void *cbdata);
 
+static bool get_local(pmix_cb_t *cb, pmix_proc_t *proc);
+
+static void get_done(pmix_cb_t *cb);
+
+static void resolve_pending(const pmix_proc_t *target, pmix_scope_t scope, bool answered);
+
 static void _getnb_cbfunc(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr,
                           pmix_buffer_t *buf, void *cbdata);
 
@@ -75,6 +82,134 @@ static pmix_status_t process_values(pmix_cb_t *cb);
 
 static pmix_status_t refresh_cache(void);
 
+/* tracks the requests of a PMIx_Get_multi call and, once they have
+ * been sent, the procs the server was asked about and the key asked
+ * for from each */
+typedef struct {
+    pmix_object_t super;
+    pmix_event_t ev;
+    pmix_cb_t **cbs;
+    size_t ncbs;
+    const pmix_info_t *info;
+    size_t ninfo;
+    pmix_proc_t *procs;
+    char **keys;
+    size_t nprocs;
+    pmix_scope_t scope;
+} pmix_get_multi_t;
+static void gmcon(pmix_get_multi_t *p)
+{
+    p->cbs = NULL;
+    p->ncbs = 0;
+    p->info = NULL;
+    p->ninfo = 0;
+    p->procs = NULL;
+    p->keys = NULL;
+    p->nprocs = 0;
+    p->scope = PMIX_SCOPE_UNDEF;
+}
+static void gmdes(pmix_get_multi_t *p)
+{
+    if (NULL != p->cbs) {
+        free(p->cbs);
+    }
+    if (NULL != p->procs) {
+        free(p->procs);
+    }
+    if (NULL != p->keys) {
+        free(p->keys);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_get_multi_t, pmix_object_t, gmcon, gmdes);
+
+static void get_multi_data(int sd, short args, void *cbdata);
+
+/* a key the server could not give us for a proc in a given scope
+ * won't appear until that proc commits more data, and nobody tells
+ * us when that happens. So if asked to, we remember for a while
+ * which keys were not found, answering requests for them without a
+ * round trip. Any fence or connect may bring new data, so they
+ * clear the whole cache */
+static size_t cache_key(const pmix_proc_t *proc, const char *key, pmix_scope_t scope,
+                        char *ckey)
+{
+    size_t len, klen;
+
+    len = pmix_nslen(proc->nspace) + 1;
+    memcpy(ckey, proc->nspace, len);
+    memcpy(ckey + len, &proc->rank, sizeof(pmix_rank_t));
+    len += sizeof(pmix_rank_t);
+    memcpy(ckey + len, &scope, sizeof(pmix_scope_t));
+    len += sizeof(pmix_scope_t);
+    klen = pmix_keylen(key);
+    memcpy(ckey + len, key, klen);
+    return len + klen;
+}
+
+#define PMIX_GETCACHE_KEYLEN \
+    (PMIX_MAX_NSLEN + 1 + sizeof(pmix_rank_t) + sizeof(pmix_scope_t) + PMIX_MAX_KEYLEN)
+
+static void cache_record(const pmix_proc_t *proc, const char *key, pmix_scope_t scope)
+{
+    char ckey[PMIX_GETCACHE_KEYLEN];
+    size_t len;
+    time_t *expiry;
+
+    if (0 >= pmix_client_globals.getcache_ttl || PMIX_RANK_UNDEF == proc->rank
+        || NULL == key) {
+        return;
+    }
+    len = cache_key(proc, key, scope, ckey);
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&pmix_client_globals.getcache, ckey, len,
+                                                      (void **) &expiry)) {
+        expiry = (time_t *) malloc(sizeof(time_t));
+        if (NULL == expiry) {
+            return;
+        }
+        pmix_hash_table_set_value_ptr(&pmix_client_globals.getcache, ckey, len, expiry);
+    }
+    *expiry = time(NULL) + pmix_client_globals.getcache_ttl;
+}
+
+static bool cache_check(const pmix_proc_t *proc, const char *key, pmix_scope_t scope)
+{
+    char ckey[PMIX_GETCACHE_KEYLEN];
+    size_t len;
+    time_t *expiry;
+
+    if (0 >= pmix_client_globals.getcache_ttl || NULL == key) {
+        return false;
+    }
+    len = cache_key(proc, key, scope, ckey);
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&pmix_client_globals.getcache, ckey, len,
+                                                      (void **) &expiry)) {
+        return false;
+    }
+    if (time(NULL) < *expiry) {
+        return true;
+    }
+    pmix_hash_table_remove_value_ptr(&pmix_client_globals.getcache, ckey, len);
+    free(expiry);
+    return false;
+}
+
+void pmix_client_get_cache_invalidate(void)
+{
+    void *k, *node;
+    size_t len;
+    time_t *expiry;
+    int rc;
+
+    rc = pmix_hash_table_get_first_key_ptr(&pmix_client_globals.getcache, &k, &len,
+                                           (void **) &expiry, &node);
+    while (PMIX_SUCCESS == rc) {
+        free(expiry);
+        rc = pmix_hash_table_get_next_key_ptr(&pmix_client_globals.getcache, &k, &len,
+                                              (void **) &expiry, node, &node);
+    }
+    pmix_hash_table_remove_all(&pmix_client_globals.getcache);
+}
+
 static pmix_status_t process_request(const pmix_proc_t *proc, const char key[],
                                      const pmix_info_t info[], size_t ninfo,
                                      pmix_get_logic_t *lg, pmix_value_t **val)
@@ -361,6 +496,124 @@ PMIX_EXPORT pmix_status_t PMIx_Get_nb(const pmix_proc_t *proc, const char key[],
     return rc;
 }
 
+PMIX_EXPORT pmix_status_t PMIx_Get_multi(const pmix_proc_t procs[], const char *keys[],
+                                         size_t nreqs, const pmix_info_t info[], size_t ninfo,
+                                         pmix_value_t *vals[], pmix_status_t status[])
+{
+    pmix_get_multi_t *mt;
+    pmix_get_logic_t *lg;
+    pmix_cb_t *cb;
+    pmix_status_t rc, ret = PMIX_SUCCESS;
+    bool refresh = false;
+    size_t n, nfound = 0;
+
+    PMIX_ACQUIRE_THREAD(&pmix_global_lock);
+
+    if (pmix_globals.init_cntr <= 0) {
+        PMIX_RELEASE_THREAD(&pmix_global_lock);
+        return PMIX_ERR_INIT;
+    }
+    PMIX_RELEASE_THREAD(&pmix_global_lock);
+
+    if (NULL == procs || NULL == keys || NULL == vals || NULL == status || 0 == nreqs) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    pmix_output_verbose(2, pmix_client_globals.get_output, "pmix:client get_multi for %lu keys",
+                        (unsigned long) nreqs);
+
+    mt = PMIX_NEW(pmix_get_multi_t);
+    mt->cbs = (pmix_cb_t **) calloc(nreqs, sizeof(pmix_cb_t *));
+    mt->info = info;
+    mt->ninfo = ninfo;
+    for (n = 0; n < nreqs; n++) {
+        vals[n] = NULL;
+        if (NULL != keys[n] && PMIX_MAX_KEYLEN < pmix_keylen(keys[n])) {
+            status[n] = PMIX_ERR_BAD_PARAM;
+            continue;
+        }
+        lg = PMIX_NEW(pmix_get_logic_t);
+        status[n] = process_request(&procs[n], keys[n], info, ninfo, lg, &vals[n]);
+        if (PMIX_SUCCESS != status[n]) {
+            /* either a true error or the value has already been prepped */
+            if (PMIX_OPERATION_SUCCEEDED == status[n]) {
+                status[n] = PMIX_SUCCESS;
+            }
+            PMIX_RELEASE(lg);
+            continue;
+        }
+        refresh |= lg->refresh_cache;
+        cb = PMIX_NEW(pmix_cb_t);
+        cb->lg = lg;
+        cb->key = (char *) keys[n];
+        cb->info = (pmix_info_t *) info;
+        cb->ninfo = ninfo;
+        cb->cbfunc.valuefn = _value_cbfunc;
+        PMIX_RETAIN(cb);
+        cb->cbdata = cb;
+        mt->cbs[mt->ncbs++] = cb;
+    }
+
+    /* if we are to refresh the cache, do it once for all of them */
+    if (refresh) {
+        rc = refresh_cache();
+        if (PMIX_SUCCESS != rc) {
+            for (n = 0; n < mt->ncbs; n++) {
+                PMIX_RELEASE(mt->cbs[n]->lg);
+                PMIX_RELEASE(mt->cbs[n]);
+                PMIX_RELEASE(mt->cbs[n]);
+            }
+            PMIX_RELEASE(mt);
+            return rc;
+        }
+    }
+
+    if (0 < mt->ncbs) {
+        /* the progress thread holds its own reference as it
+         * may be done with the tracker before we are */
+        PMIX_RETAIN(mt);
+        /* MUST threadshift here to avoid touching global
+         * data while in the user's thread */
+        PMIX_THREADSHIFT(mt, get_multi_data);
+        for (n = 0; n < nreqs; n++) {
+            if (PMIX_SUCCESS != status[n] || NULL != vals[n]) {
+                continue;
+            }
+            /* the requests were tracked in order */
+            cb = mt->cbs[nfound++];
+            PMIX_WAIT_THREAD(&cb->lock);
+            status[n] = cb->status;
+            if (PMIX_OPERATION_SUCCEEDED == status[n]) {
+                status[n] = PMIX_SUCCESS;
+            }
+            if (PMIX_SUCCESS == status[n] && NULL != cb->value) {
+                vals[n] = cb->value;
+                cb->value = NULL;
+            }
+            PMIX_RELEASE(cb);
+        }
+    }
+    PMIX_RELEASE(mt);
+
+    /* report how the set of requests went as a whole */
+    nfound = 0;
+    for (n = 0; n < nreqs; n++) {
+        if (PMIX_SUCCESS == status[n]) {
+            ++nfound;
+        } else if (PMIX_SUCCESS == ret) {
+            ret = status[n];
+        }
+    }
+    if (0 < nfound && nfound < nreqs) {
+        ret = PMIX_ERR_PARTIAL_SUCCESS;
+    }
+
+    pmix_output_verbose(2, pmix_client_globals.get_output,
+                        "pmix:client get_multi completed with status %s", PMIx_Error_string(ret));
+
+    return ret;
+}
+
 static void _value_cbfunc(pmix_status_t status, pmix_value_t *kv, void *cbdata)
 {
     pmix_cb_t *cb;
@@ -443,12 +696,10 @@ static void _getnb_cbfunc(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr,
                           pmix_buffer_t *buf, void *cbdata)
 {
     pmix_cb_t *cb = (pmix_cb_t *) cbdata;
-    pmix_cb_t *cb2;
     pmix_status_t rc, ret;
-    pmix_value_t *val = NULL;
     int32_t cnt;
-    pmix_kval_t *kv;
     pmix_get_logic_t *lg;
+    bool answered = false;
 
     PMIX_ACQUIRE_OBJECT(cb);
     PMIX_HIDE_UNUSED_PARAMS(pr, hdr);
@@ -483,6 +734,10 @@ static void _getnb_cbfunc(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr,
     if (PMIX_SUCCESS != ret) {
         pmix_output_verbose(2, pmix_client_globals.get_output, "pmix: get_nb server returned %s",
                             PMIx_Error_string(ret));
+        if (PMIX_ERR_NOT_FOUND == ret) {
+            /* the server doesn't have this key */
+            cache_record(&lg->p, cb->key, lg->scope);
+        }
         goto done;
     }
     /* store this into our GDS component associated
@@ -491,19 +746,37 @@ static void _getnb_cbfunc(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr,
      * it is the shmem component, it will contain just
      * the memory address info */
     PMIX_GDS_ACCEPT_KVS_RESP(rc, pmix_globals.mypeer, buf);
+    answered = (PMIX_SUCCESS == rc);
 
 done:
     /* now search any pending requests (including the one this was in
      * response to) to see if they can be met. Note that this function
      * will only be called if the user requested a specific key - we
      * don't support calls to "get" for a NULL key */
+    resolve_pending(&lg->p, lg->scope, answered);
+}
+
+/* complete every pending request for data from the given proc
+ * from whatever we now hold for it. If the server has just answered
+ * with the proc's data for the given scope, a key that is still
+ * missing for a request in that scope is one the server doesn't have */
+static void resolve_pending(const pmix_proc_t *target, pmix_scope_t scope, bool answered)
+{
+    pmix_cb_t *cb, *cb2;
+    pmix_proc_t proc;
+    pmix_status_t rc;
+    pmix_value_t *val = NULL;
+    pmix_kval_t *kv;
+
+    /* the target may belong to one of the requests we complete */
+    memcpy(&proc, target, sizeof(pmix_proc_t));
     pmix_output_verbose(2, pmix_client_globals.get_output,
                         "pmix: get_nb looking for requested key");
     PMIX_LIST_FOREACH_SAFE (cb, cb2, &pmix_client_globals.pending_requests, pmix_cb_t) {
-        if (PMIX_CHECK_NSPACE(lg->p.nspace, cb->pname.nspace) && cb->pname.rank == lg->p.rank) {
+        if (PMIX_CHECK_NSPACE(proc.nspace, cb->pname.nspace) && cb->pname.rank == proc.rank) {
             pmix_list_remove_item(&pmix_client_globals.pending_requests, &cb->super);
             /* we have the data for this proc - see if we can find the key */
-            cb->proc = &lg->p;
+            cb->proc = &proc;
             cb->scope = PMIX_SCOPE_UNDEF;
             pmix_output_verbose(2, pmix_client_globals.get_output,
                                 "pmix: get_nb searching for key %s for rank %s", cb->key,
@@ -512,6 +785,9 @@ done:
             if (PMIX_OPERATION_SUCCEEDED == rc) {
                 rc = PMIX_SUCCESS;
             }
+            if (PMIX_ERR_NOT_FOUND == rc && answered && scope == cb->lg->scope) {
+                cache_record(&proc, cb->key, scope);
+            }
             if (PMIX_SUCCESS == rc) {
                 if (1 != pmix_list_get_size(&cb->kvs)) {
                     rc = PMIX_ERR_INVALID_VAL;
@@ -524,7 +800,7 @@ done:
                 }
             }
             cb->cbfunc.valuefn(rc, val, cb->cbdata);
-            PMIX_RELEASE(lg);
+            PMIX_RELEASE(cb->lg);
             PMIX_RELEASE(cb);
         }
     }
@@ -578,19 +854,14 @@ static pmix_status_t process_values(pmix_cb_t *cb)
     return PMIX_SUCCESS;
 }
 
-static void get_data(int sd, short args, void *cbdata)
+/* look for the requested data among what we already hold. Returns
+ * true if the request has been answered (cb->status tells how) and
+ * false if the data has to be requested from the server for the
+ * proc returned in proc */
+static bool get_local(pmix_cb_t *cb, pmix_proc_t *proc)
 {
-    pmix_cb_t *cb;
-    pmix_cb_t *cbret;
-    pmix_buffer_t *msg;
     pmix_status_t rc;
-    pmix_proc_t proc;
-    pmix_get_logic_t *lg;
-    PMIX_HIDE_UNUSED_PARAMS(sd, args);
-
-    PMIX_ACQUIRE_OBJECT(cb);
-    cb = (pmix_cb_t*)cbdata;
-    lg = cb->lg;
+    pmix_get_logic_t *lg = cb->lg;
 
     pmix_output_verbose(2, pmix_client_globals.get_output,
                         "pmix:client:get_data value for proc %s key %s",
@@ -605,7 +876,7 @@ static void get_data(int sd, short args, void *cbdata)
         pmix_output_verbose(5, pmix_client_globals.get_output,
                             "pmix:client data found in server-provided data");
         cb->status = process_values(cb);
-        goto done;
+        return true;
     }
     pmix_output_verbose(5, pmix_client_globals.get_output,
                         "pmix:client data NOT found in server-provided data");
@@ -620,7 +891,7 @@ static void get_data(int sd, short args, void *cbdata)
             pmix_output_verbose(5, pmix_client_globals.get_output,
                                 "pmix:client data found in internal hash data");
             cb->status = process_values(cb);
-            goto done;
+            return true;
         }
     }
     pmix_output_verbose(5, pmix_client_globals.get_output,
@@ -630,7 +901,7 @@ static void get_data(int sd, short args, void *cbdata)
      * indicator of the breadth of data we want, but we will need to
      * get the specific data someone requested later. So setup a tmp
      * process ID */
-    memcpy(&proc, &lg->p, sizeof(pmix_proc_t));
+    memcpy(proc, &lg->p, sizeof(pmix_proc_t));
     cb->pname.nspace = strdup(lg->p.nspace);
     cb->pname.rank = lg->p.rank;
 
@@ -644,7 +915,7 @@ static void get_data(int sd, short args, void *cbdata)
         if (PMIX_PEER_IS_EARLIER(pmix_client_globals.myserver, 3, 1, 100)
             || !PMIX_CHECK_NSPACE(lg->p.nspace, pmix_globals.myid.nspace)) {
             /* flag that we want all of the job-level info */
-            proc.rank = PMIX_RANK_WILDCARD;
+            proc->rank = PMIX_RANK_WILDCARD;
         } else if (NULL != cb->key && !PMIX_CHECK_KEY(cb, PMIX_GROUP_CONTEXT_ID)) {
             /* this is a reserved key - we should have had this info, so
              * respond with the error - if they want us to check with the
@@ -652,7 +923,7 @@ static void get_data(int sd, short args, void *cbdata)
             pmix_output_verbose(5, pmix_client_globals.get_output,
                                 "pmix:client returning NOT FOUND error");
             cb->status = PMIX_ERR_NOT_FOUND;
-            goto done;
+            return true;
         }
     }
 
@@ -662,7 +933,7 @@ static void get_data(int sd, short args, void *cbdata)
     if (PMIX_PEER_IS_SERVER(pmix_globals.mypeer) ||
         (!PMIX_PEER_IS_SERVER(pmix_globals.mypeer) && !pmix_globals.connected)) {
         cb->status = PMIX_ERR_NOT_FOUND;
-        goto done;
+        return true;
     }
 
     /* since we are looking for a non-reserved key, check to see if we already
@@ -670,7 +941,19 @@ static void get_data(int sd, short args, void *cbdata)
      * it again */
     if (PMIX_ERR_EXISTS_OUTSIDE_SCOPE == rc) {
         cb->status = rc;
-        goto done;
+        return true;
+    }
+
+    /* if the server recently told us it doesn't have this key, then
+     * there is no point in asking again - unless we were asked to
+     * refresh the cache, in which case anything we know may be stale */
+    if (!lg->refresh_cache && cache_check(&lg->p, cb->key, lg->scope)) {
+        pmix_output_verbose(2, pmix_client_globals.get_output,
+                            "PMIx_Get key=%s for rank = %u, namespace = %s was not found - "
+                            "the server recently did not have it",
+                            cb->key, cb->pname.rank, cb->pname.nspace);
+        cb->status = PMIX_ERR_NOT_FOUND;
+        return true;
     }
 
     /* we also have to check the user's directives to see if they do not want
@@ -681,6 +964,24 @@ static void get_data(int sd, short args, void *cbdata)
                             "PMIx_Get key=%s for rank = %u, namespace = %s was not found - request was optional",
                             cb->key, cb->pname.rank, cb->pname.nspace);
         cb->status = PMIX_ERR_NOT_FOUND;
+        return true;
+    }
+    return false;
+}
+
+static void get_data(int sd, short args, void *cbdata)
+{
+    pmix_cb_t *cb;
+    pmix_cb_t *cbret;
+    pmix_buffer_t *msg;
+    pmix_status_t rc;
+    pmix_proc_t proc;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(cb);
+    cb = (pmix_cb_t*)cbdata;
+
+    if (get_local(cb, &proc)) {
         goto done;
     }
 
@@ -723,6 +1024,12 @@ static void get_data(int sd, short args, void *cbdata)
     return;
 
 done:
+    get_done(cb);
+}
+
+/* return the result of a request answered without the server */
+static void get_done(pmix_cb_t *cb)
+{
     /* we made a lot of changes to cb, so ensure they get
      * written out before we return */
     PMIX_POST_OBJECT(cb);
@@ -731,7 +1038,202 @@ done:
     } else {
         cb->cbfunc.valuefn(cb->status, cb->value, cb->cbdata);
     }
-    return;
+}
+
+/* this callback is coming from the ptl recv, and thus
+ * is occurring inside of our progress thread - hence, no
+ * need to thread shift */
+static void _getmulti_cbfunc(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr,
+                             pmix_buffer_t *buf, void *cbdata)
+{
+    pmix_get_multi_t *mt = (pmix_get_multi_t *) cbdata;
+    pmix_status_t rc, ret, *status = NULL;
+    pmix_byte_object_t *bo = NULL;
+    pmix_buffer_t pbkt;
+    int32_t cnt;
+    size_t n, nreqs = 0;
+    bool *answered;
+
+    PMIX_ACQUIRE_OBJECT(mt);
+    PMIX_HIDE_UNUSED_PARAMS(pr, hdr);
+
+    pmix_output_verbose(2, pmix_client_globals.get_output, "pmix: get_multi callback recvd");
+
+    answered = (bool *) calloc(mt->nprocs, sizeof(bool));
+
+    /* a zero-byte buffer indicates that this recv is being
+     * completed due to a lost connection */
+    if (PMIX_BUFFER_IS_EMPTY(buf)) {
+        pmix_output_verbose(2, pmix_client_globals.get_output,
+                            "pmix: get_multi server lost connection");
+        goto done;
+    }
+
+    /* unpack the status of the request as a whole */
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, buf, &ret, &cnt, PMIX_STATUS);
+    if (PMIX_SUCCESS != rc || PMIX_SUCCESS != ret) {
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+        }
+        goto done;
+    }
+    /* followed by the status and blob of each proc, in order */
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, buf, &nreqs, &cnt, PMIX_SIZE);
+    if (PMIX_SUCCESS != rc || nreqs != mt->nprocs) {
+        PMIX_ERROR_LOG(PMIX_ERR_UNPACK_FAILURE);
+        nreqs = 0;
+        goto done;
+    }
+    status = (pmix_status_t *) malloc(nreqs * sizeof(pmix_status_t));
+    PMIX_BYTE_OBJECT_CREATE(bo, nreqs);
+    cnt = nreqs;
+    PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, buf, status, &cnt, PMIX_STATUS);
+    if (PMIX_SUCCESS == rc) {
+        cnt = nreqs;
+        PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, buf, bo, &cnt, PMIX_BYTE_OBJECT);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        goto done;
+    }
+
+    for (n = 0; n < nreqs; n++) {
+        if (PMIX_ERR_NOT_FOUND == status[n]) {
+            /* the server doesn't have this key */
+            cache_record(&mt->procs[n], mt->keys[n], mt->scope);
+        } else if (PMIX_SUCCESS == status[n] && 0 < bo[n].size) {
+            /* store it as if it had been returned on its own */
+            PMIX_CONSTRUCT(&pbkt, pmix_buffer_t);
+            PMIX_LOAD_BUFFER(pmix_client_globals.myserver, &pbkt, bo[n].bytes, bo[n].size);
+            bo[n].bytes = NULL;
+            bo[n].size = 0;
+            PMIX_GDS_ACCEPT_KVS_RESP(rc, pmix_globals.mypeer, &pbkt);
+            if (NULL != answered) {
+                answered[n] = (PMIX_SUCCESS == rc);
+            }
+            PMIX_DESTRUCT(&pbkt);
+        }
+    }
+
+done:
+    /* whatever happened, answer everyone waiting on these procs
+     * from what we now hold */
+    for (n = 0; n < mt->nprocs; n++) {
+        resolve_pending(&mt->procs[n], mt->scope, NULL != answered && answered[n]);
+    }
+    if (NULL != answered) {
+        free(answered);
+    }
+    if (NULL != status) {
+        free(status);
+    }
+    if (NULL != bo) {
+        PMIX_BYTE_OBJECT_FREE(bo, nreqs);
+    }
+    PMIX_RELEASE(mt);
+}
+
+static void get_multi_data(int sd, short args, void *cbdata)
+{
+    pmix_get_multi_t *mt = (pmix_get_multi_t *) cbdata;
+    pmix_cb_t *cb, *cbret;
+    pmix_buffer_t *msg;
+    pmix_status_t rc;
+    pmix_proc_t proc;
+    pmix_cmd_t cmd = PMIX_GETMULTI_CMD;
+    pmix_get_logic_t *lg;
+    char *nsptr;
+    size_t n;
+    bool pending;
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(mt);
+
+    mt->keys = (char **) calloc(mt->ncbs, sizeof(char *));
+    mt->procs = (pmix_proc_t *) calloc(mt->ncbs, sizeof(pmix_proc_t));
+    /* the requests share their directives, and so their scope */
+    mt->scope = mt->cbs[0]->lg->scope;
+    for (n = 0; n < mt->ncbs; n++) {
+        cb = mt->cbs[n];
+        /* requests for job-level data take the path of a single
+         * get as they may need data beyond that of the proc */
+        if (NULL == cb->key || PMIX_CHECK_RESERVED_KEY(cb->key)) {
+            get_data(0, 0, cb);
+            continue;
+        }
+        if (get_local(cb, &proc)) {
+            lg = cb->lg;
+            get_done(cb);
+            /* nothing will be waiting on this one */
+            PMIX_RELEASE(lg);
+            PMIX_RELEASE(cb);
+            continue;
+        }
+        /* only ask the server once for each proc - whatever
+         * it returns will answer all requests for that proc */
+        pending = false;
+        PMIX_LIST_FOREACH (cbret, &pmix_client_globals.pending_requests, pmix_cb_t) {
+            if (PMIX_CHECK_PROCID(&cbret->pname, &proc)) {
+                pending = true;
+                break;
+            }
+        }
+        pmix_list_append(&pmix_client_globals.pending_requests, &cb->super);
+        if (!pending) {
+            memcpy(&mt->procs[mt->nprocs], &proc, sizeof(pmix_proc_t));
+            mt->keys[mt->nprocs] = cb->key;
+            ++mt->nprocs;
+        }
+    }
+    if (0 == mt->nprocs) {
+        PMIX_RELEASE(mt);
+        return;
+    }
+
+    pmix_output_verbose(2, pmix_client_globals.get_output,
+                        "%s REQUESTING DATA FROM SERVER FOR %lu PROCS",
+                        PMIX_NAME_PRINT(&pmix_globals.myid), (unsigned long) mt->nprocs);
+
+    /* pack the directives once, followed by each proc and the key
+     * we are waiting for from it */
+    msg = PMIX_NEW(pmix_buffer_t);
+    PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, &cmd, 1, PMIX_COMMAND);
+    if (PMIX_SUCCESS == rc) {
+        PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, &mt->ninfo, 1, PMIX_SIZE);
+    }
+    if (PMIX_SUCCESS == rc && 0 < mt->ninfo) {
+        PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, mt->info, mt->ninfo, PMIX_INFO);
+    }
+    if (PMIX_SUCCESS == rc) {
+        PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, &mt->nprocs, 1, PMIX_SIZE);
+    }
+    for (n = 0; PMIX_SUCCESS == rc && n < mt->nprocs; n++) {
+        nsptr = mt->procs[n].nspace;
+        PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, &nsptr, 1, PMIX_STRING);
+        if (PMIX_SUCCESS == rc) {
+            PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, &mt->procs[n].rank, 1,
+                             PMIX_PROC_RANK);
+        }
+        if (PMIX_SUCCESS == rc) {
+            PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, &mt->keys[n], 1, PMIX_STRING);
+        }
+    }
+    if (PMIX_SUCCESS == rc) {
+        /* send to the server */
+        PMIX_PTL_SEND_RECV(rc, pmix_client_globals.myserver, msg, _getmulti_cbfunc, (void *) mt);
+        if (PMIX_SUCCESS == rc) {
+            return;
+        }
+    }
+    PMIX_ERROR_LOG(rc);
+    PMIX_RELEASE(msg);
+    /* complete the requests with whatever we hold */
+    for (n = 0; n < mt->nprocs; n++) {
+        resolve_pending(&mt->procs[n], mt->scope, false);
+    }
+    PMIX_RELEASE(mt);
 }
 
 static void refcb(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr,
@@ -13,6 +13,7 @@
 
 #include "src/include/pmix_config.h"
 
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_list.h"
 #include "src/class/pmix_pointer_array.h"
 #include "src/common/pmix_iof.h"
@@ -21,11 +22,22 @@
 
 BEGIN_C_DECLS
 
+/* a value that has been put but not yet committed */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_scope_t scope;
+    pmix_kval_t *kv;
+} pmix_client_put_t;
+PMIX_CLASS_DECLARATION(pmix_client_put_t);
+
 typedef struct {
     pmix_peer_t *myserver;        // messaging support to/from my server
     bool singleton;               // no server
     pmix_list_t pending_requests; // list of pmix_cb_t pending data requests
     pmix_pointer_array_t peers;   // array of pmix_peer_t cached for data ops
+    pmix_list_t putlog;           // list of pmix_client_put_t awaiting commit
+    pmix_hash_table_t getcache;   // (proc, scope, key) the server did not have, with expiry time
+    int getcache_ttl;             // seconds to trust that the server still does not have them
     // verbosity for client get operations
     int get_output;
     int get_verbose;
@@ -57,6 +69,10 @@ typedef struct {
 
 PMIX_EXPORT extern pmix_client_globals_t pmix_client_globals;
 
+/* forget which keys the server recently did not have, so the next
+ * request for any of them is sent to the server again */
+PMIX_EXPORT void pmix_client_get_cache_invalidate(void);
+
 END_C_DECLS
 
 #endif /* PMIX_CLIENT_OPS_H */
@@ -384,7 +384,7 @@ static void wait_cbfunc(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr, pmix_buffer
     char *n2 = NULL;
     pmix_status_t rc, ret;
     int32_t cnt;
-    pmix_namespace_t *nptr, *ns;
+    pmix_namespace_t *nptr;
 
     PMIX_ACQUIRE_OBJECT(cd);
 
@@ -437,19 +437,12 @@ static void wait_cbfunc(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr, pmix_buffer
         /* process any IOF flags - we are only concerned if we are a TOOL
          * and need to know if/how we should output any IO */
         if (PMIX_PEER_IS_TOOL(pmix_globals.mypeer)) {
-            nptr = NULL;
-            PMIX_LIST_FOREACH (ns, &pmix_globals.nspaces, pmix_namespace_t)
-            {
-                if (PMIX_CHECK_NSPACE(ns->nspace, nspace)) {
-                    nptr = ns;
-                    break;
-                }
-            }
+            nptr = pmix_nspace_lookup(nspace);
             if (NULL == nptr) {
                 /* shouldn't happen, but protect us */
                 nptr = PMIX_NEW(pmix_namespace_t);
                 nptr->nspace = strdup(nspace);
-                pmix_list_append(&pmix_globals.nspaces, &nptr->super);
+                pmix_nspace_register(nptr);
             }
             /* as a client, we only handle a select set of the flags */
             memcpy(&nptr->iof_flags, &cd->flags, sizeof(pmix_iof_flags_t));
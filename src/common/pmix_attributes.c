@@ -321,6 +321,7 @@ static pmix_attr_init_t server_fns[] = {
     {.function = "PMIx_server_init",
      .attrs = (char *[]){"PMIX_SERVER_GATEWAY",
                          "PMIX_SERVER_SCHEDULER",
+                         "PMIX_SERVER_FENCE_CONTRIB",
                          "PMIX_SERVER_TMPDIR",
                          "PMIX_SYSTEM_TMPDIR",
                          "PMIX_SERVER_NSPACE",
@@ -866,6 +867,11 @@ PMIX_EXPORT const pmix_regattr_input_t *pmix_attributes_lookup_term(char *attr)
     return NULL;
 }
 
+PMIX_EXPORT const pmix_regattr_input_t *pmix_attributes_dictionary(void)
+{
+    return dictionary;
+}
+
 /*****   PRINT QUERY FUNCTIONS RESULTS   *****/
 PMIX_EXPORT char **pmix_attributes_print_functions(char *level)
 {
@@ -70,6 +70,8 @@ PMIX_EXPORT void pmix_attrs_query_support(int sd, short args, void *cbdata);
 PMIX_EXPORT const char *pmix_attributes_lookup(char *name);
 PMIX_EXPORT const char *pmix_attributes_reverse_lookup(char *name);
 PMIX_EXPORT const pmix_regattr_input_t *pmix_attributes_lookup_term(char *attr);
+/* the complete dictionary, terminated by an entry with an empty name */
+PMIX_EXPORT const pmix_regattr_input_t *pmix_attributes_dictionary(void);
 
 END_C_DECLS
 
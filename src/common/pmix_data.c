@@ -93,6 +93,11 @@ static pmix_peer_t *find_peer(const pmix_proc_t *proc)
                 continue;
             }
             if (0 == strncmp(proc->nspace, peer->nptr->nspace, PMIX_MAX_NSLEN)) {
+                /* native buffers are only for our link to the peer - the
+                 * caller may send this data anywhere */
+                if (PMIX_BFROP_BUFFER_NATIVE == peer->nptr->compat.type) {
+                    return pmix_globals.mypeer;
+                }
                 return peer;
             }
         }
@@ -137,6 +142,9 @@ static pmix_peer_t *find_peer(const pmix_proc_t *proc)
     if (0
         == strncmp(proc->nspace, pmix_client_globals.myserver->info->pname.nspace,
                    PMIX_MAX_NSLEN)) {
+        if (PMIX_BFROP_BUFFER_NATIVE == pmix_client_globals.myserver->nptr->compat.type) {
+            return pmix_globals.mypeer;
+        }
         return pmix_client_globals.myserver;
     }
 
@@ -190,8 +198,12 @@ PMIX_EXPORT pmix_status_t PMIx_Data_pack(const pmix_proc_t *target, pmix_data_bu
     /* embed the data buffer into a buffer */
     PMIX_EMBED_DATA_BUFFER(&buf, buffer);
 
-    /* pack the value */
-    PMIX_BFROPS_PACK(rc, peer, &buf, src, num_vals, type);
+    /* make room for all of it at once */
+    rc = pmix_bfrops_base_reserve(&buf, pmix_bfrops_base_packed_size(src, num_vals, type));
+    if (PMIX_SUCCESS == rc) {
+        /* pack the value */
+        PMIX_BFROPS_PACK(rc, peer, &buf, src, num_vals, type);
+    }
 
     /* extract the data buffer - the pointers may have changed */
     PMIX_EXTRACT_DATA_BUFFER(&buf, buffer);
@@ -1337,7 +1337,7 @@ pmix_status_t pmix_iof_write_output(const pmix_proc_t *name, pmix_iof_channel_t
     pmix_byte_object_t bopass;
     pmix_iof_write_event_t *channel;
     pmix_iof_flags_t myflags;
-    pmix_namespace_t *nptr, *ns;
+    pmix_namespace_t *nptr;
     bool outputio;
     bool copystdout = false;
     bool copystderr = false;
@@ -1353,14 +1353,7 @@ pmix_status_t pmix_iof_write_output(const pmix_proc_t *name, pmix_iof_channel_t
     }
 
     /* find the nspace for this source */
-    nptr = NULL;
-    PMIX_LIST_FOREACH (ns, &pmix_globals.nspaces, pmix_namespace_t)
-    {
-        if (0 == strcmp(ns->nspace, name->nspace)) {
-            nptr = ns;
-            break;
-        }
-    }
+    nptr = pmix_nspace_lookup(name->nspace);
 
     channel = NULL;
     /* default outputio to our flag */
@@ -42,7 +42,8 @@ static void relcbfunc(void *cbdata)
 
     pmix_output_verbose(2, pmix_globals.debug_output, "pmix:query release callback");
 
-    if (NULL != cd->info) {
+    /* info unpacked into an arena goes with it */
+    if (NULL != cd->info && NULL == cd->arena) {
         PMIX_INFO_FREE(cd->info, cd->ninfo);
     }
     PMIX_RELEASE(cd);
@@ -56,6 +57,7 @@ static void query_cbfunc(struct pmix_peer_t *peer, pmix_ptl_hdr_t *hdr,
     int cnt;
     size_t n;
     pmix_kval_t *kv;
+    char *mark;
     PMIX_HIDE_UNUSED_PARAMS(hdr);
 
     pmix_output_verbose(2, pmix_globals.debug_output, "pmix:query cback from server");
@@ -83,9 +85,28 @@ static void query_cbfunc(struct pmix_peer_t *peer, pmix_ptl_hdr_t *hdr,
         goto complete;
     }
     if (0 < results->ninfo) {
-        PMIX_INFO_CREATE(results->info, results->ninfo);
-        cnt = results->ninfo;
-        PMIX_BFROPS_UNPACK(rc, peer, buf, results->info, &cnt, PMIX_INFO);
+        /* the reply lives until the caller releases it, so put all
+         * of it in an arena that goes with the results - unless it
+         * holds something that can only be unpacked onto the heap,
+         * or the arena cannot get the memory */
+        mark = buf->unpack_ptr;
+        results->arena = PMIX_NEW(pmix_arena_t);
+        results->info = (pmix_info_t *) pmix_tma_calloc(&results->arena->tma,
+                                                        results->ninfo * sizeof(pmix_info_t));
+        if (NULL == results->info) {
+            rc = PMIX_ERR_NOT_SUPPORTED;
+        } else {
+            cnt = results->ninfo;
+            PMIX_BFROPS_UNPACK_TMA(rc, peer, buf, results->info, &cnt, PMIX_INFO,
+                                   &results->arena->tma);
+        }
+        if (PMIX_ERR_NOT_SUPPORTED == rc) {
+            PMIX_RELEASE(results->arena);
+            buf->unpack_ptr = mark;
+            PMIX_INFO_CREATE(results->info, results->ninfo);
+            cnt = results->ninfo;
+            PMIX_BFROPS_UNPACK(rc, peer, buf, results->info, &cnt, PMIX_INFO);
+        }
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             results->status = rc;
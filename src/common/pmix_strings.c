@@ -249,6 +249,8 @@ PMIX_EXPORT const char *pmix_command_string(pmix_cmd_t cmd)
         return "COMPUTE DEVICE DIST";
     case PMIX_REFRESH_CACHE:
         return "REFRESH CACHE";
+    case PMIX_GETMULTI_CMD:
+        return "GET MULTI";
     default:
         return "UNKNOWN";
     }
@@ -19,6 +19,7 @@
 #include "include/pmix_server.h"
 
 #include "src/threads/pmix_threads.h"
+#include "src/util/pmix_atom.h"
 #include "src/util/pmix_error.h"
 #include "src/util/pmix_name_fns.h"
 #include "src/util/pmix_output.h"
@@ -880,6 +881,71 @@ static void local_cbfunc(pmix_status_t status, void *cbdata)
     PMIX_RELEASE(cd);
 }
 
+/* a notification payload packed for one buffer personality */
+typedef struct {
+    pmix_bfrops_module_t *bfrops;
+    pmix_bfrop_buffer_type_t type;
+    pmix_buffer_t *bfr;
+} pmix_notify_payload_t;
+
+/* there are only a handful of bfrops versions and buffer
+ * types, so this is enough to cover every personality */
+#define PMIX_NOTIFY_MAX_PAYLOADS 16
+
+static pmix_status_t pack_notification(pmix_notify_caddy_t *cd, pmix_peer_t *peer,
+                                       pmix_buffer_t **bfr)
+{
+    pmix_cmd_t cmd = PMIX_NOTIFY_CMD;
+    pmix_buffer_t *buf;
+    pmix_status_t rc;
+
+    buf = PMIX_NEW(pmix_buffer_t);
+    if (NULL == buf) {
+        return PMIX_ERR_NOMEM;
+    }
+    /* pack the command */
+    PMIX_BFROPS_PACK(rc, peer, buf, &cmd, 1, PMIX_COMMAND);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(buf);
+        return rc;
+    }
+
+    /* pack the status */
+    PMIX_BFROPS_PACK(rc, peer, buf, &cd->status, 1, PMIX_STATUS);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(buf);
+        return rc;
+    }
+
+    /* pack the source */
+    PMIX_BFROPS_PACK(rc, peer, buf, &cd->source, 1, PMIX_PROC);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(buf);
+        return rc;
+    }
+    /* pack any info */
+    PMIX_BFROPS_PACK(rc, peer, buf, &cd->ninfo, 1, PMIX_SIZE);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(buf);
+        return rc;
+    }
+
+    if (0 < cd->ninfo) {
+        PMIX_BFROPS_PACK(rc, peer, buf, cd->info, cd->ninfo, PMIX_INFO);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_RELEASE(buf);
+            return rc;
+        }
+    }
+    *bfr = buf;
+    return PMIX_SUCCESS;
+}
+
 static void _notify_client_event(int sd, short args, void *cbdata)
 {
     (void) sd;
@@ -891,13 +957,14 @@ static void _notify_client_event(int sd, short args, void *cbdata)
     size_t n, nleft;
     bool matched, holdcd;
     pmix_buffer_t *bfr;
-    pmix_cmd_t cmd = PMIX_NOTIFY_CMD;
     pmix_status_t rc;
     pmix_list_t trk;
     pmix_namelist_t *nm;
-    pmix_namespace_t *nptr, *tmp;
+    pmix_namespace_t *nptr;
     pmix_range_trkr_t rngtrk;
     pmix_proc_t proc;
+    pmix_notify_payload_t payloads[PMIX_NOTIFY_MAX_PAYLOADS];
+    size_t npayloads = 0;
 
     /* need to acquire the object from its originating thread */
     PMIX_ACQUIRE_OBJECT(cd);
@@ -911,7 +978,7 @@ static void _notify_client_event(int sd, short args, void *cbdata)
     if (0 < cd->ninfo) {
         /* check for caching instructions */
         for (n = 0; n < cd->ninfo; n++) {
-            if (PMIX_CHECK_KEY(&cd->info[n], PMIX_EVENT_DO_NOT_CACHE)) {
+            if (PMIX_ATOM_KEY_EVENT_DO_NOT_CACHE == pmix_atom_lookup(cd->info[n].key)) {
                 if (PMIX_INFO_TRUE(&cd->info[n])) {
                     holdcd = false;
                 }
@@ -981,13 +1048,7 @@ static void _notify_client_event(int sd, short args, void *cbdata)
                 ++nleft;
             } else {
                 /* look up the nspace for this proc */
-                nptr = NULL;
-                PMIX_LIST_FOREACH (tmp, &pmix_globals.nspaces, pmix_namespace_t) {
-                    if (PMIX_CHECK_NSPACE(tmp->nspace, cd->targets[n].nspace)) {
-                        nptr = tmp;
-                        break;
-                    }
-                }
+                nptr = pmix_nspace_lookup(cd->targets[n].nspace);
                 /* if we don't yet know it, then nothing to do */
                 if (NULL == nptr) {
                     nleft = SIZE_MAX;
@@ -1037,7 +1098,7 @@ static void _notify_client_event(int sd, short args, void *cbdata)
         pmix_group_t *grp;
         /* must include the group id */
         for (n = 0; n < cd->ninfo; n++) {
-            if (PMIX_CHECK_KEY(&cd->info[n], PMIX_GROUP_ID)) {
+            if (PMIX_ATOM_KEY_GROUP_ID == pmix_atom_lookup(cd->info[n].key)) {
                 grpid = cd->info[n].value.data.string;
                 break;
             }
@@ -1126,48 +1187,31 @@ static void _notify_client_event(int sd, short args, void *cbdata)
                     nm->pname = &pr->peer->info->pname;
                     pmix_list_append(&trk, &nm->super);
 
-                    bfr = PMIX_NEW(pmix_buffer_t);
-                    if (NULL == bfr) {
-                        continue;
-                    }
-                    /* pack the command */
-                    PMIX_BFROPS_PACK(rc, pr->peer, bfr, &cmd, 1, PMIX_COMMAND);
-                    if (PMIX_SUCCESS != rc) {
-                        PMIX_ERROR_LOG(rc);
-                        PMIX_RELEASE(bfr);
-                        continue;
-                    }
-
-                    /* pack the status */
-                    PMIX_BFROPS_PACK(rc, pr->peer, bfr, &cd->status, 1, PMIX_STATUS);
-                    if (PMIX_SUCCESS != rc) {
-                        PMIX_ERROR_LOG(rc);
-                        PMIX_RELEASE(bfr);
-                        continue;
-                    }
-
-                    /* pack the source */
-                    PMIX_BFROPS_PACK(rc, pr->peer, bfr, &cd->source, 1, PMIX_PROC);
-                    if (PMIX_SUCCESS != rc) {
-                        PMIX_ERROR_LOG(rc);
-                        PMIX_RELEASE(bfr);
-                        continue;
-                    }
-                    /* pack any info */
-                    PMIX_BFROPS_PACK(rc, pr->peer, bfr, &cd->ninfo, 1, PMIX_SIZE);
-                    if (PMIX_SUCCESS != rc) {
-                        PMIX_ERROR_LOG(rc);
-                        PMIX_RELEASE(bfr);
-                        continue;
+                    /* clients sharing a buffer personality receive the
+                     * same payload, so only pack it once per personality */
+                    bfr = NULL;
+                    for (n = 0; n < npayloads; n++) {
+                        if (payloads[n].bfrops == pr->peer->nptr->compat.bfrops
+                            && payloads[n].type == pr->peer->nptr->compat.type) {
+                            bfr = payloads[n].bfr;
+                            break;
+                        }
                     }
-
-                    if (0 < cd->ninfo) {
-                        PMIX_BFROPS_PACK(rc, pr->peer, bfr, cd->info, cd->ninfo, PMIX_INFO);
+                    if (NULL == bfr) {
+                        rc = pack_notification(cd, pr->peer, &bfr);
                         if (PMIX_SUCCESS != rc) {
-                            PMIX_ERROR_LOG(rc);
-                            PMIX_RELEASE(bfr);
                             continue;
                         }
+                        if (npayloads < PMIX_NOTIFY_MAX_PAYLOADS) {
+                            payloads[npayloads].bfrops = pr->peer->nptr->compat.bfrops;
+                            payloads[npayloads].type = pr->peer->nptr->compat.type;
+                            payloads[npayloads].bfr = bfr;
+                            ++npayloads;
+                            /* the send releases its own reference */
+                            PMIX_RETAIN(bfr);
+                        }
+                    } else {
+                        PMIX_RETAIN(bfr);
                     }
                     PMIX_SERVER_QUEUE_REPLY(rc, pr->peer, 0, bfr);
                     if (PMIX_SUCCESS != rc) {
@@ -1188,6 +1232,9 @@ static void _notify_client_event(int sd, short args, void *cbdata)
             }
         }
         PMIX_LIST_DESTRUCT(&trk);
+        for (n = 0; n < npayloads; n++) {
+            PMIX_RELEASE(payloads[n].bfr);
+        }
         if (PMIX_RANGE_LOCAL != cd->range && PMIX_CHECK_PROCID(&cd->source, &pmix_globals.myid)) {
             /* if we are the source, then we need to post this upwards as
              * well so the host RM can broadcast it as necessary */
@@ -1378,9 +1425,11 @@ pmix_status_t pmix_prep_event_chain(pmix_event_chain_t *chain, const pmix_info_t
                 PMIX_INFO_XFER(&chain->info[n], &info[n]);
             }
             /* look for specific directives */
-            if (0 == strncmp(info[n].key, PMIX_EVENT_NON_DEFAULT, PMIX_MAX_KEYLEN)) {
+            switch (pmix_atom_lookup(info[n].key)) {
+            case PMIX_ATOM_KEY_EVENT_NON_DEFAULT:
                 chain->nondefault = PMIX_INFO_TRUE(&info[n]);
-            } else if (PMIX_CHECK_KEY(&info[n], PMIX_EVENT_CUSTOM_RANGE)) {
+                break;
+            case PMIX_ATOM_KEY_EVENT_CUSTOM_RANGE:
                 /* provides an array of pmix_proc_t identifying the procs
                  * that are to receive this notification, or a single pmix_proc_t  */
                 if (PMIX_DATA_ARRAY == info[n].value.type && NULL != info[n].value.data.darray
@@ -1398,14 +1447,16 @@ pmix_status_t pmix_prep_event_chain(pmix_event_chain_t *chain, const pmix_info_t
                     PMIX_ERROR_LOG(PMIX_ERR_BAD_PARAM);
                     return PMIX_ERR_BAD_PARAM;
                 }
-            } else if (PMIX_CHECK_KEY(&info[n], PMIX_EVENT_AFFECTED_PROC)) {
+                break;
+            case PMIX_ATOM_KEY_EVENT_AFFECTED_PROC:
                 PMIX_PROC_CREATE(chain->affected, 1);
                 if (NULL == chain->affected) {
                     return PMIX_ERR_NOMEM;
                 }
                 chain->naffected = 1;
                 memcpy(chain->affected, info[n].value.data.proc, sizeof(pmix_proc_t));
-            } else if (PMIX_CHECK_KEY(&info[n], PMIX_EVENT_AFFECTED_PROCS)) {
+                break;
+            case PMIX_ATOM_KEY_EVENT_AFFECTED_PROCS:
                 chain->naffected = info[n].value.data.darray->size;
                 PMIX_PROC_CREATE(chain->affected, chain->naffected);
                 if (NULL == chain->affected) {
@@ -1414,6 +1465,9 @@ pmix_status_t pmix_prep_event_chain(pmix_event_chain_t *chain, const pmix_info_t
                 }
                 memcpy(chain->affected, info[n].value.data.darray->array,
                        chain->naffected * sizeof(pmix_proc_t));
+                break;
+            default:
+                break;
             }
         }
     }
@@ -132,6 +132,7 @@ PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_cleanup_dir_t, pmix_list_item_t, cdcon, cdd
 static void nscon(pmix_namespace_t *p)
 {
     p->nspace = NULL;
+    p->id = 0;
     memset(&p->version, 0, sizeof(p->version));
     p->nprocs = 0;
     p->nlocalprocs = SIZE_MAX;
@@ -305,6 +306,7 @@ static void scon(pmix_shift_caddy_t *p)
     p->key = NULL;
     p->info = NULL;
     p->ninfo = 0;
+    p->arena = NULL;
     p->directives = NULL;
     p->ndirs = 0;
     p->evhdlr = NULL;
@@ -330,6 +332,9 @@ static void scdes(pmix_shift_caddy_t *p)
     if (NULL != p->kv) {
         PMIX_RELEASE(p->kv);
     }
+    if (NULL != p->arena) {
+        PMIX_RELEASE(p->arena);
+    }
 }
 PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_shift_caddy_t, pmix_object_t, scon, scdes);
 
@@ -688,6 +693,63 @@ static bool dirpath_is_empty(const char *path)
     return true;
 }
 
+void pmix_nspace_register(pmix_namespace_t *nptr)
+{
+    if (0 != nptr->id) {
+        return;
+    }
+    nptr->id = ++pmix_globals.next_nspace_id;
+    pmix_list_append(&pmix_globals.nspaces, &nptr->super);
+    pmix_hash_table_set_value_uint32(&pmix_globals.nspace_ids, nptr->id, nptr);
+    if (NULL != nptr->nspace) {
+        pmix_hash_table_set_value_ptr(&pmix_globals.nspace_names, nptr->nspace,
+                                      strlen(nptr->nspace), nptr);
+    }
+}
+
+void pmix_nspace_deregister(pmix_namespace_t *nptr)
+{
+    pmix_namespace_t *ns;
+
+    if (0 == nptr->id) {
+        return;
+    }
+    pmix_hash_table_remove_value_uint32(&pmix_globals.nspace_ids, nptr->id);
+    /* only remove the name if it still points to us */
+    if (NULL != nptr->nspace
+        && PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&pmix_globals.nspace_names, nptr->nspace,
+                                                         strlen(nptr->nspace), (void **) &ns)
+        && ns == nptr) {
+        pmix_hash_table_remove_value_ptr(&pmix_globals.nspace_names, nptr->nspace,
+                                         strlen(nptr->nspace));
+    }
+    nptr->id = 0;
+    pmix_list_remove_item(&pmix_globals.nspaces, &nptr->super);
+}
+
+pmix_namespace_t *pmix_nspace_lookup(const char *nspace)
+{
+    pmix_namespace_t *nptr;
+
+    if (NULL == nspace
+        || PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&pmix_globals.nspace_names, nspace,
+                                                         strlen(nspace), (void **) &nptr)) {
+        return NULL;
+    }
+    return nptr;
+}
+
+pmix_namespace_t *pmix_nspace_lookup_id(uint32_t id)
+{
+    pmix_namespace_t *nptr;
+
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_uint32(&pmix_globals.nspace_ids, id,
+                                                         (void **) &nptr)) {
+        return NULL;
+    }
+    return nptr;
+}
+
 int pmix_event_assign(struct event *ev, pmix_event_base_t *evbase, int fd, short arg,
                       event_callback_fn cbfn, void *cbd)
 {
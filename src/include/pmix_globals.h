@@ -39,6 +39,7 @@
 #include "pmix_common.h"
 #include "pmix_tool.h"
 
+#include "src/class/pmix_arena.h"
 #include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_hotel.h"
 #include "src/class/pmix_list.h"
@@ -51,6 +52,7 @@
 #include "src/mca/psec/psec.h"
 #include "src/mca/ptl/ptl.h"
 
+#include "src/util/pmix_atom.h"
 #include "src/util/pmix_name_fns.h"
 
 BEGIN_C_DECLS
@@ -134,6 +136,7 @@ typedef uint8_t pmix_cmd_t;
 #define PMIX_FABRIC_UPDATE_CMD            31
 #define PMIX_COMPUTE_DEVICE_DISTANCES_CMD 32
 #define PMIX_REFRESH_CACHE                33
+#define PMIX_GETMULTI_CMD                 34
 
 /* provide a "pretty-print" function for cmds */
 const char *pmix_command_string(pmix_cmd_t cmd);
@@ -209,6 +212,7 @@ typedef struct {
 typedef struct {
     pmix_list_item_t super;
     char *nspace;
+    uint32_t id; // registry id - 0 if not registered
     struct {
         uint8_t major;
         uint8_t minor;
@@ -384,6 +388,8 @@ typedef struct {
     bool hybrid;        // true if participating procs are from more than one nspace
     pmix_proc_t *pcs;   // copy of the original array of participants
     size_t npcs;        // number of procs in the array
+    char *key;          // id or participant signature the tracker is indexed by
+    size_t keylen;      // number of bytes in the key
     pmix_list_t nslist; // unique nspace list of participants
     pmix_lock_t lock;   // flag for waiting for completion
     bool def_complete;  // all local procs have been registered and the trk definition is complete
@@ -396,6 +402,8 @@ typedef struct {
     pmix_info_t *info;  // array of info structs
     size_t ninfo;       // number of info structs in array
     pmix_collect_t collect_type; // whether or not data is to be returned at completion
+    pmix_buffer_t *stream;       // contributions packed as the participants arrived
+    bool streamed;               // some contributions were already passed to the host
     pmix_modex_cbfunc_t modexcbfunc;
     pmix_op_cbfunc_t op_cbfunc;
     void *cbdata;
@@ -434,6 +442,7 @@ typedef struct {
     const char *key;
     pmix_info_t *info;
     size_t ninfo;
+    pmix_arena_t *arena; // holds info when it was unpacked into one
     pmix_info_t *directives;
     size_t ndirs;
     pmix_notification_fn_t evhdlr;
@@ -605,7 +614,10 @@ typedef struct {
     bool xml_output;
     bool timestamp_output;
     size_t output_limit;
-    pmix_list_t nspaces;
+    pmix_list_t nspaces;            // registered pmix_namespace_t
+    pmix_hash_table_t nspace_names; // registered nspaces by name
+    pmix_hash_table_t nspace_ids;   // registered nspaces by id
+    uint32_t next_nspace_id;
     pmix_topology_t topology;
     pmix_cpuset_t cpuset;
     bool external_topology;
@@ -616,6 +628,25 @@ typedef struct {
 /* provide access to a function to cleanup epilogs */
 PMIX_EXPORT void pmix_execute_epilog(pmix_epilog_t *ep);
 
+/* registry of the nspaces known to this process. A registered
+ * nspace is on the pmix_globals.nspaces list, which holds its
+ * reference, and can be found by name or by its id in constant
+ * time. Ids are never reused, so two nspaces are the same if
+ * their ids are. The nspace must be named before it is added. */
+PMIX_EXPORT void pmix_nspace_register(pmix_namespace_t *nptr);
+PMIX_EXPORT void pmix_nspace_deregister(pmix_namespace_t *nptr);
+PMIX_EXPORT pmix_namespace_t *pmix_nspace_lookup(const char *nspace);
+PMIX_EXPORT pmix_namespace_t *pmix_nspace_lookup_id(uint32_t id);
+
+/* check if two nspace objects, or the nspaces of two peers,
+ * are the same - by id if both are registered, else by name */
+#define PMIX_CHECK_NSPACE_ID(a, b)                                       \
+    ((a) == (b)                                                          \
+     || ((0 != (a)->id && 0 != (b)->id) ? (a)->id == (b)->id             \
+                                        : PMIX_CHECK_NSPACE((a)->nspace, (b)->nspace)))
+#define PMIX_CHECK_PEER_NSPACE(a, b) \
+    (NULL != (a)->nptr && NULL != (b)->nptr && PMIX_CHECK_NSPACE_ID((a)->nptr, (b)->nptr))
+
 PMIX_EXPORT pmix_status_t pmix_notify_event_cache(pmix_notify_caddy_t *cd);
 
 PMIX_EXPORT extern pmix_globals_t pmix_globals;
@@ -625,55 +656,17 @@ PMIX_EXPORT extern const char* PMIX_PROXY_BUGREPORT;
 
 static inline bool pmix_check_node_info(const char *key)
 {
-    char *keys[] = {PMIX_HOSTNAME,
-                    PMIX_HOSTNAME_ALIASES,
-                    PMIX_NODEID,
-                    PMIX_AVAIL_PHYS_MEMORY,
-                    PMIX_LOCAL_PEERS,
-                    PMIX_LOCAL_PROCS,
-                    PMIX_LOCAL_CPUSETS,
-                    PMIX_LOCAL_SIZE,
-                    PMIX_NODE_SIZE,
-                    PMIX_LOCALLDR,
-                    PMIX_NODE_OVERSUBSCRIBED,
-                    NULL};
-    size_t n;
-
-    for (n = 0; NULL != keys[n]; n++) {
-        if (0 == strncmp(key, keys[n], PMIX_MAX_KEYLEN)) {
-            return true;
-        }
-    }
-    return false;
+    return 0 != (pmix_atom_key_flags(key) & PMIX_ATOM_NODE_INFO);
 }
 
 static inline bool pmix_check_app_info(const char *key)
 {
-    char *keys[] = {PMIX_APP_SIZE,  PMIX_APPLDR,       PMIX_APP_ARGV,      PMIX_WDIR,
-                    PMIX_PSET_NAME, PMIX_APP_MAP_TYPE, PMIX_APP_MAP_REGEX, NULL};
-    size_t n;
-
-    for (n = 0; NULL != keys[n]; n++) {
-        if (0 == strncmp(key, keys[n], PMIX_MAX_KEYLEN)) {
-            return true;
-        }
-    }
-    return false;
+    return 0 != (pmix_atom_key_flags(key) & PMIX_ATOM_APP_INFO);
 }
 
 static inline bool pmix_check_session_info(const char *key)
 {
-    char *keys[] = {PMIX_SESSION_ID, PMIX_CLUSTER_ID,   PMIX_UNIV_SIZE,
-                    PMIX_TMPDIR,     PMIX_TDIR_RMCLEAN, PMIX_HOSTNAME_KEEP_FQDN,
-                    PMIX_RM_NAME,    PMIX_RM_VERSION,   NULL};
-    size_t n;
-
-    for (n = 0; NULL != keys[n]; n++) {
-        if (0 == strncmp(key, keys[n], PMIX_MAX_KEYLEN)) {
-            return true;
-        }
-    }
-    return false;
+    return 0 != (pmix_atom_key_flags(key) & PMIX_ATOM_SESSION_INFO);
 }
 
 #if PMIX_PICKY_COMPILERS
@@ -41,6 +41,8 @@
 #include "src/mca/base/pmix_mca_base_framework.h"
 #include "src/mca/bfrops/bfrops.h"
 #include "src/mca/mca.h"
+#include "src/mca/psquash/base/base.h"
+#include "src/util/pmix_error.h"
 
 BEGIN_C_DECLS
 
@@ -76,6 +78,8 @@ struct pmix_bfrops_globals_t {
     size_t initial_size;
     size_t threshold_size;
     pmix_bfrop_buffer_type_t default_type;
+    bool native;
+    char arch[64];
 };
 typedef struct pmix_bfrops_globals_t pmix_bfrops_globals_t;
 
@@ -192,28 +196,16 @@ PMIX_EXPORT extern pmix_bfrops_globals_t pmix_bfrops_globals;
         }                                                                                         \
     } while (0)
 
-#define PMIX_BFROPS_PACK_TYPE(r, b, s, n, t, arr)                                    \
-    do {                                                                             \
-        pmix_bfrop_type_info_t *__info;                                              \
-        /* Lookup the pack function for this type and call it */                     \
-        __info = (pmix_bfrop_type_info_t *) pmix_pointer_array_get_item((arr), (t)); \
-        if (NULL == __info) {                                                        \
-            (r) = PMIX_ERR_UNKNOWN_DATA_TYPE;                                        \
-        } else {                                                                     \
-            (r) = __info->odti_pack_fn(arr, b, s, n, t);                             \
-        }                                                                            \
+/* the registry names the routine for each type, but those of the
+ * hot types are run directly - see pmix_bfrop_pack_type below */
+#define PMIX_BFROPS_PACK_TYPE(r, b, s, n, t, arr)                   \
+    do {                                                            \
+        (r) = pmix_bfrop_pack_type((arr), (b), (s), (n), (t));      \
     } while (0)
 
-#define PMIX_BFROPS_UNPACK_TYPE(r, b, d, n, t, arr)                                  \
-    do {                                                                             \
-        pmix_bfrop_type_info_t *__info;                                              \
-        /* Lookup the unpack function for this type and call it */                   \
-        __info = (pmix_bfrop_type_info_t *) pmix_pointer_array_get_item((arr), (t)); \
-        if (NULL == __info) {                                                        \
-            (r) = PMIX_ERR_UNKNOWN_DATA_TYPE;                                        \
-        } else {                                                                     \
-            (r) = __info->odti_unpack_fn(arr, b, d, n, t);                           \
-        }                                                                            \
+#define PMIX_BFROPS_UNPACK_TYPE(r, b, d, n, t, arr)                 \
+    do {                                                            \
+        (r) = pmix_bfrop_unpack_type((arr), (b), (d), (n), (t));    \
     } while (0)
 
 /* NOTE: do not need to deal with endianness here, as the unpacking of
@@ -335,6 +327,10 @@ PMIX_EXPORT pmix_status_t pmix_bfrops_base_pack_int(pmix_pointer_array_t *regtyp
 PMIX_EXPORT pmix_status_t pmix_bfrops_base_pack_sizet(pmix_pointer_array_t *regtypes,
                                                       pmix_buffer_t *buffer, const void *src,
                                                       int32_t num_vals, pmix_data_type_t type);
+PMIX_EXPORT pmix_status_t pmix_bfrops_base_pack_encoded_sizet(pmix_pointer_array_t *regtypes,
+                                                              pmix_buffer_t *buffer,
+                                                              const void *src, int32_t num_vals,
+                                                              pmix_data_type_t type);
 PMIX_EXPORT pmix_status_t pmix_bfrops_base_pack_byte(pmix_pointer_array_t *regtypes,
                                                      pmix_buffer_t *buffer, const void *src,
                                                      int32_t num_vals, pmix_data_type_t type);
@@ -354,6 +350,10 @@ PMIX_EXPORT pmix_status_t pmix_bfrops_base_pack_int32(pmix_pointer_array_t *regt
 PMIX_EXPORT pmix_status_t pmix_bfrops_base_pack_int64(pmix_pointer_array_t *regtypes,
                                                       pmix_buffer_t *buffer, const void *src,
                                                       int32_t num_vals, pmix_data_type_t type);
+PMIX_EXPORT pmix_status_t pmix_bfrops_base_pack_general_int(pmix_pointer_array_t *regtypes,
+                                                            pmix_buffer_t *buffer, const void *src,
+                                                            int32_t num_vals,
+                                                            pmix_data_type_t type);
 PMIX_EXPORT pmix_status_t pmix_bfrops_base_pack_string(pmix_pointer_array_t *regtypes,
                                                        pmix_buffer_t *buffer, const void *src,
                                                        int32_t num_vals, pmix_data_type_t type);
@@ -524,6 +524,13 @@ PMIX_EXPORT pmix_status_t pmix_bfrops_base_pack_satyp(pmix_pointer_array_t *regt
 PMIX_EXPORT pmix_status_t pmix_bfrops_base_unpack(pmix_pointer_array_t *regtypes,
                                                   pmix_buffer_t *buffer, void *dst,
                                                   int32_t *num_vals, pmix_data_type_t type);
+PMIX_EXPORT pmix_status_t pmix_bfrops_base_unpack_view(pmix_pointer_array_t *regtypes,
+                                                       pmix_buffer_t *buffer, void *dst,
+                                                       int32_t *num_vals, pmix_data_type_t type);
+PMIX_EXPORT pmix_status_t pmix_bfrops_base_unpack_tma(pmix_pointer_array_t *regtypes,
+                                                      pmix_buffer_t *buffer, void *dst,
+                                                      int32_t *num_vals, pmix_data_type_t type,
+                                                      pmix_tma_t *tma);
 
 PMIX_EXPORT pmix_status_t pmix_bfrops_base_unpack_bool(pmix_pointer_array_t *regtypes,
                                                        pmix_buffer_t *buffer, void *dest,
@@ -540,6 +547,10 @@ PMIX_EXPORT pmix_status_t pmix_bfrops_base_unpack_int(pmix_pointer_array_t *regt
 PMIX_EXPORT pmix_status_t pmix_bfrops_base_unpack_sizet(pmix_pointer_array_t *regtypes,
                                                         pmix_buffer_t *buffer, void *dest,
                                                         int32_t *num_vals, pmix_data_type_t type);
+PMIX_EXPORT pmix_status_t pmix_bfrops_base_unpack_encoded_sizet(pmix_pointer_array_t *regtypes,
+                                                                pmix_buffer_t *buffer, void *dest,
+                                                                int32_t *num_vals,
+                                                                pmix_data_type_t type);
 PMIX_EXPORT pmix_status_t pmix_bfrops_base_unpack_pid(pmix_pointer_array_t *regtypes,
                                                       pmix_buffer_t *buffer, void *dest,
                                                       int32_t *num_vals, pmix_data_type_t type);
@@ -556,6 +567,10 @@ PMIX_EXPORT pmix_status_t pmix_bfrops_base_unpack_datatype(pmix_pointer_array_t
 PMIX_EXPORT pmix_status_t pmix_bfrops_base_unpack_int64(pmix_pointer_array_t *regtypes,
                                                         pmix_buffer_t *buffer, void *dest,
                                                         int32_t *num_vals, pmix_data_type_t type);
+PMIX_EXPORT pmix_status_t pmix_bfrops_base_unpack_general_int(pmix_pointer_array_t *regtypes,
+                                                              pmix_buffer_t *buffer, void *dest,
+                                                              int32_t *num_vals,
+                                                              pmix_data_type_t type);
 
 PMIX_EXPORT pmix_status_t pmix_bfrops_base_unpack_float(pmix_pointer_array_t *regtypes,
                                                         pmix_buffer_t *buffer, void *dest,
@@ -1002,6 +1017,345 @@ PMIX_EXPORT pmix_status_t pmix_bfrops_base_value_xfer(pmix_value_t *p, const pmi
 
 PMIX_EXPORT pmix_value_cmp_t pmix_bfrops_base_value_cmp(pmix_value_t *p, pmix_value_t *p1);
 
+/*
+ * Statically dispatched pack/unpack of the hot types
+ *
+ * Nearly everything that crosses the wire is built from strings,
+ * integers, sizes, procs, ranks, statuses, infos and values, and
+ * packing one of the composites used to cost an indirect call through
+ * the registry for every field. The registry is still consulted, but
+ * when the entry for one of these types is a base routine it is run
+ * directly - the leaf routines for bytes and integers are expanded in
+ * place so, for example, packing a string makes no indirect call at
+ * all. Entries that differ from the base, such as those of the older
+ * components or types added by an extension, are called through the
+ * registry as before.
+ */
+
+/* make sure there is room for bytes more, extending the buffer only
+ * when needed */
+static inline char *pmix_bfrop_buffer_space(pmix_buffer_t *buffer, size_t bytes)
+{
+    if (PMIX_LIKELY((buffer->bytes_allocated - buffer->bytes_used) >= bytes)) {
+        return buffer->pack_ptr;
+    }
+    return pmix_bfrop_buffer_extend(buffer, bytes);
+}
+
+static inline pmix_status_t pmix_bfrop_pack_bytes(pmix_buffer_t *buffer, const void *src,
+                                                  size_t nbytes)
+{
+    char *dst;
+
+    if (NULL == (dst = pmix_bfrop_buffer_space(buffer, nbytes))) {
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    memcpy(dst, src, nbytes);
+    buffer->pack_ptr += nbytes;
+    buffer->bytes_used += nbytes;
+    return PMIX_SUCCESS;
+}
+
+static inline pmix_status_t pmix_bfrop_unpack_bytes(pmix_buffer_t *buffer, void *dest,
+                                                    size_t nbytes)
+{
+    if (PMIX_UNLIKELY(buffer->pack_ptr < buffer->unpack_ptr
+                      || (size_t)(buffer->pack_ptr - buffer->unpack_ptr) < nbytes)) {
+        return PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+    }
+    memcpy(dest, buffer->unpack_ptr, nbytes);
+    buffer->unpack_ptr += nbytes;
+    return PMIX_SUCCESS;
+}
+
+/* INT16, INT32, INT64 and their unsigned forms, squashed by the
+ * active psquash component unless the buffer is native. Each array
+ * is offered to the component to encode as a block, and is squashed
+ * one value at a time if it declines */
+static inline pmix_status_t pmix_bfrop_pack_ints(pmix_buffer_t *buffer, const void *src,
+                                                 int32_t num_vals, pmix_data_type_t type)
+{
+    pmix_status_t rc;
+    int32_t i;
+    char *dst;
+    size_t val_size, max_size, pkg_size;
+
+    PMIX_SQUASH_TYPE_SIZEOF(rc, type, val_size);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    if (PMIX_BFROP_BUFFER_NATIVE == buffer->type) {
+        /* no need to squash - the other side reads them as they are */
+        return pmix_bfrop_pack_bytes(buffer, src, num_vals * val_size);
+    }
+
+    rc = pmix_psquash.get_max_size(type, &max_size);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    /* check to see if buffer needs extending */
+    if (NULL == (dst = pmix_bfrop_buffer_space(buffer, num_vals * max_size))) {
+        rc = PMIX_ERR_OUT_OF_RESOURCE;
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    if (NULL != pmix_psquash.encode_ints) {
+        rc = pmix_psquash.encode_ints(type, src, num_vals, dst, &pkg_size);
+        if (PMIX_SUCCESS == rc) {
+            buffer->pack_ptr += pkg_size;
+            buffer->bytes_used += pkg_size;
+            return PMIX_SUCCESS;
+        }
+        if (PMIX_ERR_NOT_SUPPORTED != rc) {
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+    }
+
+    for (i = 0; i < num_vals; ++i) {
+        rc = (pmix_psquash.encode_int)(type, (uint8_t *) src + i * val_size, dst, &pkg_size);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+        dst += pkg_size;
+        buffer->pack_ptr += pkg_size;
+        buffer->bytes_used += pkg_size;
+    }
+
+    return PMIX_SUCCESS;
+}
+
+static inline pmix_status_t pmix_bfrop_unpack_ints(pmix_buffer_t *buffer, void *dest,
+                                                   int32_t *num_vals, pmix_data_type_t type)
+{
+    pmix_status_t rc;
+    size_t val_size, avail_size, unpack_size, max_size;
+    int32_t i;
+
+    /* check to see if there's enough data in buffer */
+    if (buffer->pack_ptr == buffer->unpack_ptr) {
+        return PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+    }
+
+    PMIX_SQUASH_TYPE_SIZEOF(rc, type, val_size);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    if (PMIX_BFROP_BUFFER_NATIVE == buffer->type) {
+        return pmix_bfrop_unpack_bytes(buffer, dest, (*num_vals) * val_size);
+    }
+
+    if (NULL != pmix_psquash.decode_ints) {
+        avail_size = buffer->pack_ptr - buffer->unpack_ptr;
+        rc = pmix_psquash.decode_ints(type, buffer->unpack_ptr, avail_size, dest, *num_vals,
+                                      &unpack_size);
+        if (PMIX_SUCCESS == rc) {
+            buffer->unpack_ptr += unpack_size;
+            return PMIX_SUCCESS;
+        }
+        if (PMIX_ERR_NOT_SUPPORTED != rc) {
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+    }
+
+    rc = pmix_psquash.get_max_size(type, &max_size);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    /* unpack the data */
+    for (i = 0; i < (*num_vals); ++i) {
+        avail_size = buffer->pack_ptr - buffer->unpack_ptr;
+        rc = (pmix_psquash.decode_int)(type, buffer->unpack_ptr, avail_size,
+                                       (uint8_t *) dest + i * val_size, &unpack_size);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+        /* sanity checks */
+        if (unpack_size > max_size) {
+            rc = PMIX_ERR_UNPACK_FAILURE;
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+        if (unpack_size > avail_size) {
+            rc = PMIX_ERR_FATAL;
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+        buffer->unpack_ptr += unpack_size;
+    }
+
+    return PMIX_SUCCESS;
+}
+
+/* when the type is a constant, as it is at nearly every call
+ * site, the switch folds down to a single check of the registry */
+static inline pmix_status_t pmix_bfrop_pack_type(pmix_pointer_array_t *regtypes,
+                                                 pmix_buffer_t *buffer, const void *src,
+                                                 int32_t num_vals, pmix_data_type_t type)
+{
+    pmix_bfrop_type_info_t *info;
+    pmix_bfrop_internal_pack_fn_t fn;
+
+    /* Lookup the pack function for this type */
+    info = (pmix_bfrop_type_info_t *) pmix_pointer_array_get_item(regtypes, type);
+    if (NULL == info) {
+        return PMIX_ERR_UNKNOWN_DATA_TYPE;
+    }
+    fn = info->odti_pack_fn;
+
+    switch (type) {
+    case PMIX_BYTE:
+    case PMIX_INT8:
+    case PMIX_UINT8:
+        if (pmix_bfrops_base_pack_byte == fn) {
+            return pmix_bfrop_pack_bytes(buffer, src, num_vals);
+        }
+        break;
+    case PMIX_INT16:
+    case PMIX_INT32:
+    case PMIX_INT64:
+    case PMIX_UINT16:
+    case PMIX_UINT32:
+    case PMIX_UINT64:
+        if (pmix_bfrops_base_pack_general_int == fn) {
+            return pmix_bfrop_pack_ints(buffer, src, num_vals, type);
+        }
+        break;
+    case PMIX_STRING:
+        if (pmix_bfrops_base_pack_string == fn) {
+            return pmix_bfrops_base_pack_string(regtypes, buffer, src, num_vals, type);
+        }
+        break;
+    case PMIX_SIZE:
+        if (pmix_bfrops_base_pack_encoded_sizet == fn) {
+            return pmix_bfrops_base_pack_encoded_sizet(regtypes, buffer, src, num_vals, type);
+        }
+        if (pmix_bfrops_base_pack_sizet == fn) {
+            return pmix_bfrops_base_pack_sizet(regtypes, buffer, src, num_vals, type);
+        }
+        break;
+    case PMIX_PROC_RANK:
+        if (pmix_bfrops_base_pack_rank == fn) {
+            return pmix_bfrops_base_pack_rank(regtypes, buffer, src, num_vals, type);
+        }
+        break;
+    case PMIX_STATUS:
+        if (pmix_bfrops_base_pack_status == fn) {
+            return pmix_bfrops_base_pack_status(regtypes, buffer, src, num_vals, type);
+        }
+        break;
+    case PMIX_PROC:
+        if (pmix_bfrops_base_pack_proc == fn) {
+            return pmix_bfrops_base_pack_proc(regtypes, buffer, src, num_vals, type);
+        }
+        break;
+    case PMIX_INFO:
+        if (pmix_bfrops_base_pack_info == fn) {
+            return pmix_bfrops_base_pack_info(regtypes, buffer, src, num_vals, type);
+        }
+        break;
+    case PMIX_VALUE:
+        if (pmix_bfrops_base_pack_value == fn) {
+            return pmix_bfrops_base_pack_value(regtypes, buffer, src, num_vals, type);
+        }
+        break;
+    default:
+        break;
+    }
+
+    return fn(regtypes, buffer, src, num_vals, type);
+}
+
+static inline pmix_status_t pmix_bfrop_unpack_type(pmix_pointer_array_t *regtypes,
+                                                   pmix_buffer_t *buffer, void *dest,
+                                                   int32_t *num_vals, pmix_data_type_t type)
+{
+    pmix_bfrop_type_info_t *info;
+    pmix_bfrop_internal_unpack_fn_t fn;
+
+    /* Lookup the unpack function for this type */
+    info = (pmix_bfrop_type_info_t *) pmix_pointer_array_get_item(regtypes, type);
+    if (NULL == info) {
+        return PMIX_ERR_UNKNOWN_DATA_TYPE;
+    }
+    fn = info->odti_unpack_fn;
+
+    switch (type) {
+    case PMIX_BYTE:
+    case PMIX_INT8:
+    case PMIX_UINT8:
+        if (pmix_bfrops_base_unpack_byte == fn) {
+            return pmix_bfrop_unpack_bytes(buffer, dest, *num_vals);
+        }
+        break;
+    case PMIX_INT16:
+    case PMIX_INT32:
+    case PMIX_INT64:
+    case PMIX_UINT16:
+    case PMIX_UINT32:
+    case PMIX_UINT64:
+        if (pmix_bfrops_base_unpack_general_int == fn) {
+            return pmix_bfrop_unpack_ints(buffer, dest, num_vals, type);
+        }
+        break;
+    case PMIX_STRING:
+        if (pmix_bfrops_base_unpack_string == fn) {
+            return pmix_bfrops_base_unpack_string(regtypes, buffer, dest, num_vals, type);
+        }
+        break;
+    case PMIX_SIZE:
+        if (pmix_bfrops_base_unpack_encoded_sizet == fn) {
+            return pmix_bfrops_base_unpack_encoded_sizet(regtypes, buffer, dest, num_vals, type);
+        }
+        if (pmix_bfrops_base_unpack_sizet == fn) {
+            return pmix_bfrops_base_unpack_sizet(regtypes, buffer, dest, num_vals, type);
+        }
+        break;
+    case PMIX_PROC_RANK:
+        if (pmix_bfrops_base_unpack_rank == fn) {
+            return pmix_bfrops_base_unpack_rank(regtypes, buffer, dest, num_vals, type);
+        }
+        break;
+    case PMIX_STATUS:
+        if (pmix_bfrops_base_unpack_status == fn) {
+            return pmix_bfrops_base_unpack_status(regtypes, buffer, dest, num_vals, type);
+        }
+        break;
+    case PMIX_PROC:
+        if (pmix_bfrops_base_unpack_proc == fn) {
+            return pmix_bfrops_base_unpack_proc(regtypes, buffer, dest, num_vals, type);
+        }
+        break;
+    case PMIX_INFO:
+        if (pmix_bfrops_base_unpack_info == fn) {
+            return pmix_bfrops_base_unpack_info(regtypes, buffer, dest, num_vals, type);
+        }
+        break;
+    case PMIX_VALUE:
+        if (pmix_bfrops_base_unpack_value == fn) {
+            return pmix_bfrops_base_unpack_value(regtypes, buffer, dest, num_vals, type);
+        }
+        break;
+    default:
+        break;
+    }
+
+    return fn(regtypes, buffer, dest, num_vals, type);
+}
+
+
 END_C_DECLS
 
 #endif
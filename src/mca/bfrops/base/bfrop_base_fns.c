@@ -1079,14 +1079,14 @@ char *pmix_bfrop_buffer_extend(pmix_buffer_t *buffer, size_t bytes_to_add)
         pack_offset = ((char *) buffer->pack_ptr) - ((char *) buffer->base_ptr);
         unpack_offset = ((char *) buffer->unpack_ptr) - ((char *) buffer->base_ptr);
         buffer->base_ptr = (char *) realloc(buffer->base_ptr, to_alloc);
-        memset(buffer->base_ptr + pack_offset, 0, to_alloc - buffer->bytes_allocated);
     } else {
         pack_offset = 0;
         unpack_offset = 0;
         buffer->bytes_used = 0;
         buffer->base_ptr = (char *) malloc(to_alloc);
-        memset(buffer->base_ptr, 0, to_alloc);
     }
+    /* no need to zero the new space - nothing is ever read from
+     * beyond pack_ptr, and everything up to it gets written */
 
     if (NULL == buffer->base_ptr) {
         return NULL;
@@ -1099,10 +1099,49 @@ char *pmix_bfrop_buffer_extend(pmix_buffer_t *buffer, size_t bytes_to_add)
     return buffer->pack_ptr;
 }
 
-/*
- * Internal function that checks to see if the specified number of bytes
- * remain in the buffer for unpacking
- */
+/* give a buffer room for bytes more in one step. Unlike extend, a
+ * large request is allocated exactly so a buffer sized from an
+ * estimate of its final contents isn't left up to twice as large as
+ * needed - small ones double the buffer so a series of them, one per
+ * item packed, still costs only a few reallocs */
+pmix_status_t pmix_bfrops_base_reserve(pmix_buffer_t *buffer, size_t bytes)
+{
+    size_t to_alloc, pack_offset, unpack_offset;
+    char *ptr;
+
+    if ((buffer->bytes_allocated - buffer->bytes_used) >= bytes) {
+        return PMIX_SUCCESS;
+    }
+
+    if (NULL != buffer->base_ptr) {
+        to_alloc = buffer->bytes_used + bytes;
+        if (to_alloc < 2 * buffer->bytes_allocated) {
+            to_alloc = 2 * buffer->bytes_allocated;
+        }
+        pack_offset = ((char *) buffer->pack_ptr) - ((char *) buffer->base_ptr);
+        unpack_offset = ((char *) buffer->unpack_ptr) - ((char *) buffer->base_ptr);
+        ptr = (char *) realloc(buffer->base_ptr, to_alloc);
+    } else {
+        to_alloc = bytes;
+        if (to_alloc < pmix_bfrops_globals.initial_size) {
+            to_alloc = pmix_bfrops_globals.initial_size;
+        }
+        pack_offset = 0;
+        unpack_offset = 0;
+        buffer->bytes_used = 0;
+        ptr = (char *) malloc(to_alloc);
+    }
+    if (NULL == ptr) {
+        return PMIX_ERR_NOMEM;
+    }
+    buffer->base_ptr = ptr;
+    buffer->pack_ptr = ptr + pack_offset;
+    buffer->unpack_ptr = ptr + unpack_offset;
+    buffer->bytes_allocated = to_alloc;
+
+    return PMIX_SUCCESS;
+}
+
 bool pmix_bfrop_too_small(pmix_buffer_t *buffer, size_t bytes_reqd)
 {
     size_t bytes_remaining_packed;
@@ -38,6 +38,7 @@
 #include "src/mca/base/pmix_mca_base_var.h"
 #include "src/mca/bfrops/base/base.h"
 #include "src/mca/mca.h"
+#include "src/util/pmix_printf.h"
 
 /*
  * The following file was created by configure.  It contains extern
@@ -54,10 +55,11 @@ pmix_bfrops_globals_t pmix_bfrops_globals = {
     .initial_size = 0,
     .threshold_size = 0,
 #if PMIX_ENABLE_DEBUG
-    .default_type = PMIX_BFROP_BUFFER_FULLY_DESC
+    .default_type = PMIX_BFROP_BUFFER_FULLY_DESC,
 #else
-    .default_type = PMIX_BFROP_BUFFER_NON_DESC
+    .default_type = PMIX_BFROP_BUFFER_NON_DESC,
 #endif
+    .native = true
 };
 int pmix_bfrops_base_output = 0;
 
@@ -88,6 +90,12 @@ static int pmix_bfrop_register(pmix_mca_base_register_flag_t flags)
     pmix_mca_base_var_register("pmix", "bfrops", "base", "default_type", "Default type for buffers",
                                PMIX_MCA_BASE_VAR_TYPE_INT,
                                &pmix_bfrops_globals.default_type);
+
+    pmix_bfrops_globals.native = true;
+    pmix_mca_base_var_register("pmix", "bfrops", "base", "native",
+                               "Exchange fixed-size types in host byte order with local clients "
+                               "that report the same architecture as their server",
+                               PMIX_MCA_BASE_VAR_TYPE_BOOL, &pmix_bfrops_globals.native);
     return PMIX_SUCCESS;
 }
 
@@ -113,6 +121,18 @@ static pmix_status_t pmix_bfrop_open(pmix_mca_base_open_flag_t flags)
     pmix_bfrops_globals.initialized = true;
     PMIX_CONSTRUCT(&pmix_bfrops_globals.actives, pmix_list_t);
 
+    /* record what the layout of the types we copy as a block
+     * in native buffers depends upon */
+    pmix_snprintf(pmix_bfrops_globals.arch, sizeof(pmix_bfrops_globals.arch),
+                  "%s:%u:%u:%u:%u",
+#ifdef WORDS_BIGENDIAN
+                  "be",
+#else
+                  "le",
+#endif
+                  (unsigned) sizeof(void *), (unsigned) sizeof(size_t),
+                  (unsigned) sizeof(pid_t), (unsigned) sizeof(pmix_proc_t));
+
     /* Open up all available components */
     rc = pmix_mca_base_framework_components_open(&pmix_bfrops_base_framework, flags);
     pmix_bfrops_base_output = pmix_bfrops_base_framework.framework_output;
@@ -138,17 +158,20 @@ PMIX_CLASS_INSTANCE(pmix_bfrops_base_active_module_t, pmix_list_item_t, NULL, mo
 /** Value **/
 static void pmix_buffer_construct(pmix_buffer_t *buffer)
 {
-    /** set the default buffer type */
-    buffer->type = pmix_bfrops_globals.default_type;
+    /** the buffer takes the type of the peer it is
+     * first packed for */
+    buffer->type = PMIX_BFROP_BUFFER_UNDEF;
 
     /* Make everything NULL to begin with */
     buffer->base_ptr = buffer->pack_ptr = buffer->unpack_ptr = NULL;
     buffer->bytes_allocated = buffer->bytes_used = 0;
+    buffer->tma = NULL;
 }
 
 static void pmix_buffer_destruct(pmix_buffer_t *buffer)
 {
-    if (NULL != buffer->base_ptr) {
+    /* a buffer built in an arena was loaded with arena data */
+    if (NULL != buffer->base_ptr && !buffer->parent.obj_tma.dontfree) {
         free(buffer->base_ptr);
     }
 }
@@ -181,6 +204,11 @@ static void kvcon(pmix_kval_t *k)
 }
 static void kvdes(pmix_kval_t *k)
 {
+    /* the key and value of a kval unpacked into an arena
+     * belong to the arena */
+    if (k->super.super.obj_tma.dontfree) {
+        return;
+    }
     if (NULL != k->key) {
         free(k->key);
     }
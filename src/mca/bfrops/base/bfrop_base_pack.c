@@ -160,6 +160,31 @@ pmix_status_t pmix_bfrops_base_pack_sizet(pmix_pointer_array_t *regtypes, pmix_b
     return ret;
 }
 
+/*
+ * SIZE_T, described only when the psquash component does not
+ * encode the size of integers itself
+ */
+pmix_status_t pmix_bfrops_base_pack_encoded_sizet(pmix_pointer_array_t *regtypes,
+                                                  pmix_buffer_t *buffer, const void *src,
+                                                  int32_t num_vals, pmix_data_type_t type)
+{
+    int ret;
+
+    PMIX_HIDE_UNUSED_PARAMS(type);
+
+    if (false == pmix_psquash.int_type_is_encoded) {
+        /* System types need to always be described so we can properly
+           unpack them. */
+        if (PMIX_SUCCESS
+            != (ret = pmix_bfrop_store_data_type(regtypes, buffer, BFROP_TYPE_SIZE_T))) {
+            return ret;
+        }
+    }
+
+    PMIX_BFROPS_PACK_TYPE(ret, buffer, src, num_vals, BFROP_TYPE_SIZE_T, regtypes);
+    return ret;
+}
+
 /*
  * PID_T
  */
@@ -187,26 +212,12 @@ pmix_status_t pmix_bfrops_base_pack_pid(pmix_pointer_array_t *regtypes, pmix_buf
 pmix_status_t pmix_bfrops_base_pack_byte(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
                                          const void *src, int32_t num_vals, pmix_data_type_t type)
 {
-    char *dst;
-
     pmix_output_verbose(20, pmix_bfrops_base_framework.framework_output,
                         "pmix_bfrops_base_pack_byte * %d\n", num_vals);
 
     PMIX_HIDE_UNUSED_PARAMS(regtypes, type);
 
-    /* check to see if buffer needs extending */
-    if (NULL == (dst = pmix_bfrop_buffer_extend(buffer, num_vals))) {
-        return PMIX_ERR_OUT_OF_RESOURCE;
-    }
-
-    /* store the data */
-    memcpy(dst, src, num_vals);
-
-    /* update buffer pointers */
-    buffer->pack_ptr += num_vals;
-    buffer->bytes_used += num_vals;
-
-    return PMIX_SUCCESS;
+    return pmix_bfrop_pack_bytes(buffer, src, num_vals);
 }
 
 /*
@@ -229,10 +240,14 @@ pmix_status_t pmix_bfrops_base_pack_int16(pmix_pointer_array_t *regtypes, pmix_b
         return PMIX_ERR_OUT_OF_RESOURCE;
     }
 
-    for (i = 0; i < num_vals; ++i) {
-        tmp = pmix_htons(srctmp[i]);
-        memcpy(dst, &tmp, sizeof(tmp));
-        dst += sizeof(tmp);
+    if (PMIX_BFROP_BUFFER_NATIVE == buffer->type) {
+        memcpy(dst, src, num_vals * sizeof(tmp));
+    } else {
+        for (i = 0; i < num_vals; ++i) {
+            tmp = pmix_htons(srctmp[i]);
+            memcpy(dst, &tmp, sizeof(tmp));
+            dst += sizeof(tmp);
+        }
     }
     buffer->pack_ptr += num_vals * sizeof(tmp);
     buffer->bytes_used += num_vals * sizeof(tmp);
@@ -259,10 +274,14 @@ pmix_status_t pmix_bfrops_base_pack_int32(pmix_pointer_array_t *regtypes, pmix_b
     if (NULL == (dst = pmix_bfrop_buffer_extend(buffer, num_vals * sizeof(tmp)))) {
         return PMIX_ERR_OUT_OF_RESOURCE;
     }
-    for (i = 0; i < num_vals; ++i) {
-        tmp = htonl(srctmp[i]);
-        memcpy(dst, &tmp, sizeof(tmp));
-        dst += sizeof(tmp);
+    if (PMIX_BFROP_BUFFER_NATIVE == buffer->type) {
+        memcpy(dst, src, num_vals * sizeof(tmp));
+    } else {
+        for (i = 0; i < num_vals; ++i) {
+            tmp = htonl(srctmp[i]);
+            memcpy(dst, &tmp, sizeof(tmp));
+            dst += sizeof(tmp);
+        }
     }
     buffer->pack_ptr += num_vals * sizeof(tmp);
     buffer->bytes_used += num_vals * sizeof(tmp);
@@ -291,11 +310,15 @@ pmix_status_t pmix_bfrops_base_pack_int64(pmix_pointer_array_t *regtypes, pmix_b
         return PMIX_ERR_OUT_OF_RESOURCE;
     }
 
-    for (i = 0; i < num_vals; ++i) {
-        memcpy(&tmp2, (char *) src + i * sizeof(uint64_t), sizeof(uint64_t));
-        tmp = pmix_hton64(tmp2);
-        memcpy(dst, &tmp, sizeof(tmp));
-        dst += sizeof(tmp);
+    if (PMIX_BFROP_BUFFER_NATIVE == buffer->type) {
+        memcpy(dst, src, bytes_packed);
+    } else {
+        for (i = 0; i < num_vals; ++i) {
+            memcpy(&tmp2, (char *) src + i * sizeof(uint64_t), sizeof(uint64_t));
+            tmp = pmix_hton64(tmp2);
+            memcpy(dst, &tmp, sizeof(tmp));
+            dst += sizeof(tmp);
+        }
     }
     buffer->pack_ptr += bytes_packed;
     buffer->bytes_used += bytes_packed;
@@ -303,6 +326,21 @@ pmix_status_t pmix_bfrops_base_pack_int64(pmix_pointer_array_t *regtypes, pmix_b
     return PMIX_SUCCESS;
 }
 
+/*
+ * INT16, INT32, INT64 squashed by the active psquash component
+ */
+pmix_status_t pmix_bfrops_base_pack_general_int(pmix_pointer_array_t *regtypes,
+                                                pmix_buffer_t *buffer, const void *src,
+                                                int32_t num_vals, pmix_data_type_t type)
+{
+    pmix_output_verbose(20, pmix_bfrops_base_framework.framework_output,
+                        "pmix_bfrops_base_pack_integer * %d\n", num_vals);
+
+    PMIX_HIDE_UNUSED_PARAMS(regtypes);
+
+    return pmix_bfrop_pack_ints(buffer, src, num_vals, type);
+}
+
 /*
  * STRING
  */
@@ -447,6 +485,12 @@ pmix_status_t pmix_bfrops_base_pack_status(pmix_pointer_array_t *regtypes, pmix_
 
     PMIX_HIDE_UNUSED_PARAMS(type);
 
+    if (PMIX_BFROP_BUFFER_NATIVE == buffer->type) {
+        /* the status is an int, so the array can go as it is */
+        PMIX_BFROPS_PACK_TYPE(ret, buffer, src, num_vals, PMIX_INT32, regtypes);
+        return ret;
+    }
+
     for (i = 0; i < num_vals; ++i) {
         status = (int32_t) ssrc[i];
         PMIX_BFROPS_PACK_TYPE(ret, buffer, &status, 1, PMIX_INT32, regtypes);
@@ -528,6 +572,13 @@ pmix_status_t pmix_bfrops_base_pack_proc(pmix_pointer_array_t *regtypes, pmix_bu
 
     proc = (pmix_proc_t *) src;
 
+    if (PMIX_BFROP_BUFFER_NATIVE == buffer->type
+        && num_vals <= INT32_MAX / (int32_t) sizeof(pmix_proc_t)) {
+        /* both sides agree on the layout of the struct */
+        return pmix_bfrops_base_pack_byte(regtypes, buffer, src, num_vals * sizeof(pmix_proc_t),
+                                          PMIX_BYTE);
+    }
+
     for (i = 0; i < num_vals; ++i) {
         char *ptr = proc[i].nspace;
         PMIX_BFROPS_PACK_TYPE(ret, buffer, &ptr, 1, PMIX_STRING, regtypes);
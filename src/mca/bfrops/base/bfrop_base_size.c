@@ -0,0 +1,335 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+
+#include "src/include/pmix_globals.h"
+#include "src/util/pmix_argv.h"
+
+#include "src/mca/bfrops/base/base.h"
+
+/*
+ * Estimate the space that data will take once packed so buffers can
+ * be given their final size up front instead of growing in steps.
+ * The estimate is for a single PMIX_BFROPS_PACK of the values, and
+ * so includes the count - and the type descriptions, whether or not
+ * the buffer carries them - that it writes ahead of them.
+ *
+ * The estimates follow the encoding of the current components with
+ * the active psquash module - they are exact for the data this
+ * library packs for itself and close for older peers. Types whose
+ * size cannot be told without packing them (e.g., topologies) count
+ * nothing, and the buffer grows for them as it always did.
+ */
+
+static size_t data_size(const void *src, int32_t num_vals, pmix_data_type_t type);
+static size_t value_size(const pmix_value_t *p);
+
+/* the size of a single squashed integer */
+static size_t int_size(const void *src, pmix_data_type_t type)
+{
+    uint8_t tmp[16];
+    size_t sz, max_size;
+    pmix_status_t rc;
+
+    if (PMIX_SUCCESS != pmix_psquash.get_max_size(type, &max_size) || sizeof(tmp) < max_size) {
+        return 0;
+    }
+    rc = (pmix_psquash.encode_int)(type, (void *) src, tmp, &sz);
+    if (PMIX_SUCCESS != rc) {
+        return max_size;
+    }
+    return sz;
+}
+
+static size_t ints_size(const void *src, int32_t num_vals, pmix_data_type_t type)
+{
+    size_t val_size, sz = 0;
+    pmix_status_t rc;
+    int32_t i;
+
+    /* arrays the psquash module encodes as a block */
+    if (NULL != pmix_psquash.encode_ints
+        && PMIX_SUCCESS == pmix_psquash.encode_ints(type, src, num_vals, NULL, &sz)) {
+        return sz;
+    }
+    PMIX_SQUASH_TYPE_SIZEOF(rc, type, val_size);
+    if (PMIX_SUCCESS != rc) {
+        return 0;
+    }
+    for (i = 0; i < num_vals; i++) {
+        sz += int_size((const uint8_t *) src + i * val_size, type);
+    }
+    return sz;
+}
+
+static size_t type_size(pmix_data_type_t type)
+{
+    return int_size(&type, PMIX_UINT16);
+}
+
+static size_t sizet_size(const size_t *s)
+{
+    return data_size(s, 1, PMIX_SIZE);
+}
+
+static size_t string_size(const char *s)
+{
+    int32_t len;
+
+    if (NULL == s) {
+        len = 0;
+        return int_size(&len, PMIX_INT32);
+    }
+    len = (int32_t) strlen(s) + 1;
+    return int_size(&len, PMIX_INT32) + len;
+}
+
+static size_t bo_size(const pmix_byte_object_t *bo)
+{
+    return sizet_size(&bo->size) + bo->size;
+}
+
+static size_t proc_size(const pmix_proc_t *p)
+{
+    return string_size(p->nspace) + int_size(&p->rank, PMIX_UINT32);
+}
+
+static size_t info_size(const pmix_info_t *info)
+{
+    return string_size(info->key) + int_size(&info->flags, PMIX_UINT32)
+           + type_size(info->value.type) + value_size(&info->value);
+}
+
+/* the packed form of the value itself - the caller adds its type */
+static size_t value_size(const pmix_value_t *p)
+{
+    switch (p->type) {
+    case PMIX_UNDEF:
+        return 0;
+    case PMIX_PROC:
+    case PMIX_PROC_NSPACE:
+    case PMIX_PROC_INFO:
+    case PMIX_DATA_ARRAY:
+    case PMIX_COORD:
+    case PMIX_TOPO:
+    case PMIX_PROC_CPUSET:
+    case PMIX_GEOMETRY:
+    case PMIX_DEVICE_DIST:
+    case PMIX_ENDPOINT:
+    case PMIX_REGATTR:
+    case PMIX_PROC_STATS:
+    case PMIX_DISK_STATS:
+    case PMIX_NET_STATS:
+    case PMIX_NODE_STATS:
+        return data_size(p->data.ptr, 1, p->type);
+    default:
+        return data_size(&p->data, 1, p->type);
+    }
+}
+
+static size_t data_size(const void *src, int32_t num_vals, pmix_data_type_t type)
+{
+    size_t sz = 0;
+    int32_t i, j, n;
+
+    if (NULL == src || 0 >= num_vals) {
+        return 0;
+    }
+
+    switch (type) {
+    case PMIX_BOOL:
+    case PMIX_BYTE:
+    case PMIX_INT8:
+    case PMIX_UINT8:
+    case PMIX_POINTER:
+    case PMIX_PERSIST:
+    case PMIX_SCOPE:
+    case PMIX_DATA_RANGE:
+    case PMIX_COMMAND:
+    case PMIX_PROC_STATE:
+    case PMIX_ALLOC_DIRECTIVE:
+    case PMIX_JOB_STATE:
+    case PMIX_LINK_STATE:
+        return num_vals;
+
+    case PMIX_INT16:
+    case PMIX_INT32:
+    case PMIX_INT64:
+    case PMIX_UINT16:
+    case PMIX_UINT32:
+    case PMIX_UINT64:
+        return ints_size(src, num_vals, type);
+    case PMIX_STATUS:
+        return ints_size(src, num_vals, PMIX_INT32);
+    case PMIX_PROC_RANK:
+    case PMIX_INFO_DIRECTIVES:
+        return ints_size(src, num_vals, PMIX_UINT32);
+    case PMIX_DATA_TYPE:
+    case PMIX_IOF_CHANNEL:
+    case PMIX_LOCTYPE:
+        return ints_size(src, num_vals, PMIX_UINT16);
+    case PMIX_DEVTYPE:
+    case PMIX_TIME:
+        return ints_size(src, num_vals, PMIX_UINT64);
+    case PMIX_TIMEVAL:
+        return ints_size(src, 2 * num_vals, PMIX_INT64);
+
+    /* system types are described unless psquash tells them apart */
+    case PMIX_INT:
+    case PMIX_UINT:
+        sz = pmix_psquash.int_type_is_encoded ? 0 : type_size(BFROP_TYPE_INT);
+        return sz + ints_size(src, num_vals, BFROP_TYPE_INT);
+    case PMIX_SIZE:
+        sz = pmix_psquash.int_type_is_encoded ? 0 : type_size(BFROP_TYPE_SIZE_T);
+        return sz + ints_size(src, num_vals, BFROP_TYPE_SIZE_T);
+    case PMIX_PID:
+        return type_size(BFROP_TYPE_PID_T) + ints_size(src, num_vals, BFROP_TYPE_PID_T);
+
+    /* floats travel as "%f" strings */
+    case PMIX_FLOAT:
+    case PMIX_DOUBLE:
+        return num_vals * 16;
+
+    case PMIX_STRING:
+    case PMIX_REGEX:
+        for (i = 0; i < num_vals; i++) {
+            sz += string_size(((char *const *) src)[i]);
+        }
+        return sz;
+    case PMIX_PROC_NSPACE:
+        for (i = 0; i < num_vals; i++) {
+            sz += string_size(((const pmix_nspace_t *) src)[i]);
+        }
+        return sz;
+    case PMIX_BYTE_OBJECT:
+    case PMIX_COMPRESSED_STRING:
+        for (i = 0; i < num_vals; i++) {
+            sz += bo_size(&((const pmix_byte_object_t *) src)[i]);
+        }
+        return sz;
+    case PMIX_BUFFER:
+        for (i = 0; i < num_vals; i++) {
+            const pmix_buffer_t *b = &((const pmix_buffer_t *) src)[i];
+            sz += 1 + sizet_size(&b->bytes_used) + b->bytes_used;
+        }
+        return sz;
+
+    case PMIX_PROC:
+        for (i = 0; i < num_vals; i++) {
+            sz += proc_size(&((const pmix_proc_t *) src)[i]);
+        }
+        return sz;
+    case PMIX_VALUE:
+        for (i = 0; i < num_vals; i++) {
+            const pmix_value_t *v = &((const pmix_value_t *) src)[i];
+            sz += type_size(v->type) + value_size(v);
+        }
+        return sz;
+    case PMIX_INFO:
+        for (i = 0; i < num_vals; i++) {
+            sz += info_size(&((const pmix_info_t *) src)[i]);
+        }
+        return sz;
+    case PMIX_KVAL:
+        for (i = 0; i < num_vals; i++) {
+            const pmix_kval_t *kv = &((const pmix_kval_t *) src)[i];
+            sz += string_size(kv->key);
+            if (NULL != kv->value) {
+                sz += type_size(kv->value->type) + value_size(kv->value);
+            }
+        }
+        return sz;
+    case PMIX_PDATA:
+        for (i = 0; i < num_vals; i++) {
+            const pmix_pdata_t *pd = &((const pmix_pdata_t *) src)[i];
+            sz += proc_size(&pd->proc) + string_size(pd->key) + type_size(pd->value.type)
+                  + value_size(&pd->value);
+        }
+        return sz;
+    case PMIX_DATA_ARRAY:
+        for (i = 0; i < num_vals; i++) {
+            const pmix_data_array_t *d = &((const pmix_data_array_t *) src)[i];
+            sz += type_size(d->type) + sizet_size(&d->size);
+            if (0 < d->size && d->size <= INT32_MAX) {
+                sz += data_size(d->array, d->size, d->type);
+            }
+        }
+        return sz;
+    case PMIX_PROC_INFO:
+        for (i = 0; i < num_vals; i++) {
+            const pmix_proc_info_t *p = &((const pmix_proc_info_t *) src)[i];
+            sz += proc_size(&p->proc) + string_size(p->hostname)
+                  + string_size(p->executable_name)
+                  + data_size(&p->pid, 1, PMIX_PID) + 1;
+        }
+        return sz;
+    case PMIX_ENVAR:
+        for (i = 0; i < num_vals; i++) {
+            const pmix_envar_t *e = &((const pmix_envar_t *) src)[i];
+            sz += string_size(e->envar) + string_size(e->value) + 1;
+        }
+        return sz;
+    case PMIX_COORD:
+        for (i = 0; i < num_vals; i++) {
+            const pmix_coord_t *c = &((const pmix_coord_t *) src)[i];
+            sz += 1 + sizet_size(&c->dims);
+            if (c->dims <= INT32_MAX) {
+                sz += ints_size(c->coord, c->dims, PMIX_UINT32);
+            }
+        }
+        return sz;
+    case PMIX_APP:
+        for (i = 0; i < num_vals; i++) {
+            const pmix_app_t *app = &((const pmix_app_t *) src)[i];
+            sz += string_size(app->cmd) + string_size(app->cwd);
+            n = pmix_argv_count(app->argv);
+            sz += data_size(&n, 1, PMIX_INT);
+            for (j = 0; j < n; j++) {
+                sz += string_size(app->argv[j]);
+            }
+            n = pmix_argv_count(app->env);
+            sz += int_size(&n, PMIX_INT32);
+            for (j = 0; j < n; j++) {
+                sz += string_size(app->env[j]);
+            }
+            sz += data_size(&app->maxprocs, 1, PMIX_INT)
+                  + sizet_size(&app->ninfo);
+            if (app->ninfo <= INT32_MAX) {
+                sz += data_size(app->info, app->ninfo, PMIX_INFO);
+            }
+        }
+        return sz;
+    case PMIX_QUERY:
+        for (i = 0; i < num_vals; i++) {
+            const pmix_query_t *q = &((const pmix_query_t *) src)[i];
+            n = pmix_argv_count(q->keys);
+            sz += int_size(&n, PMIX_INT32);
+            for (j = 0; j < n; j++) {
+                sz += string_size(q->keys[j]);
+            }
+            sz += sizet_size(&q->nqual);
+            if (q->nqual <= INT32_MAX) {
+                sz += data_size(q->qualifiers, q->nqual, PMIX_INFO);
+            }
+        }
+        return sz;
+
+    default:
+        return 0;
+    }
+}
+
+size_t pmix_bfrops_base_packed_size(const void *src, int32_t num_vals, pmix_data_type_t type)
+{
+    /* PMIX_BFROPS_PACK puts the number of values ahead of them and,
+     * in fully described buffers, the types of both */
+    return int_size(&num_vals, PMIX_INT32) + 2 * type_size(type)
+           + data_size(src, num_vals, type);
+}
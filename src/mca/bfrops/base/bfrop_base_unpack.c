@@ -35,9 +35,73 @@
 #include "src/mca/bfrops/base/base.h"
 #include "src/mca/bfrops/bfrops_types.h"
 
+/* point each buffer at its payload within the source buffer */
+static pmix_status_t unpack_buf_view(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
+                                     pmix_buffer_t *ptr, int32_t n)
+{
+    int32_t i, m;
+    pmix_status_t ret;
+    size_t nbytes;
+
+    for (i = 0; i < n; ++i) {
+        PMIX_CONSTRUCT(&ptr[i], pmix_buffer_t);
+        /* unpack the type of buffer */
+        m = 1;
+        PMIX_BFROPS_UNPACK_TYPE(ret, buffer, &ptr[i].type, &m, PMIX_BYTE, regtypes);
+        if (PMIX_SUCCESS != ret) {
+            return ret;
+        }
+        /* unpack the number of bytes */
+        m = 1;
+        PMIX_BFROPS_UNPACK_TYPE(ret, buffer, &nbytes, &m, PMIX_SIZE, regtypes);
+        if (PMIX_SUCCESS != ret) {
+            return ret;
+        }
+        if (pmix_bfrop_too_small(buffer, nbytes)) {
+            return PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+        }
+        if (0 < nbytes) {
+            ptr[i].base_ptr = buffer->unpack_ptr;
+            buffer->unpack_ptr += nbytes;
+        }
+        ptr[i].pack_ptr = ptr[i].base_ptr + nbytes;
+        ptr[i].unpack_ptr = ptr[i].base_ptr;
+        ptr[i].bytes_allocated = nbytes;
+        ptr[i].bytes_used = nbytes;
+    }
+    return PMIX_SUCCESS;
+}
+
+/* point each byte object at its bytes within the source buffer */
+static pmix_status_t unpack_bo_view(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
+                                    pmix_byte_object_t *ptr, int32_t n)
+{
+    int32_t i, m;
+    pmix_status_t ret;
+
+    for (i = 0; i < n; ++i) {
+        memset(&ptr[i], 0, sizeof(pmix_byte_object_t));
+        /* unpack the number of bytes */
+        m = 1;
+        PMIX_BFROPS_UNPACK_TYPE(ret, buffer, &ptr[i].size, &m, PMIX_SIZE, regtypes);
+        if (PMIX_SUCCESS != ret) {
+            return ret;
+        }
+        if (pmix_bfrop_too_small(buffer, ptr[i].size)) {
+            return PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+        }
+        if (0 < ptr[i].size) {
+            ptr[i].bytes = buffer->unpack_ptr;
+            buffer->unpack_ptr += ptr[i].size;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
 static pmix_status_t pmix_bfrops_base_unpack_buffer(pmix_pointer_array_t *regtypes,
                                                     pmix_buffer_t *buffer, void *dst,
-                                                    int32_t *num_vals, pmix_data_type_t type)
+                                                    int32_t *num_vals, pmix_data_type_t type,
+                                                    bool view)
 {
     pmix_status_t rc;
     pmix_data_type_t local_type;
@@ -59,12 +123,18 @@ static pmix_status_t pmix_bfrops_base_unpack_buffer(pmix_pointer_array_t *regtyp
             return PMIX_ERR_PACK_MISMATCH;
         }
     }
-    PMIX_BFROPS_UNPACK_TYPE(rc, buffer, dst, num_vals, type, regtypes);
+    if (!view) {
+        PMIX_BFROPS_UNPACK_TYPE(rc, buffer, dst, num_vals, type, regtypes);
+    } else if (PMIX_BUFFER == type) {
+        rc = unpack_buf_view(regtypes, buffer, (pmix_buffer_t *) dst, *num_vals);
+    } else {
+        rc = unpack_bo_view(regtypes, buffer, (pmix_byte_object_t *) dst, *num_vals);
+    }
     return rc;
 }
 
-pmix_status_t pmix_bfrops_base_unpack(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
-                                      void *dst, int32_t *num_vals, pmix_data_type_t type)
+static pmix_status_t unpack_values(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
+                                   void *dst, int32_t *num_vals, pmix_data_type_t type, bool view)
 {
     pmix_status_t rc, ret;
     int32_t local_num, n = 1;
@@ -137,7 +207,7 @@ pmix_status_t pmix_bfrops_base_unpack(pmix_pointer_array_t *regtypes, pmix_buffe
 
     /** Unpack the value(s) */
     if (PMIX_SUCCESS
-        != (rc = pmix_bfrops_base_unpack_buffer(regtypes, buffer, dst, &local_num, type))) {
+        != (rc = pmix_bfrops_base_unpack_buffer(regtypes, buffer, dst, &local_num, type, view))) {
         *num_vals = 0;
         ret = rc;
     }
@@ -145,6 +215,121 @@ pmix_status_t pmix_bfrops_base_unpack(pmix_pointer_array_t *regtypes, pmix_buffe
     return ret;
 }
 
+pmix_status_t pmix_bfrops_base_unpack(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
+                                      void *dst, int32_t *num_vals, pmix_data_type_t type)
+{
+    return unpack_values(regtypes, buffer, dst, num_vals, type, false);
+}
+
+pmix_status_t pmix_bfrops_base_unpack_view(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
+                                           void *dst, int32_t *num_vals, pmix_data_type_t type)
+{
+    if (PMIX_BUFFER != type && PMIX_BYTE_OBJECT != type) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    return unpack_values(regtypes, buffer, dst, num_vals, type, true);
+}
+
+/* the storage for one element of a type whose unpack can be built
+ * entirely from a tma, or zero for types whose unpack allocates in
+ * ways that only the heap can release (e.g., topologies) */
+static size_t tma_type_size(pmix_data_type_t type)
+{
+    switch (type) {
+    case PMIX_BOOL:
+        return sizeof(bool);
+    case PMIX_BYTE:
+    case PMIX_INT8:
+    case PMIX_UINT8:
+    case PMIX_PERSIST:
+    case PMIX_SCOPE:
+    case PMIX_DATA_RANGE:
+    case PMIX_COMMAND:
+    case PMIX_PROC_STATE:
+    case PMIX_ALLOC_DIRECTIVE:
+    case PMIX_JOB_STATE:
+    case PMIX_LINK_STATE:
+        return sizeof(uint8_t);
+    case PMIX_INT16:
+    case PMIX_UINT16:
+    case PMIX_DATA_TYPE:
+    case PMIX_IOF_CHANNEL:
+    case PMIX_LOCTYPE:
+        return sizeof(uint16_t);
+    case PMIX_INT32:
+    case PMIX_UINT32:
+    case PMIX_STATUS:
+    case PMIX_PROC_RANK:
+    case PMIX_INFO_DIRECTIVES:
+        return sizeof(uint32_t);
+    case PMIX_INT64:
+    case PMIX_UINT64:
+    case PMIX_DEVTYPE:
+        return sizeof(uint64_t);
+    case PMIX_INT:
+    case PMIX_UINT:
+        return sizeof(int);
+    case PMIX_SIZE:
+        return sizeof(size_t);
+    case PMIX_PID:
+        return sizeof(pid_t);
+    case PMIX_FLOAT:
+        return sizeof(float);
+    case PMIX_DOUBLE:
+        return sizeof(double);
+    case PMIX_TIMEVAL:
+        return sizeof(struct timeval);
+    case PMIX_TIME:
+        return sizeof(time_t);
+    case PMIX_STRING:
+        return sizeof(char *);
+    case PMIX_BYTE_OBJECT:
+    case PMIX_COMPRESSED_STRING:
+        return sizeof(pmix_byte_object_t);
+    case PMIX_PROC:
+        return sizeof(pmix_proc_t);
+    case PMIX_PROC_NSPACE:
+        return sizeof(pmix_nspace_t);
+    case PMIX_PROC_INFO:
+        return sizeof(pmix_proc_info_t);
+    case PMIX_DATA_ARRAY:
+        return sizeof(pmix_data_array_t);
+    case PMIX_COORD:
+        return sizeof(pmix_coord_t);
+    case PMIX_ENVAR:
+        return sizeof(pmix_envar_t);
+    case PMIX_INFO:
+        return sizeof(pmix_info_t);
+    case PMIX_VALUE:
+        return sizeof(pmix_value_t);
+    case PMIX_PDATA:
+        return sizeof(pmix_pdata_t);
+    default:
+        return 0;
+    }
+}
+
+pmix_status_t pmix_bfrops_base_unpack_tma(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
+                                          void *dst, int32_t *num_vals, pmix_data_type_t type,
+                                          pmix_tma_t *tma)
+{
+    pmix_tma_t *save;
+    pmix_status_t rc;
+
+    if (NULL == buffer) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    if (PMIX_KVAL != type && 0 == tma_type_size(type)) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    /* everything the unpack allocates comes from the tma */
+    save = buffer->tma;
+    buffer->tma = tma;
+    rc = unpack_values(regtypes, buffer, dst, num_vals, type, false);
+    buffer->tma = save;
+    return rc;
+}
+
 /* UNPACK GENERIC SYSTEM TYPES */
 
 /*
@@ -246,6 +431,44 @@ pmix_status_t pmix_bfrops_base_unpack_sizet(pmix_pointer_array_t *regtypes, pmix
     return ret;
 }
 
+/*
+ * SIZE_T, described only when the psquash component does not
+ * encode the size of integers itself
+ */
+pmix_status_t pmix_bfrops_base_unpack_encoded_sizet(pmix_pointer_array_t *regtypes,
+                                                    pmix_buffer_t *buffer, void *dest,
+                                                    int32_t *num_vals, pmix_data_type_t type)
+{
+    pmix_status_t ret;
+    pmix_data_type_t remote_type;
+
+    PMIX_HIDE_UNUSED_PARAMS(type);
+
+    if (false == pmix_psquash.int_type_is_encoded) {
+        if (PMIX_SUCCESS != (ret = pmix_bfrop_get_data_type(regtypes, buffer, &remote_type))) {
+            PMIX_ERROR_LOG(ret);
+            return ret;
+        }
+        if (remote_type == BFROP_TYPE_SIZE_T) {
+            /* fast path it if the sizes are the same */
+            /* Turn around and unpack the real type */
+            PMIX_BFROPS_UNPACK_TYPE(ret, buffer, dest, num_vals, BFROP_TYPE_SIZE_T, regtypes);
+            if (PMIX_SUCCESS != ret) {
+                PMIX_ERROR_LOG(ret);
+            }
+        } else {
+            /* slow path - types are different sizes */
+            PMIX_BFROP_UNPACK_SIZE_MISMATCH(regtypes, size_t, remote_type, ret);
+        }
+    } else {
+        PMIX_BFROPS_UNPACK_TYPE(ret, buffer, dest, num_vals, BFROP_TYPE_SIZE_T, regtypes);
+        if (PMIX_SUCCESS != ret) {
+            PMIX_ERROR_LOG(ret);
+        }
+    }
+    return ret;
+}
+
 /*
  * PID_T
  */
@@ -286,18 +509,7 @@ pmix_status_t pmix_bfrops_base_unpack_byte(pmix_pointer_array_t *regtypes, pmix_
 
     PMIX_HIDE_UNUSED_PARAMS(regtypes, type);
 
-    /* check to see if there's enough data in buffer */
-    if (pmix_bfrop_too_small(buffer, *num_vals)) {
-        return PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
-    }
-
-    /* unpack the data */
-    memcpy(dest, buffer->unpack_ptr, *num_vals);
-
-    /* update buffer pointer */
-    buffer->unpack_ptr += *num_vals;
-
-    return PMIX_SUCCESS;
+    return pmix_bfrop_unpack_bytes(buffer, dest, *num_vals);
 }
 
 pmix_status_t pmix_bfrops_base_unpack_int16(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
@@ -317,6 +529,11 @@ pmix_status_t pmix_bfrops_base_unpack_int16(pmix_pointer_array_t *regtypes, pmix
     }
 
     /* unpack the data */
+    if (PMIX_BFROP_BUFFER_NATIVE == buffer->type) {
+        memcpy(dest, buffer->unpack_ptr, (*num_vals) * sizeof(tmp));
+        buffer->unpack_ptr += (*num_vals) * sizeof(tmp);
+        return PMIX_SUCCESS;
+    }
     for (i = 0; i < (*num_vals); ++i) {
         memcpy(&(tmp), buffer->unpack_ptr, sizeof(tmp));
         tmp = pmix_ntohs(tmp);
@@ -344,6 +561,11 @@ pmix_status_t pmix_bfrops_base_unpack_int32(pmix_pointer_array_t *regtypes, pmix
     }
 
     /* unpack the data */
+    if (PMIX_BFROP_BUFFER_NATIVE == buffer->type) {
+        memcpy(dest, buffer->unpack_ptr, (*num_vals) * sizeof(tmp));
+        buffer->unpack_ptr += (*num_vals) * sizeof(tmp);
+        return PMIX_SUCCESS;
+    }
     for (i = 0; i < (*num_vals); ++i) {
         memcpy(&(tmp), buffer->unpack_ptr, sizeof(tmp));
         tmp = ntohl(tmp);
@@ -383,6 +605,11 @@ pmix_status_t pmix_bfrops_base_unpack_int64(pmix_pointer_array_t *regtypes, pmix
     }
 
     /* unpack the data */
+    if (PMIX_BFROP_BUFFER_NATIVE == buffer->type) {
+        memcpy(dest, buffer->unpack_ptr, (*num_vals) * sizeof(tmp));
+        buffer->unpack_ptr += (*num_vals) * sizeof(tmp);
+        return PMIX_SUCCESS;
+    }
     for (i = 0; i < (*num_vals); ++i) {
         memcpy(&(tmp), buffer->unpack_ptr, sizeof(tmp));
         tmp = pmix_ntoh64(tmp);
@@ -393,6 +620,21 @@ pmix_status_t pmix_bfrops_base_unpack_int64(pmix_pointer_array_t *regtypes, pmix
     return PMIX_SUCCESS;
 }
 
+/*
+ * INT16, INT32, INT64 squashed by the active psquash component
+ */
+pmix_status_t pmix_bfrops_base_unpack_general_int(pmix_pointer_array_t *regtypes,
+                                                  pmix_buffer_t *buffer, void *dest,
+                                                  int32_t *num_vals, pmix_data_type_t type)
+{
+    pmix_output_verbose(20, pmix_bfrops_base_framework.framework_output,
+                        "pmix_bfrops_base_unpack_integer * %d\n", (int) *num_vals);
+
+    PMIX_HIDE_UNUSED_PARAMS(regtypes);
+
+    return pmix_bfrop_unpack_ints(buffer, dest, num_vals, type);
+}
+
 pmix_status_t pmix_bfrops_base_unpack_string(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
                                              void *dest, int32_t *num_vals, pmix_data_type_t type)
 {
@@ -410,7 +652,7 @@ pmix_status_t pmix_bfrops_base_unpack_string(pmix_pointer_array_t *regtypes, pmi
         if (0 == len) { /* zero-length string - unpack the NULL */
             sdest[i] = NULL;
         } else {
-            sdest[i] = (char *) malloc(len); // NULL terminator is included
+            sdest[i] = (char *) pmix_tma_malloc(buffer->tma, len); // NULL terminator is included
             if (NULL == sdest[i]) {
                 return PMIX_ERR_OUT_OF_RESOURCE;
             }
@@ -448,7 +690,9 @@ pmix_status_t pmix_bfrops_base_unpack_float(pmix_pointer_array_t *regtypes, pmix
         if (NULL != convert) {
             tmp = strtof(convert, NULL);
             memcpy(&desttmp[i], &tmp, sizeof(tmp));
-            free(convert);
+            if (NULL == buffer->tma) {
+                free(convert);
+            }
         }
     }
     return PMIX_SUCCESS;
@@ -478,7 +722,9 @@ pmix_status_t pmix_bfrops_base_unpack_double(pmix_pointer_array_t *regtypes, pmi
         if (NULL != convert) {
             tmp = strtod(convert, NULL);
             memcpy(&desttmp[i], &tmp, sizeof(tmp));
-            free(convert);
+            if (NULL == buffer->tma) {
+                free(convert);
+            }
         }
     }
     return PMIX_SUCCESS;
@@ -568,6 +814,44 @@ pmix_status_t pmix_bfrops_base_unpack_val(pmix_pointer_array_t *regtypes, pmix_b
     pmix_status_t ret = PMIX_SUCCESS;
 
     m = 1;
+    if (NULL != buffer->tma) {
+        /* types that allocate from the heap cannot be unpacked into
+         * a tma - the caller unpacks the message the normal way */
+        if (PMIX_UNDEF != val->type && 0 == tma_type_size(val->type)) {
+            return PMIX_ERR_NOT_SUPPORTED;
+        }
+        switch (val->type) {
+        case PMIX_PROC:
+        case PMIX_PROC_NSPACE:
+            val->data.proc = (pmix_proc_t *) pmix_tma_calloc(buffer->tma, sizeof(pmix_proc_t));
+            break;
+        case PMIX_PROC_INFO:
+            val->data.pinfo = (pmix_proc_info_t *) pmix_tma_calloc(buffer->tma,
+                                                                   sizeof(pmix_proc_info_t));
+            break;
+        case PMIX_DATA_ARRAY:
+            val->data.darray = (pmix_data_array_t *) pmix_tma_malloc(buffer->tma,
+                                                                     sizeof(pmix_data_array_t));
+            break;
+        case PMIX_COORD:
+            val->data.coord = (pmix_coord_t *) pmix_tma_calloc(buffer->tma, sizeof(pmix_coord_t));
+            break;
+        default:
+            PMIX_BFROPS_UNPACK_TYPE(ret, buffer, &val->data, &m, val->type, regtypes);
+            return ret;
+        }
+        if (NULL == val->data.ptr) {
+            return PMIX_ERR_NOMEM;
+        }
+        if (PMIX_PROC_NSPACE == val->type) {
+            PMIX_BFROPS_UNPACK_TYPE(ret, buffer, &val->data.proc->nspace, &m, PMIX_PROC_NSPACE,
+                                    regtypes);
+        } else {
+            PMIX_BFROPS_UNPACK_TYPE(ret, buffer, val->data.ptr, &m, val->type, regtypes);
+        }
+        return ret;
+    }
+
     switch (val->type) {
         case PMIX_UNDEF:
             break;
@@ -714,20 +998,48 @@ pmix_status_t pmix_bfrops_base_unpack_value(pmix_pointer_array_t *regtypes, pmix
         }
         /* unpack value */
         if (PMIX_SUCCESS != (ret = pmix_bfrops_base_unpack_val(regtypes, buffer, &ptr[i]))) {
-            PMIX_ERROR_LOG(ret);
+            if (NULL == buffer->tma || PMIX_ERR_NOT_SUPPORTED != ret) {
+                PMIX_ERROR_LOG(ret);
+            }
             return ret;
         }
     }
     return PMIX_SUCCESS;
 }
 
+/* unpack a string straight into a fixed-size array of max+1 chars,
+ * truncating it as pmix_strncpy would - saves allocating a copy of
+ * every key and nspace only to free it again */
+static pmix_status_t unpack_fixed_string(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
+                                         char *dst, size_t max, int32_t *len)
+{
+    pmix_status_t ret;
+    int32_t m = 1;
+    size_t n;
+
+    PMIX_BFROPS_UNPACK_TYPE(ret, buffer, len, &m, PMIX_INT32, regtypes);
+    if (PMIX_SUCCESS != ret) {
+        return ret;
+    }
+    if (0 > *len) {
+        return PMIX_ERR_UNPACK_FAILURE;
+    }
+    if (pmix_bfrop_too_small(buffer, *len)) {
+        return PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+    }
+    n = (size_t) *len < max ? (size_t) *len : max;
+    memcpy(dst, buffer->unpack_ptr, n);
+    dst[n] = '\0';
+    buffer->unpack_ptr += *len;
+    return PMIX_SUCCESS;
+}
+
 pmix_status_t pmix_bfrops_base_unpack_info(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
                                            void *dest, int32_t *num_vals, pmix_data_type_t type)
 {
     pmix_info_t *ptr;
-    int32_t i, n, m;
+    int32_t i, n, m, len;
     pmix_status_t ret;
-    char *tmp;
 
     pmix_output_verbose(20, pmix_bfrops_base_framework.framework_output,
                         "pmix_bfrop_unpack: %d info", *num_vals);
@@ -741,18 +1053,14 @@ pmix_status_t pmix_bfrops_base_unpack_info(pmix_pointer_array_t *regtypes, pmix_
         memset(ptr[i].key, 0, sizeof(ptr[i].key));
         memset(&ptr[i].value, 0, sizeof(pmix_value_t));
         /* unpack key */
-        m = 1;
-        tmp = NULL;
-        PMIX_BFROPS_UNPACK_TYPE(ret, buffer, &tmp, &m, PMIX_STRING, regtypes);
+        ret = unpack_fixed_string(regtypes, buffer, ptr[i].key, PMIX_MAX_KEYLEN, &len);
         if (PMIX_SUCCESS != ret) {
             PMIX_ERROR_LOG(ret);
             return ret;
         }
-        if (NULL == tmp) {
+        if (0 == len) {
             return PMIX_ERROR;
         }
-        pmix_strncpy(ptr[i].key, tmp, PMIX_MAX_KEYLEN);
-        free(tmp);
         /* unpack the directives */
         m = 1;
         PMIX_BFROPS_UNPACK_TYPE(ret, buffer, &ptr[i].flags, &m, PMIX_INFO_DIRECTIVES, regtypes);
@@ -780,9 +1088,8 @@ pmix_status_t pmix_bfrops_base_unpack_pdata(pmix_pointer_array_t *regtypes, pmix
                                             void *dest, int32_t *num_vals, pmix_data_type_t type)
 {
     pmix_pdata_t *ptr;
-    int32_t i, n, m;
+    int32_t i, n, m, len;
     pmix_status_t ret;
-    char *tmp;
 
     pmix_output_verbose(20, pmix_bfrops_base_framework.framework_output,
                         "pmix_bfrop_unpack: %d pdata", *num_vals);
@@ -801,18 +1108,14 @@ pmix_status_t pmix_bfrops_base_unpack_pdata(pmix_pointer_array_t *regtypes, pmix
             return ret;
         }
         /* unpack key */
-        m = 1;
-        tmp = NULL;
-        PMIX_BFROPS_UNPACK_TYPE(ret, buffer, &tmp, &m, PMIX_STRING, regtypes);
+        ret = unpack_fixed_string(regtypes, buffer, ptr[i].key, PMIX_MAX_KEYLEN, &len);
         if (PMIX_SUCCESS != ret) {
             return ret;
         }
-        if (NULL == tmp) {
+        if (0 == len) {
             PMIX_ERROR_LOG(PMIX_ERROR);
             return PMIX_ERROR;
         }
-        pmix_strncpy(ptr[i].key, tmp, PMIX_MAX_KEYLEN);
-        free(tmp);
         /* unpack value - since the value structure is statically-defined
          * instead of a pointer in this struct, we directly unpack it to
          * avoid the malloc */
@@ -826,7 +1129,9 @@ pmix_status_t pmix_bfrops_base_unpack_pdata(pmix_pointer_array_t *regtypes, pmix
                             ptr[i].value.data.string);
         m = 1;
         if (PMIX_SUCCESS != (ret = pmix_bfrops_base_unpack_val(regtypes, buffer, &ptr[i].value))) {
-            PMIX_ERROR_LOG(ret);
+            if (NULL == buffer->tma || PMIX_ERR_NOT_SUPPORTED != ret) {
+                PMIX_ERROR_LOG(ret);
+            }
             return ret;
         }
     }
@@ -885,9 +1190,8 @@ pmix_status_t pmix_bfrops_base_unpack_proc(pmix_pointer_array_t *regtypes, pmix_
                                            void *dest, int32_t *num_vals, pmix_data_type_t type)
 {
     pmix_proc_t *ptr;
-    int32_t i, n, m;
+    int32_t i, n, m, len;
     pmix_status_t ret;
-    char *tmp;
 
     pmix_output_verbose(20, pmix_bfrops_base_framework.framework_output,
                         "pmix_bfrop_unpack: %d procs", *num_vals);
@@ -897,23 +1201,25 @@ pmix_status_t pmix_bfrops_base_unpack_proc(pmix_pointer_array_t *regtypes, pmix_
     ptr = (pmix_proc_t *) dest;
     n = *num_vals;
 
+    if (PMIX_BFROP_BUFFER_NATIVE == buffer->type
+        && n <= INT32_MAX / (int32_t) sizeof(pmix_proc_t)) {
+        m = n * sizeof(pmix_proc_t);
+        return pmix_bfrops_base_unpack_byte(regtypes, buffer, dest, &m, PMIX_BYTE);
+    }
+
     for (i = 0; i < n; ++i) {
         pmix_output_verbose(20, pmix_bfrops_base_framework.framework_output,
                             "pmix_bfrop_unpack: init proc[%d]", i);
         memset(&ptr[i], 0, sizeof(pmix_proc_t));
         /* unpack nspace */
-        m = 1;
-        tmp = NULL;
-        PMIX_BFROPS_UNPACK_TYPE(ret, buffer, &tmp, &m, PMIX_STRING, regtypes);
+        ret = unpack_fixed_string(regtypes, buffer, ptr[i].nspace, PMIX_MAX_NSLEN, &len);
         if (PMIX_SUCCESS != ret) {
             return ret;
         }
-        if (NULL == tmp) {
+        if (0 == len) {
             PMIX_ERROR_LOG(PMIX_ERROR);
             return PMIX_ERROR;
         }
-        pmix_strncpy(ptr[i].nspace, tmp, PMIX_MAX_NSLEN);
-        free(tmp);
         /* unpack the rank */
         m = 1;
         PMIX_BFROPS_UNPACK_TYPE(ret, buffer, &ptr[i].rank, &m, PMIX_PROC_RANK, regtypes);
@@ -1042,7 +1348,7 @@ pmix_status_t pmix_bfrops_base_unpack_kval(pmix_pointer_array_t *regtypes, pmix_
     n = *num_vals;
 
     for (i = 0; i < n; ++i) {
-        PMIX_CONSTRUCT(&ptr[i], pmix_kval_t);
+        PMIX_CONSTRUCT_TMA(&ptr[i], pmix_kval_t, buffer->tma);
         /* unpack the key */
         m = 1;
         PMIX_BFROPS_UNPACK_TYPE(ret, buffer, &ptr[i].key, &m, PMIX_STRING, regtypes);
@@ -1050,7 +1356,10 @@ pmix_status_t pmix_bfrops_base_unpack_kval(pmix_pointer_array_t *regtypes, pmix_
             return ret;
         }
         /* allocate the space */
-        ptr[i].value = (pmix_value_t *) malloc(sizeof(pmix_value_t));
+        ptr[i].value = (pmix_value_t *) pmix_tma_malloc(buffer->tma, sizeof(pmix_value_t));
+        if (NULL == ptr[i].value) {
+            return PMIX_ERR_NOMEM;
+        }
         /* unpack the value */
         m = 1;
         PMIX_BFROPS_UNPACK_TYPE(ret, buffer, ptr[i].value, &m, PMIX_VALUE, regtypes);
@@ -1096,7 +1405,10 @@ pmix_status_t pmix_bfrops_base_unpack_bo(pmix_pointer_array_t *regtypes, pmix_bu
             return ret;
         }
         if (0 < ptr[i].size) {
-            ptr[i].bytes = (char *) malloc(ptr[i].size * sizeof(char));
+            ptr[i].bytes = (char *) pmix_tma_malloc(buffer->tma, ptr[i].size * sizeof(char));
+            if (NULL == ptr[i].bytes) {
+                return PMIX_ERR_NOMEM;
+            }
             m = ptr[i].size;
             PMIX_BFROPS_UNPACK_TYPE(ret, buffer, ptr[i].bytes, &m, PMIX_BYTE, regtypes);
             if (PMIX_SUCCESS != ret) {
@@ -1236,7 +1548,7 @@ pmix_status_t pmix_bfrops_base_unpack_darray(pmix_pointer_array_t *regtypes, pmi
     int32_t i, n, m;
     pmix_status_t ret;
     pmix_data_type_t t;
-    size_t sm;
+    size_t sm, esize;
 
     pmix_output_verbose(20, pmix_bfrops_base_framework.framework_output,
                         "pmix_bfrop_unpack: %d data arrays", *num_vals);
@@ -1267,9 +1579,27 @@ pmix_status_t pmix_bfrops_base_unpack_darray(pmix_pointer_array_t *regtypes, pmi
         sm = ptr[i].size;
         t = ptr[i].type;
 
-        PMIX_DATA_ARRAY_CONSTRUCT(&ptr[i], sm, t);
-        if (NULL == ptr[i].array) {
-            return PMIX_ERR_NOMEM;
+        if (NULL != buffer->tma) {
+            esize = tma_type_size(t);
+            if (0 == esize) {
+                return PMIX_ERR_NOT_SUPPORTED;
+            }
+            if (INT32_MAX < sm) {
+                return PMIX_ERR_UNPACK_FAILURE;
+            }
+            ptr[i].array = pmix_tma_calloc(buffer->tma, sm * esize);
+            if (NULL == ptr[i].array) {
+                return PMIX_ERR_NOMEM;
+            }
+            if (PMIX_INFO == t) {
+                /* mark the end as PMIX_INFO_CREATE would */
+                ((pmix_info_t *) ptr[i].array)[sm - 1].flags = PMIX_INFO_ARRAY_END;
+            }
+        } else {
+            PMIX_DATA_ARRAY_CONSTRUCT(&ptr[i], sm, t);
+            if (NULL == ptr[i].array) {
+                return PMIX_ERR_NOMEM;
+            }
         }
         m = sm;
         PMIX_BFROPS_UNPACK_TYPE(ret, buffer, ptr[i].array, &m, t, regtypes);
@@ -1439,7 +1769,11 @@ pmix_status_t pmix_bfrops_base_unpack_coord(pmix_pointer_array_t *regtypes, pmix
             return ret;
         }
         if (0 < ptr[i].dims) {
-            ptr[i].coord = (uint32_t *) malloc(ptr[i].dims * sizeof(uint32_t));
+            ptr[i].coord = (uint32_t *) pmix_tma_malloc(buffer->tma,
+                                                        ptr[i].dims * sizeof(uint32_t));
+            if (NULL == ptr[i].coord) {
+                return PMIX_ERR_NOMEM;
+            }
             /* unpack the coords */
             m = ptr[i].dims;
             PMIX_BFROPS_UNPACK_TYPE(ret, buffer, ptr[i].coord, &m, PMIX_UINT32, regtypes);
@@ -1815,9 +2149,8 @@ pmix_status_t pmix_bfrops_base_unpack_nspace(pmix_pointer_array_t *regtypes, pmi
                                              void *dest, int32_t *num_vals, pmix_data_type_t type)
 {
     pmix_nspace_t *ptr;
-    int32_t i, n, m;
+    int32_t i, n, len;
     pmix_status_t ret;
-    char *p;
 
     pmix_output_verbose(20, pmix_bfrops_base_framework.framework_output,
                         "pmix_bfrop_unpack: %d nspace", *num_vals);
@@ -1828,14 +2161,12 @@ pmix_status_t pmix_bfrops_base_unpack_nspace(pmix_pointer_array_t *regtypes, pmi
     n = *num_vals;
 
     for (i = 0; i < n; ++i) {
-        m = 1;
-        PMIX_BFROPS_UNPACK_TYPE(ret, buffer, &p, &m, PMIX_STRING, regtypes);
+        memset(ptr[i], 0, PMIX_MAX_NSLEN + 1);
+        ret = unpack_fixed_string(regtypes, buffer, ptr[i], PMIX_MAX_NSLEN, &len);
         if (PMIX_SUCCESS != ret) {
             PMIX_ERROR_LOG(ret);
             return ret;
         }
-        PMIX_LOAD_NSPACE(ptr[i], p);
-        free(p);
     }
     return PMIX_SUCCESS;
 }
@@ -254,6 +254,41 @@ typedef pmix_status_t (*pmix_bfrop_pack_fn_t)(pmix_buffer_t *buffer, const void
  */
 typedef pmix_status_t (*pmix_bfrop_unpack_fn_t)(pmix_buffer_t *buffer, void *dest,
                                                 int32_t *max_num_values, pmix_data_type_t type);
+/**
+ * Unpack PMIX_BUFFER or PMIX_BYTE_OBJECT values without copying
+ * their payload. The unpacked values point into the storage of the
+ * source buffer and so remain valid only for as long as that buffer
+ * does. Callers must not free them - a view buffer must have its
+ * base_ptr set to NULL before it is destructed, and the bytes of a
+ * view byte object must not be released. Any other data type is
+ * rejected with PMIX_ERR_BAD_PARAM.
+ */
+typedef pmix_status_t (*pmix_bfrop_unpack_view_fn_t)(pmix_buffer_t *buffer, void *dest,
+                                                     int32_t *max_num_values,
+                                                     pmix_data_type_t type);
+
+/**
+ * Unpack values with everything they point to - strings, byte
+ * objects, values, nested arrays - allocated from the given tma
+ * instead of the heap. Given an arena's tma, all the allocations for
+ * a message land in the arena and go away with it in one call.
+ * Such values must not be freed piecemeal (e.g., by PMIX_INFO_FREE);
+ * kvals are constructed as objects of the tma, so their destructor
+ * leaves their key and value alone.
+ *
+ * Supported for kvals and for types whose unpack allocates nothing
+ * but plain memory - the scalar types, strings, byte objects, procs,
+ * values, infos, pdata, envars, coords and data arrays of them. Other
+ * types are rejected with PMIX_ERR_BAD_PARAM. A value nested inside
+ * them that can't be built in the tma (e.g., a topology) fails the
+ * unpack with PMIX_ERR_NOT_SUPPORTED, after which the caller can
+ * rewind the buffer's unpack_ptr and unpack the same data from the
+ * heap.
+ */
+typedef pmix_status_t (*pmix_bfrop_unpack_tma_fn_t)(pmix_buffer_t *buffer, void *dest,
+                                                    int32_t *max_num_values,
+                                                    pmix_data_type_t type, pmix_tma_t *tma);
+
 /**
  * Copy a payload from one buffer to another
  * This function will append a copy of the payload in one buffer into
@@ -351,6 +386,8 @@ typedef struct {
     pmix_bfrop_finalize_fn_t finalize;
     pmix_bfrop_pack_fn_t pack;
     pmix_bfrop_unpack_fn_t unpack;
+    pmix_bfrop_unpack_view_fn_t unpack_view;
+    pmix_bfrop_unpack_tma_fn_t unpack_tma;
     pmix_bfrop_copy_fn_t copy;
     pmix_bfrop_print_fn_t print;
     pmix_bfrop_copy_payload_fn_t copy_payload;
@@ -371,6 +408,14 @@ PMIX_EXPORT pmix_bfrops_module_t *pmix_bfrops_base_assign_module(const char *ver
 /* provide a backdoor to access the framework debug output */
 PMIX_EXPORT extern int pmix_bfrops_base_output;
 
+/* estimate the space num_vals of the given type will take once
+ * packed, and make room for that many bytes in a buffer. Together
+ * they let a buffer be sized for its contents up front instead of
+ * growing - and copying - in steps as they are packed */
+PMIX_EXPORT size_t pmix_bfrops_base_packed_size(const void *src, int32_t num_vals,
+                                                pmix_data_type_t type);
+PMIX_EXPORT pmix_status_t pmix_bfrops_base_reserve(pmix_buffer_t *buffer, size_t bytes);
+
 /* MACROS FOR EXECUTING BFROPS FUNCTIONS */
 #define PMIX_BFROPS_ASSIGN_TYPE(p, b) (b)->type = (p)->nptr->compat.type
 
@@ -401,6 +446,33 @@ PMIX_EXPORT extern int pmix_bfrops_base_output;
         }                                                                                      \
     } while (0)
 
+/* modules that predate view support return PMIX_ERR_NOT_SUPPORTED
+ * without touching the buffer, so the caller can fall back to a
+ * regular unpack */
+#define PMIX_BFROPS_UNPACK_VIEW(r, p, b, d, m, t)                                 \
+    do {                                                                          \
+        if (NULL == (p)->nptr->compat.bfrops->unpack_view) {                      \
+            (r) = PMIX_ERR_NOT_SUPPORTED;                                         \
+        } else if ((b)->type == (p)->nptr->compat.type) {                         \
+            (r) = (p)->nptr->compat.bfrops->unpack_view(b, d, m, t);              \
+        } else {                                                                  \
+            (r) = PMIX_ERR_UNPACK_FAILURE;                                        \
+        }                                                                         \
+    } while (0)
+
+/* likewise, modules that can't unpack into a tma return
+ * PMIX_ERR_NOT_SUPPORTED without touching the buffer */
+#define PMIX_BFROPS_UNPACK_TMA(r, p, b, d, m, t, a)                               \
+    do {                                                                          \
+        if (NULL == (p)->nptr->compat.bfrops->unpack_tma) {                       \
+            (r) = PMIX_ERR_NOT_SUPPORTED;                                         \
+        } else if ((b)->type == (p)->nptr->compat.type) {                         \
+            (r) = (p)->nptr->compat.bfrops->unpack_tma(b, d, m, t, a);            \
+        } else {                                                                  \
+            (r) = PMIX_ERR_UNPACK_FAILURE;                                        \
+        }                                                                         \
+    } while (0)
+
 #define PMIX_BFROPS_COPY(r, p, d, s, t) (r) = (p)->nptr->compat.bfrops->copy(d, s, t)
 
 #define PMIX_BFROPS_PRINT(r, p, o, pr, s, t) (r) = (p)->nptr->compat.bfrops->print(o, pr, s, t)
@@ -61,6 +61,11 @@ typedef uint8_t pmix_bfrop_buffer_type_t;
 #define PMIX_BFROP_BUFFER_UNDEF      0x00
 #define PMIX_BFROP_BUFFER_NON_DESC   0x01
 #define PMIX_BFROP_BUFFER_FULLY_DESC 0x02
+/* non-described, with fixed-size types left in host byte order
+ * and arrays of them copied as a block - only used on the link
+ * between a server and a local client that reported the same
+ * architecture (see pmix_bfrops_globals.arch) */
+#define PMIX_BFROP_BUFFER_NATIVE 0x03
 
 #define PMIX_BFROP_BUFFER_TYPE_HTON(h)
 #define PMIX_BFROP_BUFFER_TYPE_NTOH(h)
@@ -110,6 +115,9 @@ typedef struct {
     /** Number of bytes used by the buffer (i.e., amount of data --
         including overhead -- packed in the buffer) */
     size_t bytes_used;
+    /** Allocator for data unpacked from the buffer - NULL for the
+        heap. Only set for the duration of an unpack_tma call */
+    pmix_tma_t *tma;
 } pmix_buffer_t;
 PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_buffer_t);
 
@@ -36,6 +36,8 @@ static pmix_status_t pmix21_pack(pmix_buffer_t *buffer, const void *src, int num
                                  pmix_data_type_t type);
 static pmix_status_t pmix21_unpack(pmix_buffer_t *buffer, void *dest, int32_t *num_vals,
                                    pmix_data_type_t type);
+static pmix_status_t pmix21_unpack_view(pmix_buffer_t *buffer, void *dest, int32_t *num_vals,
+                                        pmix_data_type_t type);
 static pmix_status_t pmix21_copy(void **dest, void *src, pmix_data_type_t type);
 static pmix_status_t pmix21_print(char **output, char *prefix, void *src, pmix_data_type_t type);
 static const char *data_type_string(pmix_data_type_t type);
@@ -46,6 +48,7 @@ pmix_bfrops_module_t pmix_bfrops_pmix21_module = {
     .finalize = finalize,
     .pack = pmix21_pack,
     .unpack = pmix21_unpack,
+    .unpack_view = pmix21_unpack_view,
     .copy = pmix21_copy,
     .print = pmix21_print,
     .copy_payload = pmix_bfrops_base_copy_payload,
@@ -307,6 +310,12 @@ static pmix_status_t pmix21_unpack(pmix_buffer_t *buffer, void *dest, int32_t *n
     return pmix_bfrops_base_unpack(&pmix_mca_bfrops_v21_component.types, buffer, dest, num_vals, type);
 }
 
+static pmix_status_t pmix21_unpack_view(pmix_buffer_t *buffer, void *dest, int32_t *num_vals,
+                                        pmix_data_type_t type)
+{
+    return pmix_bfrops_base_unpack_view(&pmix_mca_bfrops_v21_component.types, buffer, dest, num_vals, type);
+}
+
 static pmix_status_t pmix21_copy(void **dest, void *src, pmix_data_type_t type)
 {
     return pmix_bfrops_base_copy(&pmix_mca_bfrops_v21_component.types, dest, src, type);
@@ -36,6 +36,8 @@ static pmix_status_t pmix3_pack(pmix_buffer_t *buffer, const void *src, int num_
                                 pmix_data_type_t type);
 static pmix_status_t pmix3_unpack(pmix_buffer_t *buffer, void *dest, int32_t *num_vals,
                                   pmix_data_type_t type);
+static pmix_status_t pmix3_unpack_view(pmix_buffer_t *buffer, void *dest, int32_t *num_vals,
+                                       pmix_data_type_t type);
 static pmix_status_t pmix3_copy(void **dest, void *src, pmix_data_type_t type);
 static pmix_status_t pmix3_print(char **output, char *prefix, void *src, pmix_data_type_t type);
 static const char *data_type_string(pmix_data_type_t type);
@@ -46,6 +48,7 @@ pmix_bfrops_module_t pmix_bfrops_pmix3_module = {
     .finalize = finalize,
     .pack = pmix3_pack,
     .unpack = pmix3_unpack,
+    .unpack_view = pmix3_unpack_view,
     .copy = pmix3_copy,
     .print = pmix3_print,
     .copy_payload = pmix_bfrops_base_copy_payload,
@@ -313,6 +316,12 @@ static pmix_status_t pmix3_unpack(pmix_buffer_t *buffer, void *dest, int32_t *nu
     return pmix_bfrops_base_unpack(&pmix_mca_bfrops_v3_component.types, buffer, dest, num_vals, type);
 }
 
+static pmix_status_t pmix3_unpack_view(pmix_buffer_t *buffer, void *dest, int32_t *num_vals,
+                                       pmix_data_type_t type)
+{
+    return pmix_bfrops_base_unpack_view(&pmix_mca_bfrops_v3_component.types, buffer, dest, num_vals, type);
+}
+
 static pmix_status_t pmix3_copy(void **dest, void *src, pmix_data_type_t type)
 {
     return pmix_bfrops_base_copy(&pmix_mca_bfrops_v3_component.types, dest, src, type);
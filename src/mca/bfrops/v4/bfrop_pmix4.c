@@ -39,28 +39,20 @@ static pmix_status_t pmix4_pack(pmix_buffer_t *buffer, const void *src, int num_
                                 pmix_data_type_t type);
 static pmix_status_t pmix4_unpack(pmix_buffer_t *buffer, void *dest, int32_t *num_vals,
                                   pmix_data_type_t type);
+static pmix_status_t pmix4_unpack_tma(pmix_buffer_t *buffer, void *dest, int32_t *num_vals,
+                                       pmix_data_type_t type, pmix_tma_t *tma);
+static pmix_status_t pmix4_unpack_view(pmix_buffer_t *buffer, void *dest, int32_t *num_vals,
+                                       pmix_data_type_t type);
 static pmix_status_t pmix4_copy(void **dest, void *src, pmix_data_type_t type);
 static pmix_status_t pmix4_print(char **output, char *prefix, void *src, pmix_data_type_t type);
 static const char *data_type_string(pmix_data_type_t type);
 
-static pmix_status_t pmix4_bfrops_base_pack_general_int(pmix_pointer_array_t *regtypes,
-                                                        pmix_buffer_t *buffer, const void *src,
-                                                        int32_t num_vals, pmix_data_type_t type);
 static pmix_status_t pmix4_bfrops_base_pack_int(pmix_pointer_array_t *regtypes,
                                                 pmix_buffer_t *buffer, const void *src,
                                                 int32_t num_vals, pmix_data_type_t type);
-static pmix_status_t pmix4_bfrops_base_pack_sizet(pmix_pointer_array_t *regtypes,
-                                                  pmix_buffer_t *buffer, const void *src,
-                                                  int32_t num_vals, pmix_data_type_t type);
-static pmix_status_t pmix4_bfrops_base_unpack_general_int(pmix_pointer_array_t *regtypes,
-                                                          pmix_buffer_t *buffer, void *dest,
-                                                          int32_t *num_vals, pmix_data_type_t type);
 static pmix_status_t pmix4_bfrops_base_unpack_int(pmix_pointer_array_t *regtypes,
                                                   pmix_buffer_t *buffer, void *dest,
                                                   int32_t *num_vals, pmix_data_type_t type);
-static pmix_status_t pmix4_bfrops_base_unpack_sizet(pmix_pointer_array_t *regtypes,
-                                                    pmix_buffer_t *buffer, void *dest,
-                                                    int32_t *num_vals, pmix_data_type_t type);
 
 pmix_bfrops_module_t pmix_bfrops_pmix4_module = {
     .version = "v4",
@@ -68,6 +60,8 @@ pmix_bfrops_module_t pmix_bfrops_pmix4_module = {
     .finalize = finalize,
     .pack = pmix4_pack,
     .unpack = pmix4_unpack,
+    .unpack_view = pmix4_unpack_view,
+    .unpack_tma = pmix4_unpack_tma,
     .copy = pmix4_copy,
     .print = pmix4_print,
     .copy_payload = pmix_bfrops_base_copy_payload,
@@ -94,8 +88,8 @@ static pmix_status_t init(void)
                        pmix_bfrops_base_print_string, &pmix_mca_bfrops_v4_component.types);
 
     /* Register the rest of the standard generic types to point to internal functions */
-    PMIX_REGISTER_TYPE("PMIX_SIZE", PMIX_SIZE, pmix4_bfrops_base_pack_sizet,
-                       pmix4_bfrops_base_unpack_sizet, pmix_bfrops_base_std_copy,
+    PMIX_REGISTER_TYPE("PMIX_SIZE", PMIX_SIZE, pmix_bfrops_base_pack_encoded_sizet,
+                       pmix_bfrops_base_unpack_encoded_sizet, pmix_bfrops_base_std_copy,
                        pmix_bfrops_base_print_size, &pmix_mca_bfrops_v4_component.types);
 
     PMIX_REGISTER_TYPE("PMIX_PID", PMIX_PID, pmix_bfrops_base_pack_pid, pmix_bfrops_base_unpack_pid,
@@ -111,16 +105,16 @@ static pmix_status_t init(void)
                        pmix_bfrops_base_unpack_byte, pmix_bfrops_base_std_copy,
                        pmix_bfrops_base_print_int8, &pmix_mca_bfrops_v4_component.types);
 
-    PMIX_REGISTER_TYPE("PMIX_INT16", PMIX_INT16, pmix4_bfrops_base_pack_general_int,
-                       pmix4_bfrops_base_unpack_general_int, pmix_bfrops_base_std_copy,
+    PMIX_REGISTER_TYPE("PMIX_INT16", PMIX_INT16, pmix_bfrops_base_pack_general_int,
+                       pmix_bfrops_base_unpack_general_int, pmix_bfrops_base_std_copy,
                        pmix_bfrops_base_print_int16, &pmix_mca_bfrops_v4_component.types);
 
-    PMIX_REGISTER_TYPE("PMIX_INT32", PMIX_INT32, pmix4_bfrops_base_pack_general_int,
-                       pmix4_bfrops_base_unpack_general_int, pmix_bfrops_base_std_copy,
+    PMIX_REGISTER_TYPE("PMIX_INT32", PMIX_INT32, pmix_bfrops_base_pack_general_int,
+                       pmix_bfrops_base_unpack_general_int, pmix_bfrops_base_std_copy,
                        pmix_bfrops_base_print_int32, &pmix_mca_bfrops_v4_component.types);
 
-    PMIX_REGISTER_TYPE("PMIX_INT64", PMIX_INT64, pmix4_bfrops_base_pack_general_int,
-                       pmix4_bfrops_base_unpack_general_int, pmix_bfrops_base_std_copy,
+    PMIX_REGISTER_TYPE("PMIX_INT64", PMIX_INT64, pmix_bfrops_base_pack_general_int,
+                       pmix_bfrops_base_unpack_general_int, pmix_bfrops_base_std_copy,
                        pmix_bfrops_base_print_int64, &pmix_mca_bfrops_v4_component.types);
 
     PMIX_REGISTER_TYPE("PMIX_UINT", PMIX_UINT, pmix4_bfrops_base_pack_int,
@@ -131,16 +125,16 @@ static pmix_status_t init(void)
                        pmix_bfrops_base_unpack_byte, pmix_bfrops_base_std_copy,
                        pmix_bfrops_base_print_uint8, &pmix_mca_bfrops_v4_component.types);
 
-    PMIX_REGISTER_TYPE("PMIX_UINT16", PMIX_UINT16, pmix4_bfrops_base_pack_general_int,
-                       pmix4_bfrops_base_unpack_general_int, pmix_bfrops_base_std_copy,
+    PMIX_REGISTER_TYPE("PMIX_UINT16", PMIX_UINT16, pmix_bfrops_base_pack_general_int,
+                       pmix_bfrops_base_unpack_general_int, pmix_bfrops_base_std_copy,
                        pmix_bfrops_base_print_uint16, &pmix_mca_bfrops_v4_component.types);
 
-    PMIX_REGISTER_TYPE("PMIX_UINT32", PMIX_UINT32, pmix4_bfrops_base_pack_general_int,
-                       pmix4_bfrops_base_unpack_general_int, pmix_bfrops_base_std_copy,
+    PMIX_REGISTER_TYPE("PMIX_UINT32", PMIX_UINT32, pmix_bfrops_base_pack_general_int,
+                       pmix_bfrops_base_unpack_general_int, pmix_bfrops_base_std_copy,
                        pmix_bfrops_base_print_uint32, &pmix_mca_bfrops_v4_component.types);
 
-    PMIX_REGISTER_TYPE("PMIX_UINT64", PMIX_UINT64, pmix4_bfrops_base_pack_general_int,
-                       pmix4_bfrops_base_unpack_general_int, pmix_bfrops_base_std_copy,
+    PMIX_REGISTER_TYPE("PMIX_UINT64", PMIX_UINT64, pmix_bfrops_base_pack_general_int,
+                       pmix_bfrops_base_unpack_general_int, pmix_bfrops_base_std_copy,
                        pmix_bfrops_base_print_uint64, &pmix_mca_bfrops_v4_component.types);
 
     PMIX_REGISTER_TYPE("PMIX_FLOAT", PMIX_FLOAT, pmix_bfrops_base_pack_float,
@@ -347,6 +341,19 @@ static pmix_status_t pmix4_unpack(pmix_buffer_t *buffer, void *dest, int32_t *nu
     return pmix_bfrops_base_unpack(&pmix_mca_bfrops_v4_component.types, buffer, dest, num_vals, type);
 }
 
+static pmix_status_t pmix4_unpack_view(pmix_buffer_t *buffer, void *dest, int32_t *num_vals,
+                                       pmix_data_type_t type)
+{
+    return pmix_bfrops_base_unpack_view(&pmix_mca_bfrops_v4_component.types, buffer, dest, num_vals, type);
+}
+
+static pmix_status_t pmix4_unpack_tma(pmix_buffer_t *buffer, void *dest, int32_t *num_vals,
+                                       pmix_data_type_t type, pmix_tma_t *tma)
+{
+    return pmix_bfrops_base_unpack_tma(&pmix_mca_bfrops_v4_component.types, buffer, dest, num_vals,
+                                       type, tma);
+}
+
 static pmix_status_t pmix4_copy(void **dest, void *src, pmix_data_type_t type)
 {
     return pmix_bfrops_base_copy(&pmix_mca_bfrops_v4_component.types, dest, src, type);
@@ -362,56 +369,6 @@ static const char *data_type_string(pmix_data_type_t type)
     return pmix_bfrops_base_data_type_string(&pmix_mca_bfrops_v4_component.types, type);
 }
 
-/*
- * INT16, INT32, INT64
- */
-static pmix_status_t pmix4_bfrops_base_pack_general_int(pmix_pointer_array_t *regtypes,
-                                                        pmix_buffer_t *buffer, const void *src,
-                                                        int32_t num_vals, pmix_data_type_t type)
-{
-    pmix_status_t rc;
-    int32_t i;
-    char *dst;
-    size_t val_size, max_size, pkg_size;
-
-    pmix_output_verbose(20, pmix_bfrops_base_framework.framework_output,
-                        "pmix_bfrops_base_pack_integer * %d\n", num_vals);
-
-    PMIX_HIDE_UNUSED_PARAMS(regtypes);
-
-    PMIX_SQUASH_TYPE_SIZEOF(rc, type, val_size);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return rc;
-    }
-
-    rc = pmix_psquash.get_max_size(type, &max_size);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return rc;
-    }
-
-    /* check to see if buffer needs extending */
-    if (NULL == (dst = pmix_bfrop_buffer_extend(buffer, num_vals * max_size))) {
-        rc = PMIX_ERR_OUT_OF_RESOURCE;
-        PMIX_ERROR_LOG(rc);
-        return rc;
-    }
-
-    for (i = 0; i < num_vals; ++i) {
-        rc = (pmix_psquash.encode_int)(type, (uint8_t *) src + i * val_size, dst, &pkg_size);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            return rc;
-        }
-        dst += pkg_size;
-        buffer->pack_ptr += pkg_size;
-        buffer->bytes_used += pkg_size;
-    }
-
-    return PMIX_SUCCESS;
-}
-
 /*
  * INT
  */
@@ -436,89 +393,6 @@ static pmix_status_t pmix4_bfrops_base_pack_int(pmix_pointer_array_t *regtypes,
     return ret;
 }
 
-/*
- * SIZE_T
- */
-static pmix_status_t pmix4_bfrops_base_pack_sizet(pmix_pointer_array_t *regtypes,
-                                                  pmix_buffer_t *buffer, const void *src,
-                                                  int32_t num_vals, pmix_data_type_t type)
-{
-    int ret;
-
-    PMIX_HIDE_UNUSED_PARAMS(type);
-
-    if (false == pmix_psquash.int_type_is_encoded) {
-        /* System types need to always be described so we can properly
-           unpack them. */
-        if (PMIX_SUCCESS
-            != (ret = pmix_bfrop_store_data_type(regtypes, buffer, BFROP_TYPE_SIZE_T))) {
-            return ret;
-        }
-    }
-
-    PMIX_BFROPS_PACK_TYPE(ret, buffer, src, num_vals, BFROP_TYPE_SIZE_T, regtypes);
-    return ret;
-}
-
-/*
- * INT16, INT32, INT64
- */
-static pmix_status_t pmix4_bfrops_base_unpack_general_int(pmix_pointer_array_t *regtypes,
-                                                          pmix_buffer_t *buffer, void *dest,
-                                                          int32_t *num_vals, pmix_data_type_t type)
-{
-    pmix_status_t rc;
-    size_t val_size, avail_size, unpack_size, max_size;
-    int32_t i;
-
-    pmix_output_verbose(20, pmix_bfrops_base_framework.framework_output,
-                        "pmix_bfrops_base_unpack_integer * %d\n", (int) *num_vals);
-
-    PMIX_HIDE_UNUSED_PARAMS(regtypes, type);
-
-    /* check to see if there's enough data in buffer */
-    if (buffer->pack_ptr == buffer->unpack_ptr) {
-        return PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
-    }
-
-    PMIX_SQUASH_TYPE_SIZEOF(rc, type, val_size);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return rc;
-    }
-
-    rc = pmix_psquash.get_max_size(type, &max_size);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return rc;
-    }
-
-    /* unpack the data */
-    for (i = 0; i < (*num_vals); ++i) {
-        avail_size = buffer->pack_ptr - buffer->unpack_ptr;
-        rc = (pmix_psquash.decode_int)(type, buffer->unpack_ptr, avail_size,
-                                       (uint8_t *) dest + i * val_size, &unpack_size);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            return rc;
-        }
-        /* sanity checks */
-        if (unpack_size > max_size) {
-            rc = PMIX_ERR_UNPACK_FAILURE;
-            PMIX_ERROR_LOG(rc);
-            return rc;
-        }
-        if (unpack_size > avail_size) {
-            rc = PMIX_ERR_FATAL;
-            PMIX_ERROR_LOG(rc);
-            return rc;
-        }
-        buffer->unpack_ptr += unpack_size;
-    }
-
-    return PMIX_SUCCESS;
-}
-
 /*
  * INT
  */
@@ -549,40 +423,3 @@ static pmix_status_t pmix4_bfrops_base_unpack_int(pmix_pointer_array_t *regtypes
 
     return ret;
 }
-
-/*
- * SIZE_T
- */
-static pmix_status_t pmix4_bfrops_base_unpack_sizet(pmix_pointer_array_t *regtypes,
-                                                    pmix_buffer_t *buffer, void *dest,
-                                                    int32_t *num_vals, pmix_data_type_t type)
-{
-    pmix_status_t ret;
-    pmix_data_type_t remote_type;
-
-    PMIX_HIDE_UNUSED_PARAMS(type);
-
-    if (false == pmix_psquash.int_type_is_encoded) {
-        if (PMIX_SUCCESS != (ret = pmix_bfrop_get_data_type(regtypes, buffer, &remote_type))) {
-            PMIX_ERROR_LOG(ret);
-            return ret;
-        }
-        if (remote_type == BFROP_TYPE_SIZE_T) {
-            /* fast path it if the sizes are the same */
-            /* Turn around and unpack the real type */
-            PMIX_BFROPS_UNPACK_TYPE(ret, buffer, dest, num_vals, BFROP_TYPE_SIZE_T, regtypes);
-            if (PMIX_SUCCESS != ret) {
-                PMIX_ERROR_LOG(ret);
-            }
-        } else {
-            /* slow path - types are different sizes */
-            PMIX_BFROP_UNPACK_SIZE_MISMATCH(regtypes, size_t, remote_type, ret);
-        }
-    } else {
-        PMIX_BFROPS_UNPACK_TYPE(ret, buffer, dest, num_vals, BFROP_TYPE_SIZE_T, regtypes);
-        if (PMIX_SUCCESS != ret) {
-            PMIX_ERROR_LOG(ret);
-        }
-    }
-    return ret;
-}
@@ -87,11 +87,15 @@ typedef enum {
 /* define a modex blob info */
 typedef uint8_t pmix_gds_modex_blob_info_t;
 
-#define PMIX_GDS_COLLECT_BIT 0x0001
-#define PMIX_GDS_KEYMAP_BIT  0x0002
-
-#define PMIX_GDS_KEYMAP_IS_SET(byte)  (PMIX_GDS_KEYMAP_BIT & (byte))
-#define PMIX_GDS_COLLECT_IS_SET(byte) (PMIX_GDS_COLLECT_BIT & (byte))
+#define PMIX_GDS_COLLECT_BIT  0x0001
+#define PMIX_GDS_KEYMAP_BIT   0x0002
+/* the rest of the blob is a single byte object holding
+ * its compressed form */
+#define PMIX_GDS_COMPRESS_BIT 0x0004
+
+#define PMIX_GDS_KEYMAP_IS_SET(byte)   (PMIX_GDS_KEYMAP_BIT & (byte))
+#define PMIX_GDS_COLLECT_IS_SET(byte)  (PMIX_GDS_COLLECT_BIT & (byte))
+#define PMIX_GDS_COMPRESS_IS_SET(byte) (PMIX_GDS_COMPRESS_BIT & (byte))
 
 typedef struct pmix_gds_globals_t pmix_gds_globals_t;
 
@@ -25,6 +25,7 @@
 #include "src/util/pmix_error.h"
 
 #include "src/mca/gds/base/base.h"
+#include "src/mca/pcompress/pcompress.h"
 #include "src/server/pmix_server_ops.h"
 
 char *pmix_gds_base_get_available_modules(void)
@@ -146,6 +147,29 @@ pmix_status_t pmix_gds_base_store_modex(struct pmix_namespace_t *nspace, pmix_bu
             goto exit;
         }
 
+        /* if the rest of the blob was compressed, swap it
+         * for the uncompressed data - the remaining blobs
+         * are unpacked in place from it */
+        if (PMIX_GDS_COMPRESS_IS_SET(blob_info_byte)) {
+            cnt = 1;
+            PMIX_BFROPS_UNPACK_VIEW(rc, pmix_globals.mypeer, &bkt, &bo2, &cnt, PMIX_BYTE_OBJECT);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                PMIX_DESTRUCT(&bkt);
+                goto exit;
+            }
+            if (!pmix_compress.decompress((uint8_t **) &bo.bytes, &bo.size,
+                                          (uint8_t *) bo2.bytes, bo2.size)) {
+                rc = PMIX_ERR_UNPACK_FAILURE;
+                PMIX_ERROR_LOG(rc);
+                PMIX_DESTRUCT(&bkt);
+                goto exit;
+            }
+            PMIX_DESTRUCT(&bkt);
+            PMIX_CONSTRUCT(&bkt, pmix_buffer_t);
+            PMIX_LOAD_BUFFER(pmix_globals.mypeer, &bkt, bo.bytes, bo.size);
+        }
+
         /* determine the key-map existing flag */
         kmap_type = PMIX_GDS_KEYMAP_IS_SET(blob_info_byte) ? PMIX_MODEX_KEY_KEYMAP_FMT
                                                            : PMIX_MODEX_KEY_NATIVE_FMT;
@@ -185,9 +209,11 @@ pmix_status_t pmix_gds_base_store_modex(struct pmix_namespace_t *nspace, pmix_bu
                 goto exit;
             }
         }
-        /* unpack the enclosed blobs from the various peers */
+        /* unpack the enclosed blobs from the various peers - each
+         * is only needed until it has been stored, so look at
+         * them in place rather than copying them out */
         cnt = 1;
-        PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, &bkt, &bo2, &cnt, PMIX_BYTE_OBJECT);
+        PMIX_BFROPS_UNPACK_VIEW(rc, pmix_globals.mypeer, &bkt, &bo2, &cnt, PMIX_BYTE_OBJECT);
         while (PMIX_SUCCESS == rc) {
             /* unpack all the kval's from this peer and store them in
              * our GDS. Note that PMIx by design holds all data at
@@ -242,10 +268,9 @@ pmix_status_t pmix_gds_base_store_modex(struct pmix_namespace_t *nspace, pmix_bu
             }
             pbkt.base_ptr = NULL;
             PMIX_DESTRUCT(&pbkt);
-            PMIX_BYTE_OBJECT_DESTRUCT(&bo2);
             /* get the next blob */
             cnt = 1;
-            PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, &bkt, &bo2, &cnt, PMIX_BYTE_OBJECT);
+            PMIX_BFROPS_UNPACK_VIEW(rc, pmix_globals.mypeer, &bkt, &bo2, &cnt, PMIX_BYTE_OBJECT);
         }
         PMIX_DESTRUCT(&bkt);
 
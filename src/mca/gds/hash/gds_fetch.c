@@ -115,13 +115,10 @@ static pmix_status_t dohash(pmix_hash_table_t *ht, const char *key, pmix_rank_t
                     PMIX_RELEASE(kv);
                     return PMIX_ERR_NOMEM;
                 }
-                PMIX_BFROPS_VALUE_XFER(rc, pmix_globals.mypeer, kv->value, &info[n].value);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_VALUE_RELEASE(val);
-                    PMIX_RELEASE(kv);
-                    return rc;
-                }
+                /* the array already holds a copy of the value,
+                 * so take it over rather than copying it again */
+                memcpy(kv->value, &info[n].value, sizeof(pmix_value_t));
+                info[n].value.type = PMIX_UNDEF;
                 pmix_list_append(kvs, &kv->super);
             }
             PMIX_VALUE_RELEASE(val);
@@ -139,7 +136,7 @@ static pmix_status_t dohash(pmix_hash_table_t *ht, const char *key, pmix_rank_t
     return rc;
 }
 
-pmix_status_t pmix_gds_hash_fetch_nodeinfo(const char *key, pmix_job_t *trk, pmix_list_t *tgt,
+pmix_status_t pmix_gds_hash_fetch_nodeinfo(const char *key, pmix_job_t *trk, pmix_nodelist_t *tgt,
                                            pmix_info_t *info, size_t ninfo, pmix_list_t *kvs)
 {
     size_t n, nds;
@@ -147,7 +144,7 @@ pmix_status_t pmix_gds_hash_fetch_nodeinfo(const char *key, pmix_job_t *trk, pmi
     uint32_t nid = UINT32_MAX;
     char *hostname = NULL;
     bool found = false;
-    pmix_nodeinfo_t *nd, *ndptr;
+    pmix_nodeinfo_t *nd;
     pmix_kval_t *kv, *kp2;
     pmix_data_array_t *darray;
     pmix_info_t *iptr;
@@ -174,7 +171,7 @@ pmix_status_t pmix_gds_hash_fetch_nodeinfo(const char *key, pmix_job_t *trk, pmi
         /* if the key is NULL, then they want all the info from
          * all nodes */
         if (NULL == key) {
-            PMIX_LIST_FOREACH (nd, tgt, pmix_nodeinfo_t) {
+            PMIX_LIST_FOREACH (nd, &tgt->super, pmix_nodeinfo_t) {
                 kv = PMIX_NEW(pmix_kval_t);
                 /* if the proc's version is earlier than v3.1, then the
                  * info must be provided as a data_array with a key
@@ -242,16 +239,10 @@ pmix_status_t pmix_gds_hash_fetch_nodeinfo(const char *key, pmix_job_t *trk, pmi
         hostname = pmix_globals.hostname;
     }
 
-    /* scan the list of nodes to find the matching entry */
+    /* find the matching entry */
     nd = NULL;
     if (UINT32_MAX!= nid) {
-        PMIX_LIST_FOREACH (ndptr, tgt, pmix_nodeinfo_t) {
-            if (UINT32_MAX != ndptr->nodeid &&
-                nid == ndptr->nodeid) {
-                nd = ndptr;
-                break;
-            }
-        }
+        nd = pmix_gds_hash_check_nodeid(tgt, nid);
     } else if (NULL != hostname) {
         nd = pmix_gds_hash_check_nodename(tgt, hostname);
     }
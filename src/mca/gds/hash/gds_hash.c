@@ -33,6 +33,7 @@
 
 #include "pmix_common.h"
 
+#include "src/class/pmix_arena.h"
 #include "src/class/pmix_list.h"
 #include "src/client/pmix_client_ops.h"
 #include "src/include/pmix_globals.h"
@@ -379,7 +380,7 @@ static pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns, pmix_info_
             if (NULL == nd) {
                 nd = PMIX_NEW(pmix_nodeinfo_t);
                 nd->hostname = strdup(pmix_globals.hostname);
-                pmix_list_append(&trk->nodeinfo, &nd->super);
+                pmix_gds_hash_add_node(&trk->nodeinfo, nd);
             }
             /* ensure the value isn't already on the node info */
             PMIX_LIST_FOREACH (kp2, &nd->info, pmix_kval_t) {
@@ -522,6 +523,32 @@ release:
     return rc;
 }
 
+/* the space a list of kvals takes once packed */
+static size_t kvs_size(pmix_list_t *kvs)
+{
+    pmix_kval_t *kv;
+    size_t sz = 0;
+
+    PMIX_LIST_FOREACH (kv, kvs, pmix_kval_t) {
+        sz += pmix_bfrops_base_packed_size(kv, 1, PMIX_KVAL);
+    }
+    return sz;
+}
+
+/* the space an array of info takes once packed as kvals */
+static size_t infos_size(pmix_info_t *info, size_t ninfo)
+{
+    pmix_kval_t kv;
+    size_t n, sz = 0;
+
+    for (n = 0; n < ninfo; n++) {
+        kv.key = info[n].key;
+        kv.value = &info[n].value;
+        sz += pmix_bfrops_base_packed_size(&kv, 1, PMIX_KVAL);
+    }
+    return sz;
+}
+
 static pmix_status_t register_info(pmix_peer_t *peer, pmix_namespace_t *ns, pmix_buffer_t *reply)
 {
     pmix_job_t *trk;
@@ -565,6 +592,12 @@ static pmix_status_t register_info(pmix_peer_t *peer, pmix_namespace_t *ns, pmix
     }
     info = (pmix_info_t *) val->data.darray->array;
     ninfo = val->data.darray->size;
+    /* size the reply for the job-level data up front */
+    rc = pmix_bfrops_base_reserve(reply, infos_size(info, ninfo) + kvs_size(&trk->jobinfo));
+    if (PMIX_SUCCESS != rc) {
+        PMIX_VALUE_RELEASE(val);
+        return rc;
+    }
     for (n = 0; n < ninfo; n++) {
         kv.key = info[n].key;
         kv.value = &info[n].value;
@@ -583,6 +616,7 @@ static pmix_status_t register_info(pmix_peer_t *peer, pmix_namespace_t *ns, pmix
     PMIX_CONSTRUCT(&results, pmix_list_t);
     rc = pmix_gds_hash_fetch_nodeinfo(NULL, trk, &trk->nodeinfo, NULL, 0, &results);
     if (PMIX_SUCCESS == rc) {
+        pmix_bfrops_base_reserve(reply, kvs_size(&results));
         PMIX_LIST_FOREACH (kvptr, &results, pmix_kval_t) {
             /* if the peer is earlier than v3.2.x, it is expecting
              * node info to be in the form of an array, but with the
@@ -623,6 +657,7 @@ static pmix_status_t register_info(pmix_peer_t *peer, pmix_namespace_t *ns, pmix
     PMIX_CONSTRUCT(&results, pmix_list_t);
     rc = pmix_gds_hash_fetch_appinfo(NULL, trk, &trk->apps, NULL, 0, &results);
     if (PMIX_SUCCESS == rc) {
+        pmix_bfrops_base_reserve(reply, kvs_size(&results));
         PMIX_LIST_FOREACH (kvptr, &results, pmix_kval_t) {
             PMIX_BFROPS_PACK(rc, peer, reply, kvptr, 1, PMIX_KVAL);
         }
@@ -650,6 +685,7 @@ static pmix_status_t register_info(pmix_peer_t *peer, pmix_namespace_t *ns, pmix
         if (NULL != val) {
             info = (pmix_info_t *) val->data.darray->array;
             ninfo = val->data.darray->size;
+            pmix_bfrops_base_reserve(&buf, infos_size(info, ninfo));
             for (n = 0; n < ninfo; n++) {
                 kv.key = info[n].key;
                 kv.value = &info[n].value;
@@ -660,6 +696,7 @@ static pmix_status_t register_info(pmix_peer_t *peer, pmix_namespace_t *ns, pmix
         kv.value = &blob;
         blob.type = PMIX_BYTE_OBJECT;
         PMIX_UNLOAD_BUFFER(&buf, blob.data.bo.bytes, blob.data.bo.size);
+        pmix_bfrops_base_reserve(reply, pmix_bfrops_base_packed_size(&kv, 1, PMIX_KVAL));
         PMIX_BFROPS_PACK(rc, peer, reply, &kv, 1, PMIX_KVAL);
         PMIX_VALUE_DESTRUCT(&blob);
         PMIX_DESTRUCT(&buf);
@@ -752,8 +789,34 @@ static pmix_status_t hash_register_job_info(struct pmix_peer_t *pr, pmix_buffer_
     return rc;
 }
 
-static pmix_status_t hash_store_job_info(const char *nspace, pmix_buffer_t *buf)
+/* unpack the next kval of the job info into the tma - kvals holding
+ * types that can only be unpacked onto the heap are unpacked there */
+static pmix_kval_t *unpack_job_kval(pmix_buffer_t *buf, pmix_tma_t *tma, pmix_status_t *rc)
 {
+    pmix_kval_t *kv;
+    char *mark = buf->unpack_ptr;
+    int32_t cnt = 1;
+
+    kv = PMIX_NEW_TMA(pmix_kval_t, tma);
+    if (NULL != kv) {
+        PMIX_BFROPS_UNPACK_TMA(*rc, pmix_client_globals.myserver, buf, kv, &cnt, PMIX_KVAL, tma);
+        if (PMIX_ERR_NOT_SUPPORTED != *rc) {
+            return kv;
+        }
+        PMIX_RELEASE(kv);
+        buf->unpack_ptr = mark;
+    }
+    /* the arena is out of memory or the kval holds a type
+     * that has to go on the heap */
+    kv = PMIX_NEW(pmix_kval_t);
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(*rc, pmix_client_globals.myserver, buf, kv, &cnt, PMIX_KVAL);
+    return kv;
+}
+
+static pmix_status_t store_job_info(const char *nspace, pmix_buffer_t *buf, pmix_arena_t *arena)
+{
+    pmix_tma_t *tma = &arena->tma;
     pmix_status_t rc = PMIX_SUCCESS;
     pmix_kval_t *kptr, *kp2, *kp3, kv;
     int32_t cnt;
@@ -768,7 +831,7 @@ static pmix_status_t hash_store_job_info(const char *nspace, pmix_buffer_t *buf)
     pmix_hash_table_t *ht;
     char **nodelist = NULL;
     pmix_nodeinfo_t *nd;
-    pmix_namespace_t *ns, *nptr;
+    pmix_namespace_t *nptr;
 
     pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
                         "[%s:%u] pmix:gds:hash store job info for nspace %s",
@@ -788,28 +851,21 @@ static pmix_status_t hash_store_job_info(const char *nspace, pmix_buffer_t *buf)
     ht = &trk->internal;
 
     /* retrieve the nspace pointer */
-    nptr = NULL;
-    PMIX_LIST_FOREACH (ns, &pmix_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(ns->nspace, nspace)) {
-            nptr = ns;
-            break;
-        }
-    }
+    nptr = pmix_nspace_lookup(nspace);
     if (NULL == nptr) {
         /* only can happen if we are out of mem */
         return PMIX_ERR_NOMEM;
     }
 
-    cnt = 1;
-    kptr = PMIX_NEW(pmix_kval_t);
-    PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, buf, kptr, &cnt, PMIX_KVAL);
+    kptr = unpack_job_kval(buf, tma, &rc);
     while (PMIX_SUCCESS == rc) {
         pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
                             "[%s:%u] pmix:gds:hash store job info working key %s",
                             pmix_globals.myid.nspace, pmix_globals.myid.rank, kptr->key);
         if (PMIX_CHECK_KEY(kptr, PMIX_PROC_BLOB)) {
             bo = &(kptr->value->data.bo);
-            PMIX_CONSTRUCT(&buf2, pmix_buffer_t);
+            /* the blob stays wherever the kval was unpacked */
+            PMIX_CONSTRUCT_TMA(&buf2, pmix_buffer_t, &kptr->super.super.obj_tma);
             PMIX_LOAD_BUFFER(pmix_client_globals.myserver, &buf2, bo->bytes, bo->size);
             /* start by unpacking the rank */
             cnt = 1;
@@ -865,7 +921,8 @@ static pmix_status_t hash_store_job_info(const char *nspace, pmix_buffer_t *buf)
         } else if (PMIX_CHECK_KEY(kptr, PMIX_MAP_BLOB)) {
             /* transfer the byte object for unpacking */
             bo = &(kptr->value->data.bo);
-            PMIX_CONSTRUCT(&buf2, pmix_buffer_t);
+            /* the blob stays wherever the kval was unpacked */
+            PMIX_CONSTRUCT_TMA(&buf2, pmix_buffer_t, &kptr->super.super.obj_tma);
             PMIX_LOAD_BUFFER(pmix_client_globals.myserver, &buf2, bo->bytes, bo->size);
             /* start by unpacking the number of nodes */
             cnt = 1;
@@ -895,7 +952,7 @@ static pmix_status_t hash_store_job_info(const char *nspace, pmix_buffer_t *buf)
                 if (NULL == nd) {
                     nd = PMIX_NEW(pmix_nodeinfo_t);
                     nd->hostname = strdup(kv.key);
-                    pmix_list_append(&trk->nodeinfo, &nd->super);
+                    pmix_gds_hash_add_node(&trk->nodeinfo, nd);
                 }
                 /* save the list of peers for this node */
                 kp2 = PMIX_NEW(pmix_kval_t);
@@ -987,6 +1044,23 @@ static pmix_status_t hash_store_job_info(const char *nspace, pmix_buffer_t *buf)
                 return rc;
             }
         } else {
+            /* the hash table keeps the kval, so it cannot stay in the arena */
+            if (kptr->super.super.obj_tma.dontfree) {
+                kp2 = PMIX_NEW(pmix_kval_t);
+                if (NULL == kp2) {
+                    PMIX_RELEASE(kptr);
+                    return PMIX_ERR_NOMEM;
+                }
+                kp2->key = strdup(kptr->key);
+                PMIX_VALUE_XFER(rc, kp2->value, kptr->value);
+                PMIX_RELEASE(kptr);
+                if (PMIX_SUCCESS != rc) {
+                    PMIX_ERROR_LOG(rc);
+                    PMIX_RELEASE(kp2);
+                    return rc;
+                }
+                kptr = kp2;
+            }
             /* if the value contains a string that is longer than the
              * limit, then compress it */
             if (PMIX_STRING_SIZE_CHECK(kptr->value)) {
@@ -1018,9 +1092,10 @@ static pmix_status_t hash_store_job_info(const char *nspace, pmix_buffer_t *buf)
             }
         }
         PMIX_RELEASE(kptr);
-        kptr = PMIX_NEW(pmix_kval_t);
-        cnt = 1;
-        PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, buf, kptr, &cnt, PMIX_KVAL);
+        /* nothing unpacked for this kval outlives it, so the next
+         * one can reuse the memory while it is still in cache */
+        pmix_arena_reset(arena);
+        kptr = unpack_job_kval(buf, tma, &rc);
     }
     /* need to release the leftover kptr */
     PMIX_RELEASE(kptr);
@@ -1033,6 +1108,19 @@ static pmix_status_t hash_store_job_info(const char *nspace, pmix_buffer_t *buf)
     return rc;
 }
 
+static pmix_status_t hash_store_job_info(const char *nspace, pmix_buffer_t *buf)
+{
+    pmix_arena_t arena;
+    pmix_status_t rc;
+
+    /* whatever is unpacked from the message only to be processed
+     * and discarded goes into one arena, released in a single call */
+    PMIX_CONSTRUCT(&arena, pmix_arena_t);
+    rc = store_job_info(nspace, buf, &arena);
+    PMIX_DESTRUCT(&arena);
+    return rc;
+}
+
 pmix_status_t pmix_gds_hash_store(const pmix_proc_t *proc, pmix_scope_t scope, pmix_kval_t *kv)
 {
     pmix_job_t *trk;
@@ -1312,15 +1400,14 @@ static pmix_status_t nspace_del(const char *nspace)
 {
     pmix_job_t *t;
 
-
     /* find the hash table for this nspace */
-    PMIX_LIST_FOREACH (t, &pmix_mca_gds_hash_component.myjobs, pmix_job_t) {
-        if (0 == strcmp(nspace, t->ns)) {
-            /* release it */
-            pmix_list_remove_item(&pmix_mca_gds_hash_component.myjobs, &t->super);
-            PMIX_RELEASE(t);
-            break;
-        }
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&pmix_mca_gds_hash_component.jobindex, nspace,
+                                                      strlen(nspace), (void **) &t)) {
+        /* release it */
+        pmix_hash_table_remove_value_ptr(&pmix_mca_gds_hash_component.jobindex, nspace,
+                                         strlen(nspace));
+        pmix_list_remove_item(&pmix_mca_gds_hash_component.myjobs, &t->super);
+        PMIX_RELEASE(t);
     }
     return PMIX_SUCCESS;
 }
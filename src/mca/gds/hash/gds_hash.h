@@ -14,6 +14,7 @@
 
 #include "src/include/pmix_config.h"
 
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_list.h"
 #include "src/include/pmix_globals.h"
 #include "src/util/pmix_argv.h"
@@ -22,6 +23,7 @@
 #include "src/util/pmix_name_fns.h"
 #include "src/util/pmix_output.h"
 
+#include "src/class/pmix_hash_table.h"
 #include "src/mca/gds/gds.h"
 
 BEGIN_C_DECLS
@@ -30,6 +32,7 @@ typedef struct {
     pmix_gds_base_component_t super;
     pmix_list_t mysessions;
     pmix_list_t myjobs;
+    pmix_hash_table_t jobindex; // myjobs by nspace name
 } pmix_gds_hash_component_t;
 
 /* the component must be visible data for the linker to find it */
@@ -46,11 +49,24 @@ extern pmix_gds_base_module_t pmix_hash_module;
 #define PMIX_HASH_NODE_MAP  0x00000020
 
 /* struct definitions */
+
+/* list of pmix_nodeinfo_t, indexed by hostname, alias, and
+ * nodeid. Nodes must be added with pmix_gds_hash_add_node,
+ * and re-indexed with pmix_gds_hash_index_node whenever their
+ * hostname, aliases, or nodeid change */
+typedef struct {
+    pmix_list_t super;
+    pmix_hash_table_t hostnames;
+    pmix_hash_table_t aliases;
+    pmix_hash_table_t nodeids;
+} pmix_nodelist_t;
+PMIX_CLASS_DECLARATION(pmix_nodelist_t);
+
 typedef struct {
     pmix_list_item_t super;
     uint32_t session;
     pmix_list_t sessioninfo;
-    pmix_list_t nodeinfo;
+    pmix_nodelist_t nodeinfo;
 } pmix_session_t;
 PMIX_CLASS_DECLARATION(pmix_session_t);
 
@@ -64,7 +80,7 @@ typedef struct {
     bool gdata_added;
     pmix_list_t jobinfo;
     pmix_list_t apps;
-    pmix_list_t nodeinfo;
+    pmix_nodelist_t nodeinfo;
     pmix_session_t *session;
 } pmix_job_t;
 PMIX_CLASS_DECLARATION(pmix_job_t);
@@ -73,7 +89,7 @@ typedef struct {
     pmix_list_item_t super;
     uint32_t appnum;
     pmix_list_t appinfo;
-    pmix_list_t nodeinfo;
+    pmix_nodelist_t nodeinfo;
     pmix_job_t *job;
 } pmix_apptrkr_t;
 PMIX_CLASS_DECLARATION(pmix_apptrkr_t);
@@ -87,7 +103,7 @@ typedef struct {
 } pmix_nodeinfo_t;
 PMIX_CLASS_DECLARATION(pmix_nodeinfo_t);
 
-extern pmix_status_t pmix_gds_hash_process_node_array(pmix_value_t *val, pmix_list_t *tgt);
+extern pmix_status_t pmix_gds_hash_process_node_array(pmix_value_t *val, pmix_nodelist_t *tgt);
 
 extern pmix_status_t pmix_gds_hash_process_app_array(pmix_value_t *val, pmix_job_t *trk);
 
@@ -102,7 +118,13 @@ extern bool pmix_gds_hash_check_hostname(char *h1, char *h2);
 
 extern bool pmix_gds_hash_check_node(pmix_nodeinfo_t *n1, pmix_nodeinfo_t *n2);
 
-extern pmix_nodeinfo_t* pmix_gds_hash_check_nodename(pmix_list_t *nodes, char *hostname);
+extern pmix_nodeinfo_t* pmix_gds_hash_check_nodename(pmix_nodelist_t *nodes, char *hostname);
+
+extern pmix_nodeinfo_t* pmix_gds_hash_check_nodeid(pmix_nodelist_t *nodes, uint32_t nodeid);
+
+extern void pmix_gds_hash_add_node(pmix_nodelist_t *nodes, pmix_nodeinfo_t *nd);
+
+extern void pmix_gds_hash_index_node(pmix_nodelist_t *nodes, pmix_nodeinfo_t *nd);
 
 extern pmix_status_t pmix_gds_hash_store_map(pmix_job_t *trk, char **nodes, char **ppn,
                                              uint32_t flags);
@@ -112,7 +134,7 @@ extern pmix_status_t pmix_gds_hash_fetch(const pmix_proc_t *proc, pmix_scope_t s
                                          pmix_list_t *kvs);
 
 extern pmix_status_t pmix_gds_hash_fetch_nodeinfo(const char *key, pmix_job_t *trk,
-                                                  pmix_list_t *tgt, pmix_info_t *info, size_t ninfo,
+                                                  pmix_nodelist_t *tgt, pmix_info_t *info, size_t ninfo,
                                                   pmix_list_t *kvs);
 
 extern pmix_status_t pmix_gds_hash_fetch_appinfo(const char *key, pmix_job_t *trk, pmix_list_t *tgt,
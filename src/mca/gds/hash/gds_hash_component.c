@@ -66,6 +66,8 @@ static int component_open(void)
 {
     PMIX_CONSTRUCT(&pmix_mca_gds_hash_component.mysessions, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_mca_gds_hash_component.myjobs, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_mca_gds_hash_component.jobindex, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_mca_gds_hash_component.jobindex, 256);
 
     return PMIX_SUCCESS;
 }
@@ -80,6 +82,7 @@ static int component_query(pmix_mca_base_module_t **module, int *priority)
 static int component_close(void)
 {
     PMIX_LIST_DESTRUCT(&pmix_mca_gds_hash_component.mysessions);
+    PMIX_DESTRUCT(&pmix_mca_gds_hash_component.jobindex);
     PMIX_LIST_DESTRUCT(&pmix_mca_gds_hash_component.myjobs);
 
     return PMIX_SUCCESS;
@@ -87,16 +90,33 @@ static int component_close(void)
 
 /**********************************************/
 /* class instantiations */
+static void nlcon(pmix_nodelist_t *p)
+{
+    PMIX_CONSTRUCT(&p->hostnames, pmix_hash_table_t);
+    pmix_hash_table_init(&p->hostnames, 256);
+    PMIX_CONSTRUCT(&p->aliases, pmix_hash_table_t);
+    pmix_hash_table_init(&p->aliases, 256);
+    PMIX_CONSTRUCT(&p->nodeids, pmix_hash_table_t);
+    pmix_hash_table_init(&p->nodeids, 256);
+}
+static void nldes(pmix_nodelist_t *p)
+{
+    PMIX_DESTRUCT(&p->hostnames);
+    PMIX_DESTRUCT(&p->aliases);
+    PMIX_DESTRUCT(&p->nodeids);
+}
+PMIX_CLASS_INSTANCE(pmix_nodelist_t, pmix_list_t, nlcon, nldes);
+
 static void scon(pmix_session_t *s)
 {
     s->session = UINT32_MAX;
     PMIX_CONSTRUCT(&s->sessioninfo, pmix_list_t);
-    PMIX_CONSTRUCT(&s->nodeinfo, pmix_list_t);
+    PMIX_CONSTRUCT(&s->nodeinfo, pmix_nodelist_t);
 }
 static void sdes(pmix_session_t *s)
 {
     PMIX_LIST_DESTRUCT(&s->sessioninfo);
-    PMIX_LIST_DESTRUCT(&s->nodeinfo);
+    PMIX_LIST_DESTRUCT(&s->nodeinfo.super);
 }
 PMIX_CLASS_INSTANCE(pmix_session_t, pmix_list_item_t, scon, sdes);
 
@@ -113,7 +133,7 @@ static void htcon(pmix_job_t *p)
     pmix_hash_table_init(&p->local, 256);
     p->gdata_added = false;
     PMIX_CONSTRUCT(&p->apps, pmix_list_t);
-    PMIX_CONSTRUCT(&p->nodeinfo, pmix_list_t);
+    PMIX_CONSTRUCT(&p->nodeinfo, pmix_nodelist_t);
     p->session = NULL;
 }
 static void htdes(pmix_job_t *p)
@@ -132,7 +152,7 @@ static void htdes(pmix_job_t *p)
     pmix_hash_remove_data(&p->local, PMIX_RANK_WILDCARD, NULL);
     PMIX_DESTRUCT(&p->local);
     PMIX_LIST_DESTRUCT(&p->apps);
-    PMIX_LIST_DESTRUCT(&p->nodeinfo);
+    PMIX_LIST_DESTRUCT(&p->nodeinfo.super);
     if (NULL != p->session) {
         PMIX_RELEASE(p->session);
     }
@@ -143,13 +163,13 @@ static void apcon(pmix_apptrkr_t *p)
 {
     p->appnum = 0;
     PMIX_CONSTRUCT(&p->appinfo, pmix_list_t);
-    PMIX_CONSTRUCT(&p->nodeinfo, pmix_list_t);
+    PMIX_CONSTRUCT(&p->nodeinfo, pmix_nodelist_t);
     p->job = NULL;
 }
 static void apdes(pmix_apptrkr_t *p)
 {
     PMIX_LIST_DESTRUCT(&p->appinfo);
-    PMIX_LIST_DESTRUCT(&p->nodeinfo);
+    PMIX_LIST_DESTRUCT(&p->nodeinfo.super);
     if (NULL != p->job) {
         PMIX_RELEASE(p->job);
     }
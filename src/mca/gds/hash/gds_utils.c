@@ -53,29 +53,20 @@
 
 pmix_job_t *pmix_gds_hash_get_tracker(const pmix_nspace_t nspace, bool create)
 {
-    pmix_job_t *trk, *t;
-    pmix_namespace_t *ns, *nptr;
+    pmix_job_t *trk;
+    pmix_namespace_t *nptr;
 
     /* find the hash table for this nspace */
-    trk = NULL;
-    PMIX_LIST_FOREACH (t, &pmix_mca_gds_hash_component.myjobs, pmix_job_t) {
-        if (0 == strcmp(nspace, t->ns)) {
-            trk = t;
-            break;
-        }
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&pmix_mca_gds_hash_component.jobindex, nspace,
+                                                      strlen(nspace), (void **) &trk)) {
+        trk = NULL;
     }
     if (NULL == trk && create) {
         /* create one */
         trk = PMIX_NEW(pmix_job_t);
         trk->ns = strdup(nspace);
         /* see if we already have this nspace */
-        nptr = NULL;
-        PMIX_LIST_FOREACH (ns, &pmix_globals.nspaces, pmix_namespace_t) {
-            if (0 == strcmp(ns->nspace, nspace)) {
-                nptr = ns;
-                break;
-            }
-        }
+        nptr = pmix_nspace_lookup(nspace);
         if (NULL == nptr) {
             nptr = PMIX_NEW(pmix_namespace_t);
             if (NULL == nptr) {
@@ -83,11 +74,13 @@ pmix_job_t *pmix_gds_hash_get_tracker(const pmix_nspace_t nspace, bool create)
                 return NULL;
             }
             nptr->nspace = strdup(nspace);
-            pmix_list_append(&pmix_globals.nspaces, &nptr->super);
+            pmix_nspace_register(nptr);
         }
         PMIX_RETAIN(nptr);
         trk->nptr = nptr;
         pmix_list_append(&pmix_mca_gds_hash_component.myjobs, &trk->super);
+        pmix_hash_table_set_value_ptr(&pmix_mca_gds_hash_component.jobindex, trk->ns,
+                                      strlen(trk->ns), trk);
     }
     return trk;
 }
@@ -143,11 +136,9 @@ bool pmix_gds_hash_check_node(pmix_nodeinfo_t *n1, pmix_nodeinfo_t *n2)
     return false;
 }
 
-pmix_nodeinfo_t* pmix_gds_hash_check_nodename(pmix_list_t *nodes, char *hostname)
+pmix_nodeinfo_t* pmix_gds_hash_check_nodename(pmix_nodelist_t *nodes, char *hostname)
 {
-    int i;
     pmix_nodeinfo_t *nd;
-    bool aliases_exist = false;
 
     if (NULL == hostname) {
         return NULL;
@@ -155,31 +146,66 @@ pmix_nodeinfo_t* pmix_gds_hash_check_nodename(pmix_list_t *nodes, char *hostname
 
     /* first, just check all the node names as this is the
      * most likely match */
-    PMIX_LIST_FOREACH (nd, nodes, pmix_nodeinfo_t) {
-        if (0 == strcmp(nd->hostname, hostname)) {
-            return nd;
-        }
-        if (NULL != nd->aliases) {
-            aliases_exist = true;
-        }
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&nodes->hostnames, hostname,
+                                                      strlen(hostname), (void **) &nd)) {
+        return nd;
+    }
+
+    /* if a match wasn't found, then we have to try the aliases */
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&nodes->aliases, hostname,
+                                                      strlen(hostname), (void **) &nd)) {
+        return nd;
     }
+    /* no match was found */
+    return NULL;
+}
+
+pmix_nodeinfo_t* pmix_gds_hash_check_nodeid(pmix_nodelist_t *nodes, uint32_t nodeid)
+{
+    pmix_nodeinfo_t *nd;
 
-    if (!aliases_exist) {
+    if (UINT32_MAX == nodeid) {
         return NULL;
     }
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_uint32(&nodes->nodeids, nodeid, (void **) &nd)) {
+        return nd;
+    }
+    return NULL;
+}
 
-    /* if a match wasn't found, then we have to try the aliases */
-    PMIX_LIST_FOREACH (nd, nodes, pmix_nodeinfo_t) {
-        if (NULL != nd->aliases) {
-            for (i = 0; NULL != nd->aliases[i]; i++) {
-                if (0 == strcmp(nd->aliases[i], hostname)) {
-                    return nd;
-                }
+void pmix_gds_hash_add_node(pmix_nodelist_t *nodes, pmix_nodeinfo_t *nd)
+{
+    pmix_list_append(&nodes->super, &nd->super);
+    pmix_gds_hash_index_node(nodes, nd);
+}
+
+/* index the node under its current identifiers. An identifier
+ * already claimed by an earlier node on the list keeps pointing
+ * at that node so lookups return the same node a scan of the
+ * list would have found */
+void pmix_gds_hash_index_node(pmix_nodelist_t *nodes, pmix_nodeinfo_t *nd)
+{
+    void *ptr;
+    int i;
+
+    if (NULL != nd->hostname
+        && PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&nodes->hostnames, nd->hostname,
+                                                         strlen(nd->hostname), &ptr)) {
+        pmix_hash_table_set_value_ptr(&nodes->hostnames, nd->hostname, strlen(nd->hostname), nd);
+    }
+    if (NULL != nd->aliases) {
+        for (i = 0; NULL != nd->aliases[i]; i++) {
+            if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&nodes->aliases, nd->aliases[i],
+                                                              strlen(nd->aliases[i]), &ptr)) {
+                pmix_hash_table_set_value_ptr(&nodes->aliases, nd->aliases[i],
+                                              strlen(nd->aliases[i]), nd);
             }
         }
     }
-    /* no match was found */
-    return NULL;
+    if (UINT32_MAX != nd->nodeid
+        && PMIX_SUCCESS != pmix_hash_table_get_value_uint32(&nodes->nodeids, nd->nodeid, &ptr)) {
+        pmix_hash_table_set_value_uint32(&nodes->nodeids, nd->nodeid, nd);
+    }
 }
 
 pmix_status_t pmix_gds_hash_store_map(pmix_job_t *trk, char **nodes, char **ppn, uint32_t flags)
@@ -228,7 +254,7 @@ pmix_status_t pmix_gds_hash_store_map(pmix_job_t *trk, char **nodes, char **ppn,
             nd = PMIX_NEW(pmix_nodeinfo_t);
             nd->hostname = strdup(nodes[n]);
             nd->nodeid = n;
-            pmix_list_append(&trk->nodeinfo, &nd->super);
+            pmix_gds_hash_add_node(&trk->nodeinfo, nd);
         }
         /* store the proc list as-is */
         kp2 = PMIX_NEW(pmix_kval_t);
@@ -55,7 +55,7 @@
  * node-level info for a single node. Either the
  * nodeid, hostname, or both must be included
  * in the array to identify the node */
-pmix_status_t pmix_gds_hash_process_node_array(pmix_value_t *val, pmix_list_t *tgt)
+pmix_status_t pmix_gds_hash_process_node_array(pmix_value_t *val, pmix_nodelist_t *tgt)
 {
     size_t size, j, n;
     pmix_info_t *iptr;
@@ -143,47 +143,36 @@ pmix_status_t pmix_gds_hash_process_node_array(pmix_value_t *val, pmix_list_t *t
     }
 
     /* see if we already have this node on the
-     * provided list */
+     * provided list - match by nodeid if both sides
+     * have one, otherwise by hostname */
     update = false;
-    PMIX_LIST_FOREACH (ndptr, tgt, pmix_nodeinfo_t) {
-        if (UINT32_MAX != ndptr->nodeid &&
-            UINT32_MAX != nd->nodeid) {
-            if (ndptr->nodeid == nd->nodeid) {
-                if (NULL == ndptr->hostname &&
-                    NULL != nd->hostname) {
-                    ndptr->hostname = strdup(nd->hostname);
-                }
-                if (NULL != nd->aliases) {
-                    for (n=0; NULL != nd->aliases[n]; n++) {
-                        pmix_argv_append_unique_nosize(&ndptr->aliases, nd->aliases[n]);
-                    }
-                }
-                PMIX_RELEASE(nd);
-                nd = ndptr;
-                update = true;
-                break;
-            }
-        } else if (NULL != ndptr->hostname &&
-                   NULL != nd->hostname) {
-            if (0 == strcmp(ndptr->hostname, nd->hostname)) {
-                if (UINT32_MAX == ndptr->nodeid &&
-                    UINT32_MAX != nd->nodeid) {
-                    ndptr->nodeid = nd->nodeid;
-                }
-                if (NULL != nd->aliases) {
-                    for (n=0; NULL != nd->aliases[n]; n++) {
-                        pmix_argv_append_unique_nosize(&ndptr->aliases, nd->aliases[n]);
-                    }
-                }
-                PMIX_RELEASE(nd);
-                nd = ndptr;
-                update = true;
-                break;
-            }
+    ndptr = pmix_gds_hash_check_nodeid(tgt, nd->nodeid);
+    if (NULL == ndptr && NULL != nd->hostname) {
+        if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&tgt->hostnames, nd->hostname,
+                                                          strlen(nd->hostname), (void **) &ndptr)
+            && UINT32_MAX != ndptr->nodeid && UINT32_MAX != nd->nodeid) {
+            /* same name but a different node */
+            ndptr = NULL;
         }
     }
-    if (!update) {
-        pmix_list_append(tgt, &nd->super);
+    if (NULL != ndptr) {
+        if (NULL == ndptr->hostname && NULL != nd->hostname) {
+            ndptr->hostname = strdup(nd->hostname);
+        }
+        if (UINT32_MAX == ndptr->nodeid && UINT32_MAX != nd->nodeid) {
+            ndptr->nodeid = nd->nodeid;
+        }
+        if (NULL != nd->aliases) {
+            for (n=0; NULL != nd->aliases[n]; n++) {
+                pmix_argv_append_unique_nosize(&ndptr->aliases, nd->aliases[n]);
+            }
+        }
+        PMIX_RELEASE(nd);
+        nd = ndptr;
+        update = true;
+        pmix_gds_hash_index_node(tgt, nd);
+    } else {
+        pmix_gds_hash_add_node(tgt, nd);
     }
 
     /* transfer the cached items to the nodeinfo list */
@@ -216,7 +205,8 @@ pmix_status_t pmix_gds_hash_process_node_array(pmix_value_t *val, pmix_list_t *t
  * an error if violated */
 pmix_status_t pmix_gds_hash_process_app_array(pmix_value_t *val, pmix_job_t *trk)
 {
-    pmix_list_t cache, ncache;
+    pmix_list_t cache;
+    pmix_nodelist_t ncache;
     size_t size, j;
     pmix_info_t *iptr;
     pmix_status_t rc = PMIX_SUCCESS;
@@ -241,7 +231,7 @@ pmix_status_t pmix_gds_hash_process_app_array(pmix_value_t *val, pmix_job_t *trk
 
     /* setup arrays and lists */
     PMIX_CONSTRUCT(&cache, pmix_list_t);
-    PMIX_CONSTRUCT(&ncache, pmix_list_t);
+    PMIX_CONSTRUCT(&ncache, pmix_nodelist_t);
     size = val->data.darray->size;
     iptr = (pmix_info_t *) val->data.darray->array;
 
@@ -260,7 +250,7 @@ pmix_status_t pmix_gds_hash_process_app_array(pmix_value_t *val, pmix_job_t *trk
                  * described in this array */
                 PMIX_RELEASE(app);
                 PMIX_LIST_DESTRUCT(&cache);
-                PMIX_LIST_DESTRUCT(&ncache);
+                PMIX_LIST_DESTRUCT(&ncache.super);
                 return PMIX_ERR_BAD_PARAM;
             }
             app = PMIX_NEW(pmix_apptrkr_t);
@@ -344,15 +334,15 @@ pmix_status_t pmix_gds_hash_process_app_array(pmix_value_t *val, pmix_job_t *trk
         kp2 = (pmix_kval_t *) pmix_list_remove_first(&cache);
     }
     /* transfer the associated node-level data across */
-    nd = (pmix_nodeinfo_t *) pmix_list_remove_first(&ncache);
+    nd = (pmix_nodeinfo_t *) pmix_list_remove_first(&ncache.super);
     while (NULL != nd) {
-        pmix_list_append(&app->nodeinfo, &nd->super);
-        nd = (pmix_nodeinfo_t *) pmix_list_remove_first(&ncache);
+        pmix_gds_hash_add_node(&app->nodeinfo, nd);
+        nd = (pmix_nodeinfo_t *) pmix_list_remove_first(&ncache.super);
     }
 
 release:
     PMIX_LIST_DESTRUCT(&cache);
-    PMIX_LIST_DESTRUCT(&ncache);
+    PMIX_LIST_DESTRUCT(&ncache.super);
 
     return rc;
 }
@@ -458,7 +448,8 @@ pmix_status_t pmix_gds_hash_process_session_array(pmix_value_t *val, pmix_job_t
     pmix_session_t *s = NULL, *sptr;
     size_t j, size;
     pmix_info_t *iptr;
-    pmix_list_t cache, ncache;
+    pmix_list_t cache;
+    pmix_nodelist_t ncache;
     pmix_status_t rc;
     pmix_kval_t *kp2;
     pmix_nodeinfo_t *nd;
@@ -473,14 +464,14 @@ pmix_status_t pmix_gds_hash_process_session_array(pmix_value_t *val, pmix_job_t
     iptr = (pmix_info_t *) val->data.darray->array;
 
     PMIX_CONSTRUCT(&cache, pmix_list_t);
-    PMIX_CONSTRUCT(&ncache, pmix_list_t);
+    PMIX_CONSTRUCT(&ncache, pmix_nodelist_t);
     for (j = 0; j < size; j++) {
         if (PMIX_CHECK_KEY(&iptr[j], PMIX_SESSION_ID)) {
             PMIX_VALUE_GET_NUMBER(rc, &iptr[j].value, sid, uint32_t);
             if (PMIX_SUCCESS != rc) {
                 PMIX_ERROR_LOG(rc);
                 PMIX_LIST_DESTRUCT(&cache);
-                PMIX_LIST_DESTRUCT(&ncache);
+                PMIX_LIST_DESTRUCT(&ncache.super);
                 return rc;
             }
             /* see if we already have this session - it could have
@@ -501,7 +492,7 @@ pmix_status_t pmix_gds_hash_process_session_array(pmix_value_t *val, pmix_job_t
             if (PMIX_SUCCESS != (rc = pmix_gds_hash_process_node_array(&iptr[j].value, &ncache))) {
                 PMIX_ERROR_LOG(rc);
                 PMIX_LIST_DESTRUCT(&cache);
-                PMIX_LIST_DESTRUCT(&ncache);
+                PMIX_LIST_DESTRUCT(&ncache.super);
                 return rc;
             }
         } else {
@@ -513,7 +504,7 @@ pmix_status_t pmix_gds_hash_process_session_array(pmix_value_t *val, pmix_job_t
                 PMIX_ERROR_LOG(rc);
                 PMIX_RELEASE(kp2);
                 PMIX_LIST_DESTRUCT(&cache);
-                PMIX_LIST_DESTRUCT(&ncache);
+                PMIX_LIST_DESTRUCT(&ncache.super);
                 return rc;
             }
             pmix_list_append(&cache, &kp2->super);
@@ -523,7 +514,7 @@ pmix_status_t pmix_gds_hash_process_session_array(pmix_value_t *val, pmix_job_t
         /* this is not allowed to happen - they are required
          * to provide us with a session ID per the standard */
         PMIX_LIST_DESTRUCT(&cache);
-        PMIX_LIST_DESTRUCT(&ncache);
+        PMIX_LIST_DESTRUCT(&ncache.super);
         rc = PMIX_ERR_BAD_PARAM;
         PMIX_ERROR_LOG(rc);
         return rc;
@@ -541,11 +532,11 @@ pmix_status_t pmix_gds_hash_process_session_array(pmix_value_t *val, pmix_job_t
         kp2 = (pmix_kval_t *) pmix_list_remove_first(&cache);
     }
     PMIX_LIST_DESTRUCT(&cache);
-    nd = (pmix_nodeinfo_t *) pmix_list_remove_first(&ncache);
+    nd = (pmix_nodeinfo_t *) pmix_list_remove_first(&ncache.super);
     while (NULL != nd) {
-        pmix_list_append(&s->nodeinfo, &nd->super);
-        nd = (pmix_nodeinfo_t *) pmix_list_remove_first(&ncache);
+        pmix_gds_hash_add_node(&s->nodeinfo, nd);
+        nd = (pmix_nodeinfo_t *) pmix_list_remove_first(&ncache.super);
     }
-    PMIX_LIST_DESTRUCT(&ncache);
+    PMIX_LIST_DESTRUCT(&ncache.super);
     return PMIX_SUCCESS;
 }
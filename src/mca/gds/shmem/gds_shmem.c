@@ -21,7 +21,9 @@
 #include "gds_shmem_utils.h"
 #include "gds_shmem.h"
 
+#include "src/include/pmix_atomic.h"
 #include "src/include/pmix_globals.h"
+#include "src/include/pmix_stdint.h"
 #include "src/class/pmix_list.h"
 #include "src/client/pmix_client_ops.h"
 #include "src/server/pmix_server_ops.h"
@@ -31,6 +33,7 @@
 #include "src/util/pmix_name_fns.h"
 #include "src/util/pmix_environ.h"
 #include "src/util/pmix_shmem.h"
+#include "src/util/pmix_string_copy.h"
 
 #ifdef HAVE_STRING_H
 #include <string.h>
@@ -64,53 +67,11 @@ do {                                                                           \
                         "gds:" PMIX_GDS_SHMEM_NAME ":" __VA_ARGS__);           \
 } while (0)
 
-#define PMIX_GDS_SHMEM_MALLOC_ALIGN(p, s)                                      \
-    (uint8_t *)(p) + (((s) + 8UL - 1) & ~(8UL - 1))
-/*
- * TODO(skg) Think about reallocs. Pointer arrays may change size.
- * TODO(skg) We don't know how big this will thing will be.
- * * Can do a two-step process; in memory; get size; copy into sm.
- * * On the client side need to write locally. Server as well.
- * * Try to avoid thread locks, too expensive at scale.
- * * Work on getting data stored. Cache will go into hash. Use register job
- *   info.
+/**
+ * Key of the marker sent in place of the job info when a client's job info is
+ * available in a shared-memory segment.
  */
-
-#if 0
-static void *
-tma_shmem_malloc(
-    pmix_tma_t *tma,
-    size_t length
-) {
-    void *current = tma->data;
-    tma->data = PMIX_GDS_SHMEM_MALLOC_ALIGN(tma->data, length);
-    return current;
-}
-#endif
-
-static void
-session_construct(
-    pmix_gds_shmem_session_t *s
-) {
-    s->session = UINT32_MAX;
-    PMIX_CONSTRUCT(&s->sessioninfo, pmix_list_t);
-    PMIX_CONSTRUCT(&s->nodeinfo, pmix_list_t);
-}
-
-static void
-session_destruct(
-    pmix_gds_shmem_session_t *s
-) {
-    PMIX_LIST_DESTRUCT(&s->sessioninfo);
-    PMIX_LIST_DESTRUCT(&s->nodeinfo);
-}
-
-PMIX_CLASS_INSTANCE(
-    pmix_gds_shmem_session_t,
-    pmix_list_item_t,
-    session_construct,
-    session_destruct
-);
+#define PMIX_GDS_SHMEM_SEG_KEY "pmix.gds.shmem.seg"
 
 static void
 job_construct(
@@ -119,7 +80,11 @@ job_construct(
     p->ns = NULL;
     p->shmem = PMIX_NEW(pmix_shmem_t);
     p->nptr = NULL;
-    p->session = NULL;
+    p->seg = NULL;
+    p->bfrops = NULL;
+    p->modex = NULL;
+    p->modex_seg = NULL;
+    p->modex_gen = 0;
 }
 
 static void
@@ -127,9 +92,14 @@ job_destruct(
     pmix_gds_shmem_job_t *p
 ) {
     free(p->ns);
+    // Detaches and, if we created it, removes the segment.
     PMIX_RELEASE(p->shmem);
-    PMIX_RELEASE(p->nptr);
-    PMIX_RELEASE(p->session);
+    if (p->modex) {
+        PMIX_RELEASE(p->modex);
+    }
+    if (p->nptr) {
+        PMIX_RELEASE(p->nptr);
+    }
 }
 
 PMIX_CLASS_INSTANCE(
@@ -139,6 +109,28 @@ PMIX_CLASS_INSTANCE(
     job_destruct
 );
 
+static void
+modex_proc_construct(
+    pmix_gds_shmem_modex_proc_t *p
+) {
+    p->rank = PMIX_RANK_UNDEF;
+    PMIX_CONSTRUCT(&p->kvs, pmix_list_t);
+}
+
+static void
+modex_proc_destruct(
+    pmix_gds_shmem_modex_proc_t *p
+) {
+    PMIX_LIST_DESTRUCT(&p->kvs);
+}
+
+PMIX_CLASS_INSTANCE(
+    pmix_gds_shmem_modex_proc_t,
+    pmix_list_item_t,
+    modex_proc_construct,
+    modex_proc_destruct
+);
+
 static pmix_status_t
 init(
     pmix_info_t info[],
@@ -158,10 +150,119 @@ finalize(void)
 }
 
 /**
- * Note: only clients enter here.
+ * Maps the segment named in our environment and makes it available to the
+ * namespace it describes. Note: only clients enter here.
+ */
+static pmix_status_t
+client_attach_segment(
+    const char *path,
+    const char *addr
+) {
+    pmix_status_t rc = PMIX_SUCCESS;
+    pmix_gds_shmem_job_t *job = NULL;
+    pmix_shmem_t *shmem = NULL;
+    uintptr_t mmap_addr = 0;
+
+    // The hint is only a preference: the segment is position independent.
+    size_t base_addr = (size_t)strtoull(addr, NULL, 16);
+
+    shmem = PMIX_NEW(pmix_shmem_t);
+    if (!shmem) {
+        return PMIX_ERR_NOMEM;
+    }
+    pmix_string_copy(shmem->backing_path, path, PMIX_PATH_MAX);
+    rc = pmix_shmem_segment_attach(
+        shmem, (void *)base_addr, PMIX_SHMEM_RDONLY, &mmap_addr
+    );
+    if (PMIX_SUCCESS != rc) {
+        goto out;
+    }
+    pmix_gds_shmem_seg_hdr_t *hdr = (pmix_gds_shmem_seg_hdr_t *)mmap_addr;
+    if (!pmix_gds_shmem_seg_valid(hdr, shmem->size)) {
+        rc = PMIX_ERR_BAD_PARAM;
+        goto out;
+    }
+    rc = pmix_gds_shmem_get_job_tracker(hdr->nspace, true, &job);
+    if (PMIX_SUCCESS != rc) {
+        goto out;
+    }
+    PMIX_RELEASE(job->shmem);
+    job->shmem = shmem;
+    job->seg = hdr;
+    shmem = NULL;
+    PMIX_GDS_SHMEM_VOUT(
+        "%s: attached to %s at address=%zx", __func__, path, (size_t)mmap_addr
+    );
+out:
+    if (shmem) {
+        PMIX_RELEASE(shmem);
+    }
+    return rc;
+}
+
+/**
+ * Maps the namespace's current modex segment if the server has replaced it
+ * since we last looked. Note: only clients enter here.
+ */
+static void
+client_update_modex(
+    pmix_gds_shmem_job_t *job
+) {
+    const pmix_gds_shmem_seg_hdr_t *hdr = job->seg;
+    char path[PMIX_PATH_MAX];
+    uintptr_t mmap_addr = 0;
+
+    const uint64_t gen = hdr->modex_gen;
+    pmix_atomic_rmb();
+    // Unchanged, or in the middle of an update: keep what we have.
+    if (gen == job->modex_gen || 0 != (gen & 1)) {
+        return;
+    }
+    pmix_string_copy(path, hdr->modex_path, sizeof(path));
+    pmix_atomic_rmb();
+    if (gen != hdr->modex_gen) {
+        return;
+    }
+    if (job->modex) {
+        PMIX_RELEASE(job->modex);
+        job->modex = NULL;
+        job->modex_seg = NULL;
+    }
+    job->modex_gen = gen;
+    if ('\0' == path[0]) {
+        return;
+    }
+    pmix_shmem_t *modex = PMIX_NEW(pmix_shmem_t);
+    if (!modex) {
+        return;
+    }
+    pmix_string_copy(modex->backing_path, path, PMIX_PATH_MAX);
+    // The server may already have replaced it, in which case we ask it.
+    if (PMIX_SUCCESS != pmix_shmem_segment_attach(
+            modex, NULL, PMIX_SHMEM_RDONLY, &mmap_addr)) {
+        PMIX_RELEASE(modex);
+        return;
+    }
+    pmix_gds_shmem_seg_hdr_t *mhdr = (pmix_gds_shmem_seg_hdr_t *)mmap_addr;
+    if (!pmix_gds_shmem_seg_valid(mhdr, modex->size)
+        || !PMIX_CHECK_NSPACE(mhdr->nspace, job->ns)) {
+        PMIX_RELEASE(modex);
+        return;
+    }
+    job->modex = modex;
+    job->modex_seg = mhdr;
+    PMIX_GDS_SHMEM_VOUT(
+        "%s: attached to modex generation %" PRIu64 " at %s",
+        __func__, gen, path
+    );
+}
+
+/**
+ * Clients select us only if they can attach to the segment their server made
+ * for them. Servers select us for any peer that asks for us by name.
  */
 static pmix_status_t
-client_assign_module(
+assign_module(
     pmix_info_t *info,
     size_t ninfo,
     int *priority
@@ -198,6 +299,18 @@ client_assign_module(
         *priority = 0;
         return PMIX_SUCCESS;
     }
+    // Without hash we have nowhere to keep everything else.
+    if (!pmix_gds_shmem_hash_module()) {
+        *priority = 0;
+        return PMIX_SUCCESS;
+    }
+    // A client chose us: serve it.
+    if (PMIX_PEER_IS_SERVER(pmix_globals.mypeer)) {
+        if (!specified) {
+            *priority = 0;
+        }
+        return PMIX_SUCCESS;
+    }
     // Else we are a candidate for use.
     // Look for the shared-memory segment connection environment variables: If
     // found, then we can connect to the segment. Otherwise, we have to reject.
@@ -209,25 +322,30 @@ client_assign_module(
     }
     PMIX_GDS_SHMEM_VOUT("%s found path=%s", __func__, path);
     PMIX_GDS_SHMEM_VOUT("%s found addr=%s", __func__, addr);
+    // Attach once, on first selection.
+    pmix_gds_shmem_job_t *job;
+    PMIX_LIST_FOREACH (job, &pmix_mca_gds_shmem_component.myjobs, pmix_gds_shmem_job_t) {
+        if (job->seg) {
+            return PMIX_SUCCESS;
+        }
+    }
+    if (PMIX_SUCCESS != client_attach_segment(path, addr)) {
+        *priority = 0;
+    }
     return PMIX_SUCCESS;
 }
 
-/**
- * @note: only servers enter here.
- * At this moment we aren't called since hash has a higher priority.
- */
 static pmix_status_t
 server_cache_job_info(
     struct pmix_namespace_t *ns,
     pmix_info_t info[],
     size_t ninfo
 ) {
-    PMIX_GDS_SHMEM_UNUSED(ns);
-    PMIX_GDS_SHMEM_UNUSED(info);
-    PMIX_GDS_SHMEM_UNUSED(ninfo);
-
-    PMIX_GDS_SHMEM_VOUT_HERE();
-    return PMIX_SUCCESS;
+    pmix_gds_base_module_t *hash = pmix_gds_shmem_hash_module();
+    if (!hash) {
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+    return hash->cache_job_info(ns, info, ninfo);
 }
 
 static pmix_status_t
@@ -235,54 +353,181 @@ server_register_job_info(
     struct pmix_peer_t *pr,
     pmix_buffer_t *reply
 ) {
-    // TODO(skg) GDS_GET pass own peer to get info; cache in sm.
-    PMIX_GDS_SHMEM_UNUSED(pr);
-    PMIX_GDS_SHMEM_UNUSED(reply);
+    pmix_status_t rc = PMIX_SUCCESS;
+    pmix_peer_t *peer = (pmix_peer_t *)pr;
 
-    PMIX_GDS_SHMEM_VOUT_HERE();
-    /* Since the data is already in the shmem when we
-     * cached it, there is nothing to do here. */
-    return PMIX_SUCCESS;
+    if (!PMIX_PEER_IS_SERVER(pmix_globals.mypeer)
+        && !PMIX_PEER_IS_LAUNCHER(pmix_globals.mypeer)) {
+        // This function is only available on servers.
+        PMIX_ERROR_LOG(PMIX_ERR_NOT_SUPPORTED);
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+    pmix_gds_shmem_job_t *job = NULL;
+    rc = pmix_gds_shmem_get_job_tracker(peer->nptr->nspace, false, &job);
+    if (PMIX_SUCCESS != rc || !job->shmem->base_address) {
+        // No segment for this job, so ship the job info the usual way.
+        pmix_gds_base_module_t *hash = pmix_gds_shmem_hash_module();
+        if (!hash) {
+            return PMIX_ERR_NOT_SUPPORTED;
+        }
+        return hash->register_job_info(pr, reply);
+    }
+    PMIX_GDS_SHMEM_VOUT(
+        "%s: job info for %s is in %s", __func__,
+        peer->nptr->nspace, job->shmem->backing_path
+    );
+    // The job info is already in the segment: all the client
+    // needs to hear is that it should look there.
+    char *msg = peer->nptr->nspace;
+    PMIX_BFROPS_PACK(rc, peer, reply, &msg, 1, PMIX_STRING);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    pmix_kval_t kv;
+    PMIX_CONSTRUCT(&kv, pmix_kval_t);
+    kv.key = PMIX_GDS_SHMEM_SEG_KEY;
+    kv.value = (pmix_value_t *)malloc(sizeof(pmix_value_t));
+    if (!kv.value) {
+        return PMIX_ERR_NOMEM;
+    }
+    PMIX_VALUE_LOAD(kv.value, job->shmem->backing_path, PMIX_STRING);
+    PMIX_BFROPS_PACK(rc, peer, reply, &kv, 1, PMIX_KVAL);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+    }
+    kv.key = NULL;
+    PMIX_DESTRUCT(&kv);
+    return rc;
 }
 
+/**
+ * Note: only clients enter here.
+ */
 static pmix_status_t
 store_job_info(
     const char *nspace,
     pmix_buffer_t *buf
 ) {
-    PMIX_GDS_SHMEM_UNUSED(nspace);
-    PMIX_GDS_SHMEM_UNUSED(buf);
+    pmix_status_t rc = PMIX_SUCCESS;
+    pmix_gds_base_module_t *hash = pmix_gds_shmem_hash_module();
+    if (!hash) {
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+    // Peek at the first value to see if it is our marker.
+    char *unpack_ptr = buf->unpack_ptr;
+    int32_t cnt = 1;
+    pmix_kval_t *kv = PMIX_NEW(pmix_kval_t);
+    if (!kv) {
+        return PMIX_ERR_NOMEM;
+    }
+    PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver, buf, kv, &cnt, PMIX_KVAL);
+    if (PMIX_SUCCESS != rc || !PMIX_CHECK_KEY(kv, PMIX_GDS_SHMEM_SEG_KEY)) {
+        PMIX_RELEASE(kv);
+        buf->unpack_ptr = unpack_ptr;
+        return hash->store_job_info(nspace, buf);
+    }
+    PMIX_RELEASE(kv);
 
-    PMIX_GDS_SHMEM_VOUT_HERE();
+    pmix_gds_shmem_job_t *job = NULL;
+    rc = pmix_gds_shmem_get_job_tracker(nspace, false, &job);
+    if (PMIX_SUCCESS != rc || !job->seg) {
+        // Should never happen: the server only sends the marker
+        // to peers that selected us, which requires a segment.
+        rc = PMIX_ERR_NOT_AVAILABLE;
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    job->bfrops = pmix_bfrops_base_assign_module(job->seg->bfrops);
+    if (!job->bfrops) {
+        rc = PMIX_ERR_NOT_SUPPORTED;
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    if (0 == job->nptr->nprocs) {
+        job->nptr->nprocs = job->seg->nprocs;
+    }
+    PMIX_GDS_SHMEM_VOUT(
+        "%s: job info for %s found in shared memory", __func__, nspace
+    );
     return PMIX_SUCCESS;
 }
 
-static pmix_status_t
-store(
-    const pmix_proc_t *proc,
-    pmix_scope_t scope,
-    pmix_kval_t *kv
+/**
+ * Makes the given modex segment (or none, if NULL) the job's current one.
+ * Note: only servers enter here.
+ */
+static void
+server_set_modex(
+    pmix_gds_shmem_job_t *job,
+    pmix_shmem_t *modex
 ) {
-    PMIX_GDS_SHMEM_UNUSED(proc);
-    PMIX_GDS_SHMEM_UNUSED(scope);
-    PMIX_GDS_SHMEM_UNUSED(kv);
+    pmix_gds_shmem_seg_hdr_t *hdr = job->shmem->base_address;
 
-    PMIX_GDS_SHMEM_VOUT_HERE();
-    return PMIX_SUCCESS;
+    if (NULL == hdr || (NULL == modex && NULL == job->modex)) {
+        return;
+    }
+    // Readers only ever see a complete path under an even generation.
+    hdr->modex_gen++;
+    pmix_atomic_wmb();
+    pmix_string_copy(hdr->modex_path, modex ? modex->backing_path : "",
+                     sizeof(hdr->modex_path));
+    pmix_atomic_wmb();
+    hdr->modex_gen++;
+    // Clients that still have the previous one mapped keep their mapping.
+    if (job->modex) {
+        PMIX_RELEASE(job->modex);
+    }
+    job->modex = modex;
+    PMIX_GDS_SHMEM_VOUT(
+        "%s: %s modex generation %" PRIu64 " at %s", __func__,
+        job->ns, hdr->modex_gen, hdr->modex_path
+    );
 }
 
-static pmix_status_t
-store_modex(
-    struct pmix_namespace_t *ns,
-    pmix_buffer_t *buff,
-    void *cbdata
+/**
+ * Stops serving the given rank from the job's modex segment, so its local
+ * peers ask us for its data instead. Note: only servers enter here.
+ */
+static void
+server_drop_modex_rank(
+    pmix_gds_shmem_job_t *job,
+    pmix_rank_t rank
 ) {
-    PMIX_GDS_SHMEM_UNUSED(ns);
-    PMIX_GDS_SHMEM_UNUSED(buff);
-    PMIX_GDS_SHMEM_UNUSED(cbdata);
+    pmix_gds_shmem_seg_hdr_t *hdr;
 
-    PMIX_GDS_SHMEM_VOUT_HERE();
-    return PMIX_SUCCESS;
+    if (NULL == job->modex) {
+        return;
+    }
+    hdr = job->modex->base_address;
+    if (rank < hdr->nranks) {
+        ((volatile uint64_t *)PMIX_GDS_SHMEM_SEG_PTR(hdr, hdr->rankdir))[rank] = 0;
+        return;
+    }
+    // Not in the rank directory, so we can only withdraw it all.
+    server_set_modex(job, NULL);
+}
+
+static pmix_status_t
+store(
+    const pmix_proc_t *proc,
+    pmix_scope_t scope,
+    pmix_kval_t *kv
+) {
+    pmix_gds_base_module_t *hash = pmix_gds_shmem_hash_module();
+    if (!hash) {
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+    // The modex segment only holds the non-internal data of
+    // individual procs: nothing else can make it stale.
+    if (PMIX_PEER_IS_SERVER(pmix_globals.mypeer) && PMIX_INTERNAL != scope
+        && PMIX_RANK_IS_VALID(proc->rank)) {
+        pmix_gds_shmem_job_t *job = NULL;
+        if (PMIX_SUCCESS == pmix_gds_shmem_get_job_tracker(proc->nspace, false, &job)) {
+            server_drop_modex_rank(job, proc->rank);
+        }
+    }
+    return hash->store(proc, scope, kv);
 }
 
 static pmix_status_t
@@ -295,16 +540,39 @@ fetch(
     size_t nqual,
     pmix_list_t *kvs
 ) {
-    PMIX_GDS_SHMEM_UNUSED(proc);
-    PMIX_GDS_SHMEM_UNUSED(scope);
-    PMIX_GDS_SHMEM_UNUSED(copy);
-    PMIX_GDS_SHMEM_UNUSED(key);
-    PMIX_GDS_SHMEM_UNUSED(qualifiers);
-    PMIX_GDS_SHMEM_UNUSED(nqual);
-    PMIX_GDS_SHMEM_UNUSED(kvs);
+    pmix_status_t rc = PMIX_SUCCESS;
+    pmix_gds_shmem_job_t *job = NULL;
+    bool have_seg = false;
 
-    PMIX_GDS_SHMEM_VOUT_HERE();
-    return PMIX_SUCCESS;
+    rc = pmix_gds_shmem_get_job_tracker(proc->nspace, false, &job);
+    if (PMIX_SUCCESS == rc && job->seg && job->bfrops) {
+        have_seg = true;
+        rc = pmix_gds_shmem_seg_fetch(
+            job, proc, scope, key, qualifiers, nqual, kvs
+        );
+        // All of a proc's data includes what it contributed to the modex.
+        if (!PMIX_PEER_IS_SERVER(pmix_globals.mypeer)
+            && (PMIX_ERR_NOT_FOUND == rc || (PMIX_SUCCESS == rc && NULL == key))) {
+            client_update_modex(job);
+            if (PMIX_SUCCESS == pmix_gds_shmem_modex_fetch(job, proc, scope, key, kvs)) {
+                rc = PMIX_SUCCESS;
+            }
+        }
+        if (PMIX_ERR_NOT_FOUND != rc) {
+            return rc;
+        }
+    }
+    // Not in the segment: try what we keep in hash.
+    pmix_gds_base_module_t *hash = pmix_gds_shmem_hash_module();
+    if (!hash) {
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+    rc = hash->fetch(proc, scope, copy, key, qualifiers, nqual, kvs);
+    if (have_seg && PMIX_ERR_INVALID_NAMESPACE == rc) {
+        // We know the namespace, just not this value.
+        rc = PMIX_ERR_NOT_FOUND;
+    }
+    return rc;
 }
 
 static pmix_status_t
@@ -317,9 +585,12 @@ server_setup_fork(
     pmix_status_t rc = PMIX_SUCCESS;
     // Get the tracker for this job.
     pmix_gds_shmem_job_t *job = NULL;
-    rc = pmix_gds_shmem_get_job_tracker(peer->nspace, &job);
-    if (PMIX_SUCCESS != rc) {
-        return rc;
+    rc = pmix_gds_shmem_get_job_tracker(peer->nspace, false, &job);
+    if (PMIX_SUCCESS != rc || !job->shmem->base_address) {
+        // Make sure nothing inherited points the child at a stale segment.
+        (void)pmix_unsetenv(PMIX_GDS_SHMEM_ENVVAR_SEG_PATH, env);
+        (void)pmix_unsetenv(PMIX_GDS_SHMEM_ENVVAR_SEG_ADDR, env);
+        return PMIX_ERR_NOT_AVAILABLE;
     }
 
     pmix_shmem_t *shmem = job->shmem;
@@ -356,34 +627,14 @@ server_setup_fork(
 }
 
 static pmix_status_t
-get_estimated_segment_size(
-    const char *nspace,
-    uint32_t nlocalprocs,
-    pmix_info_t info[],
-    size_t ninfo,
-    size_t *segment_size
-) {
-    PMIX_GDS_SHMEM_UNUSED(nspace);
-    PMIX_GDS_SHMEM_UNUSED(nlocalprocs);
-    PMIX_GDS_SHMEM_UNUSED(info);
-    PMIX_GDS_SHMEM_UNUSED(ninfo);
-    // Calculate a rough (upper bound) estimate on the amount of storage
-    // required to store the values associated with this namespace.
-    // TODO(skg) Implement.
-    *segment_size = 1024 << 20;
-    PMIX_GDS_SHMEM_VOUT(
-        "%s: determined required segment size of %zd B", __func__, *segment_size
-    );
-    return PMIX_SUCCESS;
-}
-
-static const char *
 get_shmem_backing_path(
     pmix_info_t info[],
-    size_t ninfo
+    size_t ninfo,
+    char *path,
+    size_t path_size
 ) {
-    static char path[PMIX_PATH_MAX];
-    static const char *basedir = NULL;
+    static unsigned int nsegments = 0;
+    const char *basedir = NULL;
 
     for (size_t i = 0; i < ninfo; ++i) {
         if (0 == strcmp(PMIX_NSDIR, info[i].key)) {
@@ -395,28 +646,31 @@ get_shmem_backing_path(
             break;
         }
     }
+    if (!basedir) {
+        basedir = pmix_server_globals.tmpdir;
+    }
     if (!basedir) {
         if (NULL == (basedir = getenv("TMPDIR"))) {
             basedir = "/tmp";
         }
     }
-    // Now that we have the base dir, append file name.
+    // Now that we have the base dir, append a file name unique to
+    // this server and segment.
     int nw = snprintf(
-        path, PMIX_PATH_MAX, "%s/gds-%s.%d",
-        basedir, PMIX_GDS_SHMEM_NAME, getpid()
+        path, path_size, "%s/gds-%s.%d.%u",
+        basedir, PMIX_GDS_SHMEM_NAME, getpid(), nsegments++
     );
-    if (nw >= PMIX_PATH_MAX) {
-        // Best we can do. Sorry.
-        return basedir;
+    if (nw < 0 || (size_t)nw >= path_size) {
+        return PMIX_ERR_BAD_PARAM;
     }
-    return path;
+    return PMIX_SUCCESS;
 }
 
 static pmix_status_t
 segment_create(
     pmix_info_t info[],
     size_t ninfo,
-    pmix_gds_shmem_job_t *job,
+    pmix_shmem_t *shmem,
     size_t size
 ) {
     pmix_status_t rc = PMIX_SUCCESS;
@@ -430,17 +684,23 @@ segment_create(
         "%s: found vmhole at address=%zx", __func__, base_addr
     );
     // Find a unique path for the shared-memory backing file.
-    const char *segment_path = get_shmem_backing_path(info, ninfo);
+    char segment_path[PMIX_PATH_MAX];
+    rc = get_shmem_backing_path(info, ninfo, segment_path, sizeof(segment_path));
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
     PMIX_GDS_SHMEM_VOUT(
         "%s: segment backing file path is %s", __func__, segment_path
     );
     // Create the shared-memory segment with the given address.
-    rc = pmix_shmem_segment_create(job->shmem, size, segment_path);
+    rc = pmix_shmem_segment_create(shmem, size, segment_path);
     if (PMIX_SUCCESS != rc) {
         return rc;
     }
     uintptr_t mmap_addr = 0;
-    rc = pmix_shmem_segment_attach(job->shmem, (void *)base_addr, &mmap_addr);
+    rc = pmix_shmem_segment_attach(
+        shmem, (void *)base_addr, PMIX_SHMEM_RDWR, &mmap_addr
+    );
     if (PMIX_SUCCESS != rc) {
         return rc;
     }
@@ -450,6 +710,9 @@ segment_create(
     return rc;
 }
 
+/**
+ * Note: only servers enter here, after the job info has been cached.
+ */
 static pmix_status_t
 server_add_nspace(
     const char *nspace,
@@ -463,32 +726,281 @@ server_add_nspace(
         "%s: adding namespace=%s with nlocalprocs=%d",
         __func__, nspace, nlocalprocs
     );
-    // Get the shared-memory segment size. Mas o menos.
-    size_t segment_size = 0;
-    rc = get_estimated_segment_size(
-        nspace, nlocalprocs,
-        info, ninfo, &segment_size
-    );
+    // Nobody local to share it with.
+    if (!PMIX_PEER_IS_SERVER(pmix_globals.mypeer) || 0 == nlocalprocs) {
+        return PMIX_SUCCESS;
+    }
+    // Collect the complete job-level info we cached for this namespace.
+    pmix_proc_t wildcard;
+    PMIX_LOAD_PROCID(&wildcard, nspace, PMIX_RANK_WILDCARD);
+    pmix_cb_t cb;
+    PMIX_CONSTRUCT(&cb, pmix_cb_t);
+    cb.proc = &wildcard;
+    cb.scope = PMIX_INTERNAL;
+    cb.copy = false;
+    PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
     if (PMIX_SUCCESS != rc) {
-        return rc;
+        // Nothing to share: clients get whatever exists the usual way.
+        PMIX_DESTRUCT(&cb);
+        return PMIX_SUCCESS;
     }
     // Create a job tracker.
     pmix_gds_shmem_job_t *job = NULL;
-    rc = pmix_gds_shmem_get_job_tracker(nspace, &job);
+    rc = pmix_gds_shmem_get_job_tracker(nspace, true, &job);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_DESTRUCT(&cb);
+        return rc;
+    }
+    // Lay out the segment in private memory first, so we know its size.
+    uint8_t *image = NULL;
+    size_t image_size = 0;
+    rc = pmix_gds_shmem_build_image(job, &cb.kvs, &image, &image_size);
+    PMIX_DESTRUCT(&cb);
     if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
         return rc;
     }
     // Create the shared-memory segment; update job tracker.
-    return segment_create(info, ninfo, job, segment_size);
+    rc = segment_create(info, ninfo, job->shmem, image_size);
+    if (PMIX_SUCCESS == rc) {
+        memcpy(job->shmem->base_address, image, image_size);
+    } else {
+        // Not fatal: we just won't offer a segment for this job.
+        PMIX_RELEASE(job->shmem);
+        job->shmem = PMIX_NEW(pmix_shmem_t);
+        rc = PMIX_SUCCESS;
+    }
+    free(image);
+    return rc;
+}
+
+/**
+ * Collects what we would hand a local client of the same namespace that
+ * asked us for the given rank's data. Returns NULL if we have none.
+ */
+static pmix_gds_shmem_modex_proc_t *
+server_get_modex_proc(
+    pmix_gds_shmem_job_t *job,
+    pmix_rank_t rank,
+    bool local
+) {
+    pmix_status_t rc;
+    pmix_gds_shmem_modex_proc_t *p = NULL;
+    pmix_kval_t *kv;
+    pmix_proc_t proc;
+    pmix_cb_t cb;
+
+    PMIX_LOAD_PROCID(&proc, job->ns, rank);
+    PMIX_CONSTRUCT(&cb, pmix_cb_t);
+    cb.proc = &proc;
+    cb.scope = local ? PMIX_LOCAL : PMIX_REMOTE;
+    cb.copy = false;
+    PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
+    if (PMIX_SUCCESS == rc) {
+        p = PMIX_NEW(pmix_gds_shmem_modex_proc_t);
+        p->rank = rank;
+        while (NULL != (kv = (pmix_kval_t *)pmix_list_remove_first(&cb.kvs))) {
+            pmix_list_append(&p->kvs, &kv->super);
+        }
+    }
+    PMIX_DESTRUCT(&cb);
+    return p;
+}
+
+/**
+ * Appends the data of every rank of the job that took part in the fence to
+ * the job's modex segment. Returns PMIX_ERR_OUT_OF_RESOURCE if it did not
+ * fit. Note: only servers enter here.
+ */
+static pmix_status_t
+server_update_modex(
+    pmix_gds_shmem_job_t *job,
+    pmix_server_trkr_t *trk,
+    const bool *local
+) {
+    pmix_status_t rc;
+    pmix_gds_shmem_modex_proc_t *p;
+    pmix_rank_t first, last;
+    const pmix_gds_shmem_seg_hdr_t *hdr = job->modex->base_address;
+
+    for (size_t n = 0; n < trk->npcs; n++) {
+        if (!PMIX_CHECK_NSPACE(trk->pcs[n].nspace, job->ns)) {
+            continue;
+        }
+        if (PMIX_RANK_WILDCARD == trk->pcs[n].rank) {
+            first = 0;
+            last = hdr->nranks;
+        } else if (trk->pcs[n].rank < hdr->nranks) {
+            first = trk->pcs[n].rank;
+            last = first + 1;
+        } else {
+            // Only ranks in the directory can be replaced.
+            return PMIX_ERR_OUT_OF_RESOURCE;
+        }
+        for (pmix_rank_t r = first; r < last; r++) {
+            p = server_get_modex_proc(job, r, local[r]);
+            if (NULL == p) {
+                continue;
+            }
+            rc = pmix_gds_shmem_modex_append(job, r, &p->kvs);
+            PMIX_RELEASE(p);
+            if (PMIX_SUCCESS != rc) {
+                return rc;
+            }
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+/**
+ * Replaces the namespace's modex segment with one holding, for every rank,
+ * what we would hand a local client of the same namespace that asked us for
+ * it. Note: only servers enter here.
+ */
+static pmix_status_t
+server_build_modex(
+    pmix_gds_shmem_job_t *job,
+    const bool *local
+) {
+    pmix_status_t rc = PMIX_SUCCESS;
+    pmix_shmem_t *modex = NULL;
+    pmix_list_t procs;
+    pmix_gds_shmem_modex_proc_t *p;
+    uint8_t *image = NULL;
+    size_t image_size = 0;
+
+    PMIX_CONSTRUCT(&procs, pmix_list_t);
+    for (pmix_rank_t r = 0; r < job->nptr->nprocs; r++) {
+        p = server_get_modex_proc(job, r, local[r]);
+        if (NULL != p) {
+            pmix_list_append(&procs, &p->super);
+        }
+    }
+    rc = pmix_gds_shmem_build_modex_image(job, &procs, &image, &image_size);
+    if (PMIX_SUCCESS != rc) {
+        goto out;
+    }
+    modex = PMIX_NEW(pmix_shmem_t);
+    if (NULL == modex) {
+        rc = PMIX_ERR_NOMEM;
+        goto out;
+    }
+    // Leave as much room again for the fences to come.
+    rc = segment_create(NULL, 0, modex, 2 * image_size);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_RELEASE(modex);
+        modex = NULL;
+        goto out;
+    }
+    memcpy(modex->base_address, image, image_size);
+    ((pmix_gds_shmem_seg_hdr_t *)modex->base_address)->size = 2 * image_size;
+out:
+    free(image);
+    PMIX_LIST_DESTRUCT(&procs);
+    // Never leave the previous fence's data in place of this one's.
+    server_set_modex(job, modex);
+    job->modex_used = (NULL == modex) ? 0 : image_size;
+    return rc;
+}
+
+/**
+ * Brings the namespace's modex segment up to date with what the fence
+ * collected: the data of its participants is appended to the current segment
+ * if there is room, else a new segment is built. Note: only servers enter
+ * here.
+ */
+static pmix_status_t
+server_publish_modex(
+    pmix_gds_shmem_job_t *job,
+    pmix_server_trkr_t *trk
+) {
+    pmix_status_t rc = PMIX_ERR_OUT_OF_RESOURCE;
+    pmix_rank_info_t *info;
+    const uint32_t nprocs = job->nptr->nprocs;
+
+    bool *local = calloc(nprocs + 1, sizeof(bool));
+    if (NULL == local) {
+        server_set_modex(job, NULL);
+        return PMIX_ERR_NOMEM;
+    }
+    PMIX_LIST_FOREACH (info, &job->nptr->ranks, pmix_rank_info_t) {
+        if (info->pname.rank < nprocs) {
+            local[info->pname.rank] = true;
+        }
+    }
+    if (NULL != job->modex) {
+        rc = server_update_modex(job, trk, local);
+        if (PMIX_SUCCESS == rc) {
+            PMIX_GDS_SHMEM_VOUT(
+                "%s: %s modex segment has %zd of %" PRIu64 " B in use", __func__,
+                job->ns, job->modex_used,
+                ((pmix_gds_shmem_seg_hdr_t *)job->modex->base_address)->size
+            );
+        }
+    }
+    if (PMIX_SUCCESS != rc) {
+        rc = server_build_modex(job, local);
+    }
+    free(local);
+    return rc;
+}
+
+/**
+ * Everything goes to hash. Servers then also place what the fence collected
+ * for namespaces that have a job segment into a modex segment, so local
+ * clients can read each other's data without asking us for it.
+ */
+static pmix_status_t
+store_modex(
+    struct pmix_namespace_t *ns,
+    pmix_buffer_t *buff,
+    void *cbdata
+) {
+    pmix_status_t rc;
+    pmix_server_trkr_t *trk = (pmix_server_trkr_t *)cbdata;
+    pmix_nspace_caddy_t *nm;
+    pmix_gds_shmem_job_t *job;
+    pmix_gds_base_module_t *hash = pmix_gds_shmem_hash_module();
+    if (!hash) {
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+    rc = hash->store_modex(ns, buff, cbdata);
+    if (PMIX_SUCCESS != rc || !PMIX_PEER_IS_SERVER(pmix_globals.mypeer)) {
+        return rc;
+    }
+    PMIX_LIST_FOREACH (nm, &trk->nslist, pmix_nspace_caddy_t) {
+        job = NULL;
+        if (PMIX_SUCCESS != pmix_gds_shmem_get_job_tracker(nm->ns->nspace, false, &job)
+            || NULL == job->shmem->base_address) {
+            continue;
+        }
+        rc = server_publish_modex(job, trk);
+        if (PMIX_SUCCESS != rc) {
+            // Not fatal: clients will get the data from us instead.
+            PMIX_GDS_SHMEM_VOUT(
+                "%s: no modex segment for %s (%s)", __func__,
+                job->ns, PMIx_Error_string(rc)
+            );
+        }
+    }
+    return PMIX_SUCCESS;
 }
 
 static pmix_status_t
 del_nspace(
     const char *nspace
 ) {
-    PMIX_GDS_SHMEM_UNUSED(nspace);
-
-    PMIX_GDS_SHMEM_VOUT_HERE();
+    pmix_gds_shmem_job_t *job = NULL;
+    pmix_status_t rc = pmix_gds_shmem_get_job_tracker(nspace, false, &job);
+    if (PMIX_SUCCESS != rc) {
+        return PMIX_SUCCESS;
+    }
+    pmix_hash_table_remove_value_ptr(
+        &pmix_mca_gds_shmem_component.myjobs_index,
+        job->ns, strnlen(job->ns, PMIX_MAX_NSLEN)
+    );
+    pmix_list_remove_item(&pmix_mca_gds_shmem_component.myjobs, &job->super);
+    PMIX_RELEASE(job);
     return PMIX_SUCCESS;
 }
 
@@ -499,23 +1011,22 @@ assemb_kvs_req(
     pmix_buffer_t *bo,
     void *cbdata
 ) {
-    PMIX_GDS_SHMEM_UNUSED(proc);
-    PMIX_GDS_SHMEM_UNUSED(kvs);
-    PMIX_GDS_SHMEM_UNUSED(bo);
-    PMIX_GDS_SHMEM_UNUSED(cbdata);
-
-    PMIX_GDS_SHMEM_VOUT_HERE();
-    return PMIX_SUCCESS;
+    pmix_gds_base_module_t *hash = pmix_gds_shmem_hash_module();
+    if (!hash) {
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+    return hash->assemb_kvs_req(proc, kvs, bo, cbdata);
 }
 
 static pmix_status_t
 accept_kvs_resp(
     pmix_buffer_t *buf
 ) {
-    PMIX_GDS_SHMEM_UNUSED(buf);
-
-    PMIX_GDS_SHMEM_VOUT_HERE();
-    return PMIX_SUCCESS;
+    pmix_gds_base_module_t *hash = pmix_gds_shmem_hash_module();
+    if (!hash) {
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+    return hash->accept_kvs_resp(buf);
 }
 
 pmix_gds_base_module_t pmix_shmem_module = {
@@ -523,7 +1034,7 @@ pmix_gds_base_module_t pmix_shmem_module = {
     .is_tsafe = false,
     .init = init,
     .finalize = finalize,
-    .assign_module = client_assign_module,
+    .assign_module = assign_module,
     .cache_job_info = server_cache_job_info,
     .register_job_info = server_register_job_info,
     .store_job_info = store_job_info,
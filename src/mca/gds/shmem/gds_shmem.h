@@ -15,8 +15,11 @@
 #include "src/include/pmix_config.h"
 #include "src/include/pmix_globals.h"
 
+#include <string.h>
+
 #include "src/class/pmix_object.h"
 #include "src/class/pmix_list.h"
+#include "src/class/pmix_hash_table.h"
 
 #include "src/util/pmix_shmem.h"
 #include "src/util/pmix_vmem.h"
@@ -31,7 +34,7 @@
 /**
  * Set to 1 to completely disable this component.
  */
-#define PMIX_GDS_SHMEM_DISABLE 1
+#define PMIX_GDS_SHMEM_DISABLE 0
 
 /**
  * Environment variables used to find shared-memory segment info.
@@ -63,29 +66,204 @@ typedef struct {
     pmix_gds_base_component_t super;
     /** List of jobs that I'm supporting. */
     pmix_list_t myjobs;
+    /** The jobs in myjobs, keyed by nspace. */
+    pmix_hash_table_t myjobs_index;
+    /** Module that handles everything not kept in shared memory. */
+    pmix_gds_base_module_t *hash;
 } pmix_gds_shmem_component_t;
 /* The component must be visible data for the linker to find it. */
 PMIX_EXPORT extern pmix_gds_shmem_component_t pmix_mca_gds_shmem_component;
 extern pmix_gds_base_module_t pmix_shmem_module;
 
-// TODO(skg) Make sure all members are necessary.
+/**
+ * Shared-memory segment layout.
+ *
+ * The server builds one segment per namespace holding that job's job, app,
+ * node, and per-proc data. Clients map it read-only and answer PMIx_Get from
+ * it directly. Every reference inside the segment is a byte offset from the
+ * segment's base, so a reader may map it at any address. Offset 0 (the
+ * header) doubles as the NULL reference.
+ *
+ * Values whose pmix_value_t holds no pointers (numbers, ranks, states, etc.)
+ * are stored as the pmix_value_t itself and strings as their bytes, so a
+ * lookup only copies them out. Anything else (arrays, procs, byte objects,
+ * ...) is stored packed with the server's native bfrops module and is
+ * unpacked on each lookup.
+ *
+ * After a fence that collects data, the server also builds a modex segment of
+ * the same layout holding only per-proc scopes, and publishes its path in the
+ * namespace's job segment. The modex segment is created with room to spare:
+ * later fences append the data of the procs that took part in them, and then
+ * point the rank directory at it. Data in the segment is never overwritten or
+ * reused, so readers need no lock. Once the segment is full the server builds
+ * a new one.
+ */
+#define PMIX_GDS_SHMEM_SEG_MAGIC 0x70676473686d656dULL
+
+#define PMIX_GDS_SHMEM_BFROPS_NAME_MAX 32
+
+typedef enum {
+    /** id: rank, or PMIX_RANK_WILDCARD for job-level data. */
+    PMIX_GDS_SHMEM_SCOPE_PROC = 0,
+    /** sel: hostname; id: nodeid (UINT32_MAX if unknown). */
+    PMIX_GDS_SHMEM_SCOPE_NODE,
+    /** sel: hostname alias; first: offset of the aliased node scope. */
+    PMIX_GDS_SHMEM_SCOPE_NODE_ALIAS,
+    /** id: nodeid; first: offset of the node scope with that id. */
+    PMIX_GDS_SHMEM_SCOPE_NODE_ID,
+    /** id: appnum. */
+    PMIX_GDS_SHMEM_SCOPE_APP,
+    PMIX_GDS_SHMEM_SCOPE_NKINDS
+} pmix_gds_shmem_scope_kind_t;
+
 typedef struct {
-    pmix_list_item_t super;
-    uint32_t session;
-    pmix_list_t sessioninfo;
-    pmix_list_t nodeinfo;
-} pmix_gds_shmem_session_t;
-PMIX_CLASS_DECLARATION(pmix_gds_shmem_session_t);
+    uint64_t magic;
+    /** Total size of the segment in bytes. */
+    uint64_t size;
+    char nspace[PMIX_MAX_NSLEN + 1];
+    /** Version of the bfrops module used to pack values. */
+    char bfrops[PMIX_GDS_SHMEM_BFROPS_NAME_MAX];
+    uint32_t buffer_type;
+    uint32_t nprocs;
+    /** sizeof(pmix_value_t) in the server that built the segment. */
+    uint32_t value_size;
+    /** Scope index: nsbuckets offsets to scope chains. */
+    uint64_t nsbuckets;
+    uint64_t sbuckets;
+    /** Entry index: nebuckets offsets to entry chains. */
+    uint64_t nebuckets;
+    uint64_t ebuckets;
+    /** First scope of each kind, in order of creation. */
+    uint64_t scopes[PMIX_GDS_SHMEM_SCOPE_NKINDS];
+    /**
+     * Rank directory: nranks offsets to per-proc scopes, or 0. In a modex
+     * segment the server may change an offset at any time.
+     */
+    uint64_t nranks;
+    uint64_t rankdir;
+    /**
+     * Where the most recent modex segment for this namespace lives. Written
+     * only by the server: modex_gen is odd while modex_path is being updated.
+     */
+    volatile uint64_t modex_gen;
+    char modex_path[PMIX_PATH_MAX];
+} pmix_gds_shmem_seg_hdr_t;
+
+typedef struct {
+    /** Next scope in the same index bucket. */
+    uint64_t next;
+    /** Next scope of the same kind. */
+    uint64_t knext;
+    uint64_t hash;
+    uint32_t kind;
+    uint32_t id;
+    /** Selector string (hostname or alias), or 0. */
+    uint64_t sel;
+    /** First entry of this scope, or the target scope of an alias. */
+    uint64_t first;
+    uint64_t nentries;
+} pmix_gds_shmem_seg_scope_t;
+
+typedef enum {
+    /** A pmix_value_t packed with the segment's bfrops module. */
+    PMIX_GDS_SHMEM_VALUE_PACKED = 0,
+    /** A pmix_value_t without pointers, stored as is. */
+    PMIX_GDS_SHMEM_VALUE_FLAT,
+    /** A PMIX_STRING, stored as its NUL-terminated bytes. */
+    PMIX_GDS_SHMEM_VALUE_STRING
+} pmix_gds_shmem_value_form_t;
+
+typedef struct {
+    /** Next entry in the same index bucket. */
+    uint64_t next;
+    /** Next entry in the same scope, in order of insertion. */
+    uint64_t snext;
+    uint64_t hash;
+    /** Owning scope. */
+    uint64_t scope;
+    uint64_t key;
+    /** The value, in the given form, and its size. */
+    uint64_t value;
+    uint64_t vsize;
+    uint32_t form;
+} pmix_gds_shmem_seg_entry_t;
+
+#define PMIX_GDS_SHMEM_SEG_PTR(hdr, off)                                       \
+    ((void *)((uint8_t *)(hdr) + (off)))
+
+/**
+ * FNV-1a, used to hash both scopes and entries.
+ */
+static inline uint64_t
+pmix_gds_shmem_hash_bytes(
+    uint64_t h,
+    const void *data,
+    size_t len
+) {
+    const uint8_t *p = (const uint8_t *)data;
+    for (size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+static inline uint64_t
+pmix_gds_shmem_scope_hash(
+    uint32_t kind,
+    uint32_t id,
+    const char *sel
+) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    h = pmix_gds_shmem_hash_bytes(h, &kind, sizeof(kind));
+    // Scopes with a selector are found by it alone.
+    if (NULL != sel) {
+        return pmix_gds_shmem_hash_bytes(h, sel, strlen(sel));
+    }
+    return pmix_gds_shmem_hash_bytes(h, &id, sizeof(id));
+}
+
+static inline uint64_t
+pmix_gds_shmem_entry_hash(
+    uint64_t scope,
+    const char *key
+) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    h = pmix_gds_shmem_hash_bytes(h, &scope, sizeof(scope));
+    return pmix_gds_shmem_hash_bytes(h, key, strlen(key));
+}
 
 typedef struct {
     pmix_list_item_t super;
     char *ns;
     pmix_shmem_t *shmem;
     pmix_namespace_t *nptr;
-    pmix_gds_shmem_session_t *session;
+    /** Segment header when attached as a reader, NULL otherwise. */
+    pmix_gds_shmem_seg_hdr_t *seg;
+    /** The bfrops module that packed the segment's values. */
+    pmix_bfrops_module_t *bfrops;
+    /** The current modex segment, if any. */
+    pmix_shmem_t *modex;
+    /** Modex segment header when attached as a reader, NULL otherwise. */
+    pmix_gds_shmem_seg_hdr_t *modex_seg;
+    /** Generation of the modex segment we have attached (readers only). */
+    uint64_t modex_gen;
+    /** Bytes of the modex segment in use (servers only). */
+    size_t modex_used;
 } pmix_gds_shmem_job_t;
 PMIX_CLASS_DECLARATION(pmix_gds_shmem_job_t);
 
+/**
+ * One proc's contribution to a fence, as collected for a modex segment.
+ */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_rank_t rank;
+    /** List of pmix_kval_t. */
+    pmix_list_t kvs;
+} pmix_gds_shmem_modex_proc_t;
+PMIX_CLASS_DECLARATION(pmix_gds_shmem_modex_proc_t);
+
 END_C_DECLS
 
 #endif
@@ -41,6 +41,8 @@ static int
 component_open(void)
 {
     PMIX_CONSTRUCT(&pmix_mca_gds_shmem_component.myjobs, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_mca_gds_shmem_component.myjobs_index, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_mca_gds_shmem_component.myjobs_index, 32);
     return PMIX_SUCCESS;
 }
 
@@ -70,7 +72,9 @@ component_query(
 static int
 component_close(void)
 {
+    PMIX_DESTRUCT(&pmix_mca_gds_shmem_component.myjobs_index);
     PMIX_LIST_DESTRUCT(&pmix_mca_gds_shmem_component.myjobs);
+    pmix_mca_gds_shmem_component.hash = NULL;
     return PMIX_SUCCESS;
 }
 
@@ -94,7 +98,9 @@ pmix_gds_shmem_component_t pmix_mca_gds_shmem_component = {
         .pmix_mca_close_component = component_close,
         .pmix_mca_query_component = component_query,
     },
-    .myjobs = PMIX_LIST_STATIC_INIT
+    .myjobs = PMIX_LIST_STATIC_INIT,
+    .myjobs_index = PMIX_HASH_TABLE_STATIC_INIT,
+    .hash = NULL
 };
 
 /*
@@ -0,0 +1,566 @@
+/*
+ * Copyright (c) 2015-2020 Intel, Inc.  All rights reserved.
+ * Copyright (c) 2016-2018 IBM Corporation.  All rights reserved.
+ * Copyright (c) 2018      Research Organization for Information Science
+ *                         and Technology (RIST).  All rights reserved.
+ * Copyright (c) 2018-2020 Mellanox Technologies, Inc.
+ *                         All rights reserved.
+ * Copyright (c) 2021-2022 Nanook Consulting.  All rights reserved.
+ * Copyright (c) 2022      Triad National Security, LLC. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+#include "include/pmix_common.h"
+
+#include "gds_shmem_utils.h"
+#include "gds_shmem.h"
+
+#include "src/include/pmix_atomic.h"
+#include "src/include/pmix_globals.h"
+#include "src/mca/bfrops/bfrops.h"
+#include "src/mca/gds/base/base.h"
+#include "src/util/pmix_error.h"
+#include "src/util/pmix_output.h"
+
+bool
+pmix_gds_shmem_seg_valid(
+    const pmix_gds_shmem_seg_hdr_t *hdr,
+    size_t size
+) {
+    if (size < sizeof(*hdr) || PMIX_GDS_SHMEM_SEG_MAGIC != hdr->magic
+        || hdr->size > size) {
+        return false;
+    }
+    // Flat values are only readable by a library with the same pmix_value_t.
+    if (sizeof(pmix_value_t) != hdr->value_size) {
+        return false;
+    }
+    if (0 == hdr->nsbuckets || 0 != (hdr->nsbuckets & (hdr->nsbuckets - 1))
+        || 0 == hdr->nebuckets || 0 != (hdr->nebuckets & (hdr->nebuckets - 1))) {
+        return false;
+    }
+    return true;
+}
+
+static pmix_gds_shmem_seg_scope_t *
+find_scope(
+    const pmix_gds_shmem_seg_hdr_t *hdr,
+    uint32_t kind,
+    uint32_t id,
+    const char *sel
+) {
+    if (PMIX_GDS_SHMEM_SCOPE_PROC == kind && id < hdr->nranks) {
+        // The server may be changing it as we look.
+        const volatile uint64_t *rankdir = PMIX_GDS_SHMEM_SEG_PTR(hdr, hdr->rankdir);
+        const uint64_t off = rankdir[id];
+        if (0 == off) {
+            return NULL;
+        }
+        pmix_atomic_rmb();
+        return PMIX_GDS_SHMEM_SEG_PTR(hdr, off);
+    }
+
+    const uint64_t h = pmix_gds_shmem_scope_hash(kind, id, sel);
+    const uint64_t *buckets = PMIX_GDS_SHMEM_SEG_PTR(hdr, hdr->sbuckets);
+    uint64_t off = buckets[h & (hdr->nsbuckets - 1)];
+
+    while (0 != off) {
+        pmix_gds_shmem_seg_scope_t *s = PMIX_GDS_SHMEM_SEG_PTR(hdr, off);
+        if (s->hash == h && s->kind == kind) {
+            if (NULL == sel && s->id == id) {
+                return s;
+            }
+            if (NULL != sel && 0 != s->sel
+                && 0 == strcmp(sel, PMIX_GDS_SHMEM_SEG_PTR(hdr, s->sel))) {
+                return s;
+            }
+        }
+        off = s->next;
+    }
+    return NULL;
+}
+
+static pmix_gds_shmem_seg_scope_t *
+find_node(
+    const pmix_gds_shmem_seg_hdr_t *hdr,
+    uint32_t nodeid,
+    const char *hostname
+) {
+    pmix_gds_shmem_seg_scope_t *s;
+
+    if (UINT32_MAX != nodeid) {
+        s = find_scope(hdr, PMIX_GDS_SHMEM_SCOPE_NODE_ID, nodeid, NULL);
+    } else if (NULL != hostname) {
+        s = find_scope(hdr, PMIX_GDS_SHMEM_SCOPE_NODE, UINT32_MAX, hostname);
+        if (NULL != s) {
+            return s;
+        }
+        s = find_scope(hdr, PMIX_GDS_SHMEM_SCOPE_NODE_ALIAS, UINT32_MAX, hostname);
+    } else {
+        return NULL;
+    }
+    // Follow the indirection.
+    if (NULL == s) {
+        return NULL;
+    }
+    return PMIX_GDS_SHMEM_SEG_PTR(hdr, s->first);
+}
+
+static pmix_gds_shmem_seg_entry_t *
+find_entry(
+    const pmix_gds_shmem_seg_hdr_t *hdr,
+    const pmix_gds_shmem_seg_scope_t *scope,
+    const char *key
+) {
+    const uint64_t soff = (uint64_t)((uint8_t *)scope - (uint8_t *)hdr);
+    const uint64_t h = pmix_gds_shmem_entry_hash(soff, key);
+    const volatile uint64_t *buckets = PMIX_GDS_SHMEM_SEG_PTR(hdr, hdr->ebuckets);
+    uint64_t off = buckets[h & (hdr->nebuckets - 1)];
+
+    pmix_atomic_rmb();
+    while (0 != off) {
+        pmix_gds_shmem_seg_entry_t *e = PMIX_GDS_SHMEM_SEG_PTR(hdr, off);
+        if (e->hash == h && e->scope == soff
+            && 0 == strcmp(key, PMIX_GDS_SHMEM_SEG_PTR(hdr, e->key))) {
+            return e;
+        }
+        off = e->next;
+    }
+    return NULL;
+}
+
+static pmix_status_t
+load_value(
+    pmix_gds_shmem_job_t *job,
+    const pmix_gds_shmem_seg_hdr_t *hdr,
+    const pmix_gds_shmem_seg_entry_t *entry,
+    pmix_value_t *value
+) {
+    pmix_status_t rc;
+    pmix_buffer_t buf;
+    int32_t cnt = 1;
+
+    switch (entry->form) {
+    case PMIX_GDS_SHMEM_VALUE_FLAT:
+        memcpy(value, PMIX_GDS_SHMEM_SEG_PTR(hdr, entry->value), sizeof(pmix_value_t));
+        return PMIX_SUCCESS;
+    case PMIX_GDS_SHMEM_VALUE_STRING:
+        value->type = PMIX_STRING;
+        value->data.string = strdup(PMIX_GDS_SHMEM_SEG_PTR(hdr, entry->value));
+        if (NULL == value->data.string) {
+            return PMIX_ERR_NOMEM;
+        }
+        return PMIX_SUCCESS;
+    default:
+        break;
+    }
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    buf.type = hdr->buffer_type;
+    buf.base_ptr = PMIX_GDS_SHMEM_SEG_PTR(hdr, entry->value);
+    buf.bytes_used = buf.bytes_allocated = entry->vsize;
+    buf.unpack_ptr = buf.base_ptr;
+    buf.pack_ptr = buf.base_ptr + entry->vsize;
+    // Unpack with the same bfrops module that packed the segment.
+    rc = job->bfrops->unpack(&buf, value, &cnt, PMIX_VALUE);
+    // The segment still owns the data.
+    buf.base_ptr = NULL;
+    buf.bytes_used = 0;
+    PMIX_DESTRUCT(&buf);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+    }
+    return rc;
+}
+
+static pmix_status_t
+append_kval(
+    pmix_gds_shmem_job_t *job,
+    const pmix_gds_shmem_seg_hdr_t *hdr,
+    const pmix_gds_shmem_seg_entry_t *entry,
+    pmix_list_t *kvs
+) {
+    pmix_status_t rc;
+    pmix_kval_t *kv = PMIX_NEW(pmix_kval_t);
+
+    if (NULL == kv) {
+        return PMIX_ERR_NOMEM;
+    }
+    kv->key = strdup(PMIX_GDS_SHMEM_SEG_PTR(hdr, entry->key));
+    PMIX_VALUE_CREATE(kv->value, 1);
+    if (NULL == kv->value) {
+        PMIX_RELEASE(kv);
+        return PMIX_ERR_NOMEM;
+    }
+    rc = load_value(job, hdr, entry, kv->value);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_RELEASE(kv);
+        return rc;
+    }
+    pmix_list_append(kvs, &kv->super);
+    return PMIX_SUCCESS;
+}
+
+/**
+ * Returns either one key from the scope or, if key is NULL, all of them as
+ * individual values.
+ */
+static pmix_status_t
+fetch_from_scope(
+    pmix_gds_shmem_job_t *job,
+    const pmix_gds_shmem_seg_hdr_t *hdr,
+    const pmix_gds_shmem_seg_scope_t *scope,
+    const char *key,
+    pmix_list_t *kvs
+) {
+    pmix_status_t rc;
+    uint64_t off;
+
+    if (NULL != key) {
+        pmix_gds_shmem_seg_entry_t *e = find_entry(hdr, scope, key);
+        if (NULL == e) {
+            return PMIX_ERR_NOT_FOUND;
+        }
+        return append_kval(job, hdr, e, kvs);
+    }
+    if (0 == scope->nentries) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    for (off = scope->first; 0 != off;) {
+        pmix_gds_shmem_seg_entry_t *e = PMIX_GDS_SHMEM_SEG_PTR(hdr, off);
+        rc = append_kval(job, hdr, e, kvs);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+        off = e->snext;
+    }
+    return PMIX_SUCCESS;
+}
+
+/**
+ * Returns the scope's contents as a single data array of pmix_info_t, with
+ * an optional leading info (e.g., the rank of a proc scope).
+ */
+static pmix_status_t
+fetch_scope_array(
+    pmix_gds_shmem_job_t *job,
+    const pmix_gds_shmem_seg_scope_t *scope,
+    const char *key,
+    const pmix_info_t *lead,
+    pmix_list_t *kvs
+) {
+    const pmix_gds_shmem_seg_hdr_t *hdr = job->seg;
+    pmix_status_t rc;
+    pmix_kval_t *kv;
+    pmix_info_t *iptr;
+    uint64_t off;
+    size_t n = 0;
+
+    kv = PMIX_NEW(pmix_kval_t);
+    if (NULL == kv) {
+        return PMIX_ERR_NOMEM;
+    }
+    kv->key = strdup(key);
+    PMIX_VALUE_CREATE(kv->value, 1);
+    if (NULL == kv->value) {
+        PMIX_RELEASE(kv);
+        return PMIX_ERR_NOMEM;
+    }
+    kv->value->type = PMIX_DATA_ARRAY;
+    PMIX_DATA_ARRAY_CREATE(kv->value->data.darray,
+                           scope->nentries + (NULL == lead ? 0 : 1), PMIX_INFO);
+    if (NULL == kv->value->data.darray) {
+        PMIX_RELEASE(kv);
+        return PMIX_ERR_NOMEM;
+    }
+    iptr = (pmix_info_t *)kv->value->data.darray->array;
+    if (NULL != lead) {
+        PMIX_INFO_XFER(&iptr[n], lead);
+        ++n;
+    }
+    for (off = scope->first; 0 != off; n++) {
+        pmix_gds_shmem_seg_entry_t *e = PMIX_GDS_SHMEM_SEG_PTR(hdr, off);
+        PMIX_LOAD_KEY(iptr[n].key, PMIX_GDS_SHMEM_SEG_PTR(hdr, e->key));
+        rc = load_value(job, hdr, e, &iptr[n].value);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_RELEASE(kv);
+            return rc;
+        }
+        off = e->snext;
+    }
+    pmix_list_append(kvs, &kv->super);
+    return PMIX_SUCCESS;
+}
+
+static const char *
+node_array_key(
+    pmix_gds_shmem_job_t *job,
+    const pmix_gds_shmem_seg_scope_t *node
+) {
+    const pmix_gds_shmem_seg_hdr_t *hdr = job->seg;
+    // Peers that predate v3.1 expect node arrays keyed by hostname.
+    if (job->nptr->version.major < 3
+        || (3 == job->nptr->version.major && 0 == job->nptr->version.minor)) {
+        return PMIX_GDS_SHMEM_SEG_PTR(hdr, node->sel);
+    }
+    return PMIX_NODE_INFO_ARRAY;
+}
+
+/**
+ * Reconstructs the complete job-level data in the form the hash component
+ * provides it.
+ */
+static pmix_status_t
+fetch_all(
+    pmix_gds_shmem_job_t *job,
+    pmix_list_t *kvs
+) {
+    const pmix_gds_shmem_seg_hdr_t *hdr = job->seg;
+    pmix_status_t rc;
+    pmix_gds_shmem_seg_scope_t *s;
+    pmix_info_t lead;
+    uint64_t off;
+
+    s = find_scope(hdr, PMIX_GDS_SHMEM_SCOPE_PROC, PMIX_RANK_WILDCARD, NULL);
+    if (NULL != s && 0 < s->nentries) {
+        rc = fetch_from_scope(job, hdr, s, NULL, kvs);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    }
+    for (off = hdr->scopes[PMIX_GDS_SHMEM_SCOPE_NODE]; 0 != off; off = s->knext) {
+        s = PMIX_GDS_SHMEM_SEG_PTR(hdr, off);
+        rc = fetch_scope_array(job, s, node_array_key(job, s), NULL, kvs);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    }
+    for (off = hdr->scopes[PMIX_GDS_SHMEM_SCOPE_APP]; 0 != off; off = s->knext) {
+        s = PMIX_GDS_SHMEM_SEG_PTR(hdr, off);
+        rc = fetch_scope_array(job, s, PMIX_APP_INFO_ARRAY, NULL, kvs);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    }
+    for (off = hdr->scopes[PMIX_GDS_SHMEM_SCOPE_PROC]; 0 != off; off = s->knext) {
+        s = PMIX_GDS_SHMEM_SEG_PTR(hdr, off);
+        if (PMIX_RANK_WILDCARD == s->id || 0 == s->nentries) {
+            continue;
+        }
+        pmix_rank_t rank = s->id;
+        PMIX_INFO_LOAD(&lead, PMIX_RANK, &rank, PMIX_PROC_RANK);
+        rc = fetch_scope_array(job, s, PMIX_PROC_DATA, &lead, kvs);
+        PMIX_INFO_DESTRUCT(&lead);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t
+fetch_nodeinfo(
+    pmix_gds_shmem_job_t *job,
+    const char *key,
+    pmix_info_t qualifiers[],
+    size_t nqual,
+    pmix_list_t *kvs
+) {
+    const pmix_gds_shmem_seg_hdr_t *hdr = job->seg;
+    pmix_status_t rc;
+    pmix_gds_shmem_seg_scope_t *node;
+    uint32_t nid = UINT32_MAX;
+    char *hostname = NULL;
+    bool found = false;
+    uint64_t off;
+
+    for (size_t n = 0; n < nqual; n++) {
+        if (PMIX_CHECK_KEY(&qualifiers[n], PMIX_NODEID)) {
+            PMIX_VALUE_GET_NUMBER(rc, &qualifiers[n].value, nid, uint32_t);
+            if (PMIX_SUCCESS != rc) {
+                return rc;
+            }
+            found = true;
+            break;
+        } else if (PMIX_CHECK_KEY(&qualifiers[n], PMIX_HOSTNAME)) {
+            hostname = qualifiers[n].value.data.string;
+            found = true;
+            break;
+        }
+    }
+    if (!found) {
+        // All info from all nodes.
+        if (NULL == key) {
+            for (off = hdr->scopes[PMIX_GDS_SHMEM_SCOPE_NODE]; 0 != off; off = node->knext) {
+                node = PMIX_GDS_SHMEM_SEG_PTR(hdr, off);
+                rc = fetch_scope_array(job, node, node_array_key(job, node), NULL, kvs);
+                if (PMIX_SUCCESS != rc) {
+                    return rc;
+                }
+            }
+            return PMIX_SUCCESS;
+        }
+        // Assume they want it from this node.
+        hostname = pmix_globals.hostname;
+    }
+    node = find_node(hdr, nid, hostname);
+    if (NULL == node) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    if (NULL == key) {
+        return fetch_scope_array(job, node, node_array_key(job, node), NULL, kvs);
+    }
+    return fetch_from_scope(job, hdr, node, key, kvs);
+}
+
+static pmix_status_t
+fetch_appinfo(
+    pmix_gds_shmem_job_t *job,
+    const char *key,
+    pmix_info_t qualifiers[],
+    size_t nqual,
+    pmix_list_t *kvs
+) {
+    const pmix_gds_shmem_seg_hdr_t *hdr = job->seg;
+    pmix_status_t rc;
+    pmix_gds_shmem_seg_scope_t *app;
+    uint32_t appnum = 0;
+    bool found = false;
+    uint64_t off;
+
+    for (size_t n = 0; n < nqual; n++) {
+        if (PMIX_CHECK_KEY(&qualifiers[n], PMIX_APPNUM)) {
+            PMIX_VALUE_GET_NUMBER(rc, &qualifiers[n].value, appnum, uint32_t);
+            if (PMIX_SUCCESS != rc) {
+                return rc;
+            }
+            found = true;
+        } else if (PMIX_CHECK_KEY(&qualifiers[n], PMIX_NODEID)
+                   || PMIX_CHECK_KEY(&qualifiers[n], PMIX_HOSTNAME)) {
+            // Per-app node info is not kept in the segment.
+            return PMIX_ERR_NOT_FOUND;
+        }
+    }
+    if (!found) {
+        // All info from all apps.
+        if (NULL == key) {
+            for (off = hdr->scopes[PMIX_GDS_SHMEM_SCOPE_APP]; 0 != off; off = app->knext) {
+                app = PMIX_GDS_SHMEM_SEG_PTR(hdr, off);
+                rc = fetch_scope_array(job, app, PMIX_APP_INFO_ARRAY, NULL, kvs);
+                if (PMIX_SUCCESS != rc) {
+                    return rc;
+                }
+            }
+            return PMIX_SUCCESS;
+        }
+        // Assume they are asking for our app.
+        appnum = pmix_globals.appnum;
+    }
+    app = find_scope(hdr, PMIX_GDS_SHMEM_SCOPE_APP, appnum, NULL);
+    if (NULL == app) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    return fetch_from_scope(job, hdr, app, key, kvs);
+}
+
+pmix_status_t
+pmix_gds_shmem_seg_fetch(
+    pmix_gds_shmem_job_t *job,
+    const pmix_proc_t *proc,
+    pmix_scope_t scope,
+    const char *key,
+    pmix_info_t qualifiers[],
+    size_t nqual,
+    pmix_list_t *kvs
+) {
+    pmix_status_t rc;
+    const pmix_gds_shmem_seg_hdr_t *hdr = job->seg;
+    pmix_gds_shmem_seg_scope_t *s;
+    bool nodeinfo = false, appinfo = false;
+    bool nigiven = false, apigiven = false;
+
+    if (NULL == hdr) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    // A complete copy of the job-level info.
+    if (NULL == key && PMIX_RANK_WILDCARD == proc->rank) {
+        return fetch_all(job, kvs);
+    }
+
+    for (size_t n = 0; n < nqual; n++) {
+        if (PMIX_CHECK_KEY(&qualifiers[n], PMIX_SESSION_INFO)) {
+            // Session info is not kept in the segment.
+            return PMIX_ERR_NOT_FOUND;
+        } else if (PMIX_CHECK_KEY(&qualifiers[n], PMIX_NODE_INFO)) {
+            nodeinfo = PMIX_INFO_TRUE(&qualifiers[n]);
+            nigiven = true;
+        } else if (PMIX_CHECK_KEY(&qualifiers[n], PMIX_APP_INFO)) {
+            appinfo = PMIX_INFO_TRUE(&qualifiers[n]);
+            apigiven = true;
+        }
+    }
+    // Check for node/app keys in the absence of a corresponding qualifier.
+    if (NULL != key && !nigiven && !apigiven) {
+        if (pmix_check_node_info(key)) {
+            nodeinfo = true;
+        } else if (pmix_check_app_info(key)) {
+            appinfo = true;
+        }
+    }
+
+    if (!PMIX_RANK_IS_VALID(proc->rank) && (nodeinfo || appinfo)) {
+        if (nodeinfo) {
+            rc = fetch_nodeinfo(job, key, qualifiers, nqual, kvs);
+        } else {
+            rc = fetch_appinfo(job, key, qualifiers, nqual, kvs);
+        }
+        if (PMIX_SUCCESS == rc || NULL == key || PMIX_RANK_WILDCARD != proc->rank) {
+            return rc;
+        }
+        // Older peers may have provided it as job-level data.
+    }
+    if (PMIX_RANK_UNDEF == proc->rank) {
+        // Any rank could be the source: leave that search to hash.
+        return PMIX_ERR_NOT_FOUND;
+    }
+    // Only internal (i.e., job-level) data is kept in the segment.
+    if (PMIX_INTERNAL != scope && PMIX_SCOPE_UNDEF != scope && PMIX_GLOBAL != scope
+        && PMIX_RANK_WILDCARD != proc->rank) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    s = find_scope(hdr, PMIX_GDS_SHMEM_SCOPE_PROC, proc->rank, NULL);
+    if (NULL == s) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    return fetch_from_scope(job, hdr, s, key, kvs);
+}
+
+pmix_status_t
+pmix_gds_shmem_modex_fetch(
+    pmix_gds_shmem_job_t *job,
+    const pmix_proc_t *proc,
+    pmix_scope_t scope,
+    const char *key,
+    pmix_list_t *kvs
+) {
+    const pmix_gds_shmem_seg_hdr_t *hdr = job->modex_seg;
+    pmix_gds_shmem_seg_scope_t *s;
+
+    if (NULL == hdr || !PMIX_RANK_IS_VALID(proc->rank)) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    // The segment holds what the server would return for a request that did
+    // not specify a scope. Our own values may since have been replaced.
+    if (PMIX_SCOPE_UNDEF != scope || PMIX_CHECK_PROCID(proc, &pmix_globals.myid)) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    s = find_scope(hdr, PMIX_GDS_SHMEM_SCOPE_PROC, proc->rank, NULL);
+    if (NULL == s) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    return fetch_from_scope(job, hdr, s, key, kvs);
+}
@@ -0,0 +1,692 @@
+/*
+ * Copyright (c) 2015-2020 Intel, Inc.  All rights reserved.
+ * Copyright (c) 2016-2018 IBM Corporation.  All rights reserved.
+ * Copyright (c) 2018      Research Organization for Information Science
+ *                         and Technology (RIST).  All rights reserved.
+ * Copyright (c) 2018-2020 Mellanox Technologies, Inc.
+ *                         All rights reserved.
+ * Copyright (c) 2021-2022 Nanook Consulting.  All rights reserved.
+ * Copyright (c) 2022      Triad National Security, LLC. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+#include "include/pmix_common.h"
+
+#include "gds_shmem_utils.h"
+#include "gds_shmem.h"
+
+#include "src/include/pmix_atomic.h"
+#include "src/include/pmix_globals.h"
+#include "src/class/pmix_list.h"
+#include "src/mca/bfrops/bfrops.h"
+#include "src/mca/gds/base/base.h"
+#include "src/util/pmix_argv.h"
+#include "src/util/pmix_error.h"
+#include "src/util/pmix_output.h"
+#include "src/util/pmix_string_copy.h"
+
+/*
+ * The segment image is first assembled in private memory, where it may grow
+ * freely, and is then copied into a segment. Everything in the image is
+ * addressed by offset, so reallocs are harmless. Modex segments are created
+ * with room to spare, and later fences append to them in place.
+ */
+
+typedef struct {
+    uint8_t *base;
+    size_t used;
+    size_t size;
+    /** The image is a live segment and cannot grow. */
+    bool fixed;
+} pmix_gds_shmem_image_t;
+
+/**
+ * A reference to a key/value pair owned by the caller's list.
+ */
+typedef struct {
+    pmix_list_item_t super;
+    const char *key;
+    pmix_value_t *value;
+} pmix_gds_shmem_bval_t;
+
+static PMIX_CLASS_INSTANCE(
+    pmix_gds_shmem_bval_t,
+    pmix_list_item_t,
+    NULL,
+    NULL
+);
+
+/**
+ * A scope (job, proc, node, or app) and the values it holds, collected
+ * before anything is written to the image.
+ */
+typedef struct {
+    pmix_list_item_t super;
+    uint32_t kind;
+    uint32_t id;
+    char *sel;
+    char **aliases;
+    /** List of pmix_gds_shmem_bval_t. */
+    pmix_list_t vals;
+} pmix_gds_shmem_bscope_t;
+
+static void
+bscope_construct(
+    pmix_gds_shmem_bscope_t *s
+) {
+    s->kind = PMIX_GDS_SHMEM_SCOPE_PROC;
+    s->id = UINT32_MAX;
+    s->sel = NULL;
+    s->aliases = NULL;
+    PMIX_CONSTRUCT(&s->vals, pmix_list_t);
+}
+
+static void
+bscope_destruct(
+    pmix_gds_shmem_bscope_t *s
+) {
+    free(s->sel);
+    pmix_argv_free(s->aliases);
+    PMIX_LIST_DESTRUCT(&s->vals);
+}
+
+static PMIX_CLASS_INSTANCE(
+    pmix_gds_shmem_bscope_t,
+    pmix_list_item_t,
+    bscope_construct,
+    bscope_destruct
+);
+
+static size_t
+next_pow2(
+    size_t n
+) {
+    size_t p = 16;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+/**
+ * Reserves zeroed, 8-byte aligned space in the image, returning its offset.
+ */
+static pmix_status_t
+image_alloc(
+    pmix_gds_shmem_image_t *img,
+    size_t len,
+    uint64_t *off
+) {
+    const size_t start = (img->used + 7UL) & ~7UL;
+    const size_t end = start + len;
+
+    if (end > img->size) {
+        if (img->fixed) {
+            return PMIX_ERR_OUT_OF_RESOURCE;
+        }
+        size_t nsize = (0 == img->size) ? 4096 : img->size;
+        while (nsize < end) {
+            nsize <<= 1;
+        }
+        uint8_t *nbase = realloc(img->base, nsize);
+        if (NULL == nbase) {
+            return PMIX_ERR_NOMEM;
+        }
+        memset(nbase + img->size, 0, nsize - img->size);
+        img->base = nbase;
+        img->size = nsize;
+    }
+    img->used = end;
+    *off = start;
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t
+image_strdup(
+    pmix_gds_shmem_image_t *img,
+    const char *str,
+    uint64_t *off
+) {
+    const size_t len = strlen(str) + 1;
+    pmix_status_t rc = image_alloc(img, len, off);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    memcpy(img->base + *off, str, len);
+    return PMIX_SUCCESS;
+}
+
+static pmix_gds_shmem_bscope_t *
+bscope_get(
+    pmix_list_t *scopes,
+    uint32_t kind,
+    uint32_t id,
+    const char *sel
+) {
+    pmix_gds_shmem_bscope_t *s;
+
+    PMIX_LIST_FOREACH (s, scopes, pmix_gds_shmem_bscope_t) {
+        if (s->kind == kind && s->id == id
+            && ((NULL == sel && NULL == s->sel)
+                || (NULL != sel && NULL != s->sel && 0 == strcmp(sel, s->sel)))) {
+            return s;
+        }
+    }
+    s = PMIX_NEW(pmix_gds_shmem_bscope_t);
+    s->kind = kind;
+    s->id = id;
+    if (NULL != sel) {
+        s->sel = strdup(sel);
+    }
+    pmix_list_append(scopes, &s->super);
+    return s;
+}
+
+static void
+bscope_add(
+    pmix_gds_shmem_bscope_t *s,
+    const char *key,
+    pmix_value_t *value
+) {
+    pmix_gds_shmem_bval_t *bv = PMIX_NEW(pmix_gds_shmem_bval_t);
+    bv->key = key;
+    bv->value = value;
+    pmix_list_append(&s->vals, &bv->super);
+}
+
+/**
+ * Sorts the complete job-level data into scopes. The data itself is not
+ * copied: the scopes reference values held in the provided list.
+ */
+static pmix_status_t
+collect_scopes(
+    pmix_list_t *kvs,
+    pmix_list_t *scopes
+) {
+    pmix_kval_t *kv;
+    pmix_gds_shmem_bscope_t *s;
+    pmix_info_t *iptr;
+    size_t n, sz;
+
+    PMIX_LIST_FOREACH (kv, kvs, pmix_kval_t) {
+        pmix_info_t *hostname = NULL, *nodeid = NULL, *aliases = NULL;
+        pmix_info_t *appnum = NULL, *rank = NULL;
+
+        if (PMIX_DATA_ARRAY != kv->value->type || NULL == kv->value->data.darray
+            || PMIX_INFO != kv->value->data.darray->type) {
+            // Plain job-level value.
+            s = bscope_get(scopes, PMIX_GDS_SHMEM_SCOPE_PROC, PMIX_RANK_WILDCARD, NULL);
+            bscope_add(s, kv->key, kv->value);
+            continue;
+        }
+        iptr = (pmix_info_t *)kv->value->data.darray->array;
+        sz = kv->value->data.darray->size;
+        for (n = 0; n < sz; n++) {
+            if (PMIX_CHECK_KEY(&iptr[n], PMIX_HOSTNAME)) {
+                hostname = &iptr[n];
+            } else if (PMIX_CHECK_KEY(&iptr[n], PMIX_NODEID)) {
+                nodeid = &iptr[n];
+            } else if (PMIX_CHECK_KEY(&iptr[n], PMIX_HOSTNAME_ALIASES)) {
+                aliases = &iptr[n];
+            }
+        }
+        if (0 < sz && PMIX_CHECK_KEY(&iptr[0], PMIX_APPNUM)) {
+            appnum = &iptr[0];
+        } else if (0 < sz && PMIX_CHECK_KEY(&iptr[0], PMIX_RANK)) {
+            rank = &iptr[0];
+        }
+
+        if (PMIX_CHECK_KEY(kv, PMIX_PROC_DATA) && NULL != rank
+            && PMIX_PROC_RANK == rank->value.type) {
+            s = bscope_get(scopes, PMIX_GDS_SHMEM_SCOPE_PROC, rank->value.data.rank, NULL);
+            for (n = 1; n < sz; n++) {
+                bscope_add(s, iptr[n].key, &iptr[n].value);
+            }
+        } else if (PMIX_CHECK_KEY(kv, PMIX_APP_INFO_ARRAY) && NULL != appnum) {
+            uint32_t anum = 0;
+            pmix_status_t rc;
+            PMIX_VALUE_GET_NUMBER(rc, &appnum->value, anum, uint32_t);
+            if (PMIX_SUCCESS != rc) {
+                return rc;
+            }
+            s = bscope_get(scopes, PMIX_GDS_SHMEM_SCOPE_APP, anum, NULL);
+            for (n = 0; n < sz; n++) {
+                bscope_add(s, iptr[n].key, &iptr[n].value);
+            }
+        } else if (NULL != hostname && PMIX_STRING == hostname->value.type) {
+            // Node arrays are keyed by PMIX_NODE_INFO_ARRAY, or by the
+            // hostname itself for peers that predate node-info arrays.
+            uint32_t nid = UINT32_MAX;
+            if (NULL != nodeid) {
+                pmix_status_t rc;
+                PMIX_VALUE_GET_NUMBER(rc, &nodeid->value, nid, uint32_t);
+                if (PMIX_SUCCESS != rc) {
+                    return rc;
+                }
+            }
+            s = bscope_get(scopes, PMIX_GDS_SHMEM_SCOPE_NODE, nid,
+                           hostname->value.data.string);
+            if (NULL != aliases && PMIX_STRING == aliases->value.type
+                && NULL == s->aliases) {
+                s->aliases = pmix_argv_split(aliases->value.data.string, ',');
+            }
+            for (n = 0; n < sz; n++) {
+                bscope_add(s, iptr[n].key, &iptr[n].value);
+            }
+        } else {
+            // Some other array-valued job-level datum.
+            s = bscope_get(scopes, PMIX_GDS_SHMEM_SCOPE_PROC, PMIX_RANK_WILDCARD, NULL);
+            bscope_add(s, kv->key, kv->value);
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t
+add_scope(
+    pmix_gds_shmem_image_t *img,
+    uint64_t *ktails,
+    uint32_t kind,
+    uint32_t id,
+    const char *sel,
+    uint64_t *soff
+) {
+    pmix_status_t rc;
+    uint64_t off, seloff = 0;
+    pmix_gds_shmem_seg_hdr_t *hdr;
+    pmix_gds_shmem_seg_scope_t *scope;
+    uint64_t *buckets;
+
+    if (NULL != sel) {
+        rc = image_strdup(img, sel, &seloff);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    }
+    rc = image_alloc(img, sizeof(*scope), &off);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    hdr = (pmix_gds_shmem_seg_hdr_t *)img->base;
+    scope = PMIX_GDS_SHMEM_SEG_PTR(hdr, off);
+    scope->kind = kind;
+    scope->id = id;
+    scope->sel = seloff;
+    scope->hash = pmix_gds_shmem_scope_hash(kind, id, sel);
+    // Link into the index.
+    buckets = PMIX_GDS_SHMEM_SEG_PTR(hdr, hdr->sbuckets);
+    const uint64_t b = scope->hash & (hdr->nsbuckets - 1);
+    scope->next = buckets[b];
+    buckets[b] = off;
+    // Procs can also be found by rank.
+    if (PMIX_GDS_SHMEM_SCOPE_PROC == kind && id < hdr->nranks) {
+        uint64_t *rankdir = PMIX_GDS_SHMEM_SEG_PTR(hdr, hdr->rankdir);
+        rankdir[id] = off;
+    }
+    // Link onto the tail of its kind.
+    if (0 == ktails[kind]) {
+        hdr->scopes[kind] = off;
+    } else {
+        pmix_gds_shmem_seg_scope_t *prev = PMIX_GDS_SHMEM_SEG_PTR(hdr, ktails[kind]);
+        prev->knext = off;
+    }
+    ktails[kind] = off;
+    *soff = off;
+    return PMIX_SUCCESS;
+}
+
+/**
+ * Returns true if a pmix_value_t of the given type holds no pointers, so it
+ * can be stored as is.
+ */
+static bool
+is_flat_type(
+    pmix_data_type_t type
+) {
+    switch (type) {
+    case PMIX_BOOL:
+    case PMIX_BYTE:
+    case PMIX_SIZE:
+    case PMIX_PID:
+    case PMIX_INT:
+    case PMIX_INT8:
+    case PMIX_INT16:
+    case PMIX_INT32:
+    case PMIX_INT64:
+    case PMIX_UINT:
+    case PMIX_UINT8:
+    case PMIX_UINT16:
+    case PMIX_UINT32:
+    case PMIX_UINT64:
+    case PMIX_FLOAT:
+    case PMIX_DOUBLE:
+    case PMIX_TIMEVAL:
+    case PMIX_TIME:
+    case PMIX_STATUS:
+    case PMIX_PROC_RANK:
+    case PMIX_PERSIST:
+    case PMIX_SCOPE:
+    case PMIX_DATA_RANGE:
+    case PMIX_PROC_STATE:
+    case PMIX_ALLOC_DIRECTIVE:
+    case PMIX_LINK_STATE:
+    case PMIX_JOB_STATE:
+    case PMIX_LOCTYPE:
+    case PMIX_DEVTYPE:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * Writes the value into the image in the cheapest form
+ * a reader can get it back from.
+ */
+static pmix_status_t
+add_value(
+    pmix_gds_shmem_image_t *img,
+    pmix_value_t *val,
+    uint64_t *valoff,
+    uint64_t *vsize,
+    uint32_t *form
+) {
+    pmix_status_t rc;
+    pmix_buffer_t buf;
+
+    if (PMIX_STRING == val->type && NULL != val->data.string) {
+        *form = PMIX_GDS_SHMEM_VALUE_STRING;
+        *vsize = strlen(val->data.string) + 1;
+        return image_strdup(img, val->data.string, valoff);
+    }
+    if (is_flat_type(val->type)) {
+        *form = PMIX_GDS_SHMEM_VALUE_FLAT;
+        *vsize = sizeof(pmix_value_t);
+        rc = image_alloc(img, sizeof(pmix_value_t), valoff);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+        memcpy(img->base + *valoff, val, sizeof(pmix_value_t));
+        return PMIX_SUCCESS;
+    }
+    *form = PMIX_GDS_SHMEM_VALUE_PACKED;
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &buf, val, 1, PMIX_VALUE);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DESTRUCT(&buf);
+        return rc;
+    }
+    *vsize = buf.bytes_used;
+    rc = image_alloc(img, buf.bytes_used, valoff);
+    if (PMIX_SUCCESS == rc) {
+        memcpy(img->base + *valoff, buf.base_ptr, buf.bytes_used);
+    }
+    PMIX_DESTRUCT(&buf);
+    return rc;
+}
+
+static pmix_status_t
+add_entry(
+    pmix_gds_shmem_image_t *img,
+    uint64_t soff,
+    uint64_t *stail,
+    const char *key,
+    pmix_value_t *val
+) {
+    pmix_status_t rc;
+    uint64_t off, keyoff, valoff, vsize;
+    uint32_t form;
+    pmix_gds_shmem_seg_hdr_t *hdr;
+    pmix_gds_shmem_seg_entry_t *entry;
+    pmix_gds_shmem_seg_scope_t *scope;
+    uint64_t *buckets;
+
+    rc = image_strdup(img, key, &keyoff);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    rc = add_value(img, val, &valoff, &vsize, &form);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    rc = image_alloc(img, sizeof(*entry), &off);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    hdr = (pmix_gds_shmem_seg_hdr_t *)img->base;
+    entry = PMIX_GDS_SHMEM_SEG_PTR(hdr, off);
+    entry->scope = soff;
+    entry->key = keyoff;
+    entry->value = valoff;
+    entry->vsize = vsize;
+    entry->form = form;
+    entry->hash = pmix_gds_shmem_entry_hash(soff, key);
+    // Link into the index. Readers of a live segment may be walking
+    // the chain, so the entry must be complete before it is linked.
+    buckets = PMIX_GDS_SHMEM_SEG_PTR(hdr, hdr->ebuckets);
+    const uint64_t b = entry->hash & (hdr->nebuckets - 1);
+    entry->next = buckets[b];
+    pmix_atomic_wmb();
+    buckets[b] = off;
+    // Link onto the tail of its scope.
+    scope = PMIX_GDS_SHMEM_SEG_PTR(hdr, soff);
+    if (0 == *stail) {
+        scope->first = off;
+    } else {
+        pmix_gds_shmem_seg_entry_t *prev = PMIX_GDS_SHMEM_SEG_PTR(hdr, *stail);
+        prev->snext = off;
+    }
+    scope->nentries++;
+    *stail = off;
+    return PMIX_SUCCESS;
+}
+
+/**
+ * Writes the collected scopes into a new image.
+ */
+static pmix_status_t
+layout_image(
+    pmix_gds_shmem_job_t *job,
+    pmix_list_t *scopes,
+    uint8_t **image,
+    size_t *image_size
+) {
+    pmix_status_t rc = PMIX_SUCCESS;
+    pmix_gds_shmem_image_t img = {NULL, 0, 0, false};
+    pmix_gds_shmem_seg_hdr_t *hdr;
+    pmix_gds_shmem_bscope_t *s;
+    pmix_gds_shmem_bval_t *bv;
+    uint64_t off, soff, stail, ktails[PMIX_GDS_SHMEM_SCOPE_NKINDS] = {0};
+    size_t nscopes = 0, nentries = 0;
+
+    *image = NULL;
+    *image_size = 0;
+
+    PMIX_LIST_FOREACH (s, scopes, pmix_gds_shmem_bscope_t) {
+        nscopes += 1 + pmix_argv_count(s->aliases) + (UINT32_MAX != s->id ? 1 : 0);
+        nentries += pmix_list_get_size(&s->vals);
+    }
+
+    // Header and both indices. Aim for a load factor of at most one half.
+    rc = image_alloc(&img, sizeof(*hdr), &off);
+    if (PMIX_SUCCESS != rc) {
+        goto out;
+    }
+    hdr = (pmix_gds_shmem_seg_hdr_t *)img.base;
+    hdr->nsbuckets = next_pow2(2 * nscopes);
+    hdr->nebuckets = next_pow2(2 * nentries);
+    rc = image_alloc(&img, hdr->nsbuckets * sizeof(uint64_t), &off);
+    if (PMIX_SUCCESS != rc) {
+        goto out;
+    }
+    ((pmix_gds_shmem_seg_hdr_t *)img.base)->sbuckets = off;
+    hdr = (pmix_gds_shmem_seg_hdr_t *)img.base;
+    rc = image_alloc(&img, hdr->nebuckets * sizeof(uint64_t), &off);
+    if (PMIX_SUCCESS != rc) {
+        goto out;
+    }
+    ((pmix_gds_shmem_seg_hdr_t *)img.base)->ebuckets = off;
+    // Rank directory, so per-proc lookups need not hash at all.
+    if (0 < job->nptr->nprocs) {
+        rc = image_alloc(&img, job->nptr->nprocs * sizeof(uint64_t), &off);
+        if (PMIX_SUCCESS != rc) {
+            goto out;
+        }
+        hdr = (pmix_gds_shmem_seg_hdr_t *)img.base;
+        hdr->nranks = job->nptr->nprocs;
+        hdr->rankdir = off;
+    }
+
+    PMIX_LIST_FOREACH (s, scopes, pmix_gds_shmem_bscope_t) {
+        rc = add_scope(&img, ktails, s->kind, s->id, s->sel, &soff);
+        if (PMIX_SUCCESS != rc) {
+            goto out;
+        }
+        stail = 0;
+        PMIX_LIST_FOREACH (bv, &s->vals, pmix_gds_shmem_bval_t) {
+            rc = add_entry(&img, soff, &stail, bv->key, bv->value);
+            if (PMIX_SUCCESS != rc) {
+                goto out;
+            }
+        }
+        if (PMIX_GDS_SHMEM_SCOPE_NODE != s->kind) {
+            continue;
+        }
+        // Secondary ways of finding this node.
+        pmix_gds_shmem_seg_scope_t *alias;
+        if (UINT32_MAX != s->id) {
+            rc = add_scope(&img, ktails, PMIX_GDS_SHMEM_SCOPE_NODE_ID, s->id, NULL, &off);
+            if (PMIX_SUCCESS != rc) {
+                goto out;
+            }
+            alias = PMIX_GDS_SHMEM_SEG_PTR(img.base, off);
+            alias->first = soff;
+        }
+        for (size_t n = 0; NULL != s->aliases && NULL != s->aliases[n]; n++) {
+            rc = add_scope(&img, ktails, PMIX_GDS_SHMEM_SCOPE_NODE_ALIAS,
+                           UINT32_MAX, s->aliases[n], &off);
+            if (PMIX_SUCCESS != rc) {
+                goto out;
+            }
+            alias = PMIX_GDS_SHMEM_SEG_PTR(img.base, off);
+            alias->first = soff;
+        }
+    }
+
+    hdr = (pmix_gds_shmem_seg_hdr_t *)img.base;
+    hdr->magic = PMIX_GDS_SHMEM_SEG_MAGIC;
+    hdr->size = img.used;
+    pmix_string_copy(hdr->nspace, job->ns, sizeof(hdr->nspace));
+    pmix_string_copy(hdr->bfrops, pmix_globals.mypeer->nptr->compat.bfrops->version,
+                     sizeof(hdr->bfrops));
+    hdr->buffer_type = pmix_globals.mypeer->nptr->compat.type;
+    hdr->nprocs = job->nptr->nprocs;
+    hdr->value_size = sizeof(pmix_value_t);
+
+    pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                        "gds:" PMIX_GDS_SHMEM_NAME ":%s: %s has %zd scopes, "
+                        "%zd entries in %zd B", __func__, job->ns,
+                        nscopes, nentries, img.used);
+    *image = img.base;
+    *image_size = img.used;
+    img.base = NULL;
+out:
+    free(img.base);
+    return rc;
+}
+
+pmix_status_t
+pmix_gds_shmem_build_image(
+    pmix_gds_shmem_job_t *job,
+    pmix_list_t *kvs,
+    uint8_t **image,
+    size_t *image_size
+) {
+    pmix_status_t rc;
+    pmix_list_t scopes;
+
+    PMIX_CONSTRUCT(&scopes, pmix_list_t);
+    rc = collect_scopes(kvs, &scopes);
+    if (PMIX_SUCCESS == rc) {
+        rc = layout_image(job, &scopes, image, image_size);
+    }
+    PMIX_LIST_DESTRUCT(&scopes);
+    return rc;
+}
+
+pmix_status_t
+pmix_gds_shmem_build_modex_image(
+    pmix_gds_shmem_job_t *job,
+    pmix_list_t *procs,
+    uint8_t **image,
+    size_t *image_size
+) {
+    pmix_status_t rc;
+    pmix_list_t scopes;
+    pmix_gds_shmem_modex_proc_t *p;
+    pmix_gds_shmem_bscope_t *s;
+    pmix_kval_t *kv;
+
+    // Each rank contributes exactly once per fence, so no need to search.
+    PMIX_CONSTRUCT(&scopes, pmix_list_t);
+    PMIX_LIST_FOREACH (p, procs, pmix_gds_shmem_modex_proc_t) {
+        s = PMIX_NEW(pmix_gds_shmem_bscope_t);
+        s->id = p->rank;
+        PMIX_LIST_FOREACH (kv, &p->kvs, pmix_kval_t) {
+            bscope_add(s, kv->key, kv->value);
+        }
+        pmix_list_append(&scopes, &s->super);
+    }
+    rc = layout_image(job, &scopes, image, image_size);
+    PMIX_LIST_DESTRUCT(&scopes);
+    return rc;
+}
+
+pmix_status_t
+pmix_gds_shmem_modex_append(
+    pmix_gds_shmem_job_t *job,
+    pmix_rank_t rank,
+    pmix_list_t *kvs
+) {
+    pmix_status_t rc;
+    pmix_gds_shmem_seg_hdr_t *hdr = job->modex->base_address;
+    pmix_gds_shmem_image_t img = {(uint8_t *)hdr, job->modex_used, hdr->size, true};
+    pmix_gds_shmem_seg_scope_t *scope;
+    pmix_kval_t *kv;
+    uint64_t soff, stail = 0;
+
+    if (rank >= hdr->nranks) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    rc = image_alloc(&img, sizeof(*scope), &soff);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    // Only the rank directory leads to it, so no need for the scope index.
+    scope = PMIX_GDS_SHMEM_SEG_PTR(hdr, soff);
+    scope->kind = PMIX_GDS_SHMEM_SCOPE_PROC;
+    scope->id = rank;
+    scope->hash = pmix_gds_shmem_scope_hash(PMIX_GDS_SHMEM_SCOPE_PROC, rank, NULL);
+    PMIX_LIST_FOREACH (kv, kvs, pmix_kval_t) {
+        rc = add_entry(&img, soff, &stail, kv->key, kv->value);
+        if (PMIX_SUCCESS != rc) {
+            break;
+        }
+    }
+    // Entries already linked into the index may be visited by readers,
+    // so whatever we used stays used even if we failed.
+    job->modex_used = img.used;
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    // Readers switch to the new data in one store.
+    pmix_atomic_wmb();
+    ((volatile uint64_t *)PMIX_GDS_SHMEM_SEG_PTR(hdr, hdr->rankdir))[rank] = soff;
+    return PMIX_SUCCESS;
+}
@@ -19,25 +19,31 @@
 #include "gds_shmem_utils.h"
 #include "gds_shmem.h"
 
+#include "src/mca/gds/base/base.h"
+
 pmix_status_t
 pmix_gds_shmem_get_job_tracker(
     const pmix_nspace_t nspace,
+    bool create,
     pmix_gds_shmem_job_t **job
 ) {
     pmix_status_t rc = PMIX_SUCCESS;
     pmix_list_t *myjobs = &pmix_mca_gds_shmem_component.myjobs;
-    pmix_gds_shmem_job_t *target_tracker = NULL, *tracker = NULL;
+    pmix_hash_table_t *jobs_index = &pmix_mca_gds_shmem_component.myjobs_index;
+    pmix_gds_shmem_job_t *target_tracker = NULL;
+    const size_t nslen = strnlen(nspace, PMIX_MAX_NSLEN);
     // Try to find the tracker for this job.
-    // TODO(skg) Consider using a hash table here for lookup.
-    PMIX_LIST_FOREACH (tracker, myjobs, pmix_gds_shmem_job_t) {
-        if (0 == strcmp(nspace, tracker->ns)) {
-            target_tracker = tracker;
-            break;
-        }
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(
+            jobs_index, nspace, nslen, (void **)&target_tracker)) {
+        target_tracker = NULL;
+    }
+    if (!target_tracker && !create) {
+        rc = PMIX_ERR_NOT_FOUND;
+        goto out;
     }
     // Create one if not found.
     if (!target_tracker) {
-        pmix_namespace_t *ns = NULL, *nptr = NULL;
+        pmix_namespace_t *nptr = NULL;
         target_tracker = PMIX_NEW(pmix_gds_shmem_job_t);
         if (!target_tracker) {
             rc = PMIX_ERR_NOMEM;
@@ -45,12 +51,7 @@ pmix_gds_shmem_get_job_tracker(
         }
         target_tracker->ns = strdup(nspace);
         // See if we already have this nspace in global namespaces.
-        PMIX_LIST_FOREACH (ns, &pmix_globals.nspaces, pmix_namespace_t) {
-            if (0 == strcmp(ns->nspace, nspace)) {
-                nptr = ns;
-                break;
-            }
-        }
+        nptr = pmix_nspace_lookup(nspace);
         // If not, create one and update global namespace list.
         if (!nptr) {
             nptr = PMIX_NEW(pmix_namespace_t);
@@ -59,11 +60,17 @@ pmix_gds_shmem_get_job_tracker(
                 goto out;
             }
             nptr->nspace = strdup(nspace);
-            pmix_list_append(&pmix_globals.nspaces, &nptr->super);
+            pmix_nspace_register(nptr);
         }
         PMIX_RETAIN(nptr);
         target_tracker->nptr = nptr;
-        // Add it to the list of jobs I'm supporting.
+        // Add it to the jobs I'm supporting.
+        rc = pmix_hash_table_set_value_ptr(
+            jobs_index, target_tracker->ns, nslen, target_tracker
+        );
+        if (PMIX_SUCCESS != rc) {
+            goto out;
+        }
         pmix_list_append(myjobs, &target_tracker->super);
     }
 out:
@@ -76,3 +83,22 @@ out:
     *job = target_tracker;
     return rc;
 }
+
+pmix_gds_base_module_t *
+pmix_gds_shmem_hash_module(void)
+{
+    pmix_gds_shmem_component_t *c = &pmix_mca_gds_shmem_component;
+    pmix_gds_base_active_module_t *active;
+
+    if (NULL == c->hash) {
+        // Look it up by name: asking for a module assignment would
+        // land back in our own assign_module.
+        PMIX_LIST_FOREACH (active, &pmix_gds_globals.actives, pmix_gds_base_active_module_t) {
+            if (0 == strcmp(active->module->name, "hash")) {
+                c->hash = active->module;
+                break;
+            }
+        }
+    }
+    return c->hash;
+}
@@ -25,7 +25,91 @@
 PMIX_EXPORT pmix_status_t
 pmix_gds_shmem_get_job_tracker(
     const pmix_nspace_t nspace,
+    bool create,
     pmix_gds_shmem_job_t **job
 );
 
+/**
+ * Returns the hash module, to which we hand everything that does not live in
+ * the shared-memory segments (e.g., locally put values).
+ */
+PMIX_EXPORT pmix_gds_base_module_t *
+pmix_gds_shmem_hash_module(void);
+
+/**
+ * Builds the segment image for the given job from the complete job-level data
+ * (as returned by a fetch of rank PMIX_RANK_WILDCARD with a NULL key).
+ * The caller owns the returned image.
+ */
+PMIX_EXPORT pmix_status_t
+pmix_gds_shmem_build_image(
+    pmix_gds_shmem_job_t *job,
+    pmix_list_t *kvs,
+    uint8_t **image,
+    size_t *image_size
+);
+
+/**
+ * Builds a modex segment image for the given job from the data collected by
+ * a fence, given as a list of pmix_gds_shmem_modex_proc_t.
+ * The caller owns the returned image.
+ */
+PMIX_EXPORT pmix_status_t
+pmix_gds_shmem_build_modex_image(
+    pmix_gds_shmem_job_t *job,
+    pmix_list_t *procs,
+    uint8_t **image,
+    size_t *image_size
+);
+
+/**
+ * Appends a proc's modex data, given as a list of pmix_kval_t, to the job's
+ * live modex segment and makes it the data readers find for that rank.
+ * Returns PMIX_ERR_OUT_OF_RESOURCE if the segment is full.
+ * Note: only servers enter here.
+ */
+PMIX_EXPORT pmix_status_t
+pmix_gds_shmem_modex_append(
+    pmix_gds_shmem_job_t *job,
+    pmix_rank_t rank,
+    pmix_list_t *kvs
+);
+
+/**
+ * Validates a mapped segment for use by this process.
+ */
+PMIX_EXPORT bool
+pmix_gds_shmem_seg_valid(
+    const pmix_gds_shmem_seg_hdr_t *hdr,
+    size_t size
+);
+
+/**
+ * Fetches from the job's attached segment. Returns PMIX_ERR_NOT_FOUND if the
+ * segment cannot answer the request.
+ */
+PMIX_EXPORT pmix_status_t
+pmix_gds_shmem_seg_fetch(
+    pmix_gds_shmem_job_t *job,
+    const pmix_proc_t *proc,
+    pmix_scope_t scope,
+    const char *key,
+    pmix_info_t qualifiers[],
+    size_t nqual,
+    pmix_list_t *kvs
+);
+
+/**
+ * Fetches a proc's modex data from the job's attached modex segment. Returns
+ * PMIX_ERR_NOT_FOUND if the segment cannot answer the request.
+ */
+PMIX_EXPORT pmix_status_t
+pmix_gds_shmem_modex_fetch(
+    pmix_gds_shmem_job_t *job,
+    const pmix_proc_t *proc,
+    pmix_scope_t scope,
+    const char *key,
+    pmix_list_t *kvs
+);
+
 #endif
@@ -40,6 +40,13 @@ static bool compress_block(const uint8_t *inblock, size_t size, uint8_t **outbyt
     return false;
 }
 
+static bool compress_level(const uint8_t *inblock, size_t size, int level, uint8_t **outbytes,
+                           size_t *nbytes)
+{
+    (void) level;
+    return compress_block(inblock, size, outbytes, nbytes);
+}
+
 static bool decompress_block(uint8_t **outbytes, size_t *outlen, const uint8_t *inbytes, size_t len)
 {
     (void) outbytes;
@@ -72,7 +79,8 @@ static bool decompress_string(char **outstring, uint8_t *inbytes, size_t len)
 pmix_compress_base_module_t pmix_compress = {.compress = compress_block,
                                              .decompress = decompress_block,
                                              .compress_string = compress_string,
-                                             .decompress_string = decompress_string};
+                                             .decompress_string = decompress_string,
+                                             .compress_level = compress_level};
 pmix_compress_base_t pmix_compress_base = {
     .compress_limit = 0,
     .selected = false,
@@ -75,6 +75,17 @@ typedef bool (*pmix_compress_base_module_compress_fn_t)(const uint8_t *inbytes,
 typedef bool (*pmix_compress_base_module_decompress_fn_t)(uint8_t **outbytes, size_t *outlen,
                                                           const uint8_t *inbytes, size_t len);
 
+/**
+ * Compress a block at the given level regardless of the
+ * compression limit - the level is interpreted by the codec,
+ * with lower values trading ratio for speed. Returns false if
+ * the block could not be made smaller. The result is decompressed
+ * with the decompress interface.
+ */
+typedef bool (*pmix_compress_base_module_compress_level_fn_t)(const uint8_t *inbytes, size_t size,
+                                                              int level, uint8_t **outbytes,
+                                                              size_t *nbytes);
+
 /**
  * Structure for COMPRESS components.
  */
@@ -98,6 +109,9 @@ struct pmix_compress_base_module_1_0_0_t {
     /* COMPRESS STRING */
     pmix_compress_base_module_compress_string_fn_t compress_string;
     pmix_compress_base_module_decompress_string_fn_t decompress_string;
+
+    /** Compress at a caller-selected level */
+    pmix_compress_base_module_compress_level_fn_t compress_level;
 };
 typedef struct pmix_compress_base_module_1_0_0_t pmix_compress_base_module_1_0_0_t;
 typedef struct pmix_compress_base_module_1_0_0_t pmix_compress_base_module_t;
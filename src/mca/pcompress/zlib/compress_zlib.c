@@ -19,6 +19,9 @@
 #include "pmix_config.h"
 
 #include <string.h>
+#ifdef HAVE_ARPA_INET_H
+#    include <arpa/inet.h>
+#endif
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/wait.h>
@@ -48,41 +51,45 @@ static bool compress_string(char *instring, uint8_t **outbytes, size_t *nbytes);
 
 static bool decompress_string(char **outstring, uint8_t *inbytes, size_t len);
 
+static bool zlib_compress_level(const uint8_t *inbytes, size_t inlen, int level, uint8_t **outbytes,
+                                size_t *outlen);
+
 pmix_compress_base_module_t pmix_pcompress_zlib_module = {
     .compress = zlib_compress,
     .decompress = zlib_decompress,
     .compress_string = compress_string,
     .decompress_string = decompress_string,
+    .compress_level = zlib_compress_level,
 };
 
-static bool zlib_compress(const uint8_t *inbytes, size_t inlen, uint8_t **outbytes, size_t *outlen)
+static bool deflate_block(const uint8_t *inbytes, size_t inlen, int level, uint8_t **outbytes,
+                          size_t *outlen)
 {
     z_stream strm;
     size_t len, len2;
     uint8_t *tmp, *ptr;
+    uint32_t prefix;
     int rc;
 
     /* set default output */
     *outbytes = NULL;
     *outlen = 0;
 
-    if (inlen < pmix_compress_base.compress_limit) {
+    /* the uncompressed size is passed in 4 bytes */
+    if (UINT32_MAX < inlen) {
         return false;
     }
 
     /* setup the stream */
     memset(&strm, 0, sizeof(strm));
-    deflateInit(&strm, 9);
-
-    /* get an upper bound on the required output storage */
-    len = deflateBound(&strm, inlen);
-    /* if this isn't going to result in a smaller footprint,
-     * then don't do it */
-    if (len >= inlen) {
-        (void) deflateEnd(&strm);
+    if (Z_OK != deflateInit(&strm, level)) {
         return false;
     }
 
+    /* get an upper bound on the required output storage - this
+     * is always a little more than the input, so we can only
+     * tell whether compression paid off once it is done */
+    len = deflateBound(&strm, inlen);
     if (NULL == (tmp = (uint8_t *) malloc(len))) {
         (void) deflateEnd(&strm);
         return false;
@@ -97,7 +104,7 @@ static bool zlib_compress(const uint8_t *inbytes, size_t inlen, uint8_t **outbyt
 
     rc = deflate(&strm, Z_FINISH);
     (void) deflateEnd(&strm);
-    if (Z_OK != rc && Z_STREAM_END != rc) {
+    if (Z_STREAM_END != rc) {
         free(tmp);
         return false;
     }
@@ -106,6 +113,12 @@ static bool zlib_compress(const uint8_t *inbytes, size_t inlen, uint8_t **outbyt
      * can pass the size of the uncompressed block to the
      * decompress side */
     len2 = len - strm.avail_out + sizeof(uint32_t);
+    /* if this didn't result in a smaller footprint,
+     * then don't use it */
+    if (len2 >= inlen) {
+        free(tmp);
+        return false;
+    }
     ptr = (uint8_t *) malloc(len2);
     if (NULL == ptr) {
         free(tmp);
@@ -114,8 +127,10 @@ static bool zlib_compress(const uint8_t *inbytes, size_t inlen, uint8_t **outbyt
     *outbytes = ptr;
     *outlen = len2;
 
-    /* fold the uncompressed length into the buffer */
-    memcpy(ptr, &inlen, sizeof(uint32_t));
+    /* fold the uncompressed length into the buffer - in network
+     * order, as the block may be sent to another server */
+    prefix = htonl((uint32_t) inlen);
+    memcpy(ptr, &prefix, sizeof(uint32_t));
     ptr += sizeof(uint32_t);
     /* bring over the compressed data */
     memcpy(ptr, tmp, len2 - sizeof(uint32_t));
@@ -126,6 +141,26 @@ static bool zlib_compress(const uint8_t *inbytes, size_t inlen, uint8_t **outbyt
     return true; // we did the compression
 }
 
+static bool zlib_compress(const uint8_t *inbytes, size_t inlen, uint8_t **outbytes, size_t *outlen)
+{
+    if (inlen < pmix_compress_base.compress_limit) {
+        /* set default output */
+        *outbytes = NULL;
+        *outlen = 0;
+        return false;
+    }
+    return deflate_block(inbytes, inlen, Z_DEFAULT_COMPRESSION, outbytes, outlen);
+}
+
+static bool zlib_compress_level(const uint8_t *inbytes, size_t inlen, int level, uint8_t **outbytes,
+                                size_t *outlen)
+{
+    if (level < Z_NO_COMPRESSION || Z_BEST_COMPRESSION < level) {
+        level = Z_DEFAULT_COMPRESSION;
+    }
+    return deflate_block(inbytes, inlen, level, outbytes, outlen);
+}
+
 static bool compress_string(char *instring, uint8_t **outbytes, size_t *nbytes)
 {
     uint32_t inlen;
@@ -165,7 +200,8 @@ static bool doit(uint8_t **outbytes, size_t len2, const uint8_t *inbytes, size_t
 
     rc = inflate(&strm, Z_FINISH);
     inflateEnd(&strm);
-    if (Z_OK == rc) {
+    /* the whole block must have been inflated */
+    if (Z_STREAM_END == rc) {
         *outbytes = dest;
         return true;
     }
@@ -174,21 +210,25 @@ static bool doit(uint8_t **outbytes, size_t len2, const uint8_t *inbytes, size_t
 }
 static bool zlib_decompress(uint8_t **outbytes, size_t *outlen, const uint8_t *inbytes, size_t inlen)
 {
-    int32_t len2;
+    uint32_t len2;
     bool rc;
     uint8_t *input;
 
     /* set the default error answer */
     *outlen = 0;
+    if (inlen < sizeof(uint32_t)) {
+        return false;
+    }
 
     /* the first 4 bytes contains the uncompressed size */
     memcpy(&len2, inbytes, sizeof(uint32_t));
+    len2 = ntohl(len2);
 
     pmix_output_verbose(2, pmix_pcompress_base_framework.framework_output,
-                        "DECOMPRESSING INPUT OF LEN %" PRIsize_t " OUTPUT %d", inlen, len2);
+                        "DECOMPRESSING INPUT OF LEN %" PRIsize_t " OUTPUT %u", inlen, len2);
 
     input = (uint8_t *) (inbytes + sizeof(uint32_t)); // step over the size
-    rc = doit(outbytes, len2, input, inlen);
+    rc = doit(outbytes, len2, input, inlen - sizeof(uint32_t));
     if (rc) {
         *outlen = len2;
         return true;
@@ -198,22 +238,23 @@ static bool zlib_decompress(uint8_t **outbytes, size_t *outlen, const uint8_t *i
 
 static bool decompress_string(char **outstring, uint8_t *inbytes, size_t len)
 {
-    int32_t len2;
+    uint32_t len2;
     bool rc;
     uint8_t *input;
 
     /* the first 4 bytes contains the uncompressed size */
     memcpy(&len2, inbytes, sizeof(uint32_t));
+    len2 = ntohl(len2);
     /* add one to hold the NULL terminator */
     ++len2;
 
     /* decompress the bytes */
     input = (uint8_t *) (inbytes + sizeof(uint32_t)); // step over the size
-    rc = doit((uint8_t **) outstring, len2, input, len);
+    rc = doit((uint8_t **) outstring, len2, input, len - sizeof(uint32_t));
 
     if (rc) {
         /* ensure this is NULL terminated! */
-        outstring[len2 - 1] = NULL;
+        (*outstring)[len2 - 1] = '\0';
         return true;
     }
 
@@ -167,13 +167,13 @@ void pmix_pfexec_base_spawn_proc(int sd, short args, void *cbdata)
     /* add the nspace to the server global list */
     nptr = PMIX_NEW(pmix_namespace_t);
     nptr->nspace = strdup(nspace);
-    pmix_list_append(&pmix_globals.nspaces, &nptr->super);
+    pmix_nspace_register(nptr);
 
     /* locally cache any job info that will later need to
      * be communicated to the spawned job */
     rc = register_nspace(nspace, fcd);
     if (PMIX_SUCCESS != rc) {
-        pmix_list_remove_item(&pmix_globals.nspaces, &nptr->super);
+        pmix_nspace_deregister(nptr);
         PMIX_RELEASE(nptr);
         goto complete;
     }
@@ -594,7 +594,7 @@ static pmix_status_t register_nspace(char *nspace, pmix_pfexec_fork_caddy_t *fcd
     pmix_proc_t proc;
     pmix_rank_t zero = 0, rk;
     pmix_info_t *info = NULL;
-    pmix_namespace_t *nptr, *tmp;
+    pmix_namespace_t *nptr;
     void *jinfo, *tmpinfo, *pinfo;
     pmix_data_array_t darray;
     char *str;
@@ -609,20 +609,14 @@ static pmix_status_t register_nspace(char *nspace, pmix_pfexec_fork_caddy_t *fcd
     }
 
     /* see if we already have this nspace */
-    nptr = NULL;
-    PMIX_LIST_FOREACH (tmp, &pmix_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(tmp->nspace, nspace)) {
-            nptr = tmp;
-            break;
-        }
-    }
+    nptr = pmix_nspace_lookup(nspace);
     if (NULL == nptr) {
         nptr = PMIX_NEW(pmix_namespace_t);
         if (NULL == nptr) {
             return PMIX_ERR_NOMEM;
         }
         nptr->nspace = strdup(nspace);
-        pmix_list_append(&pmix_globals.nspaces, &nptr->super);
+        pmix_nspace_register(nptr);
     }
     nptr->nlocalprocs = nprocs;
 
@@ -37,7 +37,7 @@ pmix_status_t pmix_pnet_base_allocate(char *nspace, pmix_info_t info[], size_t n
 {
     pmix_pnet_base_active_module_t *active;
     pmix_status_t rc;
-    pmix_namespace_t *nptr, *ns;
+    pmix_namespace_t *nptr;
 
     pmix_output_verbose(2, pmix_pnet_base_framework.framework_output, "pnet:allocate called");
 
@@ -51,13 +51,7 @@ pmix_status_t pmix_pnet_base_allocate(char *nspace, pmix_info_t info[], size_t n
     }
 
     /* find this proc's nspace object */
-    nptr = NULL;
-    PMIX_LIST_FOREACH (ns, &pmix_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(ns->nspace, nspace)) {
-            nptr = ns;
-            break;
-        }
-    }
+    nptr = pmix_nspace_lookup(nspace);
     if (NULL == nptr) {
         /* add it */
         nptr = PMIX_NEW(pmix_namespace_t);
@@ -65,7 +59,7 @@ pmix_status_t pmix_pnet_base_allocate(char *nspace, pmix_info_t info[], size_t n
             return PMIX_ERR_NOMEM;
         }
         nptr->nspace = strdup(nspace);
-        pmix_list_append(&pmix_globals.nspaces, &nptr->super);
+        pmix_nspace_register(nptr);
     }
 
     if (PMIX_PEER_IS_SERVER(pmix_globals.mypeer)) {
@@ -90,7 +84,7 @@ pmix_status_t pmix_pnet_base_setup_local_network(char *nspace, pmix_info_t info[
 {
     pmix_pnet_base_active_module_t *active;
     pmix_status_t rc;
-    pmix_namespace_t *nsp, *nsp2;
+    pmix_namespace_t *nsp;
     pmix_nspace_env_cache_t *ns, *ns2;
 
     pmix_output_verbose(2, pmix_pnet_base_framework.framework_output,
@@ -115,13 +109,7 @@ pmix_status_t pmix_pnet_base_setup_local_network(char *nspace, pmix_info_t info[
     }
     if (NULL == ns) {
         /* find the namespace object for this nspace */
-        nsp = NULL;
-        PMIX_LIST_FOREACH (nsp2, &pmix_globals.nspaces, pmix_namespace_t) {
-            if (0 == strcmp(nsp2->nspace, nspace)) {
-                nsp = nsp2;
-                break;
-            }
-        }
+        nsp = pmix_nspace_lookup(nspace);
         if (NULL == nsp) {
             /* add it */
             nsp = PMIX_NEW(pmix_namespace_t);
@@ -129,7 +117,7 @@ pmix_status_t pmix_pnet_base_setup_local_network(char *nspace, pmix_info_t info[
                 return PMIX_ERR_NOMEM;
             }
             nsp->nspace = strdup(nspace);
-            pmix_list_append(&pmix_globals.nspaces, &nsp->super);
+            pmix_nspace_register(nsp);
         }
         ns = PMIX_NEW(pmix_nspace_env_cache_t);
         PMIX_RETAIN(nsp);
@@ -233,6 +233,16 @@ pmix_psquash_base_module_t pmix_flex128_module = {.name = "flex128",
 static pmix_status_t flex128_init(void)
 {
     pmix_output_verbose(2, pmix_globals.debug_output, "psquash: flex128 init");
+
+    /* integer arrays are encoded one value at a time unless group
+     * varints were asked for */
+    pmix_flex128_module.encode_ints = NULL;
+    pmix_flex128_module.decode_ints = NULL;
+    if (pmix_mca_psquash_flex128_component.group_varint) {
+        pmix_flex128_module.encode_ints = pmix_flex128_encode_ints;
+        pmix_flex128_module.decode_ints = pmix_flex128_decode_ints;
+        return pmix_flex128_array_init(pmix_mca_psquash_flex128_component.simd);
+    }
     return PMIX_SUCCESS;
 }
 
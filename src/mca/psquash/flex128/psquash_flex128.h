@@ -18,10 +18,25 @@
 
 BEGIN_C_DECLS
 
+typedef struct {
+    pmix_psquash_base_component_t super;
+    /* encode arrays of 16- and 32-bit integers as group varints */
+    bool group_varint;
+    /* decode group varints with SSSE3/AVX2 when the CPU has them */
+    bool simd;
+} pmix_psquash_flex128_component_t;
+
 /* the component must be visible data for the linker to find it */
-PMIX_EXPORT extern pmix_psquash_base_component_t pmix_mca_psquash_flex128_component;
+PMIX_EXPORT extern pmix_psquash_flex128_component_t pmix_mca_psquash_flex128_component;
 extern pmix_psquash_base_module_t pmix_flex128_module;
 
+/* group varint array codec - see psquash_flex128_array.c */
+pmix_status_t pmix_flex128_array_init(bool simd);
+pmix_status_t pmix_flex128_encode_ints(pmix_data_type_t type, const void *src, int32_t num_vals,
+                                       void *dest, size_t *dst_len);
+pmix_status_t pmix_flex128_decode_ints(pmix_data_type_t type, const void *src, size_t src_len,
+                                       void *dest, int32_t num_vals, size_t *src_used);
+
 END_C_DECLS
 
 #endif
@@ -0,0 +1,371 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Group varint encoding of integer arrays
+ *
+ * The base-7 encoding of single values has to look at every byte to
+ * find where a value ends, which makes decoding a long array a chain
+ * of dependent branches. Group varints move the lengths out of the
+ * data: values go in groups of four, each led by a control byte that
+ * holds the length (1 to 4 bytes) of its four values in two bits
+ * apiece, value 0 in the low bits. The values follow, little-endian,
+ * in as many bytes as they need. A final group of fewer than four
+ * values has a full control byte, but no bytes for the missing values.
+ *
+ * Signed values are first folded just as the single value encoding
+ * does - the sign moves to the low bit - so small negatives stay short.
+ *
+ * Because the control byte gives the position of every byte of the
+ * group, a whole group can be decoded with one byte shuffle. That is
+ * done with SSSE3 (one group at a time) or AVX2 (two at a time) when
+ * the CPU has them, as checked when the module is initialized, and in
+ * plain C otherwise. Only 32-bit values are decoded that way - 16-bit
+ * ones are checked for overflow and always take the plain C path.
+ */
+
+#include "src/include/pmix_config.h"
+
+#include "pmix_common.h"
+
+#include "src/include/pmix_globals.h"
+#include "src/util/pmix_output.h"
+
+#include <string.h>
+
+#include "psquash_flex128.h"
+#include "src/mca/psquash/base/base.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) \
+    && (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5))
+#    define FLEX128_GVINT_X86 1
+#    include <immintrin.h>
+#else
+#    define FLEX128_GVINT_X86 0
+#endif
+
+/* shorter arrays are encoded one value at a time */
+#define FLEX128_GVINT_MIN_VALS 8
+
+/* what the shuffle decoders need to know about each control byte:
+ * where each byte of the four values comes from (0x80 for none)
+ * and the number of data bytes in the group */
+static uint8_t gvint_shuffle[256][16] __pmix_attribute_aligned__(16);
+static uint8_t gvint_length[256];
+
+/* decode as many whole groups of 32-bit values as can be safely
+ * read from src, returning the bytes read and updating the number
+ * of values to those decoded */
+typedef size_t (*gvint_bulk_fn_t)(const uint8_t *src, size_t src_len, uint32_t *dest,
+                                  int32_t *num_vals, bool zigzag);
+
+static gvint_bulk_fn_t gvint_bulk = NULL;
+
+/* the width of the values of a type, and whether they are signed */
+static bool gvint_type(pmix_data_type_t type, size_t *size, bool *zigzag)
+{
+    switch (type) {
+    case PMIX_INT16:
+        *size = 2;
+        *zigzag = true;
+        return true;
+    case PMIX_UINT16:
+        *size = 2;
+        *zigzag = false;
+        return true;
+    case PMIX_INT32:
+        *size = 4;
+        *zigzag = true;
+        return true;
+    case PMIX_UINT32:
+        *size = 4;
+        *zigzag = false;
+        return true;
+    case PMIX_INT:
+        *size = SIZEOF_INT;
+        *zigzag = true;
+        return 4 == SIZEOF_INT;
+    case PMIX_UINT:
+        *size = SIZEOF_INT;
+        *zigzag = false;
+        return 4 == SIZEOF_INT;
+    default:
+        return false;
+    }
+}
+
+static inline uint32_t gvint_load(const uint8_t *src, size_t size, bool zigzag)
+{
+    uint16_t u16;
+    int16_t i16;
+    uint32_t u32;
+
+    if (2 == size) {
+        if (zigzag) {
+            memcpy(&i16, src, sizeof(i16));
+            u32 = (uint32_t) (int32_t) i16;
+        } else {
+            memcpy(&u16, src, sizeof(u16));
+            return u16;
+        }
+    } else {
+        memcpy(&u32, src, sizeof(u32));
+        if (!zigzag) {
+            return u32;
+        }
+    }
+    /* same as ~v << 1 | 1 for negative values, v << 1 otherwise */
+    return (u32 << 1) ^ (0 - (u32 >> 31));
+}
+
+static inline pmix_status_t gvint_store(uint32_t val, uint8_t *dest, size_t size, bool zigzag)
+{
+    uint16_t u16;
+
+    if (zigzag) {
+        val = (val >> 1) ^ (0 - (val & 1));
+    }
+    if (2 == size) {
+        /* folded or not, a 16-bit value never needs more than 16 bits */
+        if (PMIX_UNLIKELY((zigzag ? (val + 0x8000) : val) > 0xffff)) {
+            return PMIX_ERR_UNPACK_FAILURE;
+        }
+        u16 = (uint16_t) val;
+        memcpy(dest, &u16, sizeof(u16));
+        return PMIX_SUCCESS;
+    }
+    memcpy(dest, &val, sizeof(val));
+    return PMIX_SUCCESS;
+}
+
+static inline size_t gvint_len(uint32_t val)
+{
+    return 1 + (val > 0xff) + (val > 0xffff) + (val > 0xffffff);
+}
+
+/* values are read and written as whole little-endian words, and
+ * then only as many bytes as they need are kept */
+static inline void gvint_put(uint8_t *dest, uint32_t val)
+{
+#ifdef WORDS_BIGENDIAN
+    dest[0] = (uint8_t) val;
+    dest[1] = (uint8_t) (val >> 8);
+    dest[2] = (uint8_t) (val >> 16);
+    dest[3] = (uint8_t) (val >> 24);
+#else
+    memcpy(dest, &val, sizeof(val));
+#endif
+}
+
+static inline uint32_t gvint_get(const uint8_t *src, size_t len)
+{
+    uint32_t val;
+
+#ifdef WORDS_BIGENDIAN
+    val = (uint32_t) src[0] | ((uint32_t) src[1] << 8) | ((uint32_t) src[2] << 16)
+          | ((uint32_t) src[3] << 24);
+#else
+    memcpy(&val, src, sizeof(val));
+#endif
+    return val & (0xffffffffU >> (32 - 8 * len));
+}
+
+pmix_status_t pmix_flex128_encode_ints(pmix_data_type_t type, const void *src, int32_t num_vals,
+                                       void *dest, size_t *dst_len)
+{
+    const uint8_t *in = (const uint8_t *) src;
+    uint8_t *out = (uint8_t *) dest, *ctl = NULL;
+    size_t size, len, total = 0;
+    uint32_t val;
+    bool zigzag;
+    int32_t i;
+
+    if (num_vals < FLEX128_GVINT_MIN_VALS || !gvint_type(type, &size, &zigzag)) {
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+
+    for (i = 0; i < num_vals; i++) {
+        if (0 == (i & 3)) {
+            /* start a new group */
+            if (NULL != out) {
+                ctl = out + total;
+                *ctl = 0;
+            }
+            ++total;
+        }
+        val = gvint_load(in + i * size, size, zigzag);
+        len = gvint_len(val);
+        if (NULL != out) {
+            /* the whole word fits within the space bfrops reserves
+             * for the array - num_vals times the maximum size */
+            *ctl |= (uint8_t) ((len - 1) << (2 * (i & 3)));
+            gvint_put(out + total, val);
+        }
+        total += len;
+    }
+    *dst_len = total;
+    return PMIX_SUCCESS;
+}
+
+pmix_status_t pmix_flex128_decode_ints(pmix_data_type_t type, const void *src, size_t src_len,
+                                       void *dest, int32_t num_vals, size_t *src_used)
+{
+    const uint8_t *in = (const uint8_t *) src;
+    uint8_t *out = (uint8_t *) dest;
+    size_t size, len, b, pos = 0;
+    pmix_status_t rc;
+    uint32_t val;
+    uint8_t ctl = 0;
+    bool zigzag;
+    int32_t i = 0;
+
+    if (num_vals < FLEX128_GVINT_MIN_VALS || !gvint_type(type, &size, &zigzag)) {
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+
+    if (4 == size && NULL != gvint_bulk) {
+        i = num_vals;
+        pos = gvint_bulk(in, src_len, (uint32_t *) dest, &i, zigzag);
+    }
+
+    for (; i < num_vals; i++) {
+        if (0 == (i & 3)) {
+            if (PMIX_UNLIKELY(pos >= src_len)) {
+                return PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+            }
+            ctl = in[pos++];
+        }
+        len = ((ctl >> (2 * (i & 3))) & 3) + 1;
+        if (PMIX_LIKELY(src_len - pos >= sizeof(val))) {
+            val = gvint_get(in + pos, len);
+        } else if (src_len - pos >= len) {
+            for (b = 0, val = 0; b < len; b++) {
+                val |= (uint32_t) in[pos + b] << (8 * b);
+            }
+        } else {
+            return PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+        }
+        pos += len;
+        rc = gvint_store(val, out + i * size, size, zigzag);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    }
+    *src_used = pos;
+    return PMIX_SUCCESS;
+}
+
+#if FLEX128_GVINT_X86
+
+/* a group is only decoded with a shuffle when all 16 bytes following
+ * its control byte can be read, whether they are its own or not */
+
+__attribute__((target("ssse3"))) static size_t gvint_bulk_ssse3(const uint8_t *src,
+                                                                 size_t src_len, uint32_t *dest,
+                                                                 int32_t *num_vals, bool zigzag)
+{
+    const __m128i one = _mm_set1_epi32(1);
+    const uint8_t *p = src, *end = src + src_len;
+    __m128i v;
+    int32_t i = 0;
+
+    while (i + 4 <= *num_vals && 17 <= end - p) {
+        v = _mm_loadu_si128((const __m128i *) (p + 1));
+        v = _mm_shuffle_epi8(v, _mm_loadu_si128((const __m128i *) gvint_shuffle[p[0]]));
+        if (zigzag) {
+            v = _mm_xor_si128(_mm_srli_epi32(v, 1),
+                              _mm_sub_epi32(_mm_setzero_si128(), _mm_and_si128(v, one)));
+        }
+        _mm_storeu_si128((__m128i *) (dest + i), v);
+        p += 1 + gvint_length[p[0]];
+        i += 4;
+    }
+    *num_vals = i;
+    return p - src;
+}
+
+__attribute__((target("avx2"))) static size_t gvint_bulk_avx2(const uint8_t *src, size_t src_len,
+                                                               uint32_t *dest, int32_t *num_vals,
+                                                               bool zigzag)
+{
+    const __m256i one = _mm256_set1_epi32(1);
+    const uint8_t *p = src, *q, *end = src + src_len;
+    __m256i v, shuf;
+    int32_t i = 0, n;
+    size_t used;
+
+    /* two groups at a time - each half of the register is shuffled
+     * on its own, so the second group is loaded into the upper half */
+    while (i + 8 <= *num_vals && 17 <= end - p) {
+        q = p + 1 + gvint_length[p[0]];
+        if (17 > end - q) {
+            break;
+        }
+        v = _mm256_inserti128_si256(_mm256_castsi128_si256(
+                                        _mm_loadu_si128((const __m128i *) (p + 1))),
+                                    _mm_loadu_si128((const __m128i *) (q + 1)), 1);
+        shuf = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(
+                                           (const __m128i *) gvint_shuffle[p[0]])),
+                                       _mm_loadu_si128((const __m128i *) gvint_shuffle[q[0]]), 1);
+        v = _mm256_shuffle_epi8(v, shuf);
+        if (zigzag) {
+            v = _mm256_xor_si256(_mm256_srli_epi32(v, 1),
+                                 _mm256_sub_epi32(_mm256_setzero_si256(),
+                                                  _mm256_and_si256(v, one)));
+        }
+        _mm256_storeu_si256((__m256i *) (dest + i), v);
+        p = q + 1 + gvint_length[q[0]];
+        i += 8;
+    }
+    /* a single group may remain */
+    n = *num_vals - i;
+    used = gvint_bulk_ssse3(p, end - p, dest + i, &n, zigzag);
+    *num_vals = i + n;
+    return (p - src) + used;
+}
+
+#endif
+
+pmix_status_t pmix_flex128_array_init(bool simd)
+{
+    const char *decoder = "scalar";
+    size_t off, len;
+    int ctl, k, b;
+
+    for (ctl = 0; ctl < 256; ctl++) {
+        off = 0;
+        for (k = 0; k < 4; k++) {
+            len = ((ctl >> (2 * k)) & 3) + 1;
+            for (b = 0; b < 4; b++) {
+                gvint_shuffle[ctl][4 * k + b] = (size_t) b < len ? (uint8_t) (off + b) : 0x80;
+            }
+            off += len;
+        }
+        gvint_length[ctl] = (uint8_t) off;
+    }
+
+    gvint_bulk = NULL;
+#if FLEX128_GVINT_X86
+    if (simd) {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            gvint_bulk = gvint_bulk_avx2;
+            decoder = "avx2";
+        } else if (__builtin_cpu_supports("ssse3")) {
+            gvint_bulk = gvint_bulk_ssse3;
+            decoder = "ssse3";
+        }
+    }
+#else
+    PMIX_HIDE_UNUSED_PARAMS(simd);
+#endif
+    pmix_output_verbose(2, pmix_globals.debug_output,
+                        "psquash: flex128 group varint arrays, %s decoder", decoder);
+    return PMIX_SUCCESS;
+}
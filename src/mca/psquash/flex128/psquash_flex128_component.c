@@ -17,6 +17,7 @@
 #include "src/mca/base/pmix_mca_base_var.h"
 #include "src/mca/psquash/psquash.h"
 
+static pmix_status_t component_register(void);
 static pmix_status_t component_open(void);
 static pmix_status_t component_close(void);
 static pmix_status_t component_query(pmix_mca_base_module_t **module, int *priority);
@@ -25,24 +26,52 @@ static pmix_status_t component_query(pmix_mca_base_module_t **module, int *prior
  * Instantiate the public struct with all of our public information
  * and pointers to our public functions in it
  */
-pmix_psquash_base_component_t pmix_mca_psquash_flex128_component = {
-    .base = {
-        PMIX_PSQUASH_BASE_VERSION_1_0_0,
-
-        /* Component name and version */
-        .pmix_mca_component_name = "flex128",
-        PMIX_MCA_BASE_MAKE_VERSION(component,
-                                   PMIX_MAJOR_VERSION,
-                                   PMIX_MINOR_VERSION,
-                                   PMIX_RELEASE_VERSION),
-
-        /* Component open and close functions */
-        .pmix_mca_open_component = component_open,
-        .pmix_mca_close_component = component_close,
-        .pmix_mca_query_component = component_query,
+pmix_psquash_flex128_component_t pmix_mca_psquash_flex128_component = {
+    .super = {
+        .base = {
+            PMIX_PSQUASH_BASE_VERSION_1_0_0,
+
+            /* Component name and version */
+            .pmix_mca_component_name = "flex128",
+            PMIX_MCA_BASE_MAKE_VERSION(component,
+                                       PMIX_MAJOR_VERSION,
+                                       PMIX_MINOR_VERSION,
+                                       PMIX_RELEASE_VERSION),
+
+            /* Component open and close functions */
+            .pmix_mca_register_component_params = component_register,
+            .pmix_mca_open_component = component_open,
+            .pmix_mca_close_component = component_close,
+            .pmix_mca_query_component = component_query,
+        },
     },
+    .group_varint = false,
+    .simd = true
 };
 
+static pmix_status_t component_register(void)
+{
+    pmix_mca_base_component_t *component = &pmix_mca_psquash_flex128_component.super.base;
+
+    /* the encoding is not negotiated with peers, so - just as with the
+     * choice of psquash component - every process that exchanges data
+     * must agree on it */
+    pmix_mca_psquash_flex128_component.group_varint = false;
+    (void) pmix_mca_base_component_var_register(
+        component, "group_varint",
+        "Encode arrays of 16- and 32-bit integers as group varints instead of one "
+        "value at a time. All processes exchanging data must use the same setting",
+        PMIX_MCA_BASE_VAR_TYPE_BOOL, &pmix_mca_psquash_flex128_component.group_varint);
+
+    pmix_mca_psquash_flex128_component.simd = true;
+    (void) pmix_mca_base_component_var_register(
+        component, "simd",
+        "Decode group varints with SSSE3 or AVX2 instructions when the CPU supports them",
+        PMIX_MCA_BASE_VAR_TYPE_BOOL, &pmix_mca_psquash_flex128_component.simd);
+
+    return PMIX_SUCCESS;
+}
+
 static int component_open(void)
 {
     return PMIX_SUCCESS;
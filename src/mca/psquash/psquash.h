@@ -77,6 +77,42 @@ typedef pmix_status_t (*pmix_psquash_encode_int_fn_t)(pmix_data_type_t type, voi
 typedef pmix_status_t (*pmix_psquash_decode_int_fn_t)(pmix_data_type_t type, void *src,
                                                       size_t src_len, void *dest, size_t *dst_len);
 
+/**
+ * Encode an array of basic integers as a single block. Optional - a
+ * module without it, or one that returns PMIX_ERR_NOT_SUPPORTED for
+ * the type and number of values, has the array encoded one value at
+ * a time with encode_int. Whether an array is encoded as a block may
+ * depend only upon its type and number of values, so the decoder can
+ * make the same choice. The block is never larger than num_vals times
+ * the maximum size of the type, and dest must have that much room.
+ *
+ * type     - Type of the 'src' array (PMIX_SIZE, PMIX_INT to PMIX_UINT64)
+ * src      - pointer to the array
+ * num_vals - number of values in the array
+ * dest     - pointer to buffer to store data, or NULL to only
+ *            compute the packed size
+ * dst_len  - pointer to the packed size of dest, in bytes
+ */
+typedef pmix_status_t (*pmix_psquash_encode_ints_fn_t)(pmix_data_type_t type, const void *src,
+                                                       int32_t num_vals, void *dest,
+                                                       size_t *dst_len);
+
+/**
+ * Decode a block written by encode_ints. Returns PMIX_ERR_NOT_SUPPORTED,
+ * having read nothing, when encode_ints would not have encoded such an
+ * array as a block.
+ *
+ * type     - Type of the 'dest' array (PMIX_SIZE, PMIX_INT to PMIX_UINT64)
+ * src      - pointer to buffer where data was stored
+ * src_len  - length, in bytes, of the src buffer
+ * dest     - pointer to the array
+ * num_vals - number of values in the array
+ * src_used - pointer to the number of bytes of src that were read
+ */
+typedef pmix_status_t (*pmix_psquash_decode_ints_fn_t)(pmix_data_type_t type, const void *src,
+                                                       size_t src_len, void *dest,
+                                                       int32_t num_vals, size_t *src_used);
+
 /**
  * Base structure for a PSQUASH module
  */
@@ -95,6 +131,10 @@ typedef struct {
     /** Integer compression */
     pmix_psquash_encode_int_fn_t encode_int;
     pmix_psquash_decode_int_fn_t decode_int;
+
+    /** Integer array compression - may be NULL */
+    pmix_psquash_encode_ints_fn_t encode_ints;
+    pmix_psquash_decode_ints_fn_t decode_ints;
 } pmix_psquash_base_module_t;
 
 /**
@@ -57,6 +57,21 @@ PMIX_EXPORT extern pmix_mca_base_framework_t pmix_ptl_base_framework;
 PMIX_EXPORT pmix_status_t pmix_ptl_base_select(void);
 
 /* framework globals */
+/* upper bound on the number of messages gathered into one write */
+#define PMIX_PTL_MAX_SEND_BATCH 64
+
+/* receive buffers are cached in power-of-two size classes
+ * from 256 bytes up to 64k - larger messages are not cached */
+#define PMIX_PTL_RECV_CACHE_MIN_SHIFT 8
+#define PMIX_PTL_RECV_CACHE_NCLASSES  9
+/* upper bound on the number of buffers cached per size class */
+#define PMIX_PTL_MAX_RECV_CACHE 64
+
+typedef struct {
+    int nbufs;
+    char *bufs[PMIX_PTL_MAX_RECV_CACHE];
+} pmix_ptl_recv_cache_t;
+
 struct pmix_ptl_base_t {
     bool initialized;
     bool selected;
@@ -100,6 +115,15 @@ struct pmix_ptl_base_t {
     int wait_to_connect;
     int handshake_wait_time;
     int handshake_max_retries;
+    int max_active_handshakes;
+    int handshake_timeout;
+    int listen_backlog;
+    int max_send_batch;
+    int recv_cache_size;
+    size_t recv_cache_min;
+    pmix_ptl_recv_cache_t recv_cache[PMIX_PTL_RECV_CACHE_NCLASSES];
+    int active_handshakes;
+    pmix_list_t pending_handshakes; // list of pmix_pending_connection_t
 };
 typedef struct pmix_ptl_base_t pmix_ptl_base_t;
 
@@ -139,6 +163,11 @@ PMIX_EXPORT pmix_status_t pmix_ptl_base_setup_fork(const pmix_proc_t *proc, char
 PMIX_EXPORT void pmix_ptl_base_send_handler(int sd, short flags, void *cbdata);
 PMIX_EXPORT void pmix_ptl_base_recv_handler(int sd, short flags, void *cbdata);
 PMIX_EXPORT void pmix_ptl_base_process_msg(int fd, short flags, void *cbdata);
+PMIX_EXPORT char *pmix_ptl_base_recv_buffer_get(size_t nbytes);
+PMIX_EXPORT void pmix_ptl_base_recv_buffer_return(char *data, size_t nbytes);
+PMIX_EXPORT void pmix_ptl_base_recv_buffer_done(pmix_ptl_recv_t *msg, char *data,
+                                                pmix_buffer_t *buf);
+PMIX_EXPORT void pmix_ptl_base_recv_cache_release(void);
 PMIX_EXPORT pmix_status_t pmix_ptl_base_set_nonblocking(int sd);
 PMIX_EXPORT pmix_status_t pmix_ptl_base_set_blocking(int sd);
 PMIX_EXPORT pmix_status_t pmix_ptl_base_send_blocking(int sd, char *ptr, size_t size);
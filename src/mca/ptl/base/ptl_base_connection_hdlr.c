@@ -46,26 +46,163 @@
 #include "src/mca/ptl/base/base.h"
 #include "src/mca/ptl/base/ptl_base_handshake.h"
 
+static void process_connection(pmix_pending_connection_t *pnd);
 static void process_cbfunc(int sd, short args, void *cbdata);
 static void cnct_cbfunc(pmix_status_t status, pmix_proc_t *proc, void *cbdata);
 static void _check_cached_events(pmix_peer_t *peer);
 static pmix_status_t process_tool_request(pmix_pending_connection_t *pnd, char *mg, size_t cnt);
 
+/* Incoming connection requests are read without blocking so that a
+ * slow or stalled peer cannot hold up the progress thread. Each
+ * request moves through two steps:
+ *
+ *   1. receive the header and the connection request it describes,
+ *      as the socket becomes readable
+ *   2. process the request and send the (small) replies
+ *
+ * Only the first step can wait on the peer, so only it is driven by
+ * events. Requests beyond the configured number of concurrent
+ * handshakes are held on a list until a slot frees up */
+static void start_handshake(pmix_pending_connection_t *pnd);
+
+static void handshake_complete(pmix_pending_connection_t *pnd)
+{
+    pmix_pending_connection_t *next;
+
+    pmix_event_del(&pnd->ev);
+    if (pnd->timer_active) {
+        pmix_event_evtimer_del(&pnd->timer);
+        pnd->timer_active = false;
+    }
+    --pmix_ptl_base.active_handshakes;
+
+    /* start any requests that were waiting for a slot */
+    while (0 == pmix_ptl_base.max_active_handshakes
+           || pmix_ptl_base.active_handshakes < pmix_ptl_base.max_active_handshakes) {
+        next = (pmix_pending_connection_t *) pmix_list_remove_first(
+            &pmix_ptl_base.pending_handshakes);
+        if (NULL == next) {
+            break;
+        }
+        start_handshake(next);
+    }
+}
+
+static void handshake_timeout(int sd, short args, void *cbdata)
+{
+    pmix_pending_connection_t *pnd = (pmix_pending_connection_t *) cbdata;
+
+    PMIX_ACQUIRE_OBJECT(pnd);
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                        "ptl:base:connection_handler timed out waiting for connection "
+                        "request on socket %d",
+                        pnd->sd);
+    pnd->timer_active = false;
+    handshake_complete(pnd);
+    CLOSE_THE_SOCKET(pnd->sd);
+    PMIX_RELEASE(pnd);
+}
+
+static void handshake_recv(int sd, short args, void *cbdata)
+{
+    pmix_pending_connection_t *pnd = (pmix_pending_connection_t *) cbdata;
+    char *ptr;
+    size_t want;
+    ssize_t rc;
+
+    PMIX_ACQUIRE_OBJECT(pnd);
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    while (1) {
+        if (pnd->rcvd < sizeof(pmix_ptl_hdr_t)) {
+            /* still working on the header */
+            ptr = (char *) &pnd->hdr + pnd->rcvd;
+            want = sizeof(pmix_ptl_hdr_t) - pnd->rcvd;
+        } else {
+            if (NULL == pnd->msg) {
+                /* get the id, authentication and version payload (and possibly
+                 * security credential) - to guard against potential attacks,
+                 * we'll set an arbitrary limit per a define */
+                if (PMIX_MAX_CRED_SIZE < pnd->hdr.nbytes) {
+                    goto error;
+                }
+                pnd->msg = (char *) calloc(pnd->hdr.nbytes + 1, 1); // ensure NULL termination
+                if (NULL == pnd->msg) {
+                    goto error;
+                }
+            }
+            want = sizeof(pmix_ptl_hdr_t) + pnd->hdr.nbytes - pnd->rcvd;
+            if (0 == want) {
+                break;
+            }
+            ptr = pnd->msg + (pnd->rcvd - sizeof(pmix_ptl_hdr_t));
+        }
+        rc = recv(pnd->sd, ptr, want, 0);
+        if (0 == rc) {
+            pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                                "ptl:base:connection_handler remote closed connection "
+                                "on socket %d",
+                                pnd->sd);
+            goto error;
+        }
+        if (0 > rc) {
+            if (EINTR == pmix_socket_errno) {
+                continue;
+            }
+            if (EAGAIN == pmix_socket_errno || EWOULDBLOCK == pmix_socket_errno) {
+                /* wait for more to arrive */
+                return;
+            }
+            /* unable to complete the recv */
+            pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                                "ptl:base:connection_handler unable to complete recv of "
+                                "connect-ack with client ON SOCKET %d",
+                                pnd->sd);
+            goto error;
+        }
+        pnd->rcvd += rc;
+    }
+
+    /* the request is complete, so free the slot and process it.
+     * The rest of the exchange is a few small messages, and the
+     * security handshake may require the socket be blocking */
+    handshake_complete(pnd);
+    pmix_ptl_base_set_blocking(pnd->sd);
+    process_connection(pnd);
+    return;
+
+error:
+    handshake_complete(pnd);
+    CLOSE_THE_SOCKET(pnd->sd);
+    PMIX_RELEASE(pnd);
+}
+
+static void start_handshake(pmix_pending_connection_t *pnd)
+{
+    struct timeval tv;
+
+    ++pmix_ptl_base.active_handshakes;
+
+    /* ensure the socket is in non-blocking mode */
+    pmix_ptl_base_set_nonblocking(pnd->sd);
+
+    pmix_event_assign(&pnd->ev, pmix_globals.evbase, pnd->sd, EV_READ | EV_PERSIST,
+                      handshake_recv, pnd);
+    pmix_event_add(&pnd->ev, NULL);
+    if (0 < pmix_ptl_base.handshake_timeout) {
+        pmix_event_evtimer_set(pmix_globals.evbase, &pnd->timer, handshake_timeout, pnd);
+        tv.tv_sec = pmix_ptl_base.handshake_timeout;
+        tv.tv_usec = 0;
+        pmix_event_evtimer_add(&pnd->timer, &tv);
+        pnd->timer_active = true;
+    }
+}
+
 void pmix_ptl_base_connection_handler(int sd, short args, void *cbdata)
 {
     pmix_pending_connection_t *pnd = (pmix_pending_connection_t *) cbdata;
-    pmix_ptl_hdr_t hdr;
-    pmix_peer_t *peer = NULL;
-    pmix_status_t rc, reply;
-    char *msg = NULL, *mg, *p, *blob = NULL;
-    uint32_t u32;
-    size_t cnt;
-    pmix_namespace_t *nptr, *tmp;
-    pmix_rank_info_t *info = NULL, *iptr;
-    pmix_proc_t proc;
-    pmix_info_t ginfo;
-    pmix_byte_object_t cred;
-    uint8_t major, minor, release;
 
     /* acquire the object */
     PMIX_ACQUIRE_OBJECT(pnd);
@@ -76,38 +213,34 @@ void pmix_ptl_base_connection_handler(int sd, short args, void *cbdata)
     pmix_output_verbose(8, pmix_ptl_base_framework.framework_output,
                         "ptl:base:connection_handler: new connection: %d", pnd->sd);
 
-    /* ensure the socket is in blocking mode */
-    pmix_ptl_base_set_blocking(pnd->sd);
-
-    /* ensure all is zero'd */
-    memset(&hdr, 0, sizeof(pmix_ptl_hdr_t));
-
-    /* get the header */
-    if (PMIX_SUCCESS
-        != pmix_ptl_base_recv_blocking(pnd->sd, (char *) &hdr, sizeof(pmix_ptl_hdr_t))) {
-        goto error;
+    if (0 < pmix_ptl_base.max_active_handshakes
+        && pmix_ptl_base.active_handshakes >= pmix_ptl_base.max_active_handshakes) {
+        /* wait for a slot */
+        pmix_list_append(&pmix_ptl_base.pending_handshakes, &pnd->super);
+        return;
     }
+    start_handshake(pnd);
+}
 
-    /* get the id, authentication and version payload (and possibly
-     * security credential) - to guard against potential attacks,
-     * we'll set an arbitrary limit per a define */
-    if (PMIX_MAX_CRED_SIZE < hdr.nbytes) {
-        goto error;
-    }
-    if (NULL == (msg = (char *) malloc(hdr.nbytes+1))) {
-        goto error;
-    }
-    memset(msg, 0, hdr.nbytes + 1);  // ensure NULL termination of result
-    if (PMIX_SUCCESS != pmix_ptl_base_recv_blocking(pnd->sd, msg, hdr.nbytes)) {
-        /* unable to complete the recv */
-        pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
-                            "ptl:tool:connection_handler unable to complete recv of connect-ack "
-                            "with client ON SOCKET %d",
-                            pnd->sd);
-        goto error;
-    }
+static void process_connection(pmix_pending_connection_t *pnd)
+{
+    pmix_peer_t *peer = NULL;
+    pmix_status_t rc, reply;
+    char *msg = NULL, *mg, *p, *blob = NULL;
+    uint32_t u32;
+    size_t cnt;
+    pmix_namespace_t *nptr;
+    pmix_rank_info_t *info = NULL, *iptr;
+    pmix_proc_t proc;
+    pmix_info_t ginfo;
+    pmix_byte_object_t cred;
+    uint8_t major, minor, release;
+
+    /* take the request */
+    msg = pnd->msg;
+    pnd->msg = NULL;
 
-    cnt = hdr.nbytes;
+    cnt = pnd->hdr.nbytes;
     mg = msg;
     /* extract the name of the sec module they used */
     PMIX_PTL_GET_STRING(pnd->psec);
@@ -222,6 +355,11 @@ void pmix_ptl_base_connection_handler(int sd, short args, void *cbdata)
 
         /* extract the type of buffer they used */
         PMIX_PTL_GET_U8(pnd->buffer_type);
+        /* they only ask for native buffers if we offered them */
+        if (PMIX_BFROP_BUFFER_NATIVE == pnd->buffer_type && !pmix_bfrops_globals.native) {
+            PMIX_ERROR_LOG(PMIX_ERR_NOT_SUPPORTED);
+            goto error;
+        }
 
         /* extract the name of the gds module they used */
         PMIX_PTL_GET_STRING(pnd->gds);
@@ -251,13 +389,7 @@ void pmix_ptl_base_connection_handler(int sd, short args, void *cbdata)
     /* it is a client that is connecting, so it should have
      * been registered with us prior to being started.
      * See if we know this nspace */
-    nptr = NULL;
-    PMIX_LIST_FOREACH (tmp, &pmix_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(tmp->nspace, pnd->proc.nspace)) {
-            nptr = tmp;
-            break;
-        }
-    }
+    nptr = pmix_nspace_lookup(pnd->proc.nspace);
     if (NULL == nptr) {
         /* we don't know this namespace, reject it */
         rc = PMIX_ERR_NOT_FOUND;
@@ -526,7 +658,7 @@ static void process_cbfunc(int sd, short args, void *cbdata)
     if (PMIX_TOOL_CLIENT != pnd->flag && PMIX_LAUNCHER_CLIENT != pnd->flag) {
         PMIX_RETAIN(nptr);
         nptr->nspace = strdup(cd->proc.nspace);
-        pmix_list_append(&pmix_globals.nspaces, &nptr->super);
+        pmix_nspace_register(nptr);
         info = PMIX_NEW(pmix_rank_info_t);
         info->pname.nspace = strdup(nptr->nspace);
         info->pname.rank = cd->proc.rank;
@@ -637,7 +769,7 @@ error:
     CLOSE_THE_SOCKET(pnd->sd);
     PMIX_RELEASE(pnd);
     PMIX_RELEASE(peer);
-    pmix_list_remove_item(&pmix_globals.nspaces, &nptr->super);
+    pmix_nspace_deregister(nptr);
     PMIX_RELEASE(nptr); // will release the info object
     PMIX_RELEASE(cd);
     if (NULL != req) {
@@ -671,7 +803,7 @@ static void cnct_cbfunc(pmix_status_t status, pmix_proc_t *proc, void *cbdata)
 static pmix_status_t process_tool_request(pmix_pending_connection_t *pnd, char *mg, size_t cnt)
 {
     pmix_peer_t *peer;
-    pmix_namespace_t *nptr, *tmp;
+    pmix_namespace_t *nptr;
     pmix_rank_info_t *info;
     bool found;
     size_t n;
@@ -692,13 +824,7 @@ static pmix_status_t process_tool_request(pmix_pending_connection_t *pnd, char *
          * nspace - it doesn't add the peer object to our array
          * of local clients. So let's start by searching for
          * the nspace object */
-        nptr = NULL;
-        PMIX_LIST_FOREACH (tmp, &pmix_globals.nspaces, pmix_namespace_t) {
-            if (0 == strcmp(tmp->nspace, pnd->proc.nspace)) {
-                nptr = tmp;
-                break;
-            }
-        }
+        nptr = pmix_nspace_lookup(pnd->proc.nspace);
         if (NULL == nptr) {
             /* it is possible that this is a tool inside of
              * a job-script as part of a multi-spawn operation.
@@ -808,8 +808,8 @@ pmix_status_t pmix_ptl_base_construct_message(pmix_peer_t *peer, char **msgout,
     /* add our active bfrops module name */
     bfrops = pmix_globals.mypeer->nptr->compat.bfrops->version;
     sdsize += strlen(bfrops) + 1;
-    /* and the type of buffer we are using */
-    bftype = pmix_globals.mypeer->nptr->compat.type;
+    /* and the type of buffer we want to use with this server */
+    bftype = peer->nptr->compat.type;
     sdsize += sizeof(bftype);
 
     /* add our active gds module for working with the server */
@@ -106,7 +106,15 @@ pmix_ptl_base_t pmix_ptl_base = {
     .max_retries = 0,
     .wait_to_connect = 0,
     .handshake_wait_time = 0,
-    .handshake_max_retries = 0
+    .handshake_max_retries = 0,
+    .max_active_handshakes = 0,
+    .handshake_timeout = 60,
+    .listen_backlog = 0,
+    .max_send_batch = 16,
+    .recv_cache_size = 16,
+    .recv_cache_min = 2048,
+    .active_handshakes = 0,
+    .pending_handshakes = PMIX_LIST_STATIC_INIT
 };
 int pmix_ptl_base_output = -1;
 pmix_ptl_module_t pmix_ptl = {
@@ -219,6 +227,52 @@ static int pmix_ptl_register(pmix_mca_base_register_flag_t flags)
     (void) pmix_mca_base_var_register_synonym(idx, "pmix", "ptl", "tcp", "handshake_max_retries",
                                               PMIX_MCA_BASE_VAR_SYN_FLAG_DEPRECATED);
 
+    (void) pmix_mca_base_var_register("pmix", "ptl", "base", "max_active_handshakes",
+                                      "Maximum number of incoming connection requests to process "
+                                      "concurrently - additional requests wait until one completes "
+                                      "(0 => no limit)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &pmix_ptl_base.max_active_handshakes);
+
+    (void) pmix_mca_base_var_register("pmix", "ptl", "base", "handshake_timeout",
+                                      "Number of seconds to wait for a connecting peer to deliver "
+                                      "its connection request before dropping it (0 => wait forever)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &pmix_ptl_base.handshake_timeout);
+
+    (void) pmix_mca_base_var_register("pmix", "ptl", "base", "listen_backlog",
+                                      "Length of the queue of pending connection requests on "
+                                      "the listen socket (0 => maximum allowed by the kernel)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &pmix_ptl_base.listen_backlog);
+
+    (void) pmix_mca_base_var_register("pmix", "ptl", "base", "max_send_batch",
+                                      "Maximum number of queued messages to a peer that are "
+                                      "written with a single system call (1 => one at a time)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &pmix_ptl_base.max_send_batch);
+    if (1 > pmix_ptl_base.max_send_batch) {
+        pmix_ptl_base.max_send_batch = 1;
+    } else if (PMIX_PTL_MAX_SEND_BATCH < pmix_ptl_base.max_send_batch) {
+        pmix_ptl_base.max_send_batch = PMIX_PTL_MAX_SEND_BATCH;
+    }
+
+    (void) pmix_mca_base_var_register("pmix", "ptl", "base", "recv_cache_size",
+                                      "Number of message receive buffers of each size class to "
+                                      "keep for reuse (0 => do not reuse receive buffers)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &pmix_ptl_base.recv_cache_size);
+    if (0 > pmix_ptl_base.recv_cache_size) {
+        pmix_ptl_base.recv_cache_size = 0;
+    } else if (PMIX_PTL_MAX_RECV_CACHE < pmix_ptl_base.recv_cache_size) {
+        pmix_ptl_base.recv_cache_size = PMIX_PTL_MAX_RECV_CACHE;
+    }
+    (void) pmix_mca_base_var_register("pmix", "ptl", "base", "recv_cache_min",
+                                      "Size (in bytes) of the smallest message received into "
+                                      "a reused buffer - smaller ones are cheaper to allocate",
+                                      PMIX_MCA_BASE_VAR_TYPE_SIZE_T,
+                                      &pmix_ptl_base.recv_cache_min);
+
     idx = pmix_mca_base_var_register("pmix", "ptl", "base", "report_uri",
                                      "Output URI [- => stdout, + => stderr, or filename]",
                                      PMIX_MCA_BASE_VAR_TYPE_STRING,
@@ -231,6 +285,7 @@ static int pmix_ptl_register(pmix_mca_base_register_flag_t flags)
 
 static pmix_status_t pmix_ptl_close(void)
 {
+    pmix_pending_connection_t *pnd;
     int rc;
 
     if (!pmix_ptl_base.initialized) {
@@ -254,6 +309,14 @@ static pmix_status_t pmix_ptl_close(void)
     /* the component will cleanup when closed */
     PMIX_LIST_DESTRUCT(&pmix_ptl_base.posted_recvs);
     PMIX_LIST_DESTRUCT(&pmix_ptl_base.unexpected_msgs);
+    pmix_ptl_base_recv_cache_release();
+    /* drop any connection requests still waiting to be processed */
+    while (NULL != (pnd = (pmix_pending_connection_t *)
+                        pmix_list_remove_first(&pmix_ptl_base.pending_handshakes))) {
+        CLOSE_THE_SOCKET(pnd->sd);
+        PMIX_RELEASE(pnd);
+    }
+    PMIX_DESTRUCT(&pmix_ptl_base.pending_handshakes);
     PMIX_DESTRUCT(&pmix_ptl_base.listener);
 
     if (NULL != pmix_ptl_base.system_filename) {
@@ -353,6 +416,8 @@ static pmix_status_t pmix_ptl_open(pmix_mca_base_open_flag_t flags)
     pmix_ptl_base.initialized = true;
     PMIX_CONSTRUCT(&pmix_ptl_base.posted_recvs, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_ptl_base.unexpected_msgs, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_ptl_base.pending_handshakes, pmix_list_t);
+    pmix_ptl_base.active_handshakes = 0;
     pmix_ptl_base.listen_thread_active = false;
     PMIX_CONSTRUCT(&pmix_ptl_base.listener, pmix_listener_t);
     pmix_ptl_base.current_tag = PMIX_PTL_TAG_DYNAMIC;
@@ -431,12 +496,20 @@ static void rcon(pmix_ptl_recv_t *p)
     p->hdr.tag = UINT32_MAX;
     p->hdr.nbytes = 0;
     p->data = NULL;
+    p->pooled = false;
     p->hdr_recvd = false;
     p->rdptr = NULL;
     p->rdbytes = 0;
 }
 static void rdes(pmix_ptl_recv_t *p)
 {
+    if (NULL != p->data) {
+        if (p->pooled) {
+            pmix_ptl_base_recv_buffer_return(p->data, p->hdr.nbytes);
+        } else {
+            free(p->data);
+        }
+    }
     if (NULL != p->peer) {
         PMIX_RELEASE(p->peer);
     }
@@ -468,6 +541,10 @@ PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_ptl_sr_t, pmix_object_t, srcon, srdes);
 
 static void pccon(pmix_pending_connection_t *p)
 {
+    memset(&p->hdr, 0, sizeof(pmix_ptl_hdr_t));
+    p->msg = NULL;
+    p->rcvd = 0;
+    p->timer_active = false;
     p->need_id = false;
     PMIX_LOAD_PROCID(&p->proc, NULL, PMIX_RANK_UNDEF);
     p->info = NULL;
@@ -486,6 +563,9 @@ static void pccon(pmix_pending_connection_t *p)
 }
 static void pcdes(pmix_pending_connection_t *p)
 {
+    if (NULL != p->msg) {
+        free(p->msg);
+    }
     if (NULL != p->info) {
         PMIX_INFO_FREE(p->info, p->ninfo);
     }
@@ -505,7 +585,7 @@ static void pcdes(pmix_pending_connection_t *p)
         free(p->cred);
     }
 }
-PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_pending_connection_t, pmix_object_t, pccon, pcdes);
+PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_pending_connection_t, pmix_list_item_t, pccon, pcdes);
 
 static void lcon(pmix_listener_t *p)
 {
@@ -43,6 +43,9 @@
 #ifdef HAVE_SYS_TYPES_H
 #    include <sys/types.h>
 #endif
+#ifdef HAVE_SYS_EPOLL_H
+#    include <sys/epoll.h>
+#endif
 #include <ctype.h>
 #include <sys/stat.h>
 #include <event.h>
@@ -68,6 +71,23 @@ static void *listen_thread(void *obj);
 static pthread_t engine;
 static bool setup_complete = false;
 
+/* connections accepted in one pass of the listen thread,
+ * handed to the progress thread with a single event */
+typedef struct {
+    pmix_object_t super;
+    pmix_event_t ev;
+    pmix_list_t conns;
+} pmix_ptl_accept_batch_t;
+static void abcon(pmix_ptl_accept_batch_t *p)
+{
+    PMIX_CONSTRUCT(&p->conns, pmix_list_t);
+}
+static void abdes(pmix_ptl_accept_batch_t *p)
+{
+    PMIX_LIST_DESTRUCT(&p->conns);
+}
+static PMIX_CLASS_INSTANCE(pmix_ptl_accept_batch_t, pmix_object_t, abcon, abdes);
+
 /*
  * start listening thread
  */
@@ -136,19 +156,128 @@ void pmix_ptl_base_stop_listening(void)
     lt->socket = -1;
 }
 
+/* pass each accepted connection to the listener's handler */
+static void process_batch(int sd, short args, void *cbdata)
+{
+    pmix_ptl_accept_batch_t *batch = (pmix_ptl_accept_batch_t *) cbdata;
+    pmix_pending_connection_t *pnd;
+
+    PMIX_ACQUIRE_OBJECT(batch);
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    while (NULL != (pnd = (pmix_pending_connection_t *) pmix_list_remove_first(&batch->conns))) {
+        pmix_ptl_base.listener.cbfunc(-1, EV_WRITE, pnd);
+    }
+    PMIX_RELEASE(batch);
+}
+
+/* accept every connection that is waiting on the listen socket,
+ * adding them to the given batch. Returns false if the listen
+ * thread should terminate */
+static bool accept_connections(pmix_listener_t *lt, pmix_ptl_accept_batch_t *batch)
+{
+    pmix_pending_connection_t *pnd;
+    socklen_t addrlen;
+    int sd;
+
+    while (1) {
+        pnd = PMIX_NEW(pmix_pending_connection_t);
+        pnd->protocol = lt->protocol;
+        addrlen = sizeof(struct sockaddr_storage);
+#ifdef HAVE_ACCEPT4
+        sd = accept4(lt->socket, (struct sockaddr *) &pnd->addr, &addrlen,
+                     SOCK_NONBLOCK | SOCK_CLOEXEC);
+#else
+        sd = accept(lt->socket, (struct sockaddr *) &pnd->addr, &addrlen);
+        if (0 <= sd) {
+            pmix_fd_set_cloexec(sd);
+        }
+#endif
+        if (sd < 0) {
+            PMIX_RELEASE(pnd);
+            if (EAGAIN == pmix_socket_errno || EWOULDBLOCK == pmix_socket_errno) {
+                /* all pending connections have been harvested */
+                return true;
+            }
+            if (EINTR == pmix_socket_errno || ECONNABORTED == pmix_socket_errno) {
+                /* interrupted, or they aborted the attempt */
+                continue;
+            }
+            if (EMFILE == pmix_socket_errno || ENOBUFS == pmix_socket_errno
+                || ENOMEM == pmix_socket_errno) {
+                PMIX_ERROR_LOG(PMIX_ERR_OUT_OF_RESOURCE);
+            } else if (EINVAL != pmix_socket_errno && EBADF != pmix_socket_errno) {
+                /* EINVAL/EBADF are a race condition at finalize */
+                pmix_output(0, "listen_thread: accept() failed: %s (%d).",
+                            strerror(pmix_socket_errno), pmix_socket_errno);
+            }
+            return false;
+        }
+        pnd->sd = sd;
+        pmix_output_verbose(8, pmix_ptl_base_framework.framework_output,
+                            "listen_thread: new connection: (%d, %d)", pnd->sd,
+                            pmix_socket_errno);
+        pmix_list_append(&batch->conns, &pnd->super);
+    }
+}
+
+/* hand a batch of accepted connections to the progress thread */
+static void post_batch(pmix_ptl_accept_batch_t *batch)
+{
+    if (0 == pmix_list_get_size(&batch->conns)) {
+        PMIX_RELEASE(batch);
+        return;
+    }
+    PMIX_THREADSHIFT(batch, process_batch);
+}
+
 static void *listen_thread(void *obj)
 {
     (void) obj;
-    int rc, max;
-    socklen_t addrlen = sizeof(struct sockaddr_storage);
-    pmix_pending_connection_t *pending_connection;
+    int rc;
+    pmix_ptl_accept_batch_t *batch;
+    pmix_listener_t *lt = &pmix_ptl_base.listener;
+    bool active;
+#ifdef HAVE_SYS_EPOLL_H
+    struct epoll_event ev, events[2];
+    int n, epfd;
+#else
+    int max;
     struct timeval timeout;
     fd_set readfds;
-    pmix_listener_t *lt = &pmix_ptl_base.listener;
+#endif
 
     pmix_output_verbose(8, pmix_ptl_base_framework.framework_output, "listen_thread: active");
 
+#ifdef HAVE_SYS_EPOLL_H
+    /* watch the listen socket and the stop_thread fd */
+    epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (0 > epfd) {
+        PMIX_ERROR_LOG(PMIX_ERR_IN_ERRNO);
+        pmix_ptl_base.listen_thread_active = false;
+        return NULL;
+    }
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = lt->socket;
+    rc = epoll_ctl(epfd, EPOLL_CTL_ADD, lt->socket, &ev);
+    if (0 == rc) {
+        ev.data.fd = pmix_ptl_base.stop_thread[0];
+        rc = epoll_ctl(epfd, EPOLL_CTL_ADD, pmix_ptl_base.stop_thread[0], &ev);
+    }
+    if (0 != rc) {
+        PMIX_ERROR_LOG(PMIX_ERR_IN_ERRNO);
+        close(epfd);
+        pmix_ptl_base.listen_thread_active = false;
+        return NULL;
+    }
+#endif
+
     while (pmix_ptl_base.listen_thread_active) {
+#ifdef HAVE_SYS_EPOLL_H
+        /* the stop_thread pipe wakes us when it is time to terminate */
+        rc = epoll_wait(epfd, events, 2, -1);
+#else
         FD_ZERO(&readfds);
         FD_SET(lt->socket, &readfds);
         max = lt->socket;
@@ -165,71 +294,56 @@ static void *listen_thread(void *obj)
          * comes in, we'll get woken up right away.
          */
         rc = select(max + 1, &readfds, NULL, NULL, &timeout);
+#endif
         if (!pmix_ptl_base.listen_thread_active) {
             /* we've been asked to terminate */
+#ifdef HAVE_SYS_EPOLL_H
+            close(epfd);
+#endif
             close(pmix_ptl_base.stop_thread[0]);
             close(pmix_ptl_base.stop_thread[1]);
             return NULL;
         }
-        if (rc < 0) {
+        if (rc <= 0) {
             continue;
         }
 
-        /* according to the man pages, select replaces the given descriptor
-         * set with a subset consisting of those descriptors that are ready
-         * for the specified operation - in this case, a read. So we need to
-         * first check to see if this file descriptor is included in the
-         * returned subset
-         */
+        /* check to see if the listen socket is among the
+         * descriptors that are ready */
+#ifdef HAVE_SYS_EPOLL_H
+        for (n = 0; n < rc; n++) {
+            if (events[n].data.fd == lt->socket) {
+                break;
+            }
+        }
+        if (n == rc) {
+            continue;
+        }
+#else
         if (0 == FD_ISSET(lt->socket, &readfds)) {
             /* this descriptor is not included */
             continue;
         }
+#endif
 
-        /* this descriptor is ready to be read, which means a connection
-         * request has been received - so harvest it. All we want to do
-         * here is accept the connection and push the info onto the event
-         * library for subsequent processing - we don't want to actually
-         * process the connection here as it takes too long, and so the
-         * OS might start rejecting connections due to timeout.
+        /* connection requests have been received - so harvest all of
+         * them. All we want to do here is accept the connections and push
+         * them onto the event library for subsequent processing - we don't
+         * want to actually process the connections here as it takes too
+         * long, and so the OS might start rejecting connections due to
+         * timeout.
          */
-        pending_connection = PMIX_NEW(pmix_pending_connection_t);
-        pending_connection->protocol = lt->protocol;
-        pmix_event_assign(&pending_connection->ev, pmix_globals.evbase, -1, EV_WRITE, lt->cbfunc,
-                          pending_connection);
-        pending_connection->sd = accept(lt->socket, (struct sockaddr *) &(pending_connection->addr),
-                                        &addrlen);
-        if (pending_connection->sd < 0) {
-            PMIX_RELEASE(pending_connection);
-            if (pmix_socket_errno != EAGAIN || pmix_socket_errno != EWOULDBLOCK) {
-                if (EMFILE == pmix_socket_errno || ENOBUFS == pmix_socket_errno
-                    || ENOMEM == pmix_socket_errno) {
-                    PMIX_ERROR_LOG(PMIX_ERR_OUT_OF_RESOURCE);
-                } else if (EINVAL == pmix_socket_errno || EINTR == pmix_socket_errno) {
-                    /* race condition at finalize */
-                    goto done;
-                } else if (ECONNABORTED == pmix_socket_errno) {
-                    /* they aborted the attempt */
-                    continue;
-                } else {
-                    pmix_output(0, "listen_thread: accept() failed: %s (%d).",
-                                strerror(pmix_socket_errno), pmix_socket_errno);
-                }
-                goto done;
-            }
-            continue;
+        batch = PMIX_NEW(pmix_ptl_accept_batch_t);
+        active = accept_connections(lt, batch);
+        post_batch(batch);
+        if (!active) {
+            break;
         }
-
-        pmix_output_verbose(8, pmix_ptl_base_framework.framework_output,
-                            "listen_thread: new connection: (%d, %d)", pending_connection->sd,
-                            pmix_socket_errno);
-        /* post the object */
-        PMIX_POST_OBJECT(pending_connection);
-        /* activate the event */
-        pmix_event_active(&pending_connection->ev, EV_WRITE, 1);
     }
 
-done:
+#ifdef HAVE_SYS_EPOLL_H
+    close(epfd);
+#endif
     pmix_ptl_base.listen_thread_active = false;
     return NULL;
 }
@@ -558,8 +672,9 @@ pmix_status_t pmix_ptl_base_setup_listener(pmix_info_t info[], size_t ninfo)
         goto sockerror;
     }
 
-    /* setup listen backlog to maximum allowed by kernel */
-    if (listen(lt->socket, SOMAXCONN) < 0) {
+    /* setup listen backlog - default to the maximum allowed by kernel */
+    if (listen(lt->socket, (0 < pmix_ptl_base.listen_backlog) ? pmix_ptl_base.listen_backlog
+                                                               : SOMAXCONN) < 0) {
         printf("%s:%d listen() failed\n", __FILE__, __LINE__);
         goto sockerror;
     }
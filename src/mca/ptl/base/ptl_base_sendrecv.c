@@ -82,6 +82,10 @@ static void lost_connection(pmix_peer_t *peer)
         peer->recv_msg = NULL;
     }
     CLOSE_THE_SOCKET(peer->sd);
+    if (PMIX_PEER_IS_SERVER(pmix_globals.mypeer) && pmix_server_coll_lost_peer(peer)) {
+        /* another server in the built-in collective engine */
+        return;
+    }
     if (PMIX_PEER_IS_SERVER(pmix_globals.mypeer) &&
         !PMIX_PEER_IS_TOOL(pmix_globals.mypeer)) {
         /* if I am a server, then we need to ensure that
@@ -112,7 +116,8 @@ static void lost_connection(pmix_peer_t *peer)
             PMIX_INFO_LOAD(&trk->info[trk->ninfo-1], PMIX_LOCAL_COLLECTIVE_STATUS, &rc, PMIX_STATUS);
             /* see if it already participated in this tracker */
             PMIX_LIST_FOREACH_SAFE (rinfo, rnext, &trk->local_cbs, pmix_server_caddy_t) {
-                if (!PMIX_CHECK_PROCID(&rinfo->peer->info->pname, &peer->info->pname)) {
+                if (rinfo->peer->info->pname.rank != peer->info->pname.rank
+                    || !PMIX_CHECK_PEER_NSPACE(rinfo->peer, peer)) {
                     continue;
                 }
                 /* remove it from the list */
@@ -153,13 +158,9 @@ static void lost_connection(pmix_peer_t *peer)
                     /* if the host has not been called, then we need to pass the call
                      * up to the host as otherwise the global collective will hang */
                     if (PMIX_FENCENB_CMD == trk->type) {
-                        trk->host_called = true;
-                        rc = pmix_host_server.fence_nb(trk->pcs, trk->npcs, trk->info,
-                                                       trk->ninfo, NULL, 0,
-                                                       trk->modexcbfunc, trk);
+                        rc = pmix_server_fence_upcall(trk, NULL, 0);
                         if (PMIX_SUCCESS != rc) {
-                            pmix_list_remove_item(&pmix_server_globals.collectives,
-                                                  &trk->super);
+                            pmix_server_remove_tracker(trk);
                             PMIX_RELEASE(trk);
                         }
                     } else if (PMIX_CONNECTNB_CMD == trk->type) {
@@ -167,8 +168,7 @@ static void lost_connection(pmix_peer_t *peer)
                         rc = pmix_host_server.connect(trk->pcs, trk->npcs, trk->info,
                                                       trk->ninfo, trk->op_cbfunc, trk);
                         if (PMIX_SUCCESS != rc) {
-                            pmix_list_remove_item(&pmix_server_globals.collectives,
-                                                  &trk->super);
+                            pmix_server_remove_tracker(trk);
                             PMIX_RELEASE(trk);
                         }
                     } else if (PMIX_DISCONNECTNB_CMD == trk->type) {
@@ -176,8 +176,7 @@ static void lost_connection(pmix_peer_t *peer)
                         rc = pmix_host_server.disconnect(trk->pcs, trk->npcs, trk->info,
                                                          trk->ninfo, trk->op_cbfunc, trk);
                         if (PMIX_SUCCESS != rc) {
-                            pmix_list_remove_item(&pmix_server_globals.collectives,
-                                                  &trk->super);
+                            pmix_server_remove_tracker(trk);
                             PMIX_RELEASE(trk);
                         }
                     }
@@ -250,31 +249,79 @@ static void lost_connection(pmix_peer_t *peer)
     }
 }
 
-static pmix_status_t send_msg(int sd, pmix_ptl_send_t *msg)
+/* account for nbytes of the message having been written,
+ * returning true if the message is now complete */
+static bool advance_msg(pmix_ptl_send_t *msg, size_t *nbytes)
 {
-    struct iovec iov[2];
-    int iov_count;
-    ssize_t remain = msg->sdbytes, rc;
-
-    iov[0].iov_base = msg->sdptr;
-    iov[0].iov_len = msg->sdbytes;
-    if (!msg->hdr_sent && NULL != msg->data) {
-        iov[1].iov_base = msg->data->base_ptr;
-        iov[1].iov_len = ntohl(msg->hdr.nbytes);
-        remain += ntohl(msg->hdr.nbytes);
-        iov_count = 2;
-    } else {
-        iov_count = 1;
+    if (!msg->hdr_sent) {
+        if (*nbytes < msg->sdbytes) {
+            /* partial write of the header */
+            msg->sdptr = (char *) msg->sdptr + *nbytes;
+            msg->sdbytes -= *nbytes;
+            *nbytes = 0;
+            return false;
+        }
+        *nbytes -= msg->sdbytes;
+        msg->hdr_sent = true;
+        if (NULL == msg->data || 0 == ntohl(msg->hdr.nbytes)) {
+            msg->sdbytes = 0;
+            return true;
+        }
+        msg->sdptr = msg->data->base_ptr;
+        msg->sdbytes = ntohl(msg->hdr.nbytes);
     }
+    if (*nbytes < msg->sdbytes) {
+        /* partial write of the msg data */
+        msg->sdptr = (char *) msg->sdptr + *nbytes;
+        msg->sdbytes -= *nbytes;
+        *nbytes = 0;
+        return false;
+    }
+    *nbytes -= msg->sdbytes;
+    msg->sdptr = (char *) msg->sdptr + msg->sdbytes;
+    msg->sdbytes = 0;
+    return true;
+}
+
+/* write the on-deck message along with as many of the queued
+ * messages behind it as allowed, using a single writev. Messages
+ * that are completely written are released - on return, the
+ * on-deck message is either NULL (everything was sent) or
+ * the first message that is still incomplete */
+static pmix_status_t send_msgs(pmix_peer_t *peer)
+{
+    struct iovec iov[2 * PMIX_PTL_MAX_SEND_BATCH];
+    pmix_ptl_send_t *msg;
+    pmix_list_item_t *item;
+    int iov_count = 0, nmsgs = 0;
+    size_t remain = 0, nbytes;
+    ssize_t rc;
+
+    msg = peer->send_msg;
+    item = pmix_list_get_first(&peer->send_queue);
+    while (NULL != msg) {
+        iov[iov_count].iov_base = msg->sdptr;
+        iov[iov_count].iov_len = msg->sdbytes;
+        remain += msg->sdbytes;
+        ++iov_count;
+        if (!msg->hdr_sent && NULL != msg->data && 0 < ntohl(msg->hdr.nbytes)) {
+            iov[iov_count].iov_base = msg->data->base_ptr;
+            iov[iov_count].iov_len = ntohl(msg->hdr.nbytes);
+            remain += ntohl(msg->hdr.nbytes);
+            ++iov_count;
+        }
+        ++nmsgs;
+        if (nmsgs == pmix_ptl_base.max_send_batch
+            || item == pmix_list_get_end(&peer->send_queue)) {
+            break;
+        }
+        msg = (pmix_ptl_send_t *) item;
+        item = pmix_list_get_next(item);
+    }
+
 retry:
-    rc = writev(sd, iov, iov_count);
-    if (PMIX_LIKELY(rc == remain)) {
-        /* we successfully sent the header and the msg data if any */
-        msg->hdr_sent = true;
-        msg->sdbytes = 0;
-        msg->sdptr = (char *) iov[iov_count - 1].iov_base + iov[iov_count - 1].iov_len;
-        return PMIX_SUCCESS;
-    } else if (rc < 0) {
+    rc = writev(peer->sd, iov, iov_count);
+    if (rc < 0) {
         if (pmix_socket_errno == EINTR) {
             goto retry;
         } else if (pmix_socket_errno == EAGAIN) {
@@ -292,34 +339,118 @@ retry:
         } else {
             /* we hit an error and cannot progress this message */
             pmix_output(0, "pmix_ptl_base: send_msg: write failed: %s (%d) [sd = %d]",
-                        strerror(pmix_socket_errno), pmix_socket_errno, sd);
+                        strerror(pmix_socket_errno), pmix_socket_errno, peer->sd);
             return PMIX_ERR_UNREACH;
         }
-    } else {
-        /* short writev. This usually means the kernel buffer is full,
-         * so there is no point for retrying at that time.
-         * simply update the msg and return with PMIX_ERR_RESOURCE_BUSY */
-        if ((size_t) rc < msg->sdbytes) {
-            /* partial write of the header or the msg data */
-            msg->sdptr = (char *) msg->sdptr + rc;
-            msg->sdbytes -= rc;
+    }
+
+    /* release the messages that were completely written and
+     * put the first incomplete one (if any) on deck */
+    nbytes = (size_t) rc;
+    while (0 < nmsgs) {
+        msg = peer->send_msg;
+        if (!advance_msg(msg, &nbytes)) {
+            break;
+        }
+        pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                            "ptl:base:send_handler MSG SENT");
+        PMIX_RELEASE(msg);
+        --nmsgs;
+        if (0 < nmsgs) {
+            peer->send_msg = (pmix_ptl_send_t *) pmix_list_remove_first(&peer->send_queue);
         } else {
-            /* header was fully written, but only a part of the msg data was written */
-            msg->hdr_sent = true;
-            rc -= msg->sdbytes;
-            if (NULL != msg->data) {
-                /* technically, this should never happen as iov_count
-                 * would be 1 for a zero-byte message, and so we cannot
-                 * have a case where we write the header and part of the
-                 * msg. However, code checkers don't know that and are
-                 * fooled by our earlier check for NULL, and so
-                 * we silence their warnings by using this check */
-                msg->sdptr = (char *) msg->data->base_ptr + rc;
-            }
-            msg->sdbytes = ntohl(msg->hdr.nbytes) - rc;
+            peer->send_msg = NULL;
         }
+    }
+    if ((size_t) rc < remain) {
+        /* short writev. This usually means the kernel buffer is full,
+         * so there is no point for retrying at that time */
         return PMIX_ERR_RESOURCE_BUSY;
     }
+    return PMIX_SUCCESS;
+}
+
+static int recv_cache_class(size_t nbytes)
+{
+    int n;
+
+    if (nbytes < pmix_ptl_base.recv_cache_min) {
+        return -1;
+    }
+    for (n = 0; n < PMIX_PTL_RECV_CACHE_NCLASSES; n++) {
+        if (nbytes <= ((size_t) 1 << (PMIX_PTL_RECV_CACHE_MIN_SHIFT + n))) {
+            return n;
+        }
+    }
+    return -1;
+}
+
+/* get a region to receive a message body of the given size. The
+ * region must be handed back with pmix_ptl_base_recv_buffer_return
+ * using the same size, or else simply free'd. Only called from
+ * within the progress thread, so no locking is required */
+char *pmix_ptl_base_recv_buffer_get(size_t nbytes)
+{
+    pmix_ptl_recv_cache_t *cache;
+    int n;
+
+    n = recv_cache_class(nbytes);
+    if (n < 0) {
+        return (char *) malloc(nbytes);
+    }
+    cache = &pmix_ptl_base.recv_cache[n];
+    if (0 < cache->nbufs) {
+        --cache->nbufs;
+        return cache->bufs[cache->nbufs];
+    }
+    /* always allocate the full class size so the
+     * region can serve any message in its class */
+    return (char *) malloc((size_t) 1 << (PMIX_PTL_RECV_CACHE_MIN_SHIFT + n));
+}
+
+void pmix_ptl_base_recv_buffer_return(char *data, size_t nbytes)
+{
+    pmix_ptl_recv_cache_t *cache;
+    int n;
+
+    n = recv_cache_class(nbytes);
+    if (n < 0) {
+        free(data);
+        return;
+    }
+    cache = &pmix_ptl_base.recv_cache[n];
+    if (cache->nbufs < pmix_ptl_base.recv_cache_size) {
+        cache->bufs[cache->nbufs] = data;
+        ++cache->nbufs;
+        return;
+    }
+    free(data);
+}
+
+/* cleanup the buffer used to deliver the given message. If the
+ * recipient left the message body in place, then it is returned
+ * to the cache - otherwise, whatever the buffer holds is free'd */
+void pmix_ptl_base_recv_buffer_done(pmix_ptl_recv_t *msg, char *data, pmix_buffer_t *buf)
+{
+    if (msg->pooled && NULL != data && buf->base_ptr == data) {
+        pmix_ptl_base_recv_buffer_return(data, msg->hdr.nbytes);
+        buf->base_ptr = NULL;
+    }
+    PMIX_DESTRUCT(buf);
+}
+
+void pmix_ptl_base_recv_cache_release(void)
+{
+    pmix_ptl_recv_cache_t *cache;
+    int n;
+
+    for (n = 0; n < PMIX_PTL_RECV_CACHE_NCLASSES; n++) {
+        cache = &pmix_ptl_base.recv_cache[n];
+        while (0 < cache->nbufs) {
+            --cache->nbufs;
+            free(cache->bufs[cache->nbufs]);
+        }
+    }
 }
 
 static pmix_status_t read_bytes(int sd, char **buf, size_t *remain)
@@ -398,13 +529,8 @@ void pmix_ptl_base_send_handler(int sd, short flags, void *cbdata)
         pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                             "ptl:base:send_handler SENDING MSG TO %s TAG %u",
                             PMIX_PNAME_PRINT(&peer->info->pname), ntohl(msg->hdr.tag));
-        if (PMIX_SUCCESS == (rc = send_msg(peer->sd, msg))) {
-            // message is complete
-            pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
-                                "ptl:base:send_handler MSG SENT");
-            PMIX_RELEASE(msg);
-            peer->send_msg = NULL;
-        } else if (PMIX_ERR_RESOURCE_BUSY == rc || PMIX_ERR_WOULD_BLOCK == rc) {
+        rc = send_msgs(peer);
+        if (PMIX_ERR_RESOURCE_BUSY == rc || PMIX_ERR_WOULD_BLOCK == rc) {
             /* exit this event and let the event lib progress */
             pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                                 "ptl:base:send_handler RES BUSY OR WOULD BLOCK");
@@ -412,13 +538,13 @@ void pmix_ptl_base_send_handler(int sd, short flags, void *cbdata)
              * picks it back up */
             PMIX_POST_OBJECT(peer);
             return;
-        } else {
+        } else if (PMIX_SUCCESS != rc) {
             pmix_output_verbose(5, pmix_ptl_base_framework.framework_output, "%s SEND ERROR %s",
                                 PMIX_NAME_PRINT(&pmix_globals.myid), PMIx_Error_string(rc));
             // report the error
             pmix_event_del(&peer->send_event);
             peer->send_ev_active = false;
-            PMIX_RELEASE(msg);
+            PMIX_RELEASE(peer->send_msg);
             peer->send_msg = NULL;
             lost_connection(peer);
             /* ensure we post the modified peer object before another thread
@@ -427,7 +553,7 @@ void pmix_ptl_base_send_handler(int sd, short flags, void *cbdata)
             return;
         }
 
-        /* if current message completed - progress any pending sends by
+        /* if the current batch completed - progress any pending sends by
          * moving the next in the queue into the "on-deck" position. Note
          * that this doesn't mean we send the message right now - we will
          * wait for another send_event to fire before doing so. This gives
@@ -457,9 +583,6 @@ void pmix_ptl_base_recv_handler(int sd, short flags, void *cbdata)
     pmix_status_t rc;
     pmix_peer_t *peer = (pmix_peer_t *) cbdata;
     pmix_ptl_recv_t *msg = NULL;
-    pmix_ptl_hdr_t hdr;
-    size_t nbytes;
-    char *ptr;
 
     /* acquire the object */
     PMIX_ACQUIRE_OBJECT(peer);
@@ -494,15 +617,14 @@ void pmix_ptl_base_recv_handler(int sd, short flags, void *cbdata)
     if (!msg->hdr_recvd) {
         pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                             "ptl:base:recv:handler read hdr on socket %d", peer->sd);
-        nbytes = sizeof(pmix_ptl_hdr_t);
-        ptr = (char *) &hdr;
-        if (PMIX_SUCCESS == (rc = read_bytes(peer->sd, &ptr, &nbytes))) {
+        /* the header may arrive in pieces, so read it in place */
+        if (PMIX_SUCCESS == (rc = read_bytes(peer->sd, &msg->rdptr, &msg->rdbytes))) {
             /* completed reading the header */
             peer->recv_msg->hdr_recvd = true;
             /* convert the hdr to host format */
-            peer->recv_msg->hdr.pindex = ntohl(hdr.pindex);
-            peer->recv_msg->hdr.tag = ntohl(hdr.tag);
-            peer->recv_msg->hdr.nbytes = ntohl(hdr.nbytes);
+            peer->recv_msg->hdr.pindex = ntohl(peer->recv_msg->hdr.pindex);
+            peer->recv_msg->hdr.tag = ntohl(peer->recv_msg->hdr.tag);
+            peer->recv_msg->hdr.nbytes = ntohl(peer->recv_msg->hdr.nbytes);
             pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                                 "%s RECVD MSG FROM %s FOR TAG %d SIZE %d",
                                 PMIX_NAME_PRINT(&pmix_globals.myid),
@@ -533,8 +655,11 @@ void pmix_ptl_base_recv_handler(int sd, short flags, void *cbdata)
                                    (unsigned long) pmix_ptl_base.max_msg_size);
                     goto err_close;
                 }
-                peer->recv_msg->data = (char *) malloc(peer->recv_msg->hdr.nbytes);
-                memset(peer->recv_msg->data, 0, peer->recv_msg->hdr.nbytes);
+                peer->recv_msg->data = pmix_ptl_base_recv_buffer_get(peer->recv_msg->hdr.nbytes);
+                if (NULL == peer->recv_msg->data) {
+                    goto err_close;
+                }
+                peer->recv_msg->pooled = true;
                 /* point to it */
                 peer->recv_msg->rdptr = peer->recv_msg->data;
                 peer->recv_msg->rdbytes = peer->recv_msg->hdr.nbytes;
@@ -809,6 +934,7 @@ void pmix_ptl_base_process_msg(int fd, short flags, void *cbdata)
     pmix_ptl_recv_t *msg = (pmix_ptl_recv_t *) cbdata;
     pmix_ptl_posted_recv_t *rcv;
     pmix_buffer_t buf;
+    char *data;
 
     /* acquire the object */
     PMIX_ACQUIRE_OBJECT(msg);
@@ -827,8 +953,9 @@ void pmix_ptl_base_process_msg(int fd, short flags, void *cbdata)
             if (NULL != rcv->cbfunc) {
                 /* construct and load the buffer */
                 PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+                data = msg->data;
                 if (NULL != msg->data) {
-                    PMIX_LOAD_BUFFER(msg->peer, &buf, msg->data, msg->hdr.nbytes);
+                    PMIX_LOAD_BUFFER_NON_DESTRUCT(msg->peer, &buf, msg->data, msg->hdr.nbytes);
                 } else {
                     /* we need to at least set the buffer type so
                      * unpack of a zero-byte message doesn't error */
@@ -842,7 +969,7 @@ void pmix_ptl_base_process_msg(int fd, short flags, void *cbdata)
                 pmix_output_verbose(5, pmix_ptl_base_framework.framework_output,
                                     "%s:%d CALLBACK COMPLETE", pmix_globals.myid.nspace,
                                     pmix_globals.myid.rank);
-                PMIX_DESTRUCT(&buf); // free's the msg data
+                pmix_ptl_base_recv_buffer_done(msg, data, &buf);
             }
             /* done with the recv if it is a dynamic tag */
             if (PMIX_PTL_TAG_DYNAMIC <= rcv->tag && UINT_MAX != rcv->tag) {
@@ -104,6 +104,7 @@ void pmix_ptl_base_post_recv(int fd, short args, void *cbdata)
     pmix_ptl_posted_recv_t *req = (pmix_ptl_posted_recv_t *) cbdata;
     pmix_ptl_recv_t *msg, *nmsg;
     pmix_buffer_t buf;
+    char *data;
 
     pmix_output_verbose(5, pmix_ptl_base_framework.framework_output, "posting recv on tag %d",
                         req->tag);
@@ -118,6 +119,8 @@ void pmix_ptl_base_post_recv(int fd, short args, void *cbdata)
             if (NULL != req->cbfunc) {
                 /* construct and load the buffer */
                 PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+                buf.type = msg->peer->nptr->compat.type;
+                data = msg->data;
                 if (NULL != msg->data) {
                     buf.base_ptr = (char *) msg->data;
                     buf.bytes_allocated = buf.bytes_used = msg->hdr.nbytes;
@@ -126,7 +129,7 @@ void pmix_ptl_base_post_recv(int fd, short args, void *cbdata)
                 }
                 msg->data = NULL; // protect the data region
                 req->cbfunc(msg->peer, &msg->hdr, &buf, req->cbdata);
-                PMIX_DESTRUCT(&buf); // free's the msg data
+                pmix_ptl_base_recv_buffer_done(msg, data, &buf);
             }
             pmix_list_remove_item(&pmix_ptl_base.unexpected_msgs, &msg->super);
             PMIX_RELEASE(msg);
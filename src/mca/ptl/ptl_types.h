@@ -197,6 +197,8 @@ typedef uint32_t pmix_ptl_tag_t;
 #define PMIX_PTL_TAG_NOTIFY    0
 #define PMIX_PTL_TAG_HEARTBEAT 1
 #define PMIX_PTL_TAG_IOF       2
+#define PMIX_PTL_TAG_COLL      3
+#define PMIX_PTL_TAG_COLL_AUTH 4
 
 /* define the start of dynamic tags that are
  * assigned for send/recv operations */
@@ -243,6 +245,7 @@ typedef struct {
     int sd;
     pmix_ptl_hdr_t hdr;
     char *data;
+    bool pooled; // data came from the receive buffer cache
     bool hdr_recvd;
     char *rdptr;
     size_t rdbytes;
@@ -290,10 +293,17 @@ typedef uint16_t pmix_listener_protocol_t;
 
 /* connection support */
 typedef struct {
-    pmix_object_t super;
+    pmix_list_item_t super;
     pmix_event_t ev;
     pmix_listener_protocol_t protocol;
     int sd;
+    /* state of the non-blocking receive of the
+     * connection request */
+    pmix_ptl_hdr_t hdr;
+    char *msg;
+    size_t rcvd;
+    pmix_event_t timer;
+    bool timer_active;
     bool need_id;
     pmix_rnd_flag_t flag;
     pmix_proc_t proc;
@@ -369,6 +379,10 @@ PMIX_EXPORT extern int pmix_ptl_base_output;
  * p - pmix_peer_t of target recipient
  * t - tag to be sent to
  * b - buffer to be sent
+ *
+ * The buffer is only read by the send and is released once the
+ * send completes, so the same buffer can be queued to several
+ * procs provided it is retained for each of them
  */
 #define PMIX_SERVER_QUEUE_REPLY(r, p, t, b)                                                     \
     do {                                                                                        \
@@ -44,6 +44,7 @@
 #include "src/mca/psec/base/base.h"
 #include "src/mca/psquash/base/base.h"
 #include "src/mca/ptl/base/base.h"
+#include "src/util/pmix_atom.h"
 #include "src/util/pmix_keyval_parse.h"
 #include "src/util/pmix_output.h"
 #include "src/util/pmix_show_help.h"
@@ -105,6 +106,9 @@ void pmix_rte_finalize(void)
     /* keyval lex-based parser */
     pmix_util_keyval_parse_finalize();
 
+    /* release the table of well-known keys */
+    pmix_atom_finalize();
+
     (void) pmix_mca_base_framework_close(&pmix_pinstalldirs_base_framework);
     (void) pmix_mca_base_framework_close(&pmix_pif_base_framework);
     (void) pmix_mca_base_close();
@@ -143,6 +147,8 @@ void pmix_rte_finalize(void)
         free(pmix_globals.hostname);
         pmix_globals.hostname = NULL;
     }
+    PMIX_DESTRUCT(&pmix_globals.nspace_names);
+    PMIX_DESTRUCT(&pmix_globals.nspace_ids);
     PMIX_LIST_DESTRUCT(&pmix_globals.nspaces);
 
     /* now safe to release the event base */
@@ -289,6 +289,10 @@ int pmix_rte_init(uint32_t type, pmix_info_t info[], size_t ninfo, pmix_ptl_cbfu
     ret = pmix_hotel_init(&pmix_globals.notifications, pmix_globals.max_events, pmix_globals.evbase,
                           pmix_globals.event_eviction_time, _notification_eviction_cbfunc);
     PMIX_CONSTRUCT(&pmix_globals.nspaces, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_globals.nspace_names, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_globals.nspace_names, 256);
+    PMIX_CONSTRUCT(&pmix_globals.nspace_ids, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_globals.nspace_ids, 256);
     /* need to hold off checking the hotel init return code
      * until after we construct all the globals so they can
      * correct finalize */
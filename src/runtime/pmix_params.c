@@ -156,6 +156,17 @@ pmix_status_t pmix_register_params(void)
                                       PMIX_MCA_BASE_VAR_TYPE_INT,
                                       &pmix_client_globals.base_verbose);
 
+    (void) pmix_mca_base_var_register("pmix", "pmix", "client", "get_cache_ttl",
+                                      "Number of seconds a client remembers that its server did "
+                                      "not have a key of another proc, answering further requests "
+                                      "for that key with NOT_FOUND instead of asking the server "
+                                      "again. A key the proc commits later without a fence can be "
+                                      "missed for this long. The cache is cleared by any fence or "
+                                      "connect, and is bypassed by a get with "
+                                      "PMIX_GET_REFRESH_CACHE (0 = disabled)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &pmix_client_globals.getcache_ttl);
+
     /****   SERVER: VERBOSE OUTPUT PARAMS   ****/
     (void) pmix_mca_base_var_register("pmix", "pmix", "server", "get_verbose",
                                       "Verbosity for server get operations",
@@ -205,6 +216,63 @@ pmix_status_t pmix_register_params(void)
         PMIX_MCA_BASE_VAR_TYPE_BOOL,
         &pmix_server_globals.fence_localonly_opt);
 
+    pmix_server_globals.fence_streaming = false;
+    (void) pmix_mca_base_var_register("pmix", "pmix", "server", "fence_streaming",
+                                      "Pack the data of each local participant in a fence as it "
+                                      "arrives. Always enabled when the host provides the "
+                                      "PMIX_SERVER_FENCE_CONTRIB function (default: false)",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &pmix_server_globals.fence_streaming);
+
+    pmix_server_globals.modex_compress_threshold = 0;
+    (void) pmix_mca_base_var_register("pmix", "pmix", "server", "modex_compress_threshold",
+                                      "Size, in bytes, at which the data collected by a fence is "
+                                      "compressed before it is passed to the host, using the "
+                                      "codec selected by the pcompress framework. All servers "
+                                      "taking part in the fence must support it (default: 0 - "
+                                      "never compress)",
+                                      PMIX_MCA_BASE_VAR_TYPE_SIZE_T,
+                                      &pmix_server_globals.modex_compress_threshold);
+
+    pmix_server_globals.modex_compress_level = 1;
+    (void) pmix_mca_base_var_register("pmix", "pmix", "server", "modex_compress_level",
+                                      "Compression level for the data collected by a fence - "
+                                      "lower levels are faster, higher levels give smaller "
+                                      "data (default: 1)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &pmix_server_globals.modex_compress_level);
+
+    (void) pmix_mca_base_var_register("pmix", "pmix", "server", "coll_servers",
+                                      "Comma-delimited list of the host:port address of each "
+                                      "server in the group, in rank order. If given and the host "
+                                      "does not provide fence_nb, the servers exchange fence "
+                                      "data among themselves. A fence only involves the servers "
+                                      "hosting its procs if each host is the name of the node "
+                                      "in the job's map",
+                                      PMIX_MCA_BASE_VAR_TYPE_STRING,
+                                      &pmix_server_globals.coll_servers);
+
+    pmix_server_globals.coll_rank = 0;
+    (void) pmix_mca_base_var_register("pmix", "pmix", "server", "coll_rank",
+                                      "Position of this server in the list of coll_servers",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &pmix_server_globals.coll_rank);
+
+    pmix_server_globals.coll_ring_threshold = 64 * 1024;
+    (void) pmix_mca_base_var_register("pmix", "pmix", "server", "coll_ring_threshold",
+                                      "Average per-server contribution to a fence, in bytes, at "
+                                      "which the servers exchange fence data around a ring "
+                                      "(default: 64KB)",
+                                      PMIX_MCA_BASE_VAR_TYPE_SIZE_T,
+                                      &pmix_server_globals.coll_ring_threshold);
+
+    pmix_server_globals.coll_tree_fanout = 0;
+    (void) pmix_mca_base_var_register("pmix", "pmix", "server", "coll_tree_fanout",
+                                      "Fanout of the tree used by the servers for fences that do "
+                                      "not collect data (default: 0 - set by number of servers)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &pmix_server_globals.coll_tree_fanout);
+
     /* check for maximum number of pending output messages */
     pmix_globals.output_limit = (size_t) INT_MAX;
     (void) pmix_mca_base_var_register("pmix", "iof", NULL, "output_limit",
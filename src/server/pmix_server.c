@@ -85,8 +85,9 @@ pmix_server_globals_t pmix_server_globals = {
     .nspaces = PMIX_LIST_STATIC_INIT,
     .clients = PMIX_POINTER_ARRAY_STATIC_INIT,
     .collectives = PMIX_LIST_STATIC_INIT,
-    .remote_pnd = PMIX_LIST_STATIC_INIT,
-    .local_reqs = PMIX_LIST_STATIC_INIT,
+    .collectives_index = PMIX_HASH_TABLE_STATIC_INIT,
+    .remote_pnd = PMIX_DMDX_QUEUE_STATIC_INIT,
+    .local_reqs = PMIX_DMDX_QUEUE_STATIC_INIT,
     .gdata = PMIX_LIST_STATIC_INIT,
     .genvars = NULL,
     .events = PMIX_LIST_STATIC_INIT,
@@ -99,6 +100,16 @@ pmix_server_globals_t pmix_server_globals = {
     .tmpdir = NULL,
     .system_tmpdir = NULL,
     .fence_localonly_opt = false,
+    .fence_streaming = false,
+    .fence_contrib = NULL,
+    .modex_compress_threshold = 0,
+    .modex_compress_level = 1,
+    .modex_compress_floor = 0,
+    .coll_servers = NULL,
+    .coll_rank = 0,
+    .coll_size = 0,
+    .coll_ring_threshold = 0,
+    .coll_tree_fanout = 0,
     .get_output = -1,
     .get_verbose = 0,
     .connect_output = -1,
@@ -315,7 +326,7 @@ static void debugger_aggregator(size_t evhdlr_registration_id, pmix_status_t sta
 {
     pmix_proc_t proc;
     pmix_status_t rc;
-    pmix_namespace_t *ns, *nptr;
+    pmix_namespace_t *nptr;
 
     pmix_output_verbose(2, pmix_client_globals.base_output,
                         "[%s:%d] DEBUGGER AGGREGATOR CALLED FOR NSPACE %s",
@@ -324,13 +335,7 @@ static void debugger_aggregator(size_t evhdlr_registration_id, pmix_status_t sta
     PMIX_HIDE_UNUSED_PARAMS(evhdlr_registration_id, results, nresults);
 
     /* find the nspace tracker for this namespace */
-    nptr = NULL;
-    PMIX_LIST_FOREACH (ns, &pmix_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(ns->nspace, source->nspace)) {
-            nptr = ns;
-            break;
-        }
-    }
+    nptr = pmix_nspace_lookup(source->nspace);
     if (NULL == nptr) {
         /* only can happen if there is an error - nothing we can do*/
         goto done;
@@ -375,7 +380,7 @@ static pmix_status_t register_singleton(char *name)
     nptr->nspace = strdup(tmp);
     nptr->nlocalprocs = 1;
     nptr->nprocs = 1;
-    pmix_list_append(&pmix_globals.nspaces, &nptr->super);
+    pmix_nspace_register(nptr);
     /* add this rank */
     rinfo = PMIX_NEW(pmix_rank_info_t);
     if (NULL == rinfo) {
@@ -403,8 +408,10 @@ pmix_status_t pmix_server_initialize(void)
     pmix_pointer_array_init(&pmix_server_globals.clients, 1, INT_MAX, 1);
     PMIX_CONSTRUCT(&pmix_server_globals.nspaces, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_server_globals.collectives, pmix_list_t);
-    PMIX_CONSTRUCT(&pmix_server_globals.remote_pnd, pmix_list_t);
-    PMIX_CONSTRUCT(&pmix_server_globals.local_reqs, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_server_globals.collectives_index, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_server_globals.collectives_index, 256);
+    PMIX_CONSTRUCT(&pmix_server_globals.remote_pnd, pmix_dmdx_queue_t);
+    PMIX_CONSTRUCT(&pmix_server_globals.local_reqs, pmix_dmdx_queue_t);
     PMIX_CONSTRUCT(&pmix_server_globals.gdata, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_server_globals.events, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_server_globals.groups, pmix_list_t);
@@ -609,6 +616,12 @@ PMIX_EXPORT pmix_status_t PMIx_server_init(pmix_server_module_t *module, pmix_in
                 outputio = PMIX_INFO_TRUE(&info[n]);
             } else if (PMIX_CHECK_KEY(&info[n], PMIX_SINGLETON)) {
                 singleton = info[n].value.data.string;
+            } else if (PMIX_CHECK_KEY(&info[n], PMIX_SERVER_FENCE_CONTRIB)) {
+                /* the host wants the contributions as they arrive */
+                if (PMIX_POINTER == info[n].value.type) {
+                    pmix_server_globals.fence_contrib = (pmix_server_fence_contrib_fn_t)
+                                                            info[n].value.data.ptr;
+                }
             }
         }
     }
@@ -725,11 +738,13 @@ PMIX_EXPORT pmix_status_t PMIx_server_init(pmix_server_module_t *module, pmix_in
     }
     if (NULL == pmix_globals.mypeer->nptr) {
         pmix_globals.mypeer->nptr = PMIX_NEW(pmix_namespace_t);
-        /* ensure our own nspace is first on the list */
+        pmix_globals.mypeer->nptr->nspace = strdup(pmix_globals.myid.nspace);
+        /* the registry needs the name to index our own nspace */
         PMIX_RETAIN(pmix_globals.mypeer->nptr);
-        pmix_list_prepend(&pmix_globals.nspaces, &pmix_globals.mypeer->nptr->super);
+        pmix_nspace_register(pmix_globals.mypeer->nptr);
+    } else {
+        pmix_globals.mypeer->nptr->nspace = strdup(pmix_globals.myid.nspace);
     }
-    pmix_globals.mypeer->nptr->nspace = strdup(pmix_globals.myid.nspace);
     rinfo->pname.nspace = strdup(pmix_globals.mypeer->nptr->nspace);
     rinfo->pname.rank = pmix_globals.myid.rank;
     rinfo->uid = pmix_globals.uid;
@@ -836,6 +851,17 @@ PMIX_EXPORT pmix_status_t PMIx_server_init(pmix_server_module_t *module, pmix_in
         return PMIX_ERR_INIT;
     }
 
+    /* if the host can't circulate fence data, see if we
+     * are to do it ourselves */
+    if (NULL == pmix_host_server.fence_nb && NULL != pmix_server_globals.coll_servers) {
+        if (PMIX_SUCCESS != pmix_server_coll_init()) {
+            PMIX_RELEASE_THREAD(&pmix_global_lock);
+            PMIx_server_finalize();
+            return PMIX_ERR_INIT;
+        }
+        pmix_host_server.fence_nb = pmix_server_coll_fence_nb;
+    }
+
     ++pmix_globals.init_cntr;
     PMIX_RELEASE_THREAD(&pmix_global_lock);
 
@@ -978,6 +1004,7 @@ PMIX_EXPORT pmix_status_t PMIx_server_finalize(void)
     pmix_iof_static_dump_output(&pmix_client_globals.iof_stderr);
 
     pmix_ptl_base_stop_listening();
+    pmix_server_coll_finalize();
 
     for (i = 0; i < pmix_server_globals.clients.size; i++) {
         if (NULL
@@ -992,8 +1019,9 @@ PMIX_EXPORT pmix_status_t PMIx_server_finalize(void)
     }
     PMIX_DESTRUCT(&pmix_server_globals.clients);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.collectives);
-    PMIX_LIST_DESTRUCT(&pmix_server_globals.remote_pnd);
-    PMIX_LIST_DESTRUCT(&pmix_server_globals.local_reqs);
+    PMIX_DESTRUCT(&pmix_server_globals.collectives_index);
+    PMIX_DESTRUCT(&pmix_server_globals.remote_pnd);
+    PMIX_DESTRUCT(&pmix_server_globals.local_reqs);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.gdata);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.events);
     PMIX_LIST_FOREACH (ns, &pmix_globals.nspaces, pmix_namespace_t) {
@@ -1054,7 +1082,7 @@ static void opcbfunc(pmix_status_t status, void *cbdata)
 static void _register_nspace(int sd, short args, void *cbdata)
 {
     pmix_setup_caddy_t *cd = (pmix_setup_caddy_t *) cbdata;
-    pmix_namespace_t *nptr, *tmp;
+    pmix_namespace_t *nptr;
     pmix_status_t rc;
     size_t i, m, ninfo;
     pmix_info_t *iptr;
@@ -1074,13 +1102,7 @@ static void _register_nspace(int sd, short args, void *cbdata)
     PMIX_HIDE_UNUSED_PARAMS(sd, args);
 
     /* see if we already have this nspace */
-    nptr = NULL;
-    PMIX_LIST_FOREACH (tmp, &pmix_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(tmp->nspace, cd->proc.nspace)) {
-            nptr = tmp;
-            break;
-        }
-    }
+    nptr = pmix_nspace_lookup(cd->proc.nspace);
     if (NULL == nptr) {
         nptr = PMIX_NEW(pmix_namespace_t);
         if (NULL == nptr) {
@@ -1088,7 +1110,7 @@ static void _register_nspace(int sd, short args, void *cbdata)
             goto release;
         }
         nptr->nspace = strdup(cd->proc.nspace);
-        pmix_list_append(&pmix_globals.nspaces, &nptr->super);
+        pmix_nspace_register(nptr);
     }
     if (0 > cd->nlocalprocs) {
         gds = nptr->compat.gds;
@@ -1134,12 +1156,6 @@ static void _register_nspace(int sd, short args, void *cbdata)
         }
     }
 
-    /* register nspace for each activate components */
-    PMIX_GDS_ADD_NSPACE(rc, nptr->nspace, cd->nlocalprocs, cd->info, cd->ninfo);
-    if (PMIX_SUCCESS != rc) {
-        goto release;
-    }
-
     /* store this data in our own GDS module - we will retrieve
      * it later so it can be passed down to the launched procs
      * once they connect to us and we know what GDS module they
@@ -1155,6 +1171,13 @@ static void _register_nspace(int sd, short args, void *cbdata)
         goto release;
     }
 
+    /* register nspace for each activate components - done after
+     * caching so that components can build on the complete job info */
+    PMIX_GDS_ADD_NSPACE(rc, nptr->nspace, cd->nlocalprocs, cd->info, cd->ninfo);
+    if (PMIX_SUCCESS != rc) {
+        goto release;
+    }
+
     /* check any pending trackers to see if they are
      * waiting for us. There is a slight race condition whereby
      * the host server could have spawned the local client and
@@ -1180,13 +1203,9 @@ static void _register_nspace(int sd, short args, void *cbdata)
              * if the nspaces are all completely registered */
             if (all_def) {
                 /* so far, they have all been defined - check this one */
-                PMIX_LIST_FOREACH (ns, &pmix_globals.nspaces, pmix_namespace_t) {
-                    if (0 == strcmp(trk->pcs[i].nspace, ns->nspace)) {
-                        if (SIZE_MAX == ns->nlocalprocs || !ns->all_registered) {
-                            all_def = false;
-                        }
-                        break;
-                    }
+                ns = pmix_nspace_lookup(trk->pcs[i].nspace);
+                if (NULL != ns && (SIZE_MAX == ns->nlocalprocs || !ns->all_registered)) {
+                    all_def = false;
                 }
             }
             /* now see if this nspace is the one we just registered */
@@ -1280,6 +1299,22 @@ PMIX_EXPORT pmix_status_t PMIx_server_register_nspace(const pmix_nspace_t nspace
     return PMIX_SUCCESS;
 }
 
+/* take the local direct modex requests that target the given
+ * proc - a wildcard on either side matches */
+static void take_dmdx_requests(const char *nspace, pmix_rank_t rank, pmix_list_t *out)
+{
+    pmix_proc_t target;
+
+    if (PMIX_RANK_WILDCARD == rank) {
+        pmix_dmdx_queue_take_nspace(&pmix_server_globals.local_reqs, nspace, out);
+        return;
+    }
+    PMIX_LOAD_PROCID(&target, nspace, rank);
+    pmix_dmdx_queue_take(&pmix_server_globals.local_reqs, &target, out);
+    target.rank = PMIX_RANK_WILDCARD;
+    pmix_dmdx_queue_take(&pmix_server_globals.local_reqs, &target, out);
+}
+
 void pmix_server_purge_events(pmix_peer_t *peer, pmix_proc_t *proc)
 {
     pmix_regevents_info_t *reginfo, *regnext;
@@ -1289,7 +1324,8 @@ void pmix_server_purge_events(pmix_peer_t *peer, pmix_proc_t *proc)
     pmix_notify_caddy_t *ncd;
     size_t n, m, p, ntgs;
     pmix_proc_t *tgs, *tgt;
-    pmix_dmdx_local_t *dlcd, *dnxt;
+    pmix_dmdx_local_t *dlcd;
+    pmix_list_t dlcds;
 
     /* since the client is finalizing, remove them from any event
      * registrations they may still have on our list */
@@ -1335,18 +1371,20 @@ void pmix_server_purge_events(pmix_peer_t *peer, pmix_proc_t *proc)
     }
 
     /* see if this proc is involved in any direct modex requests */
-    PMIX_LIST_FOREACH_SAFE (dlcd, dnxt, &pmix_server_globals.local_reqs, pmix_dmdx_local_t) {
-        if ((NULL != peer && NULL != peer->info
-             && PMIX_CHECK_PROCID(&peer->info->pname, &dlcd->proc))
-            || (NULL != proc && PMIX_CHECK_PROCID(proc, &dlcd->proc))) {
-            /* cleanup this request */
-            pmix_list_remove_item(&pmix_server_globals.local_reqs, &dlcd->super);
-            /* we can release the dlcd item here because we are not
-             * releasing the tracker held by the host - we are only
-             * releasing one item on that tracker */
-            PMIX_RELEASE(dlcd);
-        }
+    PMIX_CONSTRUCT(&dlcds, pmix_list_t);
+    if (NULL != peer && NULL != peer->info) {
+        take_dmdx_requests(peer->info->pname.nspace, peer->info->pname.rank, &dlcds);
     }
+    if (NULL != proc) {
+        take_dmdx_requests(proc->nspace, proc->rank, &dlcds);
+    }
+    /* we can release the dlcd items here because we are not
+     * releasing the tracker held by the host - we are only
+     * releasing one item on that tracker */
+    while (NULL != (dlcd = (pmix_dmdx_local_t *) pmix_list_remove_first(&dlcds))) {
+        PMIX_RELEASE(dlcd);
+    }
+    PMIX_DESTRUCT(&dlcds);
 
     /* purge this client from any cached notifications */
     for (i = 0; i < pmix_globals.max_events; i++) {
@@ -1425,15 +1463,13 @@ static void _deregister_nspace(int sd, short args, void *cbdata)
     pmix_server_purge_events(NULL, &cd->proc);
 
     /* release this nspace */
-    PMIX_LIST_FOREACH (tmp, &pmix_globals.nspaces, pmix_namespace_t) {
-        if (PMIX_CHECK_NSPACE(tmp->nspace, cd->proc.nspace)) {
-            /* perform any nspace-level epilog */
-            pmix_execute_epilog(&tmp->epilog);
-            /* remove and release it */
-            pmix_list_remove_item(&pmix_globals.nspaces, &tmp->super);
-            PMIX_RELEASE(tmp);
-            break;
-        }
+    tmp = pmix_nspace_lookup(cd->proc.nspace);
+    if (NULL != tmp) {
+        /* perform any nspace-level epilog */
+        pmix_execute_epilog(&tmp->epilog);
+        /* remove and release it */
+        pmix_nspace_deregister(tmp);
+        PMIX_RELEASE(tmp);
     }
 
     /* release the caller */
@@ -1762,7 +1798,7 @@ void pmix_server_execute_collective(int sd, short args, void *cbdata)
     } else {
         /* unknown type */
         PMIX_ERROR_LOG(PMIX_ERR_NOT_FOUND);
-        pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+        pmix_server_remove_tracker(trk);
         PMIX_RELEASE(trk);
     }
     PMIX_RELEASE(tcd);
@@ -1788,13 +1824,7 @@ static void _register_client(int sd, short args, void *cbdata)
                         (NULL == cd->server_object) ? "NULL" : "NON-NULL");
 
     /* see if we already have this nspace */
-    nptr = NULL;
-    PMIX_LIST_FOREACH (ns, &pmix_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(ns->nspace, cd->proc.nspace)) {
-            nptr = ns;
-            break;
-        }
-    }
+    nptr = pmix_nspace_lookup(cd->proc.nspace);
     if (NULL == nptr) {
         /* there is no requirement in the Standard that hosts register
          * an nspace prior to registering clients for that nspace. So
@@ -1806,7 +1836,7 @@ static void _register_client(int sd, short args, void *cbdata)
             goto cleanup;
         }
         nptr->nspace = strdup(cd->proc.nspace);
-        pmix_list_append(&pmix_globals.nspaces, &nptr->super);
+        pmix_nspace_register(nptr);
     }
     /* setup a peer object for this client - since the host server
      * only deals with the original processes and not any clones,
@@ -1854,13 +1884,9 @@ static void _register_client(int sd, short args, void *cbdata)
                  * if the nspaces are all completely registered */
                 if (all_def) {
                     /* so far, they have all been defined - check this one */
-                    PMIX_LIST_FOREACH (ns, &pmix_globals.nspaces, pmix_namespace_t) {
-                        if (0 == strcmp(trk->pcs[i].nspace, ns->nspace)) {
-                            if (SIZE_MAX == ns->nlocalprocs || !ns->all_registered) {
-                                all_def = false;
-                            }
-                            break;
-                        }
+                    ns = pmix_nspace_lookup(trk->pcs[i].nspace);
+                    if (NULL != ns && (SIZE_MAX == ns->nlocalprocs || !ns->all_registered)) {
+                        all_def = false;
                     }
                 }
                 /* now see if this nspace is the one to which the client we just
@@ -1962,7 +1988,7 @@ static void _deregister_client(int sd, short args, void *cbdata)
 {
     pmix_setup_caddy_t *cd = (pmix_setup_caddy_t *) cbdata;
     pmix_rank_info_t *info;
-    pmix_namespace_t *nptr, *tmp;
+    pmix_namespace_t *nptr;
     pmix_peer_t *peer;
 
     PMIX_ACQUIRE_OBJECT(cd);
@@ -1973,13 +1999,7 @@ static void _deregister_client(int sd, short args, void *cbdata)
                         cd->proc.rank);
 
     /* see if we already have this nspace */
-    nptr = NULL;
-    PMIX_LIST_FOREACH (tmp, &pmix_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(tmp->nspace, cd->proc.nspace)) {
-            nptr = tmp;
-            break;
-        }
-    }
+    nptr = pmix_nspace_lookup(cd->proc.nspace);
     if (NULL == nptr) {
         /* nothing to do */
         goto cleanup;
@@ -2019,6 +2039,16 @@ static void _deregister_client(int sd, short args, void *cbdata)
                 }
                 /* honor any registered epilogs */
                 pmix_execute_epilog(&peer->epilog);
+                /* stop watching the socket before we close it - the
+                 * next connection may be given the same descriptor */
+                if (peer->recv_ev_active) {
+                    pmix_event_del(&peer->recv_event);
+                    peer->recv_ev_active = false;
+                }
+                if (peer->send_ev_active) {
+                    pmix_event_del(&peer->send_event);
+                    peer->send_ev_active = false;
+                }
                 /* ensure we close the socket to this peer so we don't
                  * generate "connection lost" events should it be
                  * subsequently "killed" by the host */
@@ -2127,6 +2157,11 @@ PMIX_EXPORT pmix_status_t PMIx_server_setup_fork(const pmix_proc_t *proc, char *
         pmix_setenv("PMIX_BFROP_BUFFER_TYPE", "PMIX_BFROP_BUFFER_FULLY_DESC", true, env);
     } else {
         pmix_setenv("PMIX_BFROP_BUFFER_TYPE", "PMIX_BFROP_BUFFER_NON_DESC", true, env);
+        /* offer native buffers - the client will only take us up
+         * on it if it was built for the same architecture */
+        if (pmix_bfrops_globals.native) {
+            pmix_setenv("PMIX_BFROP_NATIVE", pmix_bfrops_globals.arch, true, env);
+        }
     }
     /* pass our available gds modules */
     pmix_setenv("PMIX_GDS_MODULE", gds_mode, true, env);
@@ -2181,7 +2216,7 @@ static void _dmodex_req(int sd, short args, void *cbdata)
 {
     pmix_setup_caddy_t *cd = (pmix_setup_caddy_t *) cbdata;
     pmix_rank_info_t *info, *iptr;
-    pmix_namespace_t *nptr, *ns;
+    pmix_namespace_t *nptr;
     char *data = NULL;
     size_t sz = 0;
     pmix_dmdx_remote_t *dcd;
@@ -2200,13 +2235,7 @@ static void _dmodex_req(int sd, short args, void *cbdata)
      * could cause this request to arrive prior to us having
      * been informed of it - so first check to see if we know
      * about this nspace yet */
-    nptr = NULL;
-    PMIX_LIST_FOREACH (ns, &pmix_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(ns->nspace, cd->proc.nspace)) {
-            nptr = ns;
-            break;
-        }
-    }
+    nptr = pmix_nspace_lookup(cd->proc.nspace);
     if (NULL == nptr) {
         /* we don't know this namespace yet, and so we obviously
          * haven't received the data from this proc yet - defer
@@ -2217,7 +2246,12 @@ static void _dmodex_req(int sd, short args, void *cbdata)
             goto cleanup;
         }
         dcd->cd = cd;
-        pmix_list_append(&pmix_server_globals.remote_pnd, &dcd->super);
+        rc = pmix_dmdx_queue_append(&pmix_server_globals.remote_pnd, &cd->proc, &dcd->super);
+        if (PMIX_SUCCESS != rc) {
+            dcd->cd = NULL;
+            PMIX_RELEASE(dcd);
+            goto cleanup;
+        }
         return;
     }
 
@@ -2262,7 +2296,12 @@ static void _dmodex_req(int sd, short args, void *cbdata)
          * the request until we do */
         dcd = PMIX_NEW(pmix_dmdx_remote_t);
         dcd->cd = cd;
-        pmix_list_append(&pmix_server_globals.remote_pnd, &dcd->super);
+        rc = pmix_dmdx_queue_append(&pmix_server_globals.remote_pnd, &cd->proc, &dcd->super);
+        if (PMIX_SUCCESS != rc) {
+            dcd->cd = NULL;
+            PMIX_RELEASE(dcd);
+            goto cleanup;
+        }
         return;
     }
 
@@ -2273,7 +2312,12 @@ static void _dmodex_req(int sd, short args, void *cbdata)
          * data is recvd */
         dcd = PMIX_NEW(pmix_dmdx_remote_t);
         dcd->cd = cd;
-        pmix_list_append(&pmix_server_globals.remote_pnd, &dcd->super);
+        rc = pmix_dmdx_queue_append(&pmix_server_globals.remote_pnd, &cd->proc, &dcd->super);
+        if (PMIX_SUCCESS != rc) {
+            dcd->cd = NULL;
+            PMIX_RELEASE(dcd);
+            goto cleanup;
+        }
         return;
     }
 
@@ -3386,7 +3430,7 @@ cleanup:
     xfer.bytes_used = 0;
     PMIX_DESTRUCT(&xfer);
 
-    pmix_list_remove_item(&pmix_server_globals.collectives, &tracker->super);
+    pmix_server_remove_tracker(tracker);
     PMIX_RELEASE(tracker);
     PMIX_LIST_DESTRUCT(&nslist);
 
@@ -3639,7 +3683,7 @@ cleanup:
     if (NULL != nspaces) {
         pmix_argv_free(nspaces);
     }
-    pmix_list_remove_item(&pmix_server_globals.collectives, &tracker->super);
+    pmix_server_remove_tracker(tracker);
     PMIX_RELEASE(tracker);
 
     /* we are done */
@@ -3716,7 +3760,7 @@ static void _discnct(int sd, short args, void *cbdata)
 cleanup:
     /* cleanup the tracker -- the host RM is responsible for
      * telling us when to remove the nspace from our data */
-    pmix_list_remove_item(&pmix_server_globals.collectives, &tracker->super);
+    pmix_server_remove_tracker(tracker);
     PMIX_RELEASE(tracker);
 
     /* we are done */
@@ -4493,6 +4537,14 @@ static pmix_status_t server_switchyard(pmix_peer_t *peer, uint32_t tag, pmix_buf
         return rc;
     }
 
+    if (PMIX_GETMULTI_CMD == cmd) {
+        PMIX_GDS_CADDY(cd, peer, tag);
+        if (PMIX_SUCCESS != (rc = pmix_server_get_multi(buf, get_cbfunc, cd))) {
+            PMIX_RELEASE(cd);
+        }
+        return rc;
+    }
+
     if (PMIX_FINALIZE_CMD == cmd) {
         pmix_output_verbose(2, pmix_server_globals.base_output, "recvd FINALIZE");
         peer->nptr->nfinalized++;
@@ -0,0 +1,1666 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/* Built-in collective engine for hosts that do not provide
+ * a fence_nb function of their own. The servers of a job are
+ * given the address of every server in the group, in rank
+ * order, and exchange the data for a fence among themselves
+ * using the PTL message framing over TCP.
+ *
+ * A fence is run among the servers hosting its procs, found
+ * by matching the node of each proc to the host part of the
+ * server addresses. If that can't be done for some proc -
+ * e.g., the addresses don't name the nodes, or more than one
+ * server runs on a node - every server must take part.
+ *
+ * All servers must select the same algorithm for a given
+ * fence, and so the choice can only depend on information
+ * they share: the number of servers, whether data is being
+ * collected, and the average contribution to the previous
+ * fence over the same set of procs.
+ *
+ * A server says who it is when it connects to another, and
+ * the connection is only used once the address it comes from
+ * matches that of the server it claims to be and its
+ * credential checks out - so the servers must all run as the
+ * same user and select the same security module.
+ *
+ * If a server goes away, the fences that still need to hear
+ * from it fail, and the other servers are told so that none
+ * of them waits for a contribution that will never arrive.
+ */
+
+#include "src/include/pmix_config.h"
+
+#include "src/include/pmix_socket_errno.h"
+#include "src/include/pmix_stdint.h"
+
+#include "include/pmix_server.h"
+#include "src/include/pmix_globals.h"
+
+#ifdef HAVE_STRING_H
+#    include <string.h>
+#endif
+#ifdef HAVE_STRINGS_H
+#    include <strings.h>
+#endif
+#include <fcntl.h>
+#ifdef HAVE_UNISTD_H
+#    include <unistd.h>
+#endif
+#ifdef HAVE_SYS_SOCKET_H
+#    include <sys/socket.h>
+#endif
+#ifdef HAVE_NETINET_IN_H
+#    include <netinet/in.h>
+#endif
+#ifdef HAVE_NETINET_TCP_H
+#    include <netinet/tcp.h>
+#endif
+#ifdef HAVE_NETDB_H
+#    include <netdb.h>
+#endif
+#ifdef HAVE_SYS_TYPES_H
+#    include <sys/types.h>
+#endif
+#include <event.h>
+#include <time.h>
+
+#include "src/class/pmix_hash_table.h"
+#include "src/class/pmix_list.h"
+#include "src/class/pmix_pointer_array.h"
+#include "src/mca/bfrops/bfrops.h"
+#include "src/mca/gds/gds.h"
+#include "src/mca/psec/psec.h"
+#include "src/mca/ptl/base/base.h"
+#include "src/util/pmix_argv.h"
+#include "src/util/pmix_error.h"
+#include "src/util/pmix_fd.h"
+#include "src/util/pmix_output.h"
+
+#include "pmix_server_ops.h"
+
+/* algorithms */
+#define PMIX_COLL_RECURSIVE_DOUBLING 0
+#define PMIX_COLL_BRUCK              1
+#define PMIX_COLL_RING               2
+#define PMIX_COLL_TREE               3
+
+/* number of times to try connecting to a server
+ * that may still be starting up, and how long to
+ * wait between tries */
+#define PMIX_COLL_CONNECT_TRIES 100
+#define PMIX_COLL_CONNECT_DELAY 50000
+
+/* seconds to wait for a server to answer a connect */
+#define PMIX_COLL_CONNECT_TIMEOUT 10
+
+/* step of the message telling the other servers
+ * that a fence failed */
+#define PMIX_COLL_ABORT -1
+
+/* a message received from another server */
+typedef struct {
+    pmix_list_item_t super;
+    int32_t src;
+    int32_t step;
+    int32_t nblocks;
+    int32_t *origins;
+    pmix_byte_object_t *blocks;
+} coll_msg_t;
+static void mcon(coll_msg_t *p)
+{
+    p->src = -1;
+    p->step = 0;
+    p->nblocks = 0;
+    p->origins = NULL;
+    p->blocks = NULL;
+}
+static void mdes(coll_msg_t *p)
+{
+    int32_t n;
+
+    for (n = 0; n < p->nblocks; n++) {
+        PMIX_BYTE_OBJECT_DESTRUCT(&p->blocks[n]);
+    }
+    if (NULL != p->origins) {
+        free(p->origins);
+    }
+    if (NULL != p->blocks) {
+        free(p->blocks);
+    }
+}
+static PMIX_CLASS_INSTANCE(coll_msg_t, pmix_list_item_t, mcon, mdes);
+
+/* the state of a fence we are taking part in - messages for
+ * it can arrive before it starts locally */
+typedef struct {
+    pmix_list_item_t super;
+    uint64_t id;       // hash of the collective's signature
+    uint32_t epoch;    // instance of the collective
+    bool started;      // our own contribution is in
+    bool barrier;      // no data is being collected
+    int algo;
+    int step;
+    int nsteps;
+    bool sent;         // sends for the current step are done
+    pmix_status_t status; // set if another server failed it before it started
+    int *members;      // the servers taking part, in server order
+    int size;          // how many of them there are
+    int me;            // our position among them
+    pmix_byte_object_t *blobs; // contribution of each server
+    char *have;        // which contributions we hold
+    pmix_list_t msgs;  // coll_msg_t not yet consumed
+    pmix_modex_cbfunc_t cbfunc;
+    void *cbdata;
+} coll_op_t;
+static void ocon(coll_op_t *p)
+{
+    p->id = 0;
+    p->epoch = 0;
+    p->started = false;
+    p->barrier = false;
+    p->algo = PMIX_COLL_BRUCK;
+    p->step = 0;
+    p->nsteps = 0;
+    p->sent = false;
+    p->status = PMIX_SUCCESS;
+    p->members = NULL;
+    p->size = 0;
+    p->me = -1;
+    p->blobs = NULL;
+    p->have = NULL;
+    PMIX_CONSTRUCT(&p->msgs, pmix_list_t);
+    p->cbfunc = NULL;
+    p->cbdata = NULL;
+}
+static void odes(coll_op_t *p)
+{
+    int n;
+
+    if (NULL != p->blobs) {
+        for (n = 0; n < pmix_server_globals.coll_size; n++) {
+            PMIX_BYTE_OBJECT_DESTRUCT(&p->blobs[n]);
+        }
+        free(p->blobs);
+    }
+    if (NULL != p->have) {
+        free(p->have);
+    }
+    PMIX_LIST_DESTRUCT(&p->msgs);
+}
+static PMIX_CLASS_INSTANCE(coll_op_t, pmix_list_item_t, ocon, odes);
+
+/* what we remember about the fences over a given set of procs */
+typedef struct {
+    pmix_object_t super;
+    uint32_t epoch;  // number of fences started over it
+    size_t avgsize;  // average contribution to the last one
+    int *members;    // the servers hosting the procs, in server order
+    int nmembers;
+} coll_sig_t;
+static void scon(coll_sig_t *p)
+{
+    p->epoch = 0;
+    p->avgsize = 0;
+    p->members = NULL;
+    p->nmembers = 0;
+}
+static void sdes(coll_sig_t *p)
+{
+    if (NULL != p->members) {
+        free(p->members);
+    }
+}
+static PMIX_CLASS_INSTANCE(coll_sig_t, pmix_object_t, scon, sdes);
+
+/* our connection to a server we send to. Messages are
+ * queued on the peer while the connect is in progress */
+typedef struct {
+    pmix_peer_t *peer; // NULL until we first send to the server
+    int sd;            // socket being connected
+    int tries;
+    pmix_event_t ev;   // connect completion or retry timer
+    bool ev_active;
+} coll_link_t;
+
+static char **addrs = NULL;
+static char **hosts = NULL;             // host part of each address
+static struct addrinfo **resolved = NULL; // each address, resolved once at init
+static struct sockaddr_storage myaddr;  // our own address, to connect from
+static socklen_t myaddrlen = 0;
+static int lsd = -1;
+static pmix_event_t lev;
+static bool lev_active = false;
+static coll_link_t *links = NULL;       // connection to each server we send to
+static char *lost = NULL;               // servers whose connection went away
+static pmix_event_t lost_ev;            // checks the fences waiting on them
+static bool lost_ev_active = false;
+static pmix_pointer_array_t conns;      // every connection we made or accepted
+static pmix_hash_table_t sigs;          // coll_sig_t by signature hash
+static pmix_list_t ops;                 // coll_op_t in progress
+static bool initialized = false;
+
+static void advance(coll_op_t *op);
+
+static uint64_t hash_key(const char *key, size_t len)
+{
+    uint64_t h = 14695981039346656037ULL;
+    size_t n;
+
+    for (n = 0; n < len; n++) {
+        h ^= (unsigned char) key[n];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+/* split a host:port address - the port points into
+ * the string that is returned */
+static char *split_addr(const char *addr, char **port)
+{
+    char *host;
+
+    host = strdup(addr);
+    if (NULL == host) {
+        return NULL;
+    }
+    *port = strrchr(host, ':');
+    if (NULL == *port) {
+        free(host);
+        return NULL;
+    }
+    *(*port)++ = '\0';
+    if ('[' == host[0] && ']' == host[strlen(host) - 1]) {
+        host[strlen(host) - 1] = '\0';
+        memmove(host, host + 1, strlen(host));
+    }
+    return host;
+}
+
+static int parse_addr(const char *addr, struct addrinfo **res)
+{
+    struct addrinfo hints;
+    char *host, *port;
+    int rc;
+
+    host = split_addr(addr, &port);
+    if (NULL == host) {
+        return -1;
+    }
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    rc = getaddrinfo(host, port, &hints, res);
+    free(host);
+    return rc;
+}
+
+static void free_resolved(void)
+{
+    int n;
+
+    if (NULL == resolved) {
+        return;
+    }
+    for (n = 0; n < pmix_server_globals.coll_size; n++) {
+        if (NULL != resolved[n]) {
+            freeaddrinfo(resolved[n]);
+        }
+    }
+    free(resolved);
+    resolved = NULL;
+}
+
+static pmix_peer_t *new_peer(pmix_rank_t rank)
+{
+    pmix_peer_t *peer;
+
+    peer = PMIX_NEW(pmix_peer_t);
+    if (NULL == peer) {
+        return NULL;
+    }
+    peer->info = PMIX_NEW(pmix_rank_info_t);
+    peer->info->pname.nspace = strdup("pmix.coll");
+    peer->info->pname.rank = rank;
+    /* the other servers run as we do */
+    peer->info->uid = pmix_globals.uid;
+    peer->info->gid = pmix_globals.gid;
+    /* all servers use our buffer type and security module */
+    PMIX_RETAIN(pmix_globals.mypeer->nptr);
+    peer->nptr = pmix_globals.mypeer->nptr;
+    PMIX_SET_PEER_TYPE(peer, PMIX_PROC_SERVER);
+    peer->protocol = PMIX_PROTOCOL_V2;
+    pmix_pointer_array_add(&conns, peer);
+    return peer;
+}
+
+/* start sending and receiving on a connected socket */
+static void attach(pmix_peer_t *peer, int sd)
+{
+#if defined(TCP_NODELAY)
+    int one = 1;
+
+    /* the messages are small and latency-bound */
+    (void) setsockopt(sd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+#endif
+    pmix_fd_set_cloexec(sd);
+    pmix_ptl_base_set_nonblocking(sd);
+
+    peer->sd = sd;
+    pmix_event_assign(&peer->send_event, pmix_globals.evbase, sd, EV_WRITE | EV_PERSIST,
+                      pmix_ptl_base_send_handler, peer);
+    pmix_event_assign(&peer->recv_event, pmix_globals.evbase, sd, EV_READ | EV_PERSIST,
+                      pmix_ptl_base_recv_handler, peer);
+    pmix_event_add(&peer->recv_event, NULL);
+    peer->recv_ev_active = true;
+    /* push out anything queued while we were connecting */
+    if (NULL != peer->send_msg && !peer->send_ev_active) {
+        pmix_event_add(&peer->send_event, NULL);
+        peer->send_ev_active = true;
+    }
+}
+
+static void fail_link(int dst, pmix_status_t status);
+
+static void retry_connect(int sd, short args, void *cbdata);
+
+/* the server may not be listening yet - try again
+ * in a little while */
+static pmix_status_t retry(int dst)
+{
+    coll_link_t *lk = &links[dst];
+    struct timeval tv = {0, PMIX_COLL_CONNECT_DELAY};
+
+    if (PMIX_COLL_CONNECT_TRIES <= ++lk->tries) {
+        return PMIX_ERR_UNREACH;
+    }
+    pmix_event_evtimer_set(pmix_globals.evbase, &lk->ev, retry_connect, lk);
+    pmix_event_evtimer_add(&lk->ev, &tv);
+    lk->ev_active = true;
+    return PMIX_SUCCESS;
+}
+
+static void connected(int sd, short args, void *cbdata)
+{
+    coll_link_t *lk = (coll_link_t *) cbdata;
+    int dst = lk - links;
+    int err = 0;
+    socklen_t len = sizeof(err);
+    pmix_status_t rc;
+
+    lk->ev_active = false;
+    if (args & EV_TIMEOUT) {
+        /* nobody is answering at that address */
+        CLOSE_THE_SOCKET(lk->sd);
+        fail_link(dst, PMIX_ERR_TIMEOUT);
+        return;
+    }
+    if (0 != getsockopt(sd, SOL_SOCKET, SO_ERROR, &err, &len) || 0 != err) {
+        CLOSE_THE_SOCKET(lk->sd);
+        rc = retry(dst);
+        if (PMIX_SUCCESS != rc) {
+            fail_link(dst, rc);
+        }
+        return;
+    }
+    pmix_output_verbose(2, pmix_server_globals.fence_output,
+                        "pmix:server:coll: connected to server %d at %s", dst, addrs[dst]);
+    attach(lk->peer, lk->sd);
+    lk->sd = -1;
+    lk->tries = 0;
+    lost[dst] = 0;
+}
+
+static pmix_status_t start_connect(int dst)
+{
+    coll_link_t *lk = &links[dst];
+    struct addrinfo *res = resolved[dst];
+    struct timeval tv = {PMIX_COLL_CONNECT_TIMEOUT, 0};
+    int rc;
+
+    lk->sd = socket(res->ai_family, SOCK_STREAM, 0);
+    if (lk->sd < 0) {
+        return PMIX_ERR_UNREACH;
+    }
+    /* come from the address the other server knows us by */
+    if (0 < myaddrlen && res->ai_family == myaddr.ss_family
+        && 0 != bind(lk->sd, (struct sockaddr *) &myaddr, myaddrlen)) {
+        pmix_output(0, "pmix:server:coll: cannot bind to %s: %s",
+                    addrs[pmix_server_globals.coll_rank], strerror(pmix_socket_errno));
+        CLOSE_THE_SOCKET(lk->sd);
+        return PMIX_ERR_UNREACH;
+    }
+    pmix_ptl_base_set_nonblocking(lk->sd);
+    rc = connect(lk->sd, res->ai_addr, res->ai_addrlen);
+    if (0 == rc || EINPROGRESS == pmix_socket_errno) {
+        /* we learn how it went once the socket is writable */
+        pmix_event_assign(&lk->ev, pmix_globals.evbase, lk->sd, EV_WRITE, connected, lk);
+        pmix_event_add(&lk->ev, &tv);
+        lk->ev_active = true;
+        return PMIX_SUCCESS;
+    }
+    CLOSE_THE_SOCKET(lk->sd);
+    return retry(dst);
+}
+
+static void retry_connect(int sd, short args, void *cbdata)
+{
+    coll_link_t *lk = (coll_link_t *) cbdata;
+    pmix_status_t rc;
+
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+
+    lk->ev_active = false;
+    rc = start_connect(lk - links);
+    if (PMIX_SUCCESS != rc) {
+        fail_link(lk - links, rc);
+    }
+}
+
+/* close a connection we won't take messages from - the
+ * peer is released at finalize as the PTL may still be
+ * using it */
+static void drop(pmix_peer_t *peer)
+{
+    if (peer->recv_ev_active) {
+        pmix_event_del(&peer->recv_event);
+        peer->recv_ev_active = false;
+    }
+    if (peer->send_ev_active) {
+        pmix_event_del(&peer->send_event);
+        peer->send_ev_active = false;
+    }
+    if (NULL != peer->recv_msg) {
+        PMIX_RELEASE(peer->recv_msg);
+        peer->recv_msg = NULL;
+    }
+    CLOSE_THE_SOCKET(peer->sd);
+}
+
+/* tell the server we connect to who we are - this is the
+ * first message it gets from us */
+static pmix_status_t send_hello(pmix_peer_t *peer)
+{
+    pmix_byte_object_t cred;
+    pmix_buffer_t *buf;
+    int32_t me = pmix_server_globals.coll_rank;
+    char *name = peer->nptr->compat.psec->name;
+    pmix_status_t rc;
+
+    PMIX_BYTE_OBJECT_CONSTRUCT(&cred);
+    if (NULL != peer->nptr->compat.psec->create_cred) {
+        PMIX_PSEC_CREATE_CRED(rc, peer, NULL, 0, NULL, 0, &cred);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+    }
+    buf = PMIX_NEW(pmix_buffer_t);
+    PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, &me, 1, PMIX_INT32);
+    if (PMIX_SUCCESS == rc) {
+        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, &name, 1, PMIX_STRING);
+    }
+    if (PMIX_SUCCESS == rc) {
+        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, &cred, 1, PMIX_BYTE_OBJECT);
+    }
+    PMIX_BYTE_OBJECT_DESTRUCT(&cred);
+    if (PMIX_SUCCESS == rc) {
+        PMIX_SERVER_QUEUE_REPLY(rc, peer, PMIX_PTL_TAG_COLL_AUTH, buf);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(buf);
+    }
+    return rc;
+}
+
+/* get our connection to a server, starting to make it if
+ * necessary - messages can be queued on it right away */
+static pmix_peer_t *get_peer(int dst)
+{
+    coll_link_t *lk = &links[dst];
+
+    if (NULL != lk->peer) {
+        return lk->peer;
+    }
+    lk->peer = new_peer(dst);
+    if (NULL == lk->peer) {
+        return NULL;
+    }
+    lk->tries = 0;
+    if (PMIX_SUCCESS != send_hello(lk->peer) || PMIX_SUCCESS != start_connect(dst)) {
+        pmix_output(0, "pmix:server:coll: cannot connect to server %d at %s", dst, addrs[dst]);
+        /* the peer stays in the list of connections
+         * until we finalize */
+        lk->peer = NULL;
+        return NULL;
+    }
+    return lk->peer;
+}
+
+/* send a step of a fence to another server, along with
+ * the given contributions */
+static pmix_status_t send_step(coll_op_t *op, int dst, int32_t step, int32_t *origins,
+                               int32_t nblocks)
+{
+    pmix_peer_t *peer;
+    pmix_buffer_t *buf;
+    int32_t me = pmix_server_globals.coll_rank;
+    pmix_status_t rc;
+    int32_t n;
+
+    peer = get_peer(dst);
+    if (NULL == peer) {
+        return PMIX_ERR_UNREACH;
+    }
+    buf = PMIX_NEW(pmix_buffer_t);
+    PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, &op->id, 1, PMIX_UINT64);
+    if (PMIX_SUCCESS == rc) {
+        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, &op->epoch, 1, PMIX_UINT32);
+    }
+    if (PMIX_SUCCESS == rc) {
+        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, &me, 1, PMIX_INT32);
+    }
+    if (PMIX_SUCCESS == rc) {
+        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, &step, 1, PMIX_INT32);
+    }
+    if (PMIX_SUCCESS == rc) {
+        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, &nblocks, 1, PMIX_INT32);
+    }
+    for (n = 0; PMIX_SUCCESS == rc && n < nblocks; n++) {
+        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, &origins[n], 1, PMIX_INT32);
+        if (PMIX_SUCCESS == rc) {
+            PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, &op->blobs[origins[n]], 1,
+                             PMIX_BYTE_OBJECT);
+        }
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(buf);
+        return rc;
+    }
+    PMIX_SERVER_QUEUE_REPLY(rc, peer, PMIX_PTL_TAG_COLL, buf);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_RELEASE(buf);
+    }
+    return rc;
+}
+
+/* parent of a server in the barrier tree, and the first of its children */
+static int tree_fanout(int size)
+{
+    int k;
+
+    if (0 < pmix_server_globals.coll_tree_fanout) {
+        return pmix_server_globals.coll_tree_fanout;
+    }
+    /* a flat tree is quickest for a few servers - otherwise
+     * keep the tree to about two levels */
+    if (size <= 8) {
+        return (1 < size) ? size - 1 : 1;
+    }
+    for (k = 2; k * k < size; k++) {
+        continue;
+    }
+    return k;
+}
+
+static int tree_nchildren(int rank, int k, int size)
+{
+    int first = rank * k + 1;
+
+    if (size <= first) {
+        return 0;
+    }
+    return (size - first < k) ? size - first : k;
+}
+
+/* position of a server among those taking part in
+ * the fence, or -1 if it isn't one of them */
+static int position(coll_op_t *op, int server)
+{
+    int lo = 0, hi = op->size - 1, mid;
+
+    /* the members are in server order */
+    while (lo <= hi) {
+        mid = (lo + hi) / 2;
+        if (op->members[mid] == server) {
+            return mid;
+        }
+        if (op->members[mid] < server) {
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return -1;
+}
+
+/* do the sends for the current step. The algorithms work on
+ * the positions of the servers taking part in the fence */
+static pmix_status_t do_sends(coll_op_t *op)
+{
+    int me = op->me;
+    int size = op->size;
+    int *m = op->members;
+    int32_t *origins, n, cnt = 0, dist;
+    pmix_status_t rc = PMIX_SUCCESS;
+    int k, c;
+
+    origins = (int32_t *) malloc(size * sizeof(int32_t));
+    if (NULL == origins) {
+        return PMIX_ERR_NOMEM;
+    }
+    switch (op->algo) {
+    case PMIX_COLL_RECURSIVE_DOUBLING:
+        /* exchange everything we have with our partner */
+        for (n = 0; n < size; n++) {
+            if (op->have[m[n]]) {
+                origins[cnt++] = m[n];
+            }
+        }
+        rc = send_step(op, m[me ^ (1 << op->step)], op->step, origins, cnt);
+        break;
+    case PMIX_COLL_BRUCK:
+        /* we hold the contributions of the servers that follow
+         * us - pass as many as the receiver is missing */
+        dist = 1 << op->step;
+        cnt = (dist < size - dist) ? dist : size - dist;
+        for (n = 0; n < cnt; n++) {
+            origins[n] = m[(me + n) % size];
+        }
+        rc = send_step(op, m[(me - dist + size) % size], op->step, origins, cnt);
+        break;
+    case PMIX_COLL_RING:
+        /* pass on what we received in the last step */
+        origins[0] = m[(me - op->step + size) % size];
+        rc = send_step(op, m[(me + 1) % size], op->step, origins, 1);
+        break;
+    case PMIX_COLL_TREE:
+        k = tree_fanout(size);
+        if (1 == op->step && 0 < me) {
+            /* all of our subtree has arrived */
+            rc = send_step(op, m[(me - 1) / k], 0, NULL, 0);
+        } else if (2 == op->step) {
+            /* release our children */
+            for (c = 0; PMIX_SUCCESS == rc && c < tree_nchildren(me, k, size); c++) {
+                rc = send_step(op, m[me * k + 1 + c], 1, NULL, 0);
+            }
+        }
+        break;
+    default:
+        rc = PMIX_ERR_NOT_SUPPORTED;
+        break;
+    }
+    free(origins);
+    return rc;
+}
+
+/* the positions of the servers whose messages we need to
+ * finish a step - they are the count of them from first on */
+static int senders(coll_op_t *op, int step, int *first)
+{
+    int me = op->me;
+    int size = op->size;
+    int k;
+
+    switch (op->algo) {
+    case PMIX_COLL_RECURSIVE_DOUBLING:
+        *first = me ^ (1 << step);
+        return 1;
+    case PMIX_COLL_BRUCK:
+        *first = (me + (1 << step)) % size;
+        return 1;
+    case PMIX_COLL_RING:
+        *first = (me - 1 + size) % size;
+        return 1;
+    case PMIX_COLL_TREE:
+        k = tree_fanout(size);
+        if (0 == step) {
+            *first = me * k + 1;
+            return tree_nchildren(me, k, size);
+        }
+        if (1 == step && 0 < me) {
+            *first = (me - 1) / k;
+            return 1;
+        }
+        return 0;
+    default:
+        return 0;
+    }
+}
+
+/* whether a message is one of those we need to finish a step */
+static bool wanted(coll_op_t *op, coll_msg_t *msg, int step)
+{
+    int first, n, pos;
+
+    if (msg->step != step) {
+        return false;
+    }
+    n = senders(op, step, &first);
+    pos = position(op, msg->src);
+    return (0 <= pos && first <= pos && pos < first + n);
+}
+
+/* consume the messages for the current step if
+ * they have all arrived */
+static bool absorb(coll_op_t *op)
+{
+    coll_msg_t *msg, *next;
+    int32_t n;
+    int count, need, first;
+
+    need = senders(op, op->step, &first);
+    if (0 == need) {
+        return true;
+    }
+    count = 0;
+    PMIX_LIST_FOREACH (msg, &op->msgs, coll_msg_t) {
+        if (wanted(op, msg, op->step)) {
+            ++count;
+        }
+    }
+    if (count < need) {
+        return false;
+    }
+    PMIX_LIST_FOREACH_SAFE (msg, next, &op->msgs, coll_msg_t) {
+        if (!wanted(op, msg, op->step)) {
+            continue;
+        }
+        for (n = 0; n < msg->nblocks; n++) {
+            if (op->have[msg->origins[n]]) {
+                PMIX_BYTE_OBJECT_DESTRUCT(&msg->blocks[n]);
+                continue;
+            }
+            /* take the data */
+            op->blobs[msg->origins[n]] = msg->blocks[n];
+            op->have[msg->origins[n]] = 1;
+        }
+        msg->nblocks = 0;
+        pmix_list_remove_item(&op->msgs, &msg->super);
+        PMIX_RELEASE(msg);
+    }
+    return true;
+}
+
+/* whether we still need a message from the given server */
+static bool needs(coll_op_t *op, int src)
+{
+    coll_msg_t *msg;
+    int step, first, n, pos;
+    bool got;
+
+    if (0 > (pos = position(op, src))) {
+        return false;
+    }
+    for (step = op->step; step < op->nsteps; step++) {
+        n = senders(op, step, &first);
+        if (pos < first || first + n <= pos) {
+            continue;
+        }
+        got = false;
+        PMIX_LIST_FOREACH (msg, &op->msgs, coll_msg_t) {
+            if (msg->src == src && msg->step == step) {
+                got = true;
+                break;
+            }
+        }
+        if (!got) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* a server we lost the connection to that the fence
+ * still needs to hear from, or -1 if there isn't one */
+static int waiting_on_lost(coll_op_t *op)
+{
+    int n;
+
+    for (n = 0; n < op->size; n++) {
+        if (lost[op->members[n]] && needs(op, op->members[n])) {
+            return op->members[n];
+        }
+    }
+    return -1;
+}
+
+static void release_data(void *cbdata)
+{
+    free(cbdata);
+}
+
+static void complete(coll_op_t *op, pmix_status_t status)
+{
+    coll_sig_t *sig;
+    char *data = NULL;
+    pmix_byte_object_t *bo;
+    size_t ndata = 0, off = 0;
+    int n;
+
+    pmix_list_remove_item(&ops, &op->super);
+    if (PMIX_SUCCESS == status && !op->barrier) {
+        /* the contributions go back in server order */
+        for (n = 0; n < op->size; n++) {
+            ndata += op->blobs[op->members[n]].size;
+        }
+        if (0 < ndata) {
+            data = (char *) malloc(ndata);
+            if (NULL == data) {
+                status = PMIX_ERR_NOMEM;
+                ndata = 0;
+            }
+        }
+        for (n = 0; NULL != data && n < op->size; n++) {
+            bo = &op->blobs[op->members[n]];
+            if (0 < bo->size) {
+                memcpy(data + off, bo->bytes, bo->size);
+                off += bo->size;
+            }
+        }
+        if (PMIX_SUCCESS == pmix_hash_table_get_value_uint64(&sigs, op->id, (void **) &sig)) {
+            sig->avgsize = ndata / op->size;
+        }
+    }
+    pmix_output_verbose(2, pmix_server_globals.fence_output,
+                        "pmix:server:coll: fence %" PRIx64 ":%u complete with %d bytes: %s",
+                        op->id, op->epoch, (int) ndata, PMIx_Error_string(status));
+    if (NULL != op->cbfunc) {
+        op->cbfunc(status, data, ndata, op->cbdata, (NULL == data) ? NULL : release_data, data);
+    } else if (NULL != data) {
+        free(data);
+    }
+    PMIX_RELEASE(op);
+}
+
+/* fail a fence and tell the other servers, so that none of
+ * them waits for a contribution that will never arrive */
+static void fail_op(coll_op_t *op, pmix_status_t status, int skip)
+{
+    int n;
+
+    for (n = 0; n < op->size; n++) {
+        if (n != op->me && op->members[n] != skip) {
+            (void) send_step(op, op->members[n], PMIX_COLL_ABORT, NULL, 0);
+        }
+    }
+    complete(op, status);
+}
+
+static void fail_link(int dst, pmix_status_t status)
+{
+    coll_op_t *op, *next;
+
+    pmix_output(0, "pmix:server:coll: cannot connect to server %d at %s: %s", dst, addrs[dst],
+                PMIx_Error_string(status));
+    /* anything queued for it is dropped when we finalize */
+    links[dst].peer = NULL;
+    PMIX_LIST_FOREACH_SAFE (op, next, &ops, coll_op_t) {
+        if (op->started && 0 <= position(op, dst)) {
+            fail_op(op, PMIX_ERR_UNREACH, dst);
+        }
+    }
+}
+
+/* runs once the messages that were read before we lost a
+ * connection have been processed */
+static void check_lost(int sd, short args, void *cbdata)
+{
+    coll_op_t *op, *next;
+    int src;
+
+    PMIX_HIDE_UNUSED_PARAMS(sd, args, cbdata);
+
+    lost_ev_active = false;
+    PMIX_LIST_FOREACH_SAFE (op, next, &ops, coll_op_t) {
+        if (op->started && 0 <= (src = waiting_on_lost(op))) {
+            pmix_output_verbose(2, pmix_server_globals.fence_output,
+                                "pmix:server:coll: fence %" PRIx64 ":%u lost server %d",
+                                op->id, op->epoch, src);
+            fail_op(op, PMIX_ERR_LOST_CONNECTION, src);
+        }
+    }
+}
+
+static void advance(coll_op_t *op)
+{
+    pmix_status_t rc;
+
+    while (op->step < op->nsteps) {
+        if (!op->sent) {
+            rc = do_sends(op);
+            if (PMIX_SUCCESS != rc) {
+                fail_op(op, rc, -1);
+                return;
+            }
+            op->sent = true;
+        }
+        if (!absorb(op)) {
+            return;
+        }
+        op->step++;
+        op->sent = false;
+    }
+    complete(op, PMIX_SUCCESS);
+}
+
+static coll_op_t *find_op(uint64_t id, uint32_t epoch)
+{
+    coll_op_t *op;
+
+    PMIX_LIST_FOREACH (op, &ops, coll_op_t) {
+        if (op->id == id && op->epoch == epoch) {
+            return op;
+        }
+    }
+    return NULL;
+}
+
+static coll_op_t *get_op(uint64_t id, uint32_t epoch)
+{
+    coll_op_t *op;
+    int size = pmix_server_globals.coll_size;
+
+    if (NULL != (op = find_op(id, epoch))) {
+        return op;
+    }
+    op = PMIX_NEW(coll_op_t);
+    if (NULL == op) {
+        return NULL;
+    }
+    op->id = id;
+    op->epoch = epoch;
+    op->blobs = (pmix_byte_object_t *) calloc(size, sizeof(pmix_byte_object_t));
+    op->have = (char *) calloc(size, sizeof(char));
+    if (NULL == op->blobs || NULL == op->have) {
+        PMIX_RELEASE(op);
+        return NULL;
+    }
+    pmix_list_append(&ops, &op->super);
+    return op;
+}
+
+static void recv_coll(struct pmix_peer_t *peer, pmix_ptl_hdr_t *hdr, pmix_buffer_t *buf,
+                      void *cbdata)
+{
+    pmix_peer_t *pr = (pmix_peer_t *) peer;
+    coll_msg_t *msg;
+    coll_op_t *op;
+    coll_sig_t *sig;
+    uint64_t id;
+    uint32_t epoch;
+    int32_t cnt, n;
+    pmix_status_t rc;
+
+    PMIX_HIDE_UNUSED_PARAMS(hdr, cbdata);
+
+    if (!initialized) {
+        return;
+    }
+    if (PMIX_RANK_UNDEF == pr->info->pname.rank) {
+        /* it never said who it is */
+        pmix_output(0, "pmix:server:coll: dropping connection that sent a fence message "
+                    "before saying who it is");
+        drop(pr);
+        return;
+    }
+    msg = PMIX_NEW(coll_msg_t);
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buf, &id, &cnt, PMIX_UINT64);
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buf, &epoch, &cnt, PMIX_UINT32);
+    }
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buf, &msg->src, &cnt, PMIX_INT32);
+        if (PMIX_SUCCESS == rc
+            && (msg->src < 0 || pmix_server_globals.coll_size <= msg->src)) {
+            rc = PMIX_ERR_BAD_PARAM;
+        }
+    }
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buf, &msg->step, &cnt, PMIX_INT32);
+    }
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buf, &n, &cnt, PMIX_INT32);
+    }
+    if (PMIX_SUCCESS == rc && 0 < n) {
+        msg->origins = (int32_t *) calloc(n, sizeof(int32_t));
+        msg->blocks = (pmix_byte_object_t *) calloc(n, sizeof(pmix_byte_object_t));
+        if (NULL == msg->origins || NULL == msg->blocks) {
+            rc = PMIX_ERR_NOMEM;
+        }
+    }
+    for (; PMIX_SUCCESS == rc && msg->nblocks < n; msg->nblocks++) {
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buf, &msg->origins[msg->nblocks], &cnt,
+                           PMIX_INT32);
+        if (PMIX_SUCCESS == rc && (msg->origins[msg->nblocks] < 0
+                                   || pmix_server_globals.coll_size <= msg->origins[msg->nblocks])) {
+            rc = PMIX_ERR_BAD_PARAM;
+        }
+        if (PMIX_SUCCESS == rc) {
+            cnt = 1;
+            PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buf, &msg->blocks[msg->nblocks], &cnt,
+                               PMIX_BYTE_OBJECT);
+        }
+        if (PMIX_SUCCESS != rc) {
+            break;
+        }
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(msg);
+        return;
+    }
+    pmix_output_verbose(5, pmix_server_globals.fence_output,
+                        "pmix:server:coll: recvd step %d of fence %" PRIx64 ":%u from server %d",
+                        msg->step, id, epoch, msg->src);
+    if ((pmix_rank_t) msg->src != pr->info->pname.rank) {
+        pmix_output(0, "pmix:server:coll: dropping message from server %d on the "
+                    "connection of server %d", msg->src, (int) pr->info->pname.rank);
+        PMIX_RELEASE(msg);
+        return;
+    }
+
+    op = find_op(id, epoch);
+    if (NULL == op && PMIX_SUCCESS == pmix_hash_table_get_value_uint64(&sigs, id, (void **) &sig)
+        && epoch <= sig->epoch) {
+        /* the fence is already over here - e.g., another
+         * server failed it after we were done */
+        PMIX_RELEASE(msg);
+        return;
+    }
+    if (NULL == op && NULL == (op = get_op(id, epoch))) {
+        PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
+        PMIX_RELEASE(msg);
+        return;
+    }
+    if (PMIX_COLL_ABORT == msg->step) {
+        PMIX_RELEASE(msg);
+        if (op->started) {
+            complete(op, PMIX_ERR_LOST_CONNECTION);
+        } else {
+            /* fail it as soon as it starts */
+            op->status = PMIX_ERR_LOST_CONNECTION;
+        }
+        return;
+    }
+    pmix_list_append(&op->msgs, &msg->super);
+    if (op->started) {
+        advance(op);
+    }
+}
+
+/* whether a socket is connected from one of the
+ * addresses of the given server */
+static bool from_server(int sd, int rank)
+{
+    struct sockaddr_storage addr;
+    socklen_t len = sizeof(addr);
+    struct addrinfo *ai;
+    struct sockaddr_in *a4, *b4;
+    struct sockaddr_in6 *a6, *b6;
+    bool found = false;
+
+    if (0 != getpeername(sd, (struct sockaddr *) &addr, &len)) {
+        return false;
+    }
+    for (ai = resolved[rank]; NULL != ai && !found; ai = ai->ai_next) {
+        if (ai->ai_family != addr.ss_family) {
+            continue;
+        }
+        if (AF_INET == ai->ai_family) {
+            a4 = (struct sockaddr_in *) &addr;
+            b4 = (struct sockaddr_in *) ai->ai_addr;
+            found = (a4->sin_addr.s_addr == b4->sin_addr.s_addr);
+        } else if (AF_INET6 == ai->ai_family) {
+            a6 = (struct sockaddr_in6 *) &addr;
+            b6 = (struct sockaddr_in6 *) ai->ai_addr;
+            found = (0 == memcmp(&a6->sin6_addr, &b6->sin6_addr, sizeof(a6->sin6_addr)));
+        }
+    }
+    return found;
+}
+
+/* the first message on a connection we accepted says
+ * which server made it */
+static void recv_auth(struct pmix_peer_t *peer, pmix_ptl_hdr_t *hdr, pmix_buffer_t *buf,
+                      void *cbdata)
+{
+    pmix_peer_t *pr = (pmix_peer_t *) peer;
+    pmix_byte_object_t cred;
+    char *name = NULL;
+    const char *why = NULL;
+    int32_t src = -1, cnt;
+    pmix_status_t rc;
+
+    PMIX_HIDE_UNUSED_PARAMS(hdr, cbdata);
+
+    if (!initialized) {
+        return;
+    }
+    PMIX_BYTE_OBJECT_CONSTRUCT(&cred);
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buf, &src, &cnt, PMIX_INT32);
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buf, &name, &cnt, PMIX_STRING);
+    }
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buf, &cred, &cnt, PMIX_BYTE_OBJECT);
+    }
+    if (PMIX_SUCCESS != rc) {
+        why = "malformed hello";
+    } else if (PMIX_RANK_UNDEF != pr->info->pname.rank) {
+        why = "second hello";
+    } else if (src < 0 || pmix_server_globals.coll_size <= src
+               || pmix_server_globals.coll_rank == src) {
+        why = "not a server of the group";
+    } else if (!from_server(pr->sd, src)) {
+        why = "not from the address of that server";
+    } else if (NULL == name || 0 != strcmp(name, pr->nptr->compat.psec->name)) {
+        why = "different security module";
+    } else if (NULL != pr->nptr->compat.psec->validate_cred) {
+        PMIX_PSEC_VALIDATE_CRED(rc, pr, NULL, 0, NULL, NULL, &cred);
+        if (PMIX_SUCCESS != rc) {
+            why = "invalid credential";
+        }
+    }
+    if (NULL != name) {
+        free(name);
+    }
+    PMIX_BYTE_OBJECT_DESTRUCT(&cred);
+    if (NULL != why) {
+        pmix_output(0, "pmix:server:coll: rejecting connection claiming to be server %d: %s",
+                    src, why);
+        drop(pr);
+        return;
+    }
+    pmix_output_verbose(2, pmix_server_globals.fence_output,
+                        "pmix:server:coll: accepted connection from server %d", src);
+    pr->info->pname.rank = src;
+    lost[src] = 0;
+}
+
+static bool same_host(const char *a, const char *b)
+{
+    size_t la = strcspn(a, "."), lb = strcspn(b, ".");
+
+    if (0 == strcasecmp(a, b)) {
+        return true;
+    }
+    /* one of them may leave out the domain */
+    if ('\0' != a[la] && '\0' != b[lb]) {
+        return false;
+    }
+    return la == lb && 0 == strncasecmp(a, b, la);
+}
+
+/* mark the server hosting a proc - we can only tell if
+ * exactly one server is on the proc's node */
+static bool mark_host(const char *nspace, pmix_rank_t rank, char *in, char **last, int *lastsrv)
+{
+    pmix_cb_t cb;
+    pmix_proc_t proc;
+    pmix_kval_t *kv;
+    pmix_status_t rc;
+    int n, srv = -1;
+    bool ok = false;
+
+    PMIX_LOAD_PROCID(&proc, nspace, rank);
+    PMIX_CONSTRUCT(&cb, pmix_cb_t);
+    cb.proc = &proc;
+    cb.key = (char *) PMIX_HOSTNAME;
+    cb.copy = false;
+    PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
+    cb.key = NULL;
+    kv = (pmix_kval_t *) pmix_list_get_first(&cb.kvs);
+    if (PMIX_SUCCESS != rc || NULL == kv || NULL == kv->value
+        || PMIX_STRING != kv->value->type || NULL == kv->value->data.string) {
+        PMIX_DESTRUCT(&cb);
+        return false;
+    }
+    /* procs on a node usually come together */
+    if (NULL != *last && 0 == strcmp(*last, kv->value->data.string)) {
+        srv = *lastsrv;
+    } else {
+        for (n = 0; n < pmix_server_globals.coll_size; n++) {
+            if (!same_host(hosts[n], kv->value->data.string)) {
+                continue;
+            }
+            if (0 <= srv) {
+                /* more than one server on that node */
+                srv = -1;
+                break;
+            }
+            srv = n;
+        }
+        free(*last);
+        *last = strdup(kv->value->data.string);
+        *lastsrv = srv;
+    }
+    if (0 <= srv) {
+        in[srv] = 1;
+        ok = true;
+    }
+    PMIX_DESTRUCT(&cb);
+    return ok;
+}
+
+/* find the servers hosting the given procs. If we can't
+ * tell for any of them, every server must take part */
+static pmix_status_t find_members(coll_sig_t *sig, const pmix_proc_t procs[], size_t nprocs)
+{
+    int me = pmix_server_globals.coll_rank;
+    int size = pmix_server_globals.coll_size;
+    pmix_namespace_t *nptr;
+    char *in, *last = NULL;
+    bool ok = (NULL != procs && 0 < nprocs);
+    int lastsrv = -1, n;
+    pmix_rank_t r;
+    size_t p;
+
+    in = (char *) calloc(size, sizeof(char));
+    sig->members = (int *) malloc(size * sizeof(int));
+    if (NULL == in || NULL == sig->members) {
+        free(in);
+        return PMIX_ERR_NOMEM;
+    }
+    for (p = 0; ok && p < nprocs; p++) {
+        if (PMIX_RANK_WILDCARD != procs[p].rank) {
+            ok = mark_host(procs[p].nspace, procs[p].rank, in, &last, &lastsrv);
+            continue;
+        }
+        nptr = pmix_nspace_lookup(procs[p].nspace);
+        ok = (NULL != nptr && 0 < nptr->nprocs);
+        for (r = 0; ok && r < nptr->nprocs; r++) {
+            ok = mark_host(procs[p].nspace, r, in, &last, &lastsrv);
+        }
+    }
+    free(last);
+    if (!ok || !in[me]) {
+        memset(in, 1, size);
+    }
+    sig->nmembers = 0;
+    for (n = 0; n < size; n++) {
+        if (in[n]) {
+            sig->members[sig->nmembers++] = n;
+        }
+    }
+    free(in);
+    pmix_output_verbose(2, pmix_server_globals.fence_output,
+                        "pmix:server:coll: %d of %d servers host the procs%s", sig->nmembers,
+                        size, ok ? "" : " - cannot map them to servers");
+    return PMIX_SUCCESS;
+}
+
+pmix_status_t pmix_server_coll_allgather(const char *key, size_t keylen,
+                                         const pmix_proc_t procs[], size_t nprocs, bool barrier,
+                                         char *data, size_t ndata, pmix_modex_cbfunc_t cbfunc,
+                                         void *cbdata)
+{
+    int me = pmix_server_globals.coll_rank;
+    coll_sig_t *sig;
+    coll_op_t *op;
+    uint64_t id;
+    pmix_status_t rc;
+    int src, size;
+
+    if (!initialized) {
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+    id = hash_key(key, keylen);
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_uint64(&sigs, id, (void **) &sig)) {
+        sig = PMIX_NEW(coll_sig_t);
+        if (NULL == sig) {
+            return PMIX_ERR_NOMEM;
+        }
+        /* the procs of a signature are always the same */
+        rc = find_members(sig, procs, nprocs);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_RELEASE(sig);
+            return rc;
+        }
+        pmix_hash_table_set_value_uint64(&sigs, id, sig);
+    }
+    op = get_op(id, ++sig->epoch);
+    if (NULL == op) {
+        return PMIX_ERR_NOMEM;
+    }
+    op->started = true;
+    op->barrier = barrier;
+    op->cbfunc = cbfunc;
+    op->cbdata = cbdata;
+    op->members = sig->members;
+    op->size = size = sig->nmembers;
+    op->me = position(op, me);
+    op->blobs[me].bytes = data;
+    op->blobs[me].size = ndata;
+    op->have[me] = 1;
+
+    if (barrier) {
+        op->algo = PMIX_COLL_TREE;
+        op->nsteps = 3;
+    } else if (0 < sig->avgsize && pmix_server_globals.coll_ring_threshold <= sig->avgsize) {
+        /* large contributions - only pass each one once per link */
+        op->algo = PMIX_COLL_RING;
+        op->nsteps = size - 1;
+    } else {
+        /* small contributions - use as few steps as possible */
+        op->algo = (0 == (size & (size - 1))) ? PMIX_COLL_RECURSIVE_DOUBLING : PMIX_COLL_BRUCK;
+        for (op->nsteps = 0; (1 << op->nsteps) < size; op->nsteps++) {
+            continue;
+        }
+    }
+    pmix_output_verbose(2, pmix_server_globals.fence_output,
+                        "pmix:server:coll: starting fence %" PRIx64 ":%u over %d servers "
+                        "with algorithm %d", op->id, op->epoch, size, op->algo);
+    if (PMIX_SUCCESS != op->status) {
+        complete(op, op->status);
+    } else if (0 <= (src = waiting_on_lost(op))) {
+        fail_op(op, PMIX_ERR_LOST_CONNECTION, src);
+    } else {
+        advance(op);
+    }
+    return PMIX_SUCCESS;
+}
+
+/* we are only ever called by the server library itself, so
+ * the cbdata is the tracker for the collective */
+pmix_status_t pmix_server_coll_fence_nb(const pmix_proc_t procs[], size_t nprocs,
+                                        const pmix_info_t info[], size_t ninfo, char *data,
+                                        size_t ndata, pmix_modex_cbfunc_t cbfunc, void *cbdata)
+{
+    pmix_server_trkr_t *trk = (pmix_server_trkr_t *) cbdata;
+    pmix_status_t rc;
+
+    PMIX_HIDE_UNUSED_PARAMS(info, ninfo);
+
+    if (PMIX_COLLECT_YES != trk->collect_type && NULL != data) {
+        free(data);
+        data = NULL;
+        ndata = 0;
+    }
+    rc = pmix_server_coll_allgather(trk->key, trk->keylen, procs, nprocs,
+                                    PMIX_COLLECT_YES != trk->collect_type, data, ndata, cbfunc,
+                                    cbdata);
+    if (PMIX_SUCCESS != rc && NULL != data) {
+        free(data);
+    }
+    return rc;
+}
+
+static void accept_conn(int sd, short args, void *cbdata)
+{
+    struct sockaddr_storage addr;
+    socklen_t addrlen = sizeof(addr);
+    pmix_peer_t *peer;
+    int csd;
+
+    PMIX_HIDE_UNUSED_PARAMS(args, cbdata);
+
+    csd = accept(sd, (struct sockaddr *) &addr, &addrlen);
+    if (csd < 0) {
+        if (EAGAIN != pmix_socket_errno && EWOULDBLOCK != pmix_socket_errno
+            && EINTR != pmix_socket_errno && ECONNABORTED != pmix_socket_errno) {
+            pmix_output(0, "pmix:server:coll: accept() failed: %s (%d)",
+                        strerror(pmix_socket_errno), pmix_socket_errno);
+        }
+        return;
+    }
+    peer = new_peer(PMIX_RANK_UNDEF);
+    if (NULL == peer) {
+        CLOSE_THE_SOCKET(csd);
+        return;
+    }
+    attach(peer, csd);
+}
+
+pmix_status_t pmix_server_coll_init(void)
+{
+    pmix_ptl_posted_recv_t *rcv;
+    struct addrinfo *res;
+    char *host, *port;
+    int one = 1, n;
+
+    if (NULL == pmix_server_globals.coll_servers) {
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+    addrs = pmix_argv_split(pmix_server_globals.coll_servers, ',');
+    pmix_server_globals.coll_size = pmix_argv_count(addrs);
+    for (n = 0; n < pmix_server_globals.coll_size; n++) {
+        host = split_addr(addrs[n], &port);
+        if (NULL == host) {
+            pmix_output(0, "pmix:server:coll: %s is not a host:port address", addrs[n]);
+            pmix_argv_free(hosts);
+            hosts = NULL;
+            pmix_argv_free(addrs);
+            addrs = NULL;
+            return PMIX_ERR_BAD_PARAM;
+        }
+        pmix_argv_append_nosize(&hosts, host);
+        free(host);
+    }
+    if (pmix_server_globals.coll_rank < 0
+        || pmix_server_globals.coll_size <= pmix_server_globals.coll_rank) {
+        pmix_output(0, "pmix:server:coll: rank %d is not in the group of %d servers",
+                    pmix_server_globals.coll_rank, pmix_server_globals.coll_size);
+        pmix_argv_free(hosts);
+        hosts = NULL;
+        pmix_argv_free(addrs);
+        addrs = NULL;
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    /* resolve every address now - the progress thread
+     * must not wait on a name service to reach a server */
+    resolved = (struct addrinfo **) calloc(pmix_server_globals.coll_size,
+                                           sizeof(struct addrinfo *));
+    if (NULL == resolved) {
+        goto error;
+    }
+    for (n = 0; n < pmix_server_globals.coll_size; n++) {
+        if (0 != parse_addr(addrs[n], &resolved[n])) {
+            pmix_output(0, "pmix:server:coll: cannot resolve address %s", addrs[n]);
+            resolved[n] = NULL;
+            goto error;
+        }
+    }
+
+    /* listen on our own address */
+    res = resolved[pmix_server_globals.coll_rank];
+    lsd = socket(res->ai_family, SOCK_STREAM, 0);
+    if (lsd < 0) {
+        goto error;
+    }
+    (void) setsockopt(lsd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if (0 != bind(lsd, res->ai_addr, res->ai_addrlen) || 0 != listen(lsd, SOMAXCONN)) {
+        pmix_output(0, "pmix:server:coll: cannot listen on %s: %s",
+                    addrs[pmix_server_globals.coll_rank], strerror(pmix_socket_errno));
+        goto error;
+    }
+    /* connect to the others from the same address, with
+     * any port - unless we listen on all of them */
+    myaddrlen = 0;
+    memcpy(&myaddr, res->ai_addr, res->ai_addrlen);
+    if (AF_INET == res->ai_family
+        && INADDR_ANY != ((struct sockaddr_in *) &myaddr)->sin_addr.s_addr) {
+        ((struct sockaddr_in *) &myaddr)->sin_port = 0;
+        myaddrlen = res->ai_addrlen;
+    } else if (AF_INET6 == res->ai_family
+               && !IN6_IS_ADDR_UNSPECIFIED(&((struct sockaddr_in6 *) &myaddr)->sin6_addr)) {
+        ((struct sockaddr_in6 *) &myaddr)->sin6_port = 0;
+        myaddrlen = res->ai_addrlen;
+    }
+    pmix_fd_set_cloexec(lsd);
+    pmix_ptl_base_set_nonblocking(lsd);
+
+    links = (coll_link_t *) calloc(pmix_server_globals.coll_size, sizeof(coll_link_t));
+    lost = (char *) calloc(pmix_server_globals.coll_size, sizeof(char));
+    if (NULL == links || NULL == lost) {
+        goto error;
+    }
+    for (n = 0; n < pmix_server_globals.coll_size; n++) {
+        links[n].sd = -1;
+    }
+    pmix_event_assign(&lost_ev, pmix_globals.evbase, -1, EV_WRITE, check_lost, NULL);
+    PMIX_CONSTRUCT(&conns, pmix_pointer_array_t);
+    pmix_pointer_array_init(&conns, 2 * pmix_server_globals.coll_size, INT_MAX, 16);
+    PMIX_CONSTRUCT(&sigs, pmix_hash_table_t);
+    pmix_hash_table_init(&sigs, 64);
+    PMIX_CONSTRUCT(&ops, pmix_list_t);
+    /* other servers can reach us as soon as the events are in */
+    initialized = true;
+
+    /* messages from the other servers come in ahead of
+     * anything else */
+    rcv = PMIX_NEW(pmix_ptl_posted_recv_t);
+    rcv->tag = PMIX_PTL_TAG_COLL;
+    rcv->cbfunc = recv_coll;
+    pmix_list_prepend(&pmix_ptl_base.posted_recvs, &rcv->super);
+    rcv = PMIX_NEW(pmix_ptl_posted_recv_t);
+    rcv->tag = PMIX_PTL_TAG_COLL_AUTH;
+    rcv->cbfunc = recv_auth;
+    pmix_list_prepend(&pmix_ptl_base.posted_recvs, &rcv->super);
+
+    pmix_event_assign(&lev, pmix_globals.evbase, lsd, EV_READ | EV_PERSIST, accept_conn, NULL);
+    pmix_event_add(&lev, NULL);
+    lev_active = true;
+    pmix_output_verbose(2, pmix_server_globals.fence_output,
+                        "pmix:server:coll: server %d of %d listening on %s",
+                        pmix_server_globals.coll_rank, pmix_server_globals.coll_size,
+                        addrs[pmix_server_globals.coll_rank]);
+    return PMIX_SUCCESS;
+
+error:
+    free_resolved();
+    if (0 <= lsd) {
+        CLOSE_THE_SOCKET(lsd);
+        lsd = -1;
+    }
+    free(links);
+    links = NULL;
+    free(lost);
+    lost = NULL;
+    pmix_argv_free(hosts);
+    hosts = NULL;
+    pmix_argv_free(addrs);
+    addrs = NULL;
+    return PMIX_ERR_INIT;
+}
+
+void pmix_server_coll_finalize(void)
+{
+    pmix_peer_t *peer;
+    coll_sig_t *sig;
+    uint64_t id;
+    int n;
+
+    if (!initialized) {
+        return;
+    }
+    initialized = false;
+    if (lev_active) {
+        pmix_event_del(&lev);
+        lev_active = false;
+    }
+    CLOSE_THE_SOCKET(lsd);
+    lsd = -1;
+    if (lost_ev_active) {
+        pmix_event_del(&lost_ev);
+        lost_ev_active = false;
+    }
+    for (n = 0; n < pmix_server_globals.coll_size; n++) {
+        if (links[n].ev_active) {
+            pmix_event_del(&links[n].ev);
+            links[n].ev_active = false;
+        }
+        CLOSE_THE_SOCKET(links[n].sd);
+    }
+    for (n = 0; n < conns.size; n++) {
+        if (NULL == (peer = (pmix_peer_t *) pmix_pointer_array_get_item(&conns, n))) {
+            continue;
+        }
+        /* the other servers may still need what we queued
+         * for them - e.g., the release of the last barrier.
+         * The progress thread is stopped, so push it out here */
+        if (0 <= peer->sd && NULL != peer->send_msg) {
+            pmix_ptl_base_set_blocking(peer->sd);
+            while (0 <= peer->sd && NULL != peer->send_msg) {
+                pmix_ptl_base_send_handler(peer->sd, 0, peer);
+            }
+        }
+        PMIX_RELEASE(peer);
+    }
+    PMIX_DESTRUCT(&conns);
+    free(links);
+    links = NULL;
+    free(lost);
+    lost = NULL;
+    PMIX_LIST_DESTRUCT(&ops);
+    PMIX_HASH_TABLE_FOREACH (id, uint64, sig, &sigs) {
+        PMIX_RELEASE(sig);
+    }
+    PMIX_DESTRUCT(&sigs);
+    free_resolved();
+    pmix_argv_free(hosts);
+    hosts = NULL;
+    pmix_argv_free(addrs);
+    addrs = NULL;
+}
+
+bool pmix_server_coll_lost_peer(pmix_peer_t *peer)
+{
+    bool found = false;
+    int n, src;
+
+    if (!initialized) {
+        return false;
+    }
+    for (n = 0; n < conns.size && !found; n++) {
+        found = (peer == pmix_pointer_array_get_item(&conns, n));
+    }
+    if (!found) {
+        return false;
+    }
+    pmix_output_verbose(2, pmix_server_globals.fence_output,
+                        "pmix:server:coll: lost connection to server %d",
+                        (int) peer->info->pname.rank);
+    /* the connection object is released at finalize
+     * as the PTL may still be using it */
+    if (PMIX_RANK_UNDEF == peer->info->pname.rank) {
+        /* it never said who it is */
+        return true;
+    }
+    src = (int) peer->info->pname.rank;
+    if (links[src].peer == peer) {
+        /* we only send on it - the next send reconnects */
+        links[src].peer = NULL;
+        return true;
+    }
+    /* a server closes its connections once it is done, and
+     * anything it sent before then may still be waiting to be
+     * processed - so only fail the fences that still need to
+     * hear from it once that is done */
+    lost[src] = 1;
+    if (!lost_ev_active) {
+        lost_ev_active = true;
+        pmix_event_active(&lost_ev, EV_WRITE, 1);
+    }
+    return true;
+}
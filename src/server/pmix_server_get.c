@@ -50,6 +50,7 @@
 #include "src/mca/gds/gds.h"
 #include "src/mca/ptl/base/base.h"
 #include "src/util/pmix_argv.h"
+#include "src/util/pmix_atom.h"
 #include "src/util/pmix_error.h"
 #include "src/util/pmix_name_fns.h"
 #include "src/util/pmix_output.h"
@@ -91,6 +92,8 @@ static pmix_status_t create_local_tracker(char nspace[], pmix_rank_t rank, pmix_
                                           pmix_dmdx_local_t **lcd, pmix_dmdx_request_t **rq);
 static pmix_status_t get_job_data(char *nspace, pmix_server_caddy_t *cd, pmix_buffer_t *pbkt);
 static void get_timeout(int sd, short args, void *cbdata);
+static pmix_status_t get_proc(char *nspace, pmix_rank_t rank, char *key, bool keyprovided,
+                              pmix_modex_cbfunc_t cbfunc, void *cbdata);
 
 /* declare a function whose sole purpose is to
  * free data that we provided to our host server
@@ -146,23 +149,7 @@ pmix_status_t pmix_server_get(pmix_buffer_t *buf, pmix_modex_cbfunc_t cbfunc, vo
     pmix_rank_t rank;
     char *cptr, *key = NULL;
     char nspace[PMIX_MAX_NSLEN + 1];
-    pmix_namespace_t *ns, *nptr;
-    pmix_dmdx_local_t *lcd;
-    bool local = false;
-    bool localonly = false;
-    bool diffnspace = false;
-    bool refresh_cache = false;
-    bool scope_given = false;
     bool keyprovided = false;
-    struct timeval tv = {0, 0};
-    pmix_buffer_t pbkt;
-    pmix_cb_t cb;
-    pmix_proc_t proc;
-    char *data;
-    size_t sz, n;
-    pmix_info_t *info;
-    pmix_scope_t scope = PMIX_SCOPE_UNDEF;
-    pmix_rank_info_t *iptr;
 
     pmix_output_verbose(2, pmix_server_globals.get_output, "%s recvd GET",
                         PMIX_NAME_PRINT(&pmix_globals.myid));
@@ -216,30 +203,259 @@ pmix_status_t pmix_server_get(pmix_buffer_t *buf, pmix_modex_cbfunc_t cbfunc, vo
         keyprovided = true;
     }
 
+    rc = get_proc(nspace, rank, key, keyprovided, cbfunc, cd);
+    if (NULL != key) {
+        free(key);
+    }
+    return rc;
+}
+
+/* tracks the requests carried by a single GETMULTI message */
+typedef struct {
+    pmix_object_t super;
+    pmix_server_caddy_t *cd;
+    pmix_modex_cbfunc_t cbfunc;
+    size_t nreqs;
+    size_t nleft;
+    pmix_status_t *status;
+    pmix_byte_object_t *data;
+} getmulti_t;
+static void gmcon(getmulti_t *p)
+{
+    p->cd = NULL;
+    p->cbfunc = NULL;
+    p->nreqs = 0;
+    p->nleft = 0;
+    p->status = NULL;
+    p->data = NULL;
+}
+static void gmdes(getmulti_t *p)
+{
+    if (NULL != p->status) {
+        free(p->status);
+    }
+    if (NULL != p->data) {
+        PMIX_BYTE_OBJECT_FREE(p->data, p->nreqs);
+    }
+}
+static PMIX_CLASS_INSTANCE(getmulti_t, pmix_object_t, gmcon, gmdes);
+
+/* the caddy handed to get_proc for each of those requests */
+typedef struct {
+    pmix_server_caddy_t super;
+    getmulti_t *mt;
+    size_t idx;
+} getmulti_req_t;
+static PMIX_CLASS_INSTANCE(getmulti_req_t, pmix_server_caddy_t, NULL, NULL);
+
+/* account for one completed request - once all of them are done,
+ * return every status and blob to the requestor in one payload */
+static void getmulti_step(getmulti_t *mt)
+{
+    pmix_buffer_t pbkt;
+    pmix_status_t rc;
+    char *data;
+    size_t sz;
+
+    if (0 < --mt->nleft) {
+        return;
+    }
+    PMIX_CONSTRUCT(&pbkt, pmix_buffer_t);
+    PMIX_BFROPS_PACK(rc, mt->cd->peer, &pbkt, &mt->nreqs, 1, PMIX_SIZE);
+    if (PMIX_SUCCESS == rc) {
+        PMIX_BFROPS_PACK(rc, mt->cd->peer, &pbkt, mt->status, mt->nreqs, PMIX_STATUS);
+    }
+    if (PMIX_SUCCESS == rc) {
+        PMIX_BFROPS_PACK(rc, mt->cd->peer, &pbkt, mt->data, mt->nreqs, PMIX_BYTE_OBJECT);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DESTRUCT(&pbkt);
+        mt->cbfunc(rc, NULL, 0, mt->cd, NULL, NULL);
+    } else {
+        PMIX_UNLOAD_BUFFER(&pbkt, data, sz);
+        PMIX_DESTRUCT(&pbkt);
+        mt->cbfunc(PMIX_SUCCESS, data, sz, mt->cd, relfn, data);
+    }
+    PMIX_RELEASE(mt);
+}
+
+static void getmulti_cbfunc(pmix_status_t status, const char *data, size_t ndata, void *cbdata,
+                            pmix_release_cbfunc_t relcbfunc, void *relcbdata)
+{
+    getmulti_req_t *req = (getmulti_req_t *) cbdata;
+    getmulti_t *mt = req->mt;
+
+    mt->status[req->idx] = status;
+    if (PMIX_SUCCESS == status && 0 < ndata) {
+        mt->data[req->idx].bytes = (char *) malloc(ndata);
+        memcpy(mt->data[req->idx].bytes, data, ndata);
+        mt->data[req->idx].size = ndata;
+    }
+    if (NULL != relcbfunc) {
+        relcbfunc(relcbdata);
+    }
+    PMIX_RELEASE(req);
+    getmulti_step(mt);
+}
+
+pmix_status_t pmix_server_get_multi(pmix_buffer_t *buf, pmix_modex_cbfunc_t cbfunc, void *cbdata)
+{
+    pmix_server_caddy_t *cd = (pmix_server_caddy_t *) cbdata;
+    getmulti_t *mt;
+    getmulti_req_t *req;
+    pmix_info_t *info = NULL;
+    size_t ninfo, n, m;
+    int32_t cnt;
+    pmix_status_t rc;
+    pmix_rank_t rank;
+    char *cptr, *key;
+    char nspace[PMIX_MAX_NSLEN + 1];
+
+    pmix_output_verbose(2, pmix_server_globals.get_output, "%s recvd GETMULTI",
+                        PMIX_NAME_PRINT(&pmix_globals.myid));
+
+    /* retrieve the directives that apply to every request */
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, cd->peer, buf, &ninfo, &cnt, PMIX_SIZE);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    if (0 < ninfo) {
+        PMIX_INFO_CREATE(info, ninfo);
+        cnt = ninfo;
+        PMIX_BFROPS_UNPACK(rc, cd->peer, buf, info, &cnt, PMIX_INFO);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_INFO_FREE(info, ninfo);
+            return rc;
+        }
+    }
+    mt = PMIX_NEW(getmulti_t);
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, cd->peer, buf, &mt->nreqs, &cnt, PMIX_SIZE);
+    if (PMIX_SUCCESS != rc || 0 == mt->nreqs) {
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIX_ERR_BAD_PARAM;
+        }
+        PMIX_ERROR_LOG(rc);
+        PMIX_INFO_FREE(info, ninfo);
+        PMIX_RELEASE(mt);
+        return rc;
+    }
+    mt->cd = cd;
+    mt->cbfunc = cbfunc;
+    mt->status = (pmix_status_t *) malloc(mt->nreqs * sizeof(pmix_status_t));
+    PMIX_BYTE_OBJECT_CREATE(mt->data, mt->nreqs);
+    /* hold completion until every request has been started */
+    mt->nleft = mt->nreqs + 1;
+
+    for (n = 0; n < mt->nreqs; n++) {
+        mt->status[n] = PMIX_ERR_UNPACK_FAILURE;
+        cptr = NULL;
+        key = NULL;
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, cd->peer, buf, &cptr, &cnt, PMIX_STRING);
+        if (PMIX_SUCCESS == rc) {
+            PMIX_LOAD_NSPACE(nspace, cptr);
+            free(cptr);
+            cnt = 1;
+            PMIX_BFROPS_UNPACK(rc, cd->peer, buf, &rank, &cnt, PMIX_PROC_RANK);
+        }
+        if (PMIX_SUCCESS == rc) {
+            cnt = 1;
+            PMIX_BFROPS_UNPACK(rc, cd->peer, buf, &key, &cnt, PMIX_STRING);
+        }
+        if (PMIX_SUCCESS != rc) {
+            /* the rest of the message cannot be trusted */
+            PMIX_ERROR_LOG(rc);
+            mt->nleft -= mt->nreqs - n;
+            break;
+        }
+        /* give each request its own caddy so the usual tracking
+         * of deferred requests applies to it */
+        req = PMIX_NEW(getmulti_req_t);
+        req->super.hdr.tag = cd->hdr.tag;
+        PMIX_RETAIN(cd->peer);
+        req->super.peer = cd->peer;
+        if (0 < ninfo) {
+            req->super.ninfo = ninfo;
+            PMIX_INFO_CREATE(req->super.info, ninfo);
+            for (m = 0; m < ninfo; m++) {
+                PMIX_INFO_XFER(&req->super.info[m], &info[m]);
+            }
+        }
+        req->mt = mt;
+        req->idx = n;
+        rc = get_proc(nspace, rank, key, true, getmulti_cbfunc, req);
+        if (NULL != key) {
+            free(key);
+        }
+        if (PMIX_SUCCESS != rc) {
+            mt->status[n] = rc;
+            PMIX_RELEASE(req);
+            getmulti_step(mt);
+        }
+    }
+    if (NULL != info) {
+        PMIX_INFO_FREE(info, ninfo);
+    }
+    getmulti_step(mt);
+    return PMIX_SUCCESS;
+}
+
+/* process a request for the data of the given proc. The cbdata is
+ * the pmix_server_caddy_t of the requestor, whose info array holds
+ * any directives. The cbfunc will be called unless an error is
+ * returned */
+static pmix_status_t get_proc(char *nspace, pmix_rank_t rank, char *key, bool keyprovided,
+                              pmix_modex_cbfunc_t cbfunc, void *cbdata)
+{
+    pmix_server_caddy_t *cd = (pmix_server_caddy_t *) cbdata;
+    pmix_status_t rc;
+    pmix_namespace_t *nptr;
+    pmix_dmdx_local_t *lcd;
+    bool local = false;
+    bool localonly = false;
+    bool diffnspace = false;
+    bool refresh_cache = false;
+    bool scope_given = false;
+    struct timeval tv = {0, 0};
+    pmix_buffer_t pbkt;
+    pmix_cb_t cb;
+    pmix_proc_t proc;
+    char *data;
+    size_t sz, n;
+    pmix_info_t *info;
+    pmix_scope_t scope = PMIX_SCOPE_UNDEF;
+    pmix_rank_info_t *iptr;
+
     /* search for directives we can deal with here */
     for (n = 0; n < cd->ninfo; n++) {
-        if (PMIX_CHECK_KEY(&cd->info[n], PMIX_IMMEDIATE)) {
+        switch (pmix_atom_lookup(cd->info[n].key)) {
+        case PMIX_ATOM_KEY_IMMEDIATE:
             /* just check our own data - don't wait
              * or request it from someone else */
             localonly = PMIX_INFO_TRUE(&cd->info[n]);
-        } else if (PMIX_CHECK_KEY(&cd->info[n], PMIX_TIMEOUT)) {
+            break;
+        case PMIX_ATOM_KEY_TIMEOUT:
             tv.tv_sec = cd->info[n].value.data.uint32;
-        } else if (PMIX_CHECK_KEY(&cd->info[n], PMIX_GET_REFRESH_CACHE)) {
+            break;
+        case PMIX_ATOM_KEY_GET_REFRESH_CACHE:
             refresh_cache = PMIX_INFO_TRUE(&cd->info[n]);
-        } else if (PMIX_CHECK_KEY(&cd->info[n], PMIX_DATA_SCOPE)) {
+            break;
+        case PMIX_ATOM_KEY_DATA_SCOPE:
             scope = cd->info[n].value.data.scope;
             scope_given = true;
+            break;
+        default:
+            break;
         }
     }
 
     /* find the nspace object for the target proc */
-    nptr = NULL;
-    PMIX_LIST_FOREACH (ns, &pmix_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(nspace, ns->nspace)) {
-            nptr = ns;
-            break;
-        }
-    }
+    nptr = pmix_nspace_lookup(nspace);
 
     pmix_output_verbose(2, pmix_server_globals.get_output,
                         "%s EXECUTE GET FOR %s:%d WITH KEY %s ON BEHALF OF %s",
@@ -367,10 +583,7 @@ pmix_status_t pmix_server_get(pmix_buffer_t *buf, pmix_modex_cbfunc_t cbfunc, vo
     if (local && refresh_cache) {
         return PMIX_OPERATION_SUCCEEDED;
     } else if (refresh_cache) {
-        if (NULL != key) {
-            free(key);
-            key = NULL;
-        }
+        key = NULL;
         goto request;
     }
 
@@ -463,7 +676,11 @@ pmix_status_t pmix_server_get(pmix_buffer_t *buf, pmix_modex_cbfunc_t cbfunc, vo
 
     /* check if the nspace of the requestor is different from
      * the nspace of the target process */
-    diffnspace = !PMIX_CHECK_NSPACE(nptr->nspace, cd->peer->info->pname.nspace);
+    if (NULL != cd->peer->nptr) {
+        diffnspace = !PMIX_CHECK_NSPACE_ID(nptr, cd->peer->nptr);
+    } else {
+        diffnspace = !PMIX_CHECK_NSPACE(nptr->nspace, cd->peer->info->pname.nspace);
+    }
 
     if (!scope_given) {
         if (PMIX_RANK_UNDEF == rank || diffnspace) {
@@ -531,14 +748,14 @@ request:
         rc = pmix_host_server.direct_modex(&lcd->proc, cd->info, cd->ninfo, dmdx_cbfunc, lcd);
         if (PMIX_SUCCESS != rc) {
             /* may have a function entry but not support the request */
-            pmix_list_remove_item(&pmix_server_globals.local_reqs, &lcd->super);
+            pmix_dmdx_queue_remove(&pmix_server_globals.local_reqs, &lcd->proc, &lcd->super);
             PMIX_RELEASE(lcd);
         }
     } else {
         pmix_output_verbose(2, pmix_server_globals.get_output, "%s:%d NO SERVER SUPPORT",
                             pmix_globals.myid.nspace, pmix_globals.myid.rank);
         /* if we don't have direct modex feature, just respond with "not found" */
-        pmix_list_remove_item(&pmix_server_globals.local_reqs, &lcd->super);
+        pmix_dmdx_queue_remove(&pmix_server_globals.local_reqs, &lcd->proc, &lcd->super);
         PMIX_RELEASE(lcd);
         rc = PMIX_ERR_NOT_FOUND;
     }
@@ -550,8 +767,9 @@ static pmix_status_t create_local_tracker(char nspace[], pmix_rank_t rank, pmix_
                                           size_t ninfo, pmix_modex_cbfunc_t cbfunc, void *cbdata,
                                           pmix_dmdx_local_t **ld, pmix_dmdx_request_t **rq)
 {
-    pmix_dmdx_local_t *lcd, *cd;
+    pmix_dmdx_local_t *lcd;
     pmix_dmdx_request_t *req;
+    pmix_proc_t proc;
     pmix_status_t rc;
     size_t n;
 
@@ -561,14 +779,8 @@ static pmix_status_t create_local_tracker(char nspace[], pmix_rank_t rank, pmix_
 
     /* see if we already have an existing request for data
      * from this namespace/rank */
-    lcd = NULL;
-    PMIX_LIST_FOREACH (cd, &pmix_server_globals.local_reqs, pmix_dmdx_local_t) {
-        if (!PMIX_CHECK_NSPACE(nspace, cd->proc.nspace) || rank != cd->proc.rank) {
-            continue;
-        }
-        lcd = cd;
-        break;
-    }
+    PMIX_LOAD_PROCID(&proc, nspace, rank);
+    lcd = (pmix_dmdx_local_t *) pmix_dmdx_queue_first(&pmix_server_globals.local_reqs, &proc);
     if (NULL != lcd) {
         /* we already have a request, so just track that someone
          * else wants data from the same target */
@@ -590,7 +802,11 @@ static pmix_status_t create_local_tracker(char nspace[], pmix_rank_t rank, pmix_
             PMIX_INFO_XFER(&lcd->info[n], &info[n]);
         }
     }
-    pmix_list_append(&pmix_server_globals.local_reqs, &lcd->super);
+    rc = pmix_dmdx_queue_append(&pmix_server_globals.local_reqs, &lcd->proc, &lcd->super);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_RELEASE(lcd);
+        return rc;
+    }
     rc = PMIX_ERR_NOT_FOUND; // indicates that we created a new request tracker
 
 complete:
@@ -619,18 +835,25 @@ complete:
 
 void pmix_pending_nspace_requests(pmix_namespace_t *nptr)
 {
-    pmix_dmdx_local_t *cd, *cd_next;
+    pmix_dmdx_local_t *cd;
+    pmix_list_t reqs;
     pmix_status_t rc;
 
     /* Now that we know all local ranks, go along request list and ask for remote data
      * for the non-local ranks, and resolve all pending requests for local procs
      * that were waiting for registration to complete
      */
-    PMIX_LIST_FOREACH_SAFE (cd, cd_next, &pmix_server_globals.local_reqs, pmix_dmdx_local_t) {
+    PMIX_CONSTRUCT(&reqs, pmix_list_t);
+    pmix_dmdx_queue_take_nspace(&pmix_server_globals.local_reqs, nptr->nspace, &reqs);
+    while (NULL != (cd = (pmix_dmdx_local_t *) pmix_list_remove_first(&reqs))) {
         pmix_rank_info_t *info;
         bool found = false;
 
-        if (0 != strncmp(nptr->nspace, cd->proc.nspace, PMIX_MAX_NSLEN)) {
+        /* the request stays pending unless we find we cannot service it */
+        rc = pmix_dmdx_queue_append(&pmix_server_globals.local_reqs, &cd->proc, &cd->super);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_RELEASE(cd);
             continue;
         }
 
@@ -655,11 +878,12 @@ void pmix_pending_nspace_requests(pmix_namespace_t *nptr)
                     pmix_list_remove_item(&cd->loc_reqs, &req->super);
                     PMIX_RELEASE(req);
                 }
-                pmix_list_remove_item(&pmix_server_globals.local_reqs, &cd->super);
+                pmix_dmdx_queue_remove(&pmix_server_globals.local_reqs, &cd->proc, &cd->super);
                 PMIX_RELEASE(cd);
             }
         }
     }
+    PMIX_DESTRUCT(&reqs);
 }
 
 static pmix_status_t get_job_data(char *nspace, pmix_server_caddy_t *cd, pmix_buffer_t *pbkt)
@@ -846,21 +1070,18 @@ static pmix_status_t _satisfy_request(pmix_namespace_t *nptr, pmix_rank_t rank,
 pmix_status_t pmix_pending_resolve(pmix_namespace_t *nptr, pmix_rank_t rank, pmix_status_t status,
                                    pmix_dmdx_local_t *lcd)
 {
-    pmix_dmdx_local_t *cd, *ptr;
+    pmix_dmdx_local_t *ptr;
     pmix_dmdx_request_t *req, *rnext;
-    pmix_server_caddy_t scd;
+    pmix_server_caddy_t scd, *rcd;
+    pmix_proc_t proc;
 
     /* find corresponding request (if exists) */
     if (NULL == lcd) {
         ptr = NULL;
         if (NULL != nptr) {
-            PMIX_LIST_FOREACH (cd, &pmix_server_globals.local_reqs, pmix_dmdx_local_t) {
-                if (!PMIX_CHECK_NSPACE(nptr->nspace, cd->proc.nspace) || rank != cd->proc.rank) {
-                    continue;
-                }
-                ptr = cd;
-                break;
-            }
+            PMIX_LOAD_PROCID(&proc, nptr->nspace, rank);
+            ptr = (pmix_dmdx_local_t *) pmix_dmdx_queue_first(&pmix_server_globals.local_reqs,
+                                                               &proc);
         }
         if (NULL == ptr) {
             return PMIX_SUCCESS;
@@ -886,13 +1107,14 @@ pmix_status_t pmix_pending_resolve(pmix_namespace_t *nptr, pmix_rank_t rank, pmi
         /* if we've got the blob - try to satisfy requests */
         /* run through all the requests for this rank */
         /* this info is going back to one of our peers, so provide a server
-         * caddy with our peer in it so the data gets packed correctly */
+         * caddy without the request's directives - the data must be packed
+         * for the peer that asked for it, as its buffers may be native */
         PMIX_CONSTRUCT(&scd, pmix_server_caddy_t);
-        PMIX_RETAIN(pmix_globals.mypeer);
-        scd.peer = pmix_globals.mypeer;
         PMIX_LIST_FOREACH (req, &ptr->loc_reqs, pmix_dmdx_request_t) {
             pmix_status_t rc;
             bool diffnspace = !PMIX_CHECK_NSPACE(nptr->nspace, req->lcd->proc.nspace);
+            rcd = (pmix_server_caddy_t *) req->cbdata;
+            scd.peer = rcd->peer;
             rc = _satisfy_request(nptr, rank, &scd, diffnspace, PMIX_REMOTE, req->cbfunc,
                                   req->cbdata);
             if (PMIX_SUCCESS != rc) {
@@ -900,12 +1122,14 @@ pmix_status_t pmix_pending_resolve(pmix_namespace_t *nptr, pmix_rank_t rank, pmi
                 req->cbfunc(rc, NULL, 0, req->cbdata, NULL, NULL);
             }
         }
+        /* the peers belong to the requests */
+        scd.peer = NULL;
         PMIX_DESTRUCT(&scd);
     }
 
 cleanup:
     /* remove all requests to this rank and cleanup the corresponding structure */
-    pmix_list_remove_item(&pmix_server_globals.local_reqs, &ptr->super);
+    pmix_dmdx_queue_remove(&pmix_server_globals.local_reqs, &ptr->proc, &ptr->super);
     /* the dmdx request is linked back to its local request for ease
      * of lookup upon return from the server. However, this means that
      * the refcount of the local request has been increased by the number
@@ -930,7 +1154,7 @@ static void _process_dmdx_reply(int sd, short args, void *cbdata)
     pmix_rank_info_t *rinfo;
     int32_t cnt;
     pmix_kval_t *kv;
-    pmix_namespace_t *ns, *nptr;
+    pmix_namespace_t *nptr;
     pmix_status_t rc;
     pmix_list_t nspaces;
     pmix_nspace_caddy_t *nm;
@@ -946,13 +1170,7 @@ static void _process_dmdx_reply(int sd, short args, void *cbdata)
                         __FILE__, __LINE__, caddy->lcd->proc.nspace, caddy->lcd->proc.rank);
 
     /* find the nspace object for the proc whose data is being received */
-    nptr = NULL;
-    PMIX_LIST_FOREACH (ns, &pmix_globals.nspaces, pmix_namespace_t) {
-        if (PMIX_CHECK_NSPACE(caddy->lcd->proc.nspace, ns->nspace)) {
-            nptr = ns;
-            break;
-        }
-    }
+    nptr = pmix_nspace_lookup(caddy->lcd->proc.nspace);
 
     if (NULL == nptr) {
         /* We may not have this namespace because there are no local
@@ -961,7 +1179,7 @@ static void _process_dmdx_reply(int sd, short args, void *cbdata)
         nptr = PMIX_NEW(pmix_namespace_t);
         nptr->nspace = strdup(caddy->lcd->proc.nspace);
         /* add to the list */
-        pmix_list_append(&pmix_globals.nspaces, &nptr->super);
+        pmix_nspace_register(nptr);
     }
 
     /* if the request was successfully satisfied, then store the data.
@@ -51,6 +51,7 @@
 #endif
 #include <event.h>
 
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_hotel.h"
 #include "src/class/pmix_list.h"
 #include "src/common/pmix_attributes.h"
@@ -58,6 +59,7 @@
 #include "src/hwloc/pmix_hwloc.h"
 #include "src/mca/bfrops/bfrops.h"
 #include "src/mca/gds/base/base.h"
+#include "src/mca/pcompress/pcompress.h"
 #include "src/mca/plog/plog.h"
 #include "src/mca/pnet/pnet.h"
 #include "src/mca/prm/prm.h"
@@ -71,18 +73,23 @@
 
 #include "pmix_server_ops.h"
 
-/* The rank_blob_t type to collect processes blobs,
+/* The rank_blob_t type to collect the data of each process,
  * this list afterward will form a node modex blob. */
 typedef struct {
     pmix_list_item_t super;
-    pmix_buffer_t *buf;
+    pmix_rank_t rel_rank;
+    pmix_list_t kvs;
 } rank_blob_t;
 
+static void bufcon(rank_blob_t *p)
+{
+    PMIX_CONSTRUCT(&p->kvs, pmix_list_t);
+}
 static void bufdes(rank_blob_t *p)
 {
-    PMIX_RELEASE(p);
+    PMIX_LIST_DESTRUCT(&p->kvs);
 }
-static PMIX_CLASS_INSTANCE(rank_blob_t, pmix_list_item_t, NULL, bufdes);
+static PMIX_CLASS_INSTANCE(rank_blob_t, pmix_list_item_t, bufcon, bufdes);
 
 pmix_server_module_t pmix_host_server = {
     .client_connected = NULL,
@@ -197,10 +204,12 @@ pmix_status_t pmix_server_commit(pmix_peer_t *peer, pmix_buffer_t *buf)
     pmix_namespace_t *nptr;
     pmix_rank_info_t *info;
     pmix_proc_t proc;
-    pmix_dmdx_remote_t *dcd, *dcdnext;
+    pmix_dmdx_remote_t *dcd;
+    pmix_list_t waiters;
     char *data;
     size_t sz;
     pmix_cb_t cb;
+    bool view;
 
     /* shorthand */
     info = peer->info;
@@ -223,7 +232,14 @@ pmix_status_t pmix_server_commit(pmix_peer_t *peer, pmix_buffer_t *buf)
         cnt = 1;
         PMIX_CONSTRUCT(&b2, pmix_buffer_t);
         PMIX_BFROPS_ASSIGN_TYPE(peer, &b2);
-        PMIX_BFROPS_UNPACK(rc, peer, buf, &b2, &cnt, PMIX_BUFFER);
+        /* the blob is only needed while we store its contents,
+         * so avoid copying it out of the message if we can */
+        view = true;
+        PMIX_BFROPS_UNPACK_VIEW(rc, peer, buf, &b2, &cnt, PMIX_BUFFER);
+        if (PMIX_ERR_NOT_SUPPORTED == rc) {
+            view = false;
+            PMIX_BFROPS_UNPACK(rc, peer, buf, &b2, &cnt, PMIX_BUFFER);
+        }
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             return rc;
@@ -240,6 +256,9 @@ pmix_status_t pmix_server_commit(pmix_peer_t *peer, pmix_buffer_t *buf)
                 if (PMIX_SUCCESS != rc) {
                     PMIX_ERROR_LOG(rc);
                     PMIX_RELEASE(kp);
+                    if (view) {
+                        b2.base_ptr = NULL;
+                    }
                     PMIX_DESTRUCT(&b2);
                     return rc;
                 }
@@ -249,6 +268,9 @@ pmix_status_t pmix_server_commit(pmix_peer_t *peer, pmix_buffer_t *buf)
                 if (PMIX_SUCCESS != rc) {
                     PMIX_ERROR_LOG(rc);
                     PMIX_RELEASE(kp);
+                    if (view) {
+                        b2.base_ptr = NULL;
+                    }
                     PMIX_DESTRUCT(&b2);
                     return rc;
                 }
@@ -259,6 +281,9 @@ pmix_status_t pmix_server_commit(pmix_peer_t *peer, pmix_buffer_t *buf)
             PMIX_BFROPS_UNPACK(rc, peer, &b2, kp, &cnt, PMIX_KVAL);
         }
         PMIX_RELEASE(kp); // maintain accounting
+        if (view) {
+            b2.base_ptr = NULL;
+        }
         PMIX_DESTRUCT(&b2);
         if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc) {
             PMIX_ERROR_LOG(rc);
@@ -279,42 +304,42 @@ pmix_status_t pmix_server_commit(pmix_peer_t *peer, pmix_buffer_t *buf)
     peer->commit_cnt++;
 
     /* see if anyone remote is waiting on this data - could be more than one */
-    PMIX_LIST_FOREACH_SAFE (dcd, dcdnext, &pmix_server_globals.remote_pnd, pmix_dmdx_remote_t) {
-        if (0 != strncmp(dcd->cd->proc.nspace, nptr->nspace, PMIX_MAX_NSLEN)) {
-            continue;
-        }
-        if (dcd->cd->proc.rank == info->pname.rank) {
-            /* we can now fulfill this request - collect the
-             * remote/global data from this proc - note that there
-             * may not be a contribution */
-            data = NULL;
-            sz = 0;
-            PMIX_CONSTRUCT(&cb, pmix_cb_t);
-            cb.proc = &proc;
-            cb.scope = PMIX_REMOTE;
-            cb.copy = true;
-            PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
-            if (PMIX_SUCCESS == rc) {
-                /* package it up */
-                PMIX_CONSTRUCT(&pbkt, pmix_buffer_t);
-                PMIX_LIST_FOREACH (kp, &cb.kvs, pmix_kval_t) {
-                    /* we pack this in our native BFROPS form as it
-                     * will be sent to another daemon */
-                    PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &pbkt, kp, 1, PMIX_KVAL);
-                }
-                PMIX_UNLOAD_BUFFER(&pbkt, data, sz);
+    PMIX_CONSTRUCT(&waiters, pmix_list_t);
+    pmix_dmdx_queue_take(&pmix_server_globals.remote_pnd, &proc, &waiters);
+    if (0 < pmix_list_get_size(&waiters)) {
+        /* we can now fulfill these requests - collect the
+         * remote/global data from this proc - note that there
+         * may not be a contribution */
+        data = NULL;
+        sz = 0;
+        PMIX_CONSTRUCT(&cb, pmix_cb_t);
+        cb.proc = &proc;
+        cb.scope = PMIX_REMOTE;
+        cb.copy = true;
+        PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
+        if (PMIX_SUCCESS == rc) {
+            /* package it up */
+            PMIX_CONSTRUCT(&pbkt, pmix_buffer_t);
+            PMIX_LIST_FOREACH (kp, &cb.kvs, pmix_kval_t) {
+                /* we pack this in our native BFROPS form as it
+                 * will be sent to another daemon */
+                PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &pbkt, kp, 1, PMIX_KVAL);
             }
-            PMIX_DESTRUCT(&cb);
-            /* execute the callback */
+            PMIX_UNLOAD_BUFFER(&pbkt, data, sz);
+        }
+        PMIX_DESTRUCT(&cb);
+        /* the data is only needed for the duration of each
+         * callback, so all requests can share it */
+        while (NULL != (dcd = (pmix_dmdx_remote_t *) pmix_list_remove_first(&waiters))) {
             dcd->cd->cbfunc(rc, data, sz, dcd->cd->cbdata);
-            if (NULL != data) {
-                free(data);
-            }
             /* we have finished this request */
-            pmix_list_remove_item(&pmix_server_globals.remote_pnd, &dcd->super);
             PMIX_RELEASE(dcd);
         }
+        if (NULL != data) {
+            free(data);
+        }
     }
+    PMIX_DESTRUCT(&waiters);
     /* see if anyone local is waiting on this data- could be more than one */
     rc = pmix_pending_resolve(nptr, info->pname.rank, PMIX_SUCCESS, NULL);
     if (PMIX_SUCCESS != rc) {
@@ -323,6 +348,85 @@ pmix_status_t pmix_server_commit(pmix_peer_t *peer, pmix_buffer_t *buf)
     return rc;
 }
 
+static int proc_cmp(const void *a, const void *b)
+{
+    const pmix_proc_t *p1 = (const pmix_proc_t *) a;
+    const pmix_proc_t *p2 = (const pmix_proc_t *) b;
+    int rc;
+
+    rc = strncmp(p1->nspace, p2->nspace, PMIX_MAX_NSLEN);
+    if (0 != rc) {
+        return rc;
+    }
+    if (p1->rank == p2->rank) {
+        return 0;
+    }
+    return (p1->rank < p2->rank) ? -1 : 1;
+}
+
+/* build the key a collective is indexed by. A collective with an
+ * ID is known by that ID alone. Otherwise it is identified by its
+ * type and the set of participating procs - the procs may be given
+ * in any order, so the signature is built from a sorted copy */
+static char *tracker_key(char *id, pmix_proc_t *procs, size_t nprocs, pmix_cmd_t type,
+                         size_t *keylen)
+{
+    pmix_proc_t *sorted = procs;
+    size_t i, len, nslen;
+    char *key, *ptr;
+
+    if (NULL != id) {
+        len = strlen(id);
+        key = (char *) malloc(len + 1);
+        if (NULL == key) {
+            return NULL;
+        }
+        key[0] = 'i';
+        memcpy(key + 1, id, len);
+        *keylen = len + 1;
+        return key;
+    }
+
+    len = 1 + sizeof(pmix_cmd_t);
+    for (i = 0; i < nprocs; i++) {
+        len += strnlen(procs[i].nspace, PMIX_MAX_NSLEN) + 1 + sizeof(pmix_rank_t);
+        if (0 < i && 0 < proc_cmp(&procs[i - 1], &procs[i]) && sorted == procs) {
+            sorted = NULL;
+        }
+    }
+    key = (char *) malloc(len);
+    if (NULL == key) {
+        return NULL;
+    }
+    if (NULL == sorted) {
+        /* we only need to sort if they weren't given in order */
+        sorted = (pmix_proc_t *) malloc(nprocs * sizeof(pmix_proc_t));
+        if (NULL == sorted) {
+            free(key);
+            return NULL;
+        }
+        memcpy(sorted, procs, nprocs * sizeof(pmix_proc_t));
+        qsort(sorted, nprocs, sizeof(pmix_proc_t), proc_cmp);
+    }
+    ptr = key;
+    *ptr++ = 's';
+    memcpy(ptr, &type, sizeof(pmix_cmd_t));
+    ptr += sizeof(pmix_cmd_t);
+    for (i = 0; i < nprocs; i++) {
+        nslen = strnlen(sorted[i].nspace, PMIX_MAX_NSLEN);
+        memcpy(ptr, sorted[i].nspace, nslen);
+        ptr += nslen;
+        *ptr++ = '\0';
+        memcpy(ptr, &sorted[i].rank, sizeof(pmix_rank_t));
+        ptr += sizeof(pmix_rank_t);
+    }
+    if (sorted != procs) {
+        free(sorted);
+    }
+    *keylen = len;
+    return key;
+}
+
 /* get an existing object for tracking LOCAL participation in a collective
  * operation such as "fence". The only way this function can be
  * called is if at least one local client process is participating
@@ -342,8 +446,9 @@ pmix_status_t pmix_server_commit(pmix_peer_t *peer, pmix_buffer_t *buf)
 static pmix_server_trkr_t *get_tracker(char *id, pmix_proc_t *procs, size_t nprocs, pmix_cmd_t type)
 {
     pmix_server_trkr_t *trk;
-    size_t i, j;
-    size_t matches;
+    char *key;
+    size_t keylen;
+    int rc;
 
     pmix_output_verbose(5, pmix_server_globals.fence_output,
                         "get_tracker called with %d procs",
@@ -355,47 +460,38 @@ static pmix_server_trkr_t *get_tracker(char *id, pmix_proc_t *procs, size_t npro
         return NULL;
     }
 
-    /* there is no shortcut way to search the trackers - all
-     * we can do is perform a brute-force search. Fortunately,
-     * it is highly unlikely that there will be more than one
-     * or two active at a time, and they are most likely to
-     * involve only a single proc with WILDCARD rank - so this
-     * shouldn't take long */
-    PMIX_LIST_FOREACH (trk, &pmix_server_globals.collectives, pmix_server_trkr_t) {
-        /* Collective operation if unique identified by
-         * the set of participating processes and the type of collective,
-         * or by the operation ID
-         */
-        if (NULL != id) {
-            if (NULL != trk->id && 0 == strcmp(id, trk->id)) {
-                return trk;
-            }
-        } else {
-            if (nprocs != trk->npcs) {
-                continue;
-            }
-            if (type != trk->type) {
-                continue;
-            }
-            matches = 0;
-            for (i = 0; i < nprocs; i++) {
-                /* the procs may be in different order, so we have
-                 * to do an exhaustive search */
-                for (j = 0; j < trk->npcs; j++) {
-                    if (0 == strcmp(procs[i].nspace, trk->pcs[j].nspace)
-                        && procs[i].rank == trk->pcs[j].rank) {
-                        ++matches;
-                        break;
-                    }
-                }
-            }
-            if (trk->npcs == matches) {
-                return trk;
-            }
-        }
+    /* Collective operation if unique identified by
+     * the set of participating processes and the type of collective,
+     * or by the operation ID */
+    key = tracker_key(id, procs, nprocs, type, &keylen);
+    if (NULL == key) {
+        PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
+        return NULL;
+    }
+    rc = pmix_hash_table_get_value_ptr(&pmix_server_globals.collectives_index, key, keylen,
+                                       (void **) &trk);
+    free(key);
+    if (PMIX_SUCCESS != rc) {
+        /* No tracker was found */
+        return NULL;
+    }
+    return trk;
+}
+
+void pmix_server_remove_tracker(pmix_server_trkr_t *trk)
+{
+    pmix_server_trkr_t *t;
+
+    pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+    /* a new tracker for the same collective may have replaced
+     * this one in the index, so only drop our own entry */
+    if (NULL != trk->key
+        && PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&pmix_server_globals.collectives_index,
+                                                         trk->key, trk->keylen, (void **) &t)
+        && t == trk) {
+        pmix_hash_table_remove_value_ptr(&pmix_server_globals.collectives_index, trk->key,
+                                         trk->keylen);
     }
-    /* No tracker was found */
-    return NULL;
 }
 
 /* create a new object for tracking LOCAL participation in a collective
@@ -419,7 +515,7 @@ static pmix_server_trkr_t *new_tracker(char *id, pmix_proc_t *procs, size_t npro
     pmix_server_trkr_t *trk;
     size_t i;
     bool all_def, found;
-    pmix_namespace_t *nptr, *ns;
+    pmix_namespace_t *nptr;
     pmix_rank_info_t *info;
     pmix_nspace_caddy_t *nm;
     pmix_nspace_t first;
@@ -448,6 +544,12 @@ static pmix_server_trkr_t *new_tracker(char *id, pmix_proc_t *procs, size_t npro
     if (NULL != id) {
         trk->id = strdup(id);
     }
+    trk->key = tracker_key(id, procs, nprocs, type, &trk->keylen);
+    if (NULL == trk->key) {
+        PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
+        PMIX_RELEASE(trk);
+        return NULL;
+    }
 
     /* copy the procs */
     PMIX_PROC_CREATE(trk->pcs, nprocs);
@@ -466,13 +568,7 @@ static pmix_server_trkr_t *new_tracker(char *id, pmix_proc_t *procs, size_t npro
     PMIX_LOAD_NSPACE(first, NULL);
     for (i = 0; i < nprocs; i++) {
         /* is this nspace known to us? */
-        nptr = NULL;
-        PMIX_LIST_FOREACH (ns, &pmix_globals.nspaces, pmix_namespace_t) {
-            if (0 == strcmp(procs[i].nspace, ns->nspace)) {
-                nptr = ns;
-                break;
-            }
-        }
+        nptr = pmix_nspace_lookup(procs[i].nspace);
         /* check if multiple nspaces are involved in this operation */
         if (0 == strlen(first)) {
             PMIX_LOAD_NSPACE(first, procs[i].nspace);
@@ -595,6 +691,8 @@ static pmix_server_trkr_t *new_tracker(char *id, pmix_proc_t *procs, size_t npro
         trk->def_complete = true;
     }
     pmix_list_append(&pmix_server_globals.collectives, &trk->super);
+    pmix_hash_table_set_value_ptr(&pmix_server_globals.collectives_index, trk->key, trk->keylen,
+                                  trk);
     return trk;
 }
 
@@ -605,6 +703,13 @@ static void fence_timeout(int sd, short args, void *cbdata)
 
     pmix_output_verbose(2, pmix_server_globals.fence_output, "ALERT: fence timeout fired");
 
+    /* the host may be holding some of our data for this fence */
+    if (trk->streamed && !trk->host_called) {
+        pmix_server_globals.fence_contrib(trk->pcs, trk->npcs, trk->info, trk->ninfo, NULL, 0,
+                                          true, NULL, trk);
+        trk->streamed = false;
+    }
+
     /* execute the provided callback function with the error */
     if (NULL != trk->modexcbfunc) {
         trk->modexcbfunc(PMIX_ERR_TIMEOUT, NULL, 0, trk, NULL, NULL);
@@ -614,9 +719,132 @@ static void fence_timeout(int sd, short args, void *cbdata)
     PMIX_RELEASE(trk);
 }
 
+static bool _local_gds_needs_data(pmix_server_trkr_t *trk)
+{
+    pmix_server_caddy_t *cd;
+
+    PMIX_LIST_FOREACH (cd, &trk->local_cbs, pmix_server_caddy_t) {
+        if (cd->peer->nptr->compat.gds != pmix_globals.mypeer->nptr->compat.gds) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void _release_data(void *cbdata)
+{
+    free(cbdata);
+}
+
+/* look up the kmap index of a key, adding the key to
+ * the kmap if this is the first time we have seen it */
+static pmix_status_t _kmap_index(pmix_hash_table_t *dict, char ***kmap, const char *key,
+                                 uint32_t *idx, bool *added)
+{
+    void *ptr;
+    int rc;
+
+    rc = pmix_hash_table_get_value_ptr(dict, key, strlen(key), &ptr);
+    if (PMIX_SUCCESS == rc) {
+        *idx = (uint32_t) (uintptr_t) ptr;
+        *added = false;
+        return PMIX_SUCCESS;
+    }
+    *idx = pmix_argv_count(*kmap);
+    rc = pmix_argv_append_nosize(kmap, key);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    *added = true;
+    return pmix_hash_table_set_value_ptr(dict, key, strlen(key), (void *) (uintptr_t) *idx);
+}
+
+/* the rank of a participant counted across all the
+ * nspaces involved in a collective */
+static pmix_status_t _rel_rank(pmix_server_trkr_t *trk, const pmix_proc_t *proc,
+                               pmix_rank_t *rel_rank)
+{
+    pmix_nspace_caddy_t *nm;
+    pmix_rank_t base = 0;
+
+    if (1 == pmix_list_get_size(&trk->nslist)) {
+        *rel_rank = proc->rank;
+        return PMIX_SUCCESS;
+    }
+    PMIX_LIST_FOREACH (nm, &trk->nslist, pmix_nspace_caddy_t) {
+        if (0 == strcmp(nm->ns->nspace, proc->nspace)) {
+            *rel_rank = base + proc->rank;
+            return PMIX_SUCCESS;
+        }
+        base += nm->ns->nprocs;
+    }
+    return PMIX_ERR_NOT_FOUND;
+}
+
+/* replace everything in a bucket after its info byte by its
+ * compressed form if that makes it worthwhile. Data that doesn't
+ * shrink by at least an eighth isn't worth the time it takes to
+ * decompress, and data of a similar size is likely to do no
+ * better - so don't try again until a bucket is twice as large,
+ * or a larger one shows that the data compresses again */
+static pmix_status_t _compress_bucket(pmix_buffer_t *bucket, size_t hdr_size,
+                                      pmix_gds_modex_blob_info_t blob_info_byte)
+{
+    pmix_buffer_t cbkt;
+    pmix_byte_object_t bo;
+    uint8_t *out = NULL;
+    size_t size, outlen = 0;
+    pmix_status_t rc;
+
+    size = bucket->bytes_used - hdr_size;
+    if (0 == pmix_server_globals.modex_compress_threshold
+        || size < pmix_server_globals.modex_compress_threshold
+        || size <= pmix_server_globals.modex_compress_floor) {
+        return PMIX_SUCCESS;
+    }
+    if (!pmix_compress.compress_level((uint8_t *) bucket->base_ptr + hdr_size, size,
+                                      pmix_server_globals.modex_compress_level, &out, &outlen)
+        || size - size / 8 < outlen) {
+        pmix_output_verbose(5, pmix_server_globals.fence_output,
+                            "fence - %" PRIsize_t " bytes of data do not compress", size);
+        pmix_server_globals.modex_compress_floor = 2 * size;
+        if (NULL != out) {
+            free(out);
+        }
+        return PMIX_SUCCESS;
+    }
+    pmix_output_verbose(5, pmix_server_globals.fence_output,
+                        "fence - compressed %" PRIsize_t " bytes of data to %" PRIsize_t, size,
+                        outlen);
+    pmix_server_globals.modex_compress_floor = 0;
+
+    /* assemble the compressed bucket on the side so the
+     * original can still be sent if anything goes wrong */
+    PMIX_CONSTRUCT(&cbkt, pmix_buffer_t);
+    blob_info_byte |= PMIX_GDS_COMPRESS_BIT;
+    PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &cbkt, &blob_info_byte, 1, PMIX_BYTE);
+    if (PMIX_SUCCESS == rc) {
+        bo.bytes = (char *) out;
+        bo.size = outlen;
+        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &cbkt, &bo, 1, PMIX_BYTE_OBJECT);
+    }
+    free(out);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DESTRUCT(&cbkt);
+        return PMIX_SUCCESS;
+    }
+    PMIX_UNLOAD_BUFFER(&cbkt, bo.bytes, bo.size);
+    PMIX_DESTRUCT(&cbkt);
+    PMIX_DESTRUCT(bucket);
+    PMIX_CONSTRUCT(bucket, pmix_buffer_t);
+    PMIX_LOAD_BUFFER(pmix_globals.mypeer, bucket, bo.bytes, bo.size);
+    return PMIX_SUCCESS;
+}
+
 static pmix_status_t _collect_data(pmix_server_trkr_t *trk, pmix_buffer_t *buf)
 {
-    pmix_buffer_t bucket, *pbkt = NULL;
+    pmix_buffer_t bucket, pbkt, tmp;
     pmix_cb_t cb;
     pmix_kval_t *kv;
     pmix_byte_object_t bo;
@@ -624,15 +852,18 @@ static pmix_status_t _collect_data(pmix_server_trkr_t *trk, pmix_buffer_t *buf)
     pmix_proc_t pcs;
     pmix_status_t rc = PMIX_SUCCESS;
     pmix_rank_t rel_rank;
-    pmix_nspace_caddy_t *nm;
-    bool found;
+    bool added;
     pmix_list_t rank_blobs;
     rank_blob_t *blob;
-    uint32_t kmap_size;
+    pmix_hash_table_t dict;
+    pmix_value_array_t kname_sizes;
+    size_t *ksize;
+    size_t key_fmt_size[PMIX_MODEX_KEY_MAX] = {0};
+    size_t kidx_size, hdr_size, vals_size = 0, nblobs = 0;
+    uint32_t kmap_size, key_idx;
     /* key names map, the position of the key name
      * in the array determines the unique key index */
     char **kmap = NULL;
-    int i;
     pmix_gds_modex_blob_info_t blob_info_byte = 0;
     pmix_gds_modex_key_fmt_t kmap_type = PMIX_MODEX_KEY_INVALID;
 
@@ -641,141 +872,90 @@ static pmix_status_t _collect_data(pmix_server_trkr_t *trk, pmix_buffer_t *buf)
     if (PMIX_COLLECT_YES == trk->collect_type) {
         pmix_output_verbose(2, pmix_server_globals.fence_output, "fence - assembling data");
 
-        /* Evaluate key names sizes and their count to select
-         * a format to store key names:
+        PMIX_CONSTRUCT(&rank_blobs, pmix_list_t);
+        PMIX_CONSTRUCT(&dict, pmix_hash_table_t);
+        pmix_hash_table_init(&dict, 64);
+        PMIX_CONSTRUCT(&kname_sizes, pmix_value_array_t);
+        pmix_value_array_init(&kname_sizes, sizeof(size_t));
+        PMIX_CONSTRUCT(&pbkt, pmix_buffer_t);
+
+        /* the packed size of a key index doesn't depend on its value */
+        PMIX_CONSTRUCT(&tmp, pmix_buffer_t);
+        key_idx = 0;
+        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &tmp, &key_idx, 1, PMIX_UINT32);
+        kidx_size = tmp.bytes_used;
+        PMIX_DESTRUCT(&tmp);
+
+        /* get the remote contribution of each participant - note that
+         * there may not be a contribution. As we go, build the key names
+         * map and track the space the key names would take in each of
+         * the formats we can store them in:
          * - keymap: use key-map in blob header for key-name resolve
          *   from idx: key names stored as indexes (avoid key duplication)
          * - regular: key-names stored as is */
-        if (PMIX_MODEX_KEY_INVALID == kmap_type) {
-            size_t key_fmt_size[PMIX_MODEX_KEY_MAX] = {0};
-            pmix_value_array_t *key_count_array = PMIX_NEW(pmix_value_array_t);
-            uint32_t *key_count = NULL;
-
-            pmix_value_array_init(key_count_array, sizeof(uint32_t));
-
-            PMIX_LIST_FOREACH (scd, &trk->local_cbs, pmix_server_caddy_t) {
-                pmix_strncpy(pcs.nspace, scd->peer->info->pname.nspace, PMIX_MAX_NSLEN);
-                pcs.rank = scd->peer->info->pname.rank;
-                PMIX_CONSTRUCT(&cb, pmix_cb_t);
-                cb.proc = &pcs;
-                cb.scope = PMIX_REMOTE;
-                cb.copy = true;
-                PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
-                if (PMIX_SUCCESS == rc) {
-                    int key_idx;
-                    PMIX_LIST_FOREACH (kv, &cb.kvs, pmix_kval_t) {
-                        rc = pmix_argv_append_unique_idx(&key_idx, &kmap, kv->key);
-                        if (pmix_value_array_get_size(key_count_array) < (size_t)(key_idx + 1)) {
-                            size_t new_size;
-                            size_t old_size = pmix_value_array_get_size(key_count_array);
-
-                            pmix_value_array_set_size(key_count_array, key_idx + 1);
-                            new_size = pmix_value_array_get_size(key_count_array);
-                            key_count = PMIX_VALUE_ARRAY_GET_BASE(key_count_array, uint32_t);
-                            memset(key_count + old_size, 0,
-                                   sizeof(uint32_t) * (new_size - old_size));
-                        }
-                        key_count = PMIX_VALUE_ARRAY_GET_BASE(key_count_array, uint32_t);
-                        key_count[key_idx]++;
-                    }
-                }
-            }
-
-            key_count = PMIX_VALUE_ARRAY_GET_BASE(key_count_array, uint32_t);
-
-            for (i = 0; i < pmix_argv_count(kmap); i++) {
-                pmix_buffer_t tmp;
-                size_t kname_size;
-                size_t kidx_size;
-
-                PMIX_CONSTRUCT(&tmp, pmix_buffer_t);
-                PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &tmp, &kmap[i], 1, PMIX_STRING);
-                kname_size = tmp.bytes_used;
-                PMIX_DESTRUCT(&tmp);
-                PMIX_CONSTRUCT(&tmp, pmix_buffer_t);
-                PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &tmp, &i, 1, PMIX_UINT32);
-                kidx_size = tmp.bytes_used;
-                PMIX_DESTRUCT(&tmp);
-
-                /* calculate the key names sizes */
-                key_fmt_size[PMIX_MODEX_KEY_NATIVE_FMT] = kname_size * key_count[i];
-                key_fmt_size[PMIX_MODEX_KEY_KEYMAP_FMT] = kname_size + key_count[i] * kidx_size;
-            }
-            PMIX_RELEASE(key_count_array);
-
-            /* select the most efficient key-name pack format */
-            kmap_type = key_fmt_size[PMIX_MODEX_KEY_NATIVE_FMT]
-                                > key_fmt_size[PMIX_MODEX_KEY_KEYMAP_FMT]
-                            ? PMIX_MODEX_KEY_KEYMAP_FMT
-                            : PMIX_MODEX_KEY_NATIVE_FMT;
-            pmix_output_verbose(5, pmix_server_globals.fence_output, "key packing type %s",
-                                kmap_type == PMIX_MODEX_KEY_KEYMAP_FMT ? "kmap" : "native");
-        }
-        PMIX_CONSTRUCT(&rank_blobs, pmix_list_t);
         PMIX_LIST_FOREACH (scd, &trk->local_cbs, pmix_server_caddy_t) {
-            /* get any remote contribution - note that there
-             * may not be a contribution */
             pmix_strncpy(pcs.nspace, scd->peer->info->pname.nspace, PMIX_MAX_NSLEN);
             pcs.rank = scd->peer->info->pname.rank;
             PMIX_CONSTRUCT(&cb, pmix_cb_t);
             cb.proc = &pcs;
             cb.scope = PMIX_REMOTE;
-            cb.copy = true;
+            cb.copy = false;
             PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
-            if (PMIX_SUCCESS == rc) {
-                /* calculate the throughout rank */
-                rel_rank = 0;
-                found = false;
-                if (pmix_list_get_size(&trk->nslist) == 1) {
-                    found = true;
-                } else {
-                    PMIX_LIST_FOREACH (nm, &trk->nslist, pmix_nspace_caddy_t) {
-                        if (0 == strcmp(nm->ns->nspace, pcs.nspace)) {
-                            found = true;
-                            break;
-                        }
-                        rel_rank += nm->ns->nprocs;
-                    }
-                }
-                if (false == found) {
-                    rc = PMIX_ERR_NOT_FOUND;
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_DESTRUCT(&cb);
-                    PMIX_DESTRUCT(&rank_blobs);
-                    goto cleanup;
-                }
-                rel_rank += pcs.rank;
-
-                /* pack the relative rank */
-                pbkt = PMIX_NEW(pmix_buffer_t);
-                PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, pbkt, &rel_rank, 1, PMIX_PROC_RANK);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_DESTRUCT(&cb);
+                continue;
+            }
+            /* calculate the throughout rank */
+            rc = _rel_rank(trk, &pcs, &rel_rank);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                PMIX_DESTRUCT(&cb);
+                goto done;
+            }
+            PMIX_LIST_FOREACH (kv, &cb.kvs, pmix_kval_t) {
+                rc = _kmap_index(&dict, &kmap, kv->key, &key_idx, &added);
                 if (PMIX_SUCCESS != rc) {
                     PMIX_ERROR_LOG(rc);
                     PMIX_DESTRUCT(&cb);
-                    PMIX_DESTRUCT(&rank_blobs);
-                    PMIX_RELEASE(pbkt);
-                    goto cleanup;
+                    goto done;
                 }
-                /* pack the returned kval's */
-                PMIX_LIST_FOREACH (kv, &cb.kvs, pmix_kval_t) {
-                    rc = pmix_gds_base_modex_pack_kval(kmap_type, pbkt, &kmap, kv);
-                    if (rc != PMIX_SUCCESS) {
+                if (added) {
+                    rc = pmix_value_array_set_size(&kname_sizes, key_idx + 1);
+                    if (PMIX_SUCCESS != rc) {
                         PMIX_ERROR_LOG(rc);
                         PMIX_DESTRUCT(&cb);
-                        PMIX_DESTRUCT(&rank_blobs);
-                        PMIX_RELEASE(pbkt);
-                        goto cleanup;
+                        goto done;
                     }
+                    ksize = &PMIX_VALUE_ARRAY_GET_ITEM(&kname_sizes, size_t, key_idx);
+                    PMIX_CONSTRUCT(&tmp, pmix_buffer_t);
+                    PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &tmp, &kv->key, 1, PMIX_STRING);
+                    *ksize = tmp.bytes_used;
+                    PMIX_DESTRUCT(&tmp);
+                    key_fmt_size[PMIX_MODEX_KEY_KEYMAP_FMT] += *ksize;
+                } else {
+                    ksize = &PMIX_VALUE_ARRAY_GET_ITEM(&kname_sizes, size_t, key_idx);
                 }
-
-                /* add part of the process modex to the list */
-                blob = PMIX_NEW(rank_blob_t);
-                blob->buf = pbkt;
-                pmix_list_append(&rank_blobs, &blob->super);
-                pbkt = NULL;
+                key_fmt_size[PMIX_MODEX_KEY_NATIVE_FMT] += *ksize;
+                key_fmt_size[PMIX_MODEX_KEY_KEYMAP_FMT] += kidx_size;
+                vals_size += pmix_bfrops_base_packed_size(kv->value, 1, PMIX_VALUE);
             }
+            /* hold onto the data until we know how to pack it */
+            blob = PMIX_NEW(rank_blob_t);
+            blob->rel_rank = rel_rank;
+            pmix_list_join(&blob->kvs, pmix_list_get_end(&blob->kvs), &cb.kvs);
+            pmix_list_append(&rank_blobs, &blob->super);
+            ++nblobs;
             PMIX_DESTRUCT(&cb);
         }
+
+        /* select the most efficient key-name pack format */
+        kmap_type = key_fmt_size[PMIX_MODEX_KEY_NATIVE_FMT]
+                            > key_fmt_size[PMIX_MODEX_KEY_KEYMAP_FMT]
+                        ? PMIX_MODEX_KEY_KEYMAP_FMT
+                        : PMIX_MODEX_KEY_NATIVE_FMT;
+        pmix_output_verbose(5, pmix_server_globals.fence_output, "key packing type %s",
+                            kmap_type == PMIX_MODEX_KEY_KEYMAP_FMT ? "kmap" : "native");
+
         /* mark the collection type so we can check on the
          * receiving end that all participants did the same. Note
          * that if the receiving end thinks that the collect flag
@@ -786,8 +966,18 @@ static pmix_status_t _collect_data(pmix_server_trkr_t *trk, pmix_buffer_t *buf)
         if (PMIX_MODEX_KEY_KEYMAP_FMT == kmap_type) {
             blob_info_byte |= PMIX_GDS_KEYMAP_BIT;
         }
+        /* size the bucket for everything at once - on top of the keys
+         * and values, the header and the rank and length of each blob
+         * take no more than 16 bytes apiece */
+        rc = pmix_bfrops_base_reserve(&bucket, key_fmt_size[kmap_type] + vals_size
+                                                   + 16 * (nblobs + 1));
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            goto done;
+        }
         /* pack the modex blob info byte */
         PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &bucket, &blob_info_byte, 1, PMIX_BYTE);
+        hdr_size = bucket.bytes_used;
 
         if (PMIX_MODEX_KEY_KEYMAP_FMT == kmap_type) {
             /* pack node part of modex to `bucket` */
@@ -799,19 +989,59 @@ static pmix_status_t _collect_data(pmix_server_trkr_t *trk, pmix_buffer_t *buf)
                 PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &bucket, kmap, kmap_size, PMIX_STRING);
             }
         }
-        /* pack the collected blobs of processes */
+
+        /* pack the blob of each process into the bucket, reusing
+         * the same scratch buffer for all of them */
         PMIX_LIST_FOREACH (blob, &rank_blobs, rank_blob_t) {
-            /* extract the blob */
-            PMIX_UNLOAD_BUFFER(blob->buf, bo.bytes, bo.size);
-            /* pack the returned blob */
+            pbkt.pack_ptr = pbkt.base_ptr;
+            pbkt.unpack_ptr = pbkt.base_ptr;
+            pbkt.bytes_used = 0;
+            /* pack the relative rank */
+            PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &pbkt, &blob->rel_rank, 1, PMIX_PROC_RANK);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                goto done;
+            }
+            /* pack the returned kval's */
+            PMIX_LIST_FOREACH (kv, &blob->kvs, pmix_kval_t) {
+                if (PMIX_MODEX_KEY_KEYMAP_FMT == kmap_type) {
+                    rc = _kmap_index(&dict, &kmap, kv->key, &key_idx, &added);
+                    if (PMIX_SUCCESS == rc) {
+                        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &pbkt, &key_idx, 1, PMIX_UINT32);
+                    }
+                    if (PMIX_SUCCESS == rc) {
+                        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &pbkt, kv->value, 1, PMIX_VALUE);
+                    }
+                } else {
+                    PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &pbkt, kv, 1, PMIX_KVAL);
+                }
+                if (PMIX_SUCCESS != rc) {
+                    PMIX_ERROR_LOG(rc);
+                    goto done;
+                }
+            }
+            bo.bytes = pbkt.base_ptr;
+            bo.size = pbkt.bytes_used;
             PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &bucket, &bo, 1, PMIX_BYTE_OBJECT);
-            PMIX_BYTE_OBJECT_DESTRUCT(&bo); // releases the data
             if (PMIX_SUCCESS != rc) {
                 PMIX_ERROR_LOG(rc);
-                goto cleanup;
+                goto done;
             }
         }
-        PMIX_DESTRUCT(&rank_blobs);
+
+        rc = _compress_bucket(&bucket, hdr_size, blob_info_byte);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+        }
+
+    done:
+        PMIX_DESTRUCT(&pbkt);
+        PMIX_DESTRUCT(&kname_sizes);
+        PMIX_DESTRUCT(&dict);
+        PMIX_LIST_DESTRUCT(&rank_blobs);
+        if (PMIX_SUCCESS != rc) {
+            goto cleanup;
+        }
     } else {
         /* mark the collection type so we can check on the
          * receiving end that all participants did the same.
@@ -832,7 +1062,10 @@ static pmix_status_t _collect_data(pmix_server_trkr_t *trk, pmix_buffer_t *buf)
          * in chunks, we have to pack the bucket as a single
          * byte object to allow remote unpack */
         PMIX_UNLOAD_BUFFER(&bucket, bo.bytes, bo.size);
-        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, &bo, 1, PMIX_BYTE_OBJECT);
+        rc = pmix_bfrops_base_reserve(buf, pmix_bfrops_base_packed_size(&bo, 1, PMIX_BYTE_OBJECT));
+        if (PMIX_SUCCESS == rc) {
+            PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf, &bo, 1, PMIX_BYTE_OBJECT);
+        }
         PMIX_BYTE_OBJECT_DESTRUCT(&bo); // releases the data
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
@@ -845,13 +1078,120 @@ cleanup:
     return rc;
 }
 
+/* pack the data of a participant into the tracker's stream as
+ * it enters the fence. Each contribution is a complete bucket of
+ * its own, using the native key format as the key-map format
+ * needs to know all the keys up front - the receiving servers
+ * already accept any number of buckets from each server. A NULL
+ * proc packs an empty bucket so the receiving servers can check
+ * the collection type even if no local participant had data */
+static pmix_status_t _stream_data(pmix_server_trkr_t *trk, pmix_proc_t *proc)
+{
+    pmix_buffer_t bucket, pbkt;
+    pmix_byte_object_t bo;
+    pmix_gds_modex_blob_info_t blob_info_byte = PMIX_GDS_COLLECT_BIT;
+    pmix_rank_t rel_rank;
+    pmix_kval_t *kv;
+    pmix_status_t rc;
+    pmix_cb_t cb;
+
+    PMIX_CONSTRUCT(&cb, pmix_cb_t);
+    if (NULL != proc) {
+        cb.proc = proc;
+        cb.scope = PMIX_REMOTE;
+        cb.copy = false;
+        PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
+        if (PMIX_SUCCESS != rc) {
+            /* nothing to contribute */
+            PMIX_DESTRUCT(&cb);
+            return PMIX_SUCCESS;
+        }
+        rc = _rel_rank(trk, proc, &rel_rank);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_DESTRUCT(&cb);
+            return rc;
+        }
+    }
+    PMIX_CONSTRUCT(&bucket, pmix_buffer_t);
+    PMIX_CONSTRUCT(&pbkt, pmix_buffer_t);
+    PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &bucket, &blob_info_byte, 1, PMIX_BYTE);
+    if (PMIX_SUCCESS == rc && NULL != proc) {
+        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &pbkt, &rel_rank, 1, PMIX_PROC_RANK);
+        PMIX_LIST_FOREACH (kv, &cb.kvs, pmix_kval_t) {
+            if (PMIX_SUCCESS != rc) {
+                break;
+            }
+            PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &pbkt, kv, 1, PMIX_KVAL);
+        }
+        if (PMIX_SUCCESS == rc) {
+            bo.bytes = pbkt.base_ptr;
+            bo.size = pbkt.bytes_used;
+            PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &bucket, &bo, 1, PMIX_BYTE_OBJECT);
+        }
+    }
+    if (PMIX_SUCCESS == rc) {
+        bo.bytes = bucket.base_ptr;
+        bo.size = bucket.bytes_used;
+        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, trk->stream, &bo, 1, PMIX_BYTE_OBJECT);
+    }
+    PMIX_DESTRUCT(&pbkt);
+    PMIX_DESTRUCT(&bucket);
+    PMIX_DESTRUCT(&cb);
+    return rc;
+}
+
+/* pass what has been streamed so far up to the host */
+static void _stream_to_host(pmix_server_trkr_t *trk)
+{
+    char *data;
+    size_t sz;
+    pmix_status_t rc;
+
+    if (NULL == pmix_server_globals.fence_contrib || PMIX_BUFFER_IS_EMPTY(trk->stream)) {
+        return;
+    }
+    PMIX_UNLOAD_BUFFER(trk->stream, data, sz);
+    rc = pmix_server_globals.fence_contrib(trk->pcs, trk->npcs, trk->info, trk->ninfo, data,
+                                           sz, false, NULL, trk);
+    if (PMIX_SUCCESS == rc) {
+        trk->streamed = true;
+    } else {
+        /* hold it for the final call */
+        PMIX_LOAD_BUFFER(pmix_globals.mypeer, trk->stream, data, sz);
+    }
+}
+
+pmix_status_t pmix_server_fence_upcall(pmix_server_trkr_t *trk, char *data, size_t sz)
+{
+    pmix_status_t rc;
+
+    if (NULL != trk->stream) {
+        if (!trk->streamed && PMIX_BUFFER_IS_EMPTY(trk->stream)) {
+            rc = _stream_data(trk, NULL);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+            }
+        }
+        if (!PMIX_BUFFER_IS_EMPTY(trk->stream)) {
+            PMIX_UNLOAD_BUFFER(trk->stream, data, sz);
+        }
+    }
+    trk->host_called = true;
+    if (trk->streamed) {
+        return pmix_server_globals.fence_contrib(trk->pcs, trk->npcs, trk->info, trk->ninfo,
+                                                 data, sz, true, trk->modexcbfunc, trk);
+    }
+    return pmix_host_server.fence_nb(trk->pcs, trk->npcs, trk->info, trk->ninfo, data, sz,
+                                     trk->modexcbfunc, trk);
+}
+
 pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd, pmix_buffer_t *buf,
                                 pmix_modex_cbfunc_t modexcbfunc, pmix_op_cbfunc_t opcbfunc)
 {
     int32_t cnt;
     pmix_status_t rc;
     size_t nprocs;
-    pmix_proc_t *procs = NULL, *newprocs;
+    pmix_proc_t *procs = NULL, *newprocs, proc;
     bool collect_data = false;
     pmix_server_trkr_t *trk;
     char *data = NULL;
@@ -1007,6 +1347,13 @@ pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd, pmix_buffer_t *buf,
         } else {
             trk->collect_type = PMIX_COLLECT_NO;
         }
+        /* the data only has to be packed if it goes to the host,
+         * and we have to know all the participants to stream it */
+        if ((pmix_server_globals.fence_streaming || NULL != pmix_server_globals.fence_contrib)
+            && collect_data && trk->def_complete && !trk->local
+            && NULL != pmix_host_server.fence_nb) {
+            trk->stream = PMIX_NEW(pmix_buffer_t);
+        }
     } else {
         switch (trk->collect_type) {
         case PMIX_COLLECT_NO:
@@ -1045,6 +1392,18 @@ pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd, pmix_buffer_t *buf,
         PMIX_THREADSHIFT_DELAY(trk, fence_timeout, tv.tv_sec);
         trk->event_active = true;
     }
+    /* if we are streaming, this participant's data is all
+     * that has to be packed now */
+    if (NULL != trk->stream) {
+        PMIX_LOAD_PROCID(&proc, cd->peer->info->pname.nspace, cd->peer->info->pname.rank);
+        rc = _stream_data(trk, &proc);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+        }
+        if (pmix_list_get_size(&trk->local_cbs) < trk->nlocal) {
+            _stream_to_host(trk);
+        }
+    }
 
     /* if all local contributions have been received,
      * let the local host's server know that we are at the
@@ -1071,6 +1430,21 @@ pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd, pmix_buffer_t *buf,
              * but the client still requires a return from the callback in
              * that scenario, so we leave this caddy on the list of local cbs */
             rc = trk->info[trk->ninfo-1].value.data.status;
+            /* participants whose GDS keeps its own copy of the data
+             * can only see what was collected if we hand it to them */
+            if (PMIX_SUCCESS == rc && PMIX_COLLECT_YES == trk->collect_type
+                && _local_gds_needs_data(trk)) {
+                PMIX_CONSTRUCT(&bucket, pmix_buffer_t);
+                if (PMIX_SUCCESS == _collect_data(trk, &bucket)) {
+                    PMIX_UNLOAD_BUFFER(&bucket, data, sz);
+                }
+                PMIX_DESTRUCT(&bucket);
+                if (NULL != data) {
+                    trk->modexcbfunc(rc, data, sz, trk, _release_data, data);
+                    rc = PMIX_SUCCESS;
+                    goto cleanup;
+                }
+            }
             trk->modexcbfunc(rc, NULL, 0, trk, NULL, NULL);
             rc = PMIX_SUCCESS;  // ensure the switchyard doesn't release the caddy
             goto cleanup;
@@ -1102,7 +1476,10 @@ pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd, pmix_buffer_t *buf,
          * or global distribution */
 
         PMIX_CONSTRUCT(&bucket, pmix_buffer_t);
-        if (PMIX_SUCCESS != (rc = _collect_data(trk, &bucket))) {
+        if (NULL != trk->stream) {
+            /* everyone's data is already in the stream */
+            rc = PMIX_SUCCESS;
+        } else if (PMIX_SUCCESS != (rc = _collect_data(trk, &bucket))) {
             PMIX_ERROR_LOG(rc);
             PMIX_DESTRUCT(&bucket);
             /* clear the caddy from this tracker so it can be
@@ -1120,11 +1497,11 @@ pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd, pmix_buffer_t *buf,
             goto cleanup;
         }
         /* now unload the blob and pass it upstairs */
-        PMIX_UNLOAD_BUFFER(&bucket, data, sz);
+        if (!PMIX_BUFFER_IS_EMPTY(&bucket)) {
+            PMIX_UNLOAD_BUFFER(&bucket, data, sz);
+        }
         PMIX_DESTRUCT(&bucket);
-        trk->host_called = true;
-        rc = pmix_host_server.fence_nb(trk->pcs, trk->npcs, trk->info, trk->ninfo, data, sz,
-                                       trk->modexcbfunc, trk);
+        rc = pmix_server_fence_upcall(trk, data, sz);
         if (PMIX_SUCCESS != rc && PMIX_OPERATION_SUCCEEDED != rc) {
             /* clear the caddy from this tracker so it can be
              * released upon return - the switchyard will send an
@@ -3025,7 +3402,7 @@ pmix_status_t pmix_server_job_ctrl(pmix_peer_t *peer, pmix_buffer_t *buf, pmix_i
     int32_t cnt, m;
     pmix_status_t rc;
     pmix_query_caddy_t *cd;
-    pmix_namespace_t *nptr, *tmp;
+    pmix_namespace_t *nptr;
     pmix_peer_t *pr;
     pmix_proc_t proc;
     size_t n;
@@ -3075,13 +3452,7 @@ pmix_status_t pmix_server_job_ctrl(pmix_peer_t *peer, pmix_buffer_t *buf, pmix_i
     } else {
         for (n = 0; n < cd->ntargets; n++) {
             /* find the nspace of this proc */
-            nptr = NULL;
-            PMIX_LIST_FOREACH (tmp, &pmix_globals.nspaces, pmix_namespace_t) {
-                if (0 == strcmp(tmp->nspace, cd->targets[n].nspace)) {
-                    nptr = tmp;
-                    break;
-                }
-            }
+            nptr = pmix_nspace_lookup(cd->targets[n].nspace);
             if (NULL == nptr) {
                 nptr = PMIX_NEW(pmix_namespace_t);
                 if (NULL == nptr) {
@@ -3089,7 +3460,7 @@ pmix_status_t pmix_server_job_ctrl(pmix_peer_t *peer, pmix_buffer_t *buf, pmix_i
                     goto exit;
                 }
                 nptr->nspace = strdup(cd->targets[n].nspace);
-                pmix_list_append(&pmix_globals.nspaces, &nptr->super);
+                pmix_nspace_register(nptr);
             }
             /* if the rank is wildcard, then we use the epilog for the nspace */
             if (PMIX_RANK_WILDCARD == cd->targets[n].rank) {
@@ -3987,7 +4358,7 @@ static void _grpcbfunc(int sd, short args, void *cbdata)
     }
 
     /* remove the tracker from the list */
-    pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+    pmix_server_remove_tracker(trk);
     PMIX_RELEASE(trk);
 
     /* we are done */
@@ -4302,7 +4673,7 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd, pmix_buffer_t *b
         /* check if our host supports group operations */
         if (NULL == pmix_host_server.group) {
             /* remove the tracker from the list */
-            pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+            pmix_server_remove_tracker(trk);
             PMIX_RELEASE(trk);
             return PMIX_ERR_NOT_SUPPORTED;
         }
@@ -4318,7 +4689,7 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd, pmix_buffer_t *b
                     pmix_event_del(&trk->ev);
                 }
                 /* remove the tracker from the list */
-                pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+                pmix_server_remove_tracker(trk);
                 PMIX_RELEASE(trk);
                 PMIX_DESTRUCT(&bucket);
                 return rc;
@@ -4351,7 +4722,7 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd, pmix_buffer_t *b
                 return PMIX_SUCCESS;
             }
             /* remove the tracker from the list */
-            pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+            pmix_server_remove_tracker(trk);
             PMIX_RELEASE(trk);
             return rc;
         }
@@ -4499,7 +4870,7 @@ pmix_status_t pmix_server_grpdestruct(pmix_server_caddy_t *cd, pmix_buffer_t *bu
                 return PMIX_SUCCESS;
             }
             /* remove the tracker from the list */
-            pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+            pmix_server_remove_tracker(trk);
             PMIX_RELEASE(trk);
             return rc;
         }
@@ -4816,6 +5187,8 @@ static void tcon(pmix_server_trkr_t *t)
     t->pname.rank = PMIX_RANK_UNDEF;
     t->pcs = NULL;
     t->npcs = 0;
+    t->key = NULL;
+    t->keylen = 0;
     PMIX_CONSTRUCT(&t->nslist, pmix_list_t);
     PMIX_CONSTRUCT_LOCK(&t->lock);
     t->def_complete = false;
@@ -4826,6 +5199,8 @@ static void tcon(pmix_server_trkr_t *t)
     t->ninfo = 0;
     /* this needs to be set explicitly */
     t->collect_type = PMIX_COLLECT_INVALID;
+    t->stream = NULL;
+    t->streamed = false;
     t->modexcbfunc = NULL;
     t->op_cbfunc = NULL;
     t->hybrid = false;
@@ -4840,6 +5215,12 @@ static void tdes(pmix_server_trkr_t *t)
     if (NULL != t->pcs) {
         free(t->pcs);
     }
+    if (NULL != t->key) {
+        free(t->key);
+    }
+    if (NULL != t->stream) {
+        PMIX_RELEASE(t->stream);
+    }
     PMIX_LIST_DESTRUCT(&t->local_cbs);
     if (NULL != t->info) {
         PMIX_INFO_FREE(t->info, t->ninfo);
@@ -4877,7 +5258,7 @@ static void cddes(pmix_server_caddy_t *cd)
         PMIX_INFO_FREE(cd->info, cd->ninfo);
     }
 }
-PMIX_CLASS_INSTANCE(pmix_server_caddy_t, pmix_list_item_t, cdcon, cddes);
+PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_server_caddy_t, pmix_list_item_t, cdcon, cddes);
 
 static void scadcon(pmix_setup_caddy_t *p)
 {
@@ -4982,6 +5363,277 @@ static void lmdes(pmix_dmdx_local_t *p)
 }
 PMIX_CLASS_INSTANCE(pmix_dmdx_local_t, pmix_list_item_t, lmcon, lmdes);
 
+/* the requests on one proc */
+typedef struct {
+    pmix_object_t super;
+    pmix_rank_t rank;
+    pmix_list_t waiters;
+} dmdx_bucket_t;
+
+static void dbcon(dmdx_bucket_t *p)
+{
+    PMIX_CONSTRUCT(&p->waiters, pmix_list_t);
+}
+static void dbdes(dmdx_bucket_t *p)
+{
+    PMIX_LIST_DESTRUCT(&p->waiters);
+}
+static PMIX_CLASS_INSTANCE(dmdx_bucket_t, pmix_object_t, dbcon, dbdes);
+
+/* the buckets of one nspace. The ranks of a registered nspace are
+ * dense, so the buckets of ranks below its size are indexed directly
+ * by rank. Any other rank - wildcard, or one in an nspace we know
+ * nothing about - is hashed, as it comes straight off the wire and
+ * cannot be trusted to be small */
+typedef struct {
+    pmix_object_t super;
+    char nspace[PMIX_MAX_NSLEN + 1];
+    size_t nbuckets;
+    pmix_rank_t nranks;         // ranks below this are indexed directly
+    pmix_pointer_array_t ranks; // rank < nranks -> dmdx_bucket_t
+    pmix_hash_table_t others;   // any other rank -> dmdx_bucket_t
+} dmdx_nspace_t;
+
+static void dncon(dmdx_nspace_t *p)
+{
+    memset(p->nspace, 0, sizeof(p->nspace));
+    p->nbuckets = 0;
+    p->nranks = 0;
+    PMIX_CONSTRUCT(&p->ranks, pmix_pointer_array_t);
+    PMIX_CONSTRUCT(&p->others, pmix_hash_table_t);
+    pmix_hash_table_init(&p->others, 16);
+}
+static void dndes(dmdx_nspace_t *p)
+{
+    dmdx_bucket_t *bkt;
+    uint32_t rank;
+    int n;
+
+    for (n = 0; n < p->ranks.size; n++) {
+        bkt = (dmdx_bucket_t *) pmix_pointer_array_get_item(&p->ranks, n);
+        if (NULL != bkt) {
+            PMIX_RELEASE(bkt);
+        }
+    }
+    PMIX_DESTRUCT(&p->ranks);
+    PMIX_HASH_TABLE_FOREACH(rank, uint32, bkt, &p->others) {
+        PMIX_RELEASE(bkt);
+    }
+    PMIX_DESTRUCT(&p->others);
+}
+static PMIX_CLASS_INSTANCE(dmdx_nspace_t, pmix_object_t, dncon, dndes);
+
+static void dqcon(pmix_dmdx_queue_t *p)
+{
+    PMIX_CONSTRUCT(&p->nspaces, pmix_hash_table_t);
+    pmix_hash_table_init(&p->nspaces, 16);
+    p->size = 0;
+}
+static void dqdes(pmix_dmdx_queue_t *p)
+{
+    dmdx_nspace_t *ns;
+    void *key;
+
+    PMIX_HASH_TABLE_FOREACH_PTR(key, ns, &p->nspaces, {
+        PMIX_RELEASE(ns);
+    });
+    PMIX_DESTRUCT(&p->nspaces);
+}
+PMIX_CLASS_INSTANCE(pmix_dmdx_queue_t, pmix_object_t, dqcon, dqdes);
+
+static dmdx_nspace_t *dmdx_nspace(pmix_dmdx_queue_t *q, const char *nspace, bool create)
+{
+    dmdx_nspace_t *ns;
+    pmix_namespace_t *nptr;
+    size_t len = strnlen(nspace, PMIX_MAX_NSLEN);
+
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&q->nspaces, nspace, len, (void **) &ns)) {
+        return ns;
+    }
+    if (!create) {
+        return NULL;
+    }
+    ns = PMIX_NEW(dmdx_nspace_t);
+    if (NULL == ns) {
+        return NULL;
+    }
+    pmix_strncpy(ns->nspace, nspace, PMIX_MAX_NSLEN);
+    /* the direct index is bounded by the size of the job */
+    nptr = pmix_nspace_lookup(nspace);
+    if (NULL != nptr && 0 < nptr->nprocs && nptr->nprocs <= INT_MAX) {
+        ns->nranks = nptr->nprocs;
+        pmix_pointer_array_init(&ns->ranks, ns->nranks < 64 ? ns->nranks : 64, ns->nranks, 64);
+    }
+    if (PMIX_SUCCESS != pmix_hash_table_set_value_ptr(&q->nspaces, ns->nspace, len, ns)) {
+        PMIX_RELEASE(ns);
+        return NULL;
+    }
+    return ns;
+}
+
+static dmdx_bucket_t *dmdx_bucket(dmdx_nspace_t *ns, pmix_rank_t rank, bool create)
+{
+    dmdx_bucket_t *bkt = NULL;
+
+    if (rank < ns->nranks) {
+        if (rank < (pmix_rank_t) ns->ranks.size) {
+            bkt = (dmdx_bucket_t *) pmix_pointer_array_get_item(&ns->ranks, rank);
+        }
+    } else {
+        pmix_hash_table_get_value_uint32(&ns->others, rank, (void **) &bkt);
+    }
+    if (NULL != bkt || !create) {
+        return bkt;
+    }
+    bkt = PMIX_NEW(dmdx_bucket_t);
+    if (NULL == bkt) {
+        return NULL;
+    }
+    bkt->rank = rank;
+    if (rank < ns->nranks) {
+        if (PMIX_SUCCESS != pmix_pointer_array_set_item(&ns->ranks, rank, bkt)) {
+            PMIX_RELEASE(bkt);
+            return NULL;
+        }
+    } else if (PMIX_SUCCESS != pmix_hash_table_set_value_uint32(&ns->others, rank, bkt)) {
+        PMIX_RELEASE(bkt);
+        return NULL;
+    }
+    ns->nbuckets++;
+    return bkt;
+}
+
+static void dmdx_drop_nspace(pmix_dmdx_queue_t *q, dmdx_nspace_t *ns)
+{
+    pmix_hash_table_remove_value_ptr(&q->nspaces, ns->nspace, strlen(ns->nspace));
+    PMIX_RELEASE(ns);
+}
+
+/* drop a bucket once it is empty, and its nspace with it if
+ * that was the last bucket in it */
+static void dmdx_prune(pmix_dmdx_queue_t *q, dmdx_nspace_t *ns, dmdx_bucket_t *bkt)
+{
+    if (0 < pmix_list_get_size(&bkt->waiters)) {
+        return;
+    }
+    if (bkt->rank < ns->nranks) {
+        pmix_pointer_array_set_item(&ns->ranks, bkt->rank, NULL);
+    } else {
+        pmix_hash_table_remove_value_uint32(&ns->others, bkt->rank);
+    }
+    PMIX_RELEASE(bkt);
+    ns->nbuckets--;
+    if (0 == ns->nbuckets) {
+        dmdx_drop_nspace(q, ns);
+    }
+}
+
+pmix_status_t pmix_dmdx_queue_append(pmix_dmdx_queue_t *q, const pmix_proc_t *proc,
+                                     pmix_list_item_t *item)
+{
+    dmdx_nspace_t *ns;
+    dmdx_bucket_t *bkt;
+
+    ns = dmdx_nspace(q, proc->nspace, true);
+    if (NULL == ns) {
+        return PMIX_ERR_NOMEM;
+    }
+    bkt = dmdx_bucket(ns, proc->rank, true);
+    if (NULL == bkt) {
+        if (0 == ns->nbuckets) {
+            dmdx_drop_nspace(q, ns);
+        }
+        return PMIX_ERR_NOMEM;
+    }
+    pmix_list_append(&bkt->waiters, item);
+    q->size++;
+    return PMIX_SUCCESS;
+}
+
+pmix_list_item_t *pmix_dmdx_queue_first(pmix_dmdx_queue_t *q, const pmix_proc_t *proc)
+{
+    dmdx_nspace_t *ns;
+    dmdx_bucket_t *bkt;
+
+    ns = dmdx_nspace(q, proc->nspace, false);
+    if (NULL == ns) {
+        return NULL;
+    }
+    bkt = dmdx_bucket(ns, proc->rank, false);
+    if (NULL == bkt) {
+        return NULL;
+    }
+    return pmix_list_get_first(&bkt->waiters);
+}
+
+void pmix_dmdx_queue_remove(pmix_dmdx_queue_t *q, const pmix_proc_t *proc,
+                            pmix_list_item_t *item)
+{
+    dmdx_nspace_t *ns;
+    dmdx_bucket_t *bkt;
+    pmix_list_item_t *ptr;
+
+    ns = dmdx_nspace(q, proc->nspace, false);
+    if (NULL == ns) {
+        return;
+    }
+    bkt = dmdx_bucket(ns, proc->rank, false);
+    if (NULL == bkt) {
+        return;
+    }
+    PMIX_LIST_FOREACH (ptr, &bkt->waiters, pmix_list_item_t) {
+        if (ptr == item) {
+            pmix_list_remove_item(&bkt->waiters, item);
+            q->size--;
+            dmdx_prune(q, ns, bkt);
+            return;
+        }
+    }
+}
+
+void pmix_dmdx_queue_take(pmix_dmdx_queue_t *q, const pmix_proc_t *proc, pmix_list_t *out)
+{
+    dmdx_nspace_t *ns;
+    dmdx_bucket_t *bkt;
+
+    ns = dmdx_nspace(q, proc->nspace, false);
+    if (NULL == ns) {
+        return;
+    }
+    bkt = dmdx_bucket(ns, proc->rank, false);
+    if (NULL == bkt) {
+        return;
+    }
+    q->size -= pmix_list_get_size(&bkt->waiters);
+    pmix_list_join(out, pmix_list_get_end(out), &bkt->waiters);
+    dmdx_prune(q, ns, bkt);
+}
+
+void pmix_dmdx_queue_take_nspace(pmix_dmdx_queue_t *q, const char *nspace, pmix_list_t *out)
+{
+    dmdx_nspace_t *ns;
+    dmdx_bucket_t *bkt;
+    uint32_t rank;
+    int n;
+
+    ns = dmdx_nspace(q, nspace, false);
+    if (NULL == ns) {
+        return;
+    }
+    for (n = 0; n < ns->ranks.size; n++) {
+        bkt = (dmdx_bucket_t *) pmix_pointer_array_get_item(&ns->ranks, n);
+        if (NULL != bkt) {
+            q->size -= pmix_list_get_size(&bkt->waiters);
+            pmix_list_join(out, pmix_list_get_end(out), &bkt->waiters);
+        }
+    }
+    PMIX_HASH_TABLE_FOREACH(rank, uint32, bkt, &ns->others) {
+        q->size -= pmix_list_get_size(&bkt->waiters);
+        pmix_list_join(out, pmix_list_get_end(out), &bkt->waiters);
+    }
+    dmdx_drop_nspace(q, ns);
+}
+
 static void prevcon(pmix_peer_events_info_t *p)
 {
     p->peer = NULL;
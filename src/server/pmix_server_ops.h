@@ -25,6 +25,7 @@
 #include "src/include/pmix_types.h"
 
 #include "include/pmix_server.h"
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_hotel.h"
 #include "src/include/pmix_globals.h"
 #include "src/threads/pmix_threads.h"
@@ -127,6 +128,58 @@ typedef struct {
 } pmix_dmdx_request_t;
 PMIX_CLASS_DECLARATION(pmix_dmdx_request_t);
 
+/* Requests waiting for the data of a proc. The requests on each
+ * proc are kept in their own bucket, and the buckets are indexed
+ * by nspace and then by rank so the requests on a proc - or on
+ * all procs of an nspace - can be found without looking at any
+ * others. Requests for PMIX_RANK_WILDCARD have a bucket of their
+ * own. Only the ranks of a registered nspace are used as an array
+ * index, so a request for an arbitrary rank costs no more than
+ * one bucket. Releasing the queue releases all requests left on it */
+typedef struct {
+    pmix_object_t super;
+    pmix_hash_table_t nspaces; // nspace name -> bucket index for that nspace
+    size_t size;               // total number of requests
+} pmix_dmdx_queue_t;
+PMIX_CLASS_DECLARATION(pmix_dmdx_queue_t);
+
+#define PMIX_DMDX_QUEUE_STATIC_INIT                         \
+    {                                                       \
+        .super = PMIX_OBJ_STATIC_INIT(pmix_object_t),       \
+        .nspaces = PMIX_HASH_TABLE_STATIC_INIT,             \
+        .size = 0                                           \
+    }
+
+/* add a request to the end of the bucket for the given proc */
+PMIX_EXPORT pmix_status_t pmix_dmdx_queue_append(pmix_dmdx_queue_t *q, const pmix_proc_t *proc,
+                                                 pmix_list_item_t *item);
+
+/* return the oldest request on the given proc, or NULL if
+ * there is none. Only requests made for exactly that rank
+ * are considered */
+PMIX_EXPORT pmix_list_item_t *pmix_dmdx_queue_first(pmix_dmdx_queue_t *q,
+                                                    const pmix_proc_t *proc);
+
+/* remove a request from the bucket for the given proc - does
+ * nothing if the request isn't on it */
+PMIX_EXPORT void pmix_dmdx_queue_remove(pmix_dmdx_queue_t *q, const pmix_proc_t *proc,
+                                        pmix_list_item_t *item);
+
+/* move all requests on the given proc to the end of the
+ * provided list, in the order they were added */
+PMIX_EXPORT void pmix_dmdx_queue_take(pmix_dmdx_queue_t *q, const pmix_proc_t *proc,
+                                      pmix_list_t *out);
+
+/* move all requests on any proc of the given nspace to the
+ * end of the provided list */
+PMIX_EXPORT void pmix_dmdx_queue_take_nspace(pmix_dmdx_queue_t *q, const char *nspace,
+                                             pmix_list_t *out);
+
+/* remove a collective tracker from the list of active
+ * collectives so that it can no longer be found by any
+ * later participant */
+PMIX_EXPORT void pmix_server_remove_tracker(pmix_server_trkr_t *trk);
+
 /* event/error registration book keeping */
 typedef struct {
     pmix_list_item_t super;
@@ -182,9 +235,10 @@ typedef struct {
     pmix_list_t nspaces;          // list of pmix_nspace_t for the nspaces we know about
     pmix_pointer_array_t clients; // array of pmix_peer_t local clients
     pmix_list_t collectives;      // list of active pmix_server_trkr_t
-    pmix_list_t remote_pnd; // list of pmix_dmdx_remote_t awaiting arrival of data fror servicing
-                            // remote req's
-    pmix_list_t local_reqs;     // list of pmix_dmdx_local_t awaiting arrival of data from local neighbours
+    pmix_hash_table_t collectives_index; // active pmix_server_trkr_t by id or signature
+    pmix_dmdx_queue_t remote_pnd; // pmix_dmdx_remote_t awaiting arrival of data fror servicing
+                                  // remote req's
+    pmix_dmdx_queue_t local_reqs; // pmix_dmdx_local_t awaiting arrival of data from local neighbours
     pmix_list_t gdata;  // cache of data given to me for passing to all clients
     char **genvars;     // argv array of envars given to me for passing to all clients
     pmix_list_t events; // list of pmix_regevents_info_t registered events
@@ -197,6 +251,17 @@ typedef struct {
     char *tmpdir;             // temporary directory for this server
     char *system_tmpdir;      // system tmpdir
     bool fence_localonly_opt; // local-only fence optimization
+    bool fence_streaming;     // pack fence contributions as they arrive
+    pmix_server_fence_contrib_fn_t fence_contrib; // host function taking streamed contributions
+    size_t modex_compress_threshold; // fence data size at which it is compressed - 0 to disable
+    int modex_compress_level;        // compression level for fence data
+    size_t modex_compress_floor;     // fence data up to this size last failed to compress well
+    // built-in collective engine
+    char *coll_servers;         // comma-delimited host:port of each server in the group
+    int coll_rank;              // our position in the group
+    int coll_size;              // number of servers in the group
+    size_t coll_ring_threshold; // average contribution at which fences use a ring
+    int coll_tree_fanout;       // fanout of the barrier tree - 0 to size it by group
     // verbosity for server get operations
     int get_output;
     int get_verbose;
@@ -255,6 +320,12 @@ PMIX_EXPORT pmix_status_t pmix_server_abort(pmix_peer_t *peer, pmix_buffer_t *bu
 
 PMIX_EXPORT pmix_status_t pmix_server_commit(pmix_peer_t *peer, pmix_buffer_t *buf);
 
+/* pass a locally complete fence up to the host, along with the
+ * given data or, if it was streamed, whatever the host hasn't
+ * already been given */
+PMIX_EXPORT pmix_status_t pmix_server_fence_upcall(pmix_server_trkr_t *trk, char *data,
+                                                   size_t sz);
+
 PMIX_EXPORT pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd, pmix_buffer_t *buf,
                                             pmix_modex_cbfunc_t modexcbfunc,
                                             pmix_op_cbfunc_t opcbfunc);
@@ -262,6 +333,9 @@ PMIX_EXPORT pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd, pmix_buffer
 PMIX_EXPORT pmix_status_t pmix_server_get(pmix_buffer_t *buf, pmix_modex_cbfunc_t cbfunc,
                                           void *cbdata);
 
+PMIX_EXPORT pmix_status_t pmix_server_get_multi(pmix_buffer_t *buf, pmix_modex_cbfunc_t cbfunc,
+                                                void *cbdata);
+
 PMIX_EXPORT pmix_status_t pmix_server_publish(pmix_peer_t *peer, pmix_buffer_t *buf,
                                               pmix_op_cbfunc_t cbfunc, void *cbdata);
 
@@ -333,6 +407,29 @@ PMIX_EXPORT pmix_status_t pmix_server_event_recvd_from_client(pmix_peer_t *peer,
                                                               void *cbdata);
 PMIX_EXPORT void pmix_server_execute_collective(int sd, short args, void *cbdata);
 
+/* built-in collective engine - used in place of the host's
+ * fence_nb when the host doesn't provide one and we have been
+ * told the addresses of the other servers */
+PMIX_EXPORT pmix_status_t pmix_server_coll_init(void);
+PMIX_EXPORT void pmix_server_coll_finalize(void);
+/* returns true if the peer was one of our connections to
+ * another server in the group */
+PMIX_EXPORT bool pmix_server_coll_lost_peer(pmix_peer_t *peer);
+PMIX_EXPORT pmix_status_t pmix_server_coll_fence_nb(const pmix_proc_t procs[], size_t nprocs,
+                                                    const pmix_info_t info[], size_t ninfo,
+                                                    char *data, size_t ndata,
+                                                    pmix_modex_cbfunc_t cbfunc, void *cbdata);
+/* gather the data from the servers hosting the given procs -
+ * or from every server in the group if there are none - and
+ * return it, in server order, to the callback. Each of those
+ * servers must make the same sequence of calls for a given
+ * key, which always has the same procs. Must be called from
+ * the progress thread */
+PMIX_EXPORT pmix_status_t pmix_server_coll_allgather(const char *key, size_t keylen,
+                                                     const pmix_proc_t procs[], size_t nprocs,
+                                                     bool barrier, char *data, size_t ndata,
+                                                     pmix_modex_cbfunc_t cbfunc, void *cbdata);
+
 PMIX_EXPORT pmix_status_t pmix_server_initialize(void);
 
 PMIX_EXPORT void pmix_server_message_handler(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr,
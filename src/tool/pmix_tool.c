@@ -624,6 +624,9 @@ PMIX_EXPORT int PMIx_tool_init(pmix_proc_t *proc, pmix_info_t info[], size_t nin
 
     /* setup the globals */
     PMIX_CONSTRUCT(&pmix_client_globals.pending_requests, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_client_globals.putlog, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_client_globals.getcache, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_client_globals.getcache, 256);
     PMIX_CONSTRUCT(&pmix_client_globals.peers, pmix_pointer_array_t);
     pmix_pointer_array_init(&pmix_client_globals.peers, 1, INT_MAX, 1);
     pmix_client_globals.myserver = PMIX_NEW(pmix_peer_t);
@@ -1487,6 +1490,9 @@ PMIX_EXPORT pmix_status_t PMIx_tool_finalize(void)
 
     PMIX_RELEASE(pmix_client_globals.myserver);
     PMIX_LIST_DESTRUCT(&pmix_client_globals.pending_requests);
+    PMIX_LIST_DESTRUCT(&pmix_client_globals.putlog);
+    pmix_client_get_cache_invalidate();
+    PMIX_DESTRUCT(&pmix_client_globals.getcache);
     for (n = 0; n < pmix_client_globals.peers.size; n++) {
         if (NULL
             != (peer = (pmix_peer_t *) pmix_pointer_array_get_item(&pmix_client_globals.peers,
@@ -1508,8 +1514,9 @@ PMIX_EXPORT pmix_status_t PMIx_tool_finalize(void)
     (void) pmix_mca_base_framework_close(&pmix_pnet_base_framework);
     PMIX_DESTRUCT(&pmix_server_globals.clients);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.collectives);
-    PMIX_LIST_DESTRUCT(&pmix_server_globals.remote_pnd);
-    PMIX_LIST_DESTRUCT(&pmix_server_globals.local_reqs);
+    PMIX_DESTRUCT(&pmix_server_globals.collectives_index);
+    PMIX_DESTRUCT(&pmix_server_globals.remote_pnd);
+    PMIX_DESTRUCT(&pmix_server_globals.local_reqs);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.gdata);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.events);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.iof);
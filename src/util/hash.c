@@ -37,6 +37,15 @@
 
 #include "src/util/hash.h"
 
+/**
+ * Slot in the per-proc key index
+ */
+typedef struct {
+    uint32_t hash;
+    /* NULL if the slot is empty */
+    pmix_kval_t *kv;
+} pmix_keyslot_t;
+
 /**
  * Data for a particular pmix process
  * The name association is maintained in the
@@ -46,27 +55,35 @@ typedef struct {
     /** Structure can be put on lists (including in hash tables) */
     pmix_list_item_t super;
     /* List of pmix_kval_t structures containing all data
-       received from this process */
+       received from this process, in the order it was stored */
     pmix_list_t data;
+    /* open-addressing index into the list, keyed by key name.
+     * The number of slots is zero or a power of two */
+    pmix_keyslot_t *index;
+    size_t nslots;
 } pmix_proc_data_t;
 static void pdcon(pmix_proc_data_t *p)
 {
     PMIX_CONSTRUCT(&p->data, pmix_list_t);
+    p->index = NULL;
+    p->nslots = 0;
 }
 static void pddes(pmix_proc_data_t *p)
 {
     PMIX_LIST_DESTRUCT(&p->data);
+    free(p->index);
 }
 static PMIX_CLASS_INSTANCE(pmix_proc_data_t, pmix_list_item_t, pdcon, pddes);
 
-static pmix_kval_t *lookup_keyval(pmix_list_t *data, const char *key);
+static pmix_kval_t *lookup_keyval(pmix_proc_data_t *proc_data, const char *key);
+static pmix_status_t insert_keyval(pmix_proc_data_t *proc_data, pmix_kval_t *kv);
+static void remove_keyval(pmix_proc_data_t *proc_data, const char *key);
 static pmix_proc_data_t *lookup_proc(pmix_hash_table_t *jtable, uint64_t id, bool create);
 
 pmix_status_t pmix_hash_store(pmix_hash_table_t *table, pmix_rank_t rank, pmix_kval_t *kin)
 {
     pmix_proc_data_t *proc_data;
     uint64_t id;
-    pmix_kval_t *hv;
 
     pmix_output_verbose(10, pmix_globals.debug_output, "HASH:STORE rank %d key %s", rank,
                         (NULL == kin) ? "NULL KVAL" : kin->key);
@@ -83,18 +100,9 @@ pmix_status_t pmix_hash_store(pmix_hash_table_t *table, pmix_rank_t rank, pmix_k
         return PMIX_ERR_OUT_OF_RESOURCE;
     }
 
-    /* see if we already have this key-value */
-    hv = lookup_keyval(&proc_data->data, kin->key);
-    if (NULL != hv) {
-        /* yes we do - so remove the current value
-         * and replace it */
-        pmix_list_remove_item(&proc_data->data, &hv->super);
-        PMIX_RELEASE(hv);
-    }
-    PMIX_RETAIN(kin);
-    pmix_list_append(&proc_data->data, &kin->super);
-
-    return PMIX_SUCCESS;
+    /* if we already have this key-value, then
+     * the new value replaces it */
+    return insert_keyval(proc_data, kin);
 }
 
 pmix_status_t pmix_hash_fetch(pmix_hash_table_t *table, pmix_rank_t rank, const char *key,
@@ -176,7 +184,7 @@ pmix_status_t pmix_hash_fetch(pmix_hash_table_t *table, pmix_rank_t rank, const
             return PMIX_SUCCESS;
         } else {
             /* find the value from within this proc_data object */
-            hv = lookup_keyval(&proc_data->data, key);
+            hv = lookup_keyval(proc_data, key);
             if (NULL != hv) {
                 /* create the copy */
                 PMIX_BFROPS_COPY(rc, pmix_globals.mypeer, (void **) kvs, hv->value, PMIX_VALUE);
@@ -242,7 +250,7 @@ pmix_status_t pmix_hash_fetch_by_key(pmix_hash_table_t *table, const char *key,
     }
 
     /* find the value from within this proc_data object */
-    hv = lookup_keyval(&proc_data->data, key_r);
+    hv = lookup_keyval(proc_data, key_r);
     if (hv) {
         /* create the copy */
         PMIX_BFROPS_COPY(rc, pmix_globals.mypeer, (void **) kvs, hv->value, PMIX_VALUE);
@@ -280,13 +288,7 @@ pmix_status_t pmix_hash_remove_data(pmix_hash_table_t *table, pmix_rank_t rank,
                 if (NULL == key) {
                     PMIX_RELEASE(proc_data);
                 } else {
-                    PMIX_LIST_FOREACH (kv, &proc_data->data, pmix_kval_t) {
-                        if (0 == strcmp(key, kv->key)) {
-                            pmix_list_remove_item(&proc_data->data, &kv->super);
-                            PMIX_RELEASE(kv);
-                            break;
-                        }
-                    }
+                    remove_keyval(proc_data, key);
                 }
             }
             rc = pmix_hash_table_get_next_key_uint64(table, &id, (void **) &proc_data, node,
@@ -314,30 +316,137 @@ pmix_status_t pmix_hash_remove_data(pmix_hash_table_t *table, pmix_rank_t rank,
     }
 
     /* remove this item */
-    PMIX_LIST_FOREACH (kv, &proc_data->data, pmix_kval_t) {
-        if (0 == strcmp(key, kv->key)) {
-            pmix_list_remove_item(&proc_data->data, &kv->super);
-            PMIX_RELEASE(kv);
-            break;
+    remove_keyval(proc_data, key);
+
+    return PMIX_SUCCESS;
+}
+
+/**
+ * Find the index slot holding the given key or, if
+ * the key is not present, the empty slot where it
+ * belongs. The index must not be empty.
+ */
+static size_t find_slot(pmix_proc_data_t *proc_data, const char *key, uint32_t hash)
+{
+    size_t mask = proc_data->nslots - 1;
+    size_t n = hash & mask;
+    pmix_keyslot_t *slot;
+
+    /* the index is never more than half full, so
+     * this always ends */
+    for (;; n = (n + 1) & mask) {
+        slot = &proc_data->index[n];
+        if (NULL == slot->kv
+            || (slot->hash == hash && 0 == strcmp(key, slot->kv->key))) {
+            return n;
         }
     }
+}
 
+/**
+ * Double the size of the index (or create it)
+ */
+static pmix_status_t grow_index(pmix_proc_data_t *proc_data)
+{
+    pmix_keyslot_t *old = proc_data->index;
+    size_t nold = proc_data->nslots;
+    size_t n, m;
+
+    proc_data->nslots = (0 == nold) ? 16 : 2 * nold;
+    proc_data->index = (pmix_keyslot_t *) calloc(proc_data->nslots, sizeof(pmix_keyslot_t));
+    if (NULL == proc_data->index) {
+        proc_data->index = old;
+        proc_data->nslots = nold;
+        return PMIX_ERR_NOMEM;
+    }
+    for (n = 0; n < nold; n++) {
+        if (NULL != old[n].kv) {
+            m = find_slot(proc_data, old[n].kv->key, old[n].hash);
+            proc_data->index[m] = old[n];
+        }
+    }
+    free(old);
+    return PMIX_SUCCESS;
+}
+
+/**
+ * Find data for a given key in a given proc's data.
+ */
+static pmix_kval_t *lookup_keyval(pmix_proc_data_t *proc_data, const char *key)
+{
+    uint32_t hash;
+
+    if (0 == proc_data->nslots) {
+        return NULL;
+    }
+    PMIX_HASH_STR(key, hash);
+    return proc_data->index[find_slot(proc_data, key, hash)].kv;
+}
+
+/**
+ * Add data to a given proc's data, replacing
+ * any existing value for the same key.
+ */
+static pmix_status_t insert_keyval(pmix_proc_data_t *proc_data, pmix_kval_t *kv)
+{
+    pmix_keyslot_t *slot;
+    pmix_status_t rc;
+    uint32_t hash;
+
+    /* keep the index at most half full */
+    if (2 * (pmix_list_get_size(&proc_data->data) + 1) > proc_data->nslots) {
+        rc = grow_index(proc_data);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+    }
+    PMIX_HASH_STR(kv->key, hash);
+    slot = &proc_data->index[find_slot(proc_data, kv->key, hash)];
+    if (NULL != slot->kv) {
+        /* remove the current value and replace it */
+        pmix_list_remove_item(&proc_data->data, &slot->kv->super);
+        PMIX_RELEASE(slot->kv);
+    }
+    PMIX_RETAIN(kv);
+    pmix_list_append(&proc_data->data, &kv->super);
+    slot->hash = hash;
+    slot->kv = kv;
     return PMIX_SUCCESS;
 }
 
 /**
- * Find data for a given key in a given pmix_list_t.
+ * Remove data for a given key from a given proc's data.
  */
-static pmix_kval_t *lookup_keyval(pmix_list_t *data, const char *key)
+static void remove_keyval(pmix_proc_data_t *proc_data, const char *key)
 {
+    size_t mask, n, m, home;
     pmix_kval_t *kv;
+    uint32_t hash;
 
-    PMIX_LIST_FOREACH (kv, data, pmix_kval_t) {
-        if (0 == strcmp(key, kv->key)) {
-            return kv;
+    if (0 == proc_data->nslots) {
+        return;
+    }
+    PMIX_HASH_STR(key, hash);
+    n = find_slot(proc_data, key, hash);
+    kv = proc_data->index[n].kv;
+    if (NULL == kv) {
+        return;
+    }
+    mask = proc_data->nslots - 1;
+    pmix_list_remove_item(&proc_data->data, &kv->super);
+    PMIX_RELEASE(kv);
+    proc_data->index[n].kv = NULL;
+
+    /* shift back any entries that were displaced past
+     * the freed slot so that lookups never stop early */
+    for (m = (n + 1) & mask; NULL != proc_data->index[m].kv; m = (m + 1) & mask) {
+        home = proc_data->index[m].hash & mask;
+        if (((m - home) & mask) >= ((m - n) & mask)) {
+            proc_data->index[n] = proc_data->index[m];
+            proc_data->index[m].kv = NULL;
+            n = m;
         }
     }
-    return NULL;
 }
 
 /**
@@ -0,0 +1,249 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "src/include/pmix_config.h"
+
+#include "src/include/pmix_atomic.h"
+#include "src/include/pmix_hash_string.h"
+#include "src/include/pmix_prefetch.h"
+#include "src/include/pmix_stdint.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "src/common/pmix_attributes.h"
+#include "src/threads/pmix_mutex.h"
+
+#include "src/util/pmix_atom.h"
+
+typedef struct {
+    const char *string;
+    uint32_t hash;
+    uint32_t flags;
+} pmix_atom_entry_t;
+
+/* The entries are indexed by atom. The open-addressing
+ * index maps a key to its atom - each slot packs the key's
+ * hash (upper half) with its atom (lower half) */
+typedef struct {
+    pmix_atom_entry_t *entries;
+    uint32_t natoms;
+    size_t mask;
+    uint64_t *slots;
+} pmix_atom_table_t;
+
+static pmix_atom_table_t *volatile current = NULL;
+static pmix_mutex_t lock = PMIX_MUTEX_STATIC_INIT;
+
+/* keys with fixed atoms - must be in the same
+ * order as the enum in pmix_atom.h */
+static const char *fixed_keys[PMIX_ATOM_NUM_FIXED] = {NULL,
+                                                      PMIX_IMMEDIATE,
+                                                      PMIX_TIMEOUT,
+                                                      PMIX_GET_REFRESH_CACHE,
+                                                      PMIX_DATA_SCOPE,
+                                                      PMIX_EVENT_DO_NOT_CACHE,
+                                                      PMIX_GROUP_ID,
+                                                      PMIX_EVENT_NON_DEFAULT,
+                                                      PMIX_EVENT_CUSTOM_RANGE,
+                                                      PMIX_EVENT_AFFECTED_PROC,
+                                                      PMIX_EVENT_AFFECTED_PROCS};
+
+static const char *node_keys[] = {PMIX_HOSTNAME,
+                                  PMIX_HOSTNAME_ALIASES,
+                                  PMIX_NODEID,
+                                  PMIX_AVAIL_PHYS_MEMORY,
+                                  PMIX_LOCAL_PEERS,
+                                  PMIX_LOCAL_PROCS,
+                                  PMIX_LOCAL_CPUSETS,
+                                  PMIX_LOCAL_SIZE,
+                                  PMIX_NODE_SIZE,
+                                  PMIX_LOCALLDR,
+                                  PMIX_NODE_OVERSUBSCRIBED,
+                                  NULL};
+static const char *app_keys[] = {PMIX_APP_SIZE,  PMIX_APPLDR,       PMIX_APP_ARGV,      PMIX_WDIR,
+                                 PMIX_PSET_NAME, PMIX_APP_MAP_TYPE, PMIX_APP_MAP_REGEX, NULL};
+static const char *session_keys[] = {PMIX_SESSION_ID, PMIX_CLUSTER_ID,   PMIX_UNIV_SIZE,
+                                     PMIX_TMPDIR,     PMIX_TDIR_RMCLEAN, PMIX_HOSTNAME_KEEP_FQDN,
+                                     PMIX_RM_NAME,    PMIX_RM_VERSION,   NULL};
+
+static pmix_atom_t find(pmix_atom_table_t *tbl, const char *key, uint32_t hash)
+{
+    size_t n;
+    uint64_t v;
+    pmix_atom_t atom;
+
+    for (n = hash & tbl->mask;; n = (n + 1) & tbl->mask) {
+        v = tbl->slots[n];
+        if (0 == v) {
+            return PMIX_ATOM_INVALID;
+        }
+        if ((uint32_t)(v >> 32) == hash) {
+            atom = (pmix_atom_t) v;
+            if (0 == strcmp(tbl->entries[atom].string, key)) {
+                return atom;
+            }
+        }
+    }
+}
+
+/* the table must have room for the key */
+static void add(pmix_atom_table_t *tbl, const char *key, uint32_t flags)
+{
+    pmix_atom_entry_t *e;
+    pmix_atom_t atom;
+    uint32_t hash;
+    size_t n;
+
+    PMIX_HASH_STR(key, hash);
+    atom = find(tbl, key, hash);
+    if (PMIX_ATOM_INVALID != atom) {
+        tbl->entries[atom].flags |= flags;
+        return;
+    }
+    atom = ++tbl->natoms;
+    e = &tbl->entries[atom];
+    e->string = key;
+    e->hash = hash;
+    e->flags = flags;
+    for (n = hash & tbl->mask; 0 != tbl->slots[n]; n = (n + 1) & tbl->mask) {
+        continue;
+    }
+    tbl->slots[n] = ((uint64_t) hash << 32) | atom;
+}
+
+static size_t count(const char **keys)
+{
+    size_t n;
+
+    for (n = 0; NULL != keys[n]; n++) {
+        continue;
+    }
+    return n;
+}
+
+/* must be called with the lock held */
+static pmix_atom_table_t *seed(void)
+{
+    const pmix_regattr_input_t *dict;
+    pmix_atom_table_t *tbl;
+    size_t n, ndict, nentries, nslots;
+
+    dict = pmix_attributes_dictionary();
+    for (ndict = 0; '\0' != dict[ndict].name[0]; ndict++) {
+        continue;
+    }
+    nentries = PMIX_ATOM_NUM_FIXED + ndict + count(node_keys) + count(app_keys)
+               + count(session_keys);
+    /* keep the index at most half full */
+    for (nslots = 16; nslots < 2 * nentries; nslots *= 2) {
+        continue;
+    }
+
+    tbl = (pmix_atom_table_t *) malloc(sizeof(pmix_atom_table_t));
+    if (NULL == tbl) {
+        return NULL;
+    }
+    tbl->entries = (pmix_atom_entry_t *) calloc(nentries, sizeof(pmix_atom_entry_t));
+    tbl->slots = (uint64_t *) calloc(nslots, sizeof(uint64_t));
+    if (NULL == tbl->entries || NULL == tbl->slots) {
+        free(tbl->entries);
+        free(tbl->slots);
+        free(tbl);
+        return NULL;
+    }
+    tbl->natoms = 0;
+    tbl->mask = nslots - 1;
+
+    for (n = 1; n < PMIX_ATOM_NUM_FIXED; n++) {
+        add(tbl, fixed_keys[n], 0);
+    }
+    for (n = 0; n < ndict; n++) {
+        add(tbl, dict[n].string, 0);
+    }
+    for (n = 0; NULL != node_keys[n]; n++) {
+        add(tbl, node_keys[n], PMIX_ATOM_NODE_INFO);
+    }
+    for (n = 0; NULL != app_keys[n]; n++) {
+        add(tbl, app_keys[n], PMIX_ATOM_APP_INFO);
+    }
+    for (n = 0; NULL != session_keys[n]; n++) {
+        add(tbl, session_keys[n], PMIX_ATOM_SESSION_INFO);
+    }
+
+    /* the table must be complete before anyone uses it */
+    pmix_atomic_wmb();
+    current = tbl;
+    return tbl;
+}
+
+static inline pmix_atom_table_t *get_table(void)
+{
+    pmix_atom_table_t *tbl = current;
+
+    if (PMIX_UNLIKELY(NULL == tbl)) {
+        pmix_mutex_lock(&lock);
+        tbl = current;
+        if (NULL == tbl) {
+            tbl = seed();
+        }
+        pmix_mutex_unlock(&lock);
+    }
+    /* make sure we see everything the table holds */
+    pmix_atomic_rmb();
+    return tbl;
+}
+
+pmix_atom_t pmix_atom_lookup(const char *key)
+{
+    pmix_atom_table_t *tbl;
+    uint32_t hash;
+
+    if (NULL == key || NULL == (tbl = get_table())) {
+        return PMIX_ATOM_INVALID;
+    }
+    PMIX_HASH_STR(key, hash);
+    return find(tbl, key, hash);
+}
+
+const char *pmix_atom_string(pmix_atom_t atom)
+{
+    pmix_atom_table_t *tbl;
+
+    if (PMIX_ATOM_INVALID == atom || NULL == (tbl = get_table()) || tbl->natoms < atom) {
+        return NULL;
+    }
+    return tbl->entries[atom].string;
+}
+
+uint32_t pmix_atom_key_flags(const char *key)
+{
+    pmix_atom_t atom = pmix_atom_lookup(key);
+
+    if (PMIX_ATOM_INVALID == atom) {
+        return 0;
+    }
+    return current->entries[atom].flags;
+}
+
+void pmix_atom_finalize(void)
+{
+    pmix_atom_table_t *tbl;
+
+    pmix_mutex_lock(&lock);
+    tbl = current;
+    current = NULL;
+    pmix_mutex_unlock(&lock);
+    if (NULL != tbl) {
+        free(tbl->entries);
+        free(tbl->slots);
+        free(tbl);
+    }
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/**
+ * @file
+ *
+ * Process-wide table of well-known PMIx keys. Each key in the
+ * standard dictionary maps to a small integer "atom" that can be
+ * compared and switched on in place of the string. Keys that are
+ * not in the dictionary (e.g., those a user passes to PMIx_Put)
+ * have no atom.
+ *
+ * The table is built on first use and never changes after that,
+ * so lookups never take a lock. It is released by
+ * pmix_atom_finalize(), after which all atoms are invalid.
+ */
+
+#ifndef PMIX_UTIL_ATOM_H
+#define PMIX_UTIL_ATOM_H
+
+#include "src/include/pmix_config.h"
+#include "include/pmix_common.h"
+
+BEGIN_C_DECLS
+
+typedef uint32_t pmix_atom_t;
+
+/* atoms with fixed values, for keys that are checked on
+ * hot paths. Any other dictionary key gets an atom above
+ * PMIX_ATOM_NUM_FIXED */
+enum {
+    /* no key maps to this atom */
+    PMIX_ATOM_INVALID = 0,
+    PMIX_ATOM_KEY_IMMEDIATE,
+    PMIX_ATOM_KEY_TIMEOUT,
+    PMIX_ATOM_KEY_GET_REFRESH_CACHE,
+    PMIX_ATOM_KEY_DATA_SCOPE,
+    PMIX_ATOM_KEY_EVENT_DO_NOT_CACHE,
+    PMIX_ATOM_KEY_GROUP_ID,
+    PMIX_ATOM_KEY_EVENT_NON_DEFAULT,
+    PMIX_ATOM_KEY_EVENT_CUSTOM_RANGE,
+    PMIX_ATOM_KEY_EVENT_AFFECTED_PROC,
+    PMIX_ATOM_KEY_EVENT_AFFECTED_PROCS,
+    PMIX_ATOM_NUM_FIXED
+};
+
+/* classes of well-known keys */
+#define PMIX_ATOM_NODE_INFO    0x01
+#define PMIX_ATOM_APP_INFO     0x02
+#define PMIX_ATOM_SESSION_INFO 0x04
+
+/* return the atom for the given key, or PMIX_ATOM_INVALID
+ * if the key is not a well-known one */
+PMIX_EXPORT pmix_atom_t pmix_atom_lookup(const char *key);
+
+/* return the key for the given atom, or NULL if the
+ * atom is not valid */
+PMIX_EXPORT const char *pmix_atom_string(pmix_atom_t atom);
+
+/* return the classes (PMIX_ATOM_NODE_INFO etc.) the
+ * given key belongs to */
+PMIX_EXPORT uint32_t pmix_atom_key_flags(const char *key);
+
+/* release the table. Must not be called while
+ * other threads may be looking up keys */
+PMIX_EXPORT void pmix_atom_finalize(void);
+
+END_C_DECLS
+
+#endif /* PMIX_UTIL_ATOM_H */
@@ -42,14 +42,20 @@ shmem_construct(
     s->size = 0;
     s->base_address = 0;
     memset(s->backing_path, 0, PMIX_PATH_MAX);
+    s->owner = false;
 }
 
 static void
 shmem_destruct(
     pmix_shmem_t *t
 ) {
-    (void)pmix_shmem_segment_detach(t);
-    (void)pmix_shmem_segment_unlink(t);
+    if (NULL != t->base_address) {
+        (void)pmix_shmem_segment_detach(t);
+    }
+    // Only the creator removes the backing store.
+    if (t->owner) {
+        (void)pmix_shmem_segment_unlink(t);
+    }
 }
 
 PMIX_EXPORT PMIX_CLASS_INSTANCE(
@@ -79,6 +85,7 @@ pmix_shmem_segment_create(
         goto out;
     }
     shmem->size = size;
+    shmem->owner = true;
     pmix_string_copy(shmem->backing_path, backing_path, PMIX_PATH_MAX);
 out:
     (void)close(fd);
@@ -92,28 +99,45 @@ pmix_status_t
 pmix_shmem_segment_attach(
     pmix_shmem_t *shmem,
     void *requested_base_address,
+    pmix_shmem_flags_t flags,
     uintptr_t *actual_base_address
 ) {
     pmix_status_t rc = PMIX_SUCCESS;
+    const bool rdonly = (PMIX_SHMEM_RDONLY == flags);
+    void *addr = MAP_FAILED;
 
-    int fd = open(shmem->backing_path, O_RDWR);
+    int fd = open(shmem->backing_path, rdonly ? O_RDONLY : O_RDWR);
     if (fd < 0) {
         rc = PMIX_ERR_FILE_OPEN_FAILURE;
         goto out;
     }
+    // Size not known to us, so get it from the backing store.
+    if (0 == shmem->size) {
+        struct stat sbuf;
+        if (0 != fstat(fd, &sbuf) || 0 == sbuf.st_size) {
+            rc = PMIX_ERR_FILE_READ_FAILURE;
+            goto out;
+        }
+        shmem->size = (size_t)sbuf.st_size;
+    }
 
-    shmem->base_address = mmap(
+    addr = mmap(
         requested_base_address, shmem->size,
-        PROT_READ | PROT_WRITE, MAP_SHARED,
+        rdonly ? PROT_READ : (PROT_READ | PROT_WRITE), MAP_SHARED,
         fd, 0
     );
-    if (MAP_FAILED == shmem->base_address) {
+    if (MAP_FAILED == addr) {
         rc = PMIX_ERR_NOMEM;
+        goto out;
     }
+    shmem->base_address = addr;
     *actual_base_address = (uintptr_t)shmem->base_address;
 out:
-    if (PMIX_SUCCESS != rc) {
+    // The mapping remains valid after the descriptor is closed.
+    if (0 <= fd) {
         (void)close(fd);
+    }
+    if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
     }
     return rc;
@@ -126,6 +150,7 @@ pmix_shmem_segment_detach(
     if (0 != munmap(shmem->base_address, shmem->size)) {
         return PMIX_ERROR;
     }
+    shmem->base_address = NULL;
     return PMIX_SUCCESS;
 }
 
@@ -16,12 +16,15 @@
 #include "src/class/pmix_object.h"
 
 typedef struct pmix_shmem_t {
+    pmix_object_t super;
     /* Size of shared-memory segment. */
     size_t size;
     /* Base address of shared memory segment. */
     void *base_address;
     /* Buffer holding path to backing store. */
     char backing_path[PMIX_PATH_MAX];
+    /* Whether we created (and therefore own) the backing store. */
+    bool owner;
 } pmix_shmem_t;
 PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_shmem_t);
 
@@ -32,10 +35,22 @@ pmix_shmem_segment_create(
     const char *backing_path
 );
 
+typedef enum {
+    /* Map the segment readable and writable. */
+    PMIX_SHMEM_RDWR = 0,
+    /* Map the segment read-only. */
+    PMIX_SHMEM_RDONLY = 1
+} pmix_shmem_flags_t;
+
+/**
+ * Attaches to the segment backed by shmem->backing_path. If shmem->size is
+ * zero, then the size of the segment is taken from its backing store.
+ */
 PMIX_EXPORT pmix_status_t
 pmix_shmem_segment_attach(
     pmix_shmem_t *shmem,
     void *requested_base_address,
+    pmix_shmem_flags_t flags,
     uintptr_t *actual_base_address
 );
 
@@ -134,6 +134,32 @@ pmix_status_t fencenb_fn(const pmix_proc_t procs[], size_t nprocs, const pmix_in
     return server_fence_contrib(data, ndata, cbfunc, cbdata);
 }
 
+pmix_status_t fencecontrib_fn(const pmix_proc_t procs[], size_t nprocs, const pmix_info_t info[],
+                             size_t ninfo, char *data, size_t ndata, bool complete,
+                             pmix_modex_cbfunc_t cbfunc, void *cbdata)
+{
+    int rc;
+
+    PMIX_HIDE_UNUSED_PARAMS(procs, nprocs, info, ninfo);
+
+    if (!complete) {
+        TEST_VERBOSE(("Partial data for %s:%d", procs[0].nspace, procs[0].rank));
+        rc = server_fence_partial(data, ndata);
+        free(data);
+        return rc;
+    }
+    if (NULL == cbfunc) {
+        /* the fence failed locally - the partials we passed on
+         * will be dropped with the rest of this fence */
+        TEST_VERBOSE(("Fence abandoned for %s:%d", procs[0].nspace, procs[0].rank));
+        return PMIX_SUCCESS;
+    }
+    TEST_VERBOSE(("Getting final data for %s:%d", procs[0].nspace, procs[0].rank));
+    /* the partials went to the same place, so this
+     * has to go there even if we are the only server */
+    return server_fence_contrib(data, ndata, cbfunc, cbdata);
+}
+
 pmix_status_t dmodex_fn(const pmix_proc_t *proc, const pmix_info_t info[], size_t ninfo,
                         pmix_modex_cbfunc_t cbfunc, void *cbdata)
 {
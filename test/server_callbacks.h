@@ -25,6 +25,9 @@ pmix_status_t abort_fn(const pmix_proc_t *proc, void *server_object, int status,
 pmix_status_t fencenb_fn(const pmix_proc_t procs[], size_t nprocs, const pmix_info_t info[],
                          size_t ninfo, char *data, size_t ndata, pmix_modex_cbfunc_t cbfunc,
                          void *cbdata);
+pmix_status_t fencecontrib_fn(const pmix_proc_t procs[], size_t nprocs, const pmix_info_t info[],
+                             size_t ninfo, char *data, size_t ndata, bool complete,
+                             pmix_modex_cbfunc_t cbfunc, void *cbdata);
 pmix_status_t dmodex_fn(const pmix_proc_t *proc, const pmix_info_t info[], size_t ninfo,
                         pmix_modex_cbfunc_t cbfunc, void *cbdata);
 pmix_status_t publish_fn(const pmix_proc_t *proc, const pmix_info_t info[], size_t ninfo,
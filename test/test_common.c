@@ -94,6 +94,8 @@ void parse_cmd(int argc, char **argv, test_params *params)
                     "\t--test-internal N  test store internal key, N - number of internal keys\n");
             fprintf(stderr, "\t--gds <external gds name>           set GDS module \"--gds "
                             "hash|ds12\", default is hash\n");
+            fprintf(stderr, "\t--fence-contrib     servers stream the fence contributions of "
+                            "their clients as they arrive - fails if no data was streamed.\n");
             exit(0);
         } else if (0 == strcmp(argv[i], "--exec") || 0 == strcmp(argv[i], "-e")) {
             i++;
@@ -217,6 +219,8 @@ void parse_cmd(int argc, char **argv, test_params *params)
         } else if (0 == strcmp(argv[i], "--gds")) {
             i++;
             params->gds_mode = strdup(argv[i]);
+        } else if (0 == strcmp(argv[i], "--fence-contrib")) {
+            params->fence_contrib = 1;
         }
 
         else {
@@ -143,6 +143,7 @@ typedef struct {
     int test_internal;
     char *gds_mode;
     int nservers;
+    int fence_contrib;
     uint32_t lsize;
 } test_params;
 
@@ -177,6 +178,7 @@ typedef struct {
         params.test_internal = 0;              \
         params.gds_mode = NULL;                \
         params.nservers = 1;                   \
+        params.fence_contrib = 0;              \
         params.lsize = 0;                      \
     } while (0)
 
@@ -36,6 +36,8 @@ int my_server_id = 0;
 server_info_t *my_server_info = NULL;
 pmix_list_t *server_list = NULL;
 pmix_list_t *server_nspace = NULL;
+/* number of partial fence contributions passed on */
+static int fence_partials = 0;
 
 static void sdes(server_info_t *s)
 {
@@ -619,6 +621,16 @@ static void server_read_cb(int fd, short event, void *arg)
             contrib_cnt = 0;
         }
         break;
+    case CMD_FENCE_PARTIAL:
+        /* part of a server's contribution - the rest
+         * comes with its CMD_FENCE_CONTRIB */
+        if (msg_hdr.size > 0) {
+            fence_buf = (char *) realloc((void *) fence_buf, fence_buf_offset + msg_hdr.size);
+            memcpy(fence_buf + fence_buf_offset, msg_buf, msg_hdr.size);
+            fence_buf_offset += msg_hdr.size;
+        }
+        TEST_VERBOSE(("CMD_FENCE_PARTIAL from %d size %d", msg_hdr.src_id, msg_hdr.size));
+        break;
     case CMD_FENCE_COMPLETE:
         TEST_VERBOSE(("%d: CMD_FENCE_COMPLETE size %d", my_server_id, msg_hdr.size));
         server->modex_cbfunc(PMIX_SUCCESS, msg_buf, msg_hdr.size, server->cbdata, _libpmix_cb,
@@ -674,6 +686,23 @@ int server_fence_contrib(char *data, size_t ndata, pmix_modex_cbfunc_t cbfunc, v
     return rc;
 }
 
+int server_fence_partial(char *data, size_t ndata)
+{
+    msg_hdr_t msg_hdr;
+
+    fence_partials++;
+
+    msg_hdr.cmd = CMD_FENCE_PARTIAL;
+    msg_hdr.dst_id = 0;
+    msg_hdr.src_id = my_server_id;
+    msg_hdr.size = ndata;
+
+    if (PMIX_SUCCESS != server_send_msg(&msg_hdr, data, ndata)) {
+        return PMIX_ERROR;
+    }
+    return PMIX_SUCCESS;
+}
+
 static int server_pack_dmdx(int sender_id, const char *nspace, int rank, char **buf)
 {
     size_t buf_size = sizeof(int) + PMIX_MAX_NSLEN + 1 + sizeof(int);
@@ -838,7 +867,8 @@ done:
 
 int server_init(test_params *params)
 {
-    pmix_info_t info[2];
+    pmix_info_t info[3];
+    size_t ninfo = 2;
     int rc = PMIX_SUCCESS;
 
     /* fork/init servers procs */
@@ -919,10 +949,14 @@ int server_init(test_params *params)
     uint32_t u32 = 0666;
     PMIX_INFO_LOAD(&info[0], PMIX_SOCKET_MODE, &u32, PMIX_UINT32);
     PMIX_INFO_LOAD(&info[1], PMIX_HOSTNAME, my_server_info->hostname, PMIX_STRING);
+    if (params->fence_contrib) {
+        PMIX_INFO_LOAD(&info[2], PMIX_SERVER_FENCE_CONTRIB, fencecontrib_fn, PMIX_POINTER);
+        ninfo++;
+    }
 
     server_nspace = PMIX_NEW(pmix_list_t);
 
-    if (PMIX_SUCCESS != (rc = PMIx_server_init(&mymodule, info, 2))) {
+    if (PMIX_SUCCESS != (rc = PMIx_server_init(&mymodule, info, ninfo))) {
         TEST_ERROR(("Init failed with error %d", rc));
         goto error;
     }
@@ -961,6 +995,13 @@ int server_finalize(test_params *params, int local_fail)
     int rc = PMIX_SUCCESS;
     int total_ret = local_fail;
 
+    /* a fence that collects data streams the contributions of
+     * all but the last of our clients to arrive */
+    if (params->fence_contrib && 1 < params->lsize && 0 == fence_partials) {
+        TEST_ERROR(("%d: no fence contributions were streamed", my_server_id));
+        total_ret++;
+    }
+
     if (0 != (rc = server_barrier())) {
         total_ret++;
         goto exit;
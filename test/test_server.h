@@ -23,7 +23,8 @@ typedef enum {
     CMD_FENCE_CONTRIB,
     CMD_FENCE_COMPLETE,
     CMD_DMDX_REQUEST,
-    CMD_DMDX_RESPONSE
+    CMD_DMDX_RESPONSE,
+    CMD_FENCE_PARTIAL
 } server_cmd_t;
 
 typedef struct {
@@ -67,6 +68,7 @@ int server_init(test_params *params);
 int server_finalize(test_params *params, int local_fail);
 int server_barrier(void);
 int server_fence_contrib(char *data, size_t ndata, pmix_modex_cbfunc_t cbfunc, void *cbdata);
+int server_fence_partial(char *data, size_t ndata);
 int server_dmdx_get(const char *nspace, int rank, pmix_modex_cbfunc_t cbfunc, void *cbdata);
 int server_launch_clients(int local_size, int univ_size, int base_rank, test_params *params,
                           char ***client_env, char ***base_argv);
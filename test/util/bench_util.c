@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "bench_util.h"
+#include "include/pmix.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "src/util/pmix_argv.h"
+#include "src/util/pmix_environ.h"
+
+double bench_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+}
+
+void bench_opcbfunc(pmix_status_t status, void *cbdata)
+{
+    volatile int *active = (volatile int *) cbdata;
+
+    (void) status;
+    *active = 0;
+}
+
+void bench_wait_for(volatile int *active)
+{
+    struct timespec ts = {0, 100000};
+
+    while (*active) {
+        nanosleep(&ts, NULL);
+    }
+}
+
+int bench_server_init(pmix_server_module_t *module)
+{
+    static pmix_server_module_t empty;
+    pmix_status_t rc;
+
+    if (NULL == module) {
+        memset(&empty, 0, sizeof(empty));
+        module = &empty;
+    }
+    rc = PMIx_server_init(module, NULL, 0);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "PMIx_server_init failed: %s\n", PMIx_Error_string(rc));
+        return 1;
+    }
+    return 0;
+}
+
+int bench_register_job(const char *nspace, int nprocs, uid_t uid, gid_t gid)
+{
+    pmix_info_t info;
+    pmix_proc_t proc;
+    pmix_status_t rc;
+    volatile int active;
+    uint32_t u32;
+    int n;
+
+    u32 = nprocs;
+    PMIX_INFO_LOAD(&info, PMIX_JOB_SIZE, &u32, PMIX_UINT32);
+    active = 1;
+    rc = PMIx_server_register_nspace(nspace, nprocs, &info, 1, bench_opcbfunc, (void *) &active);
+    PMIX_INFO_DESTRUCT(&info);
+    if (PMIX_SUCCESS == rc) {
+        bench_wait_for(&active);
+    } else if (PMIX_OPERATION_SUCCEEDED != rc) {
+        fprintf(stderr, "PMIx_server_register_nspace failed: %s\n", PMIx_Error_string(rc));
+        return 1;
+    }
+    for (n = 0; n < nprocs; n++) {
+        PMIX_LOAD_PROCID(&proc, nspace, n);
+        active = 1;
+        rc = PMIx_server_register_client(&proc, uid, gid, NULL, bench_opcbfunc,
+                                         (void *) &active);
+        if (PMIX_SUCCESS == rc) {
+            bench_wait_for(&active);
+        } else if (PMIX_OPERATION_SUCCEEDED != rc) {
+            fprintf(stderr, "PMIx_server_register_client failed: %s\n", PMIx_Error_string(rc));
+            return 1;
+        }
+    }
+    return 0;
+}
+
+pid_t bench_spawn(const pmix_proc_t *proc, char **argv)
+{
+    pmix_status_t rc;
+    char **env;
+    pid_t pid;
+
+    env = pmix_argv_copy(environ);
+    rc = PMIx_server_setup_fork(proc, &env);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "PMIx_server_setup_fork failed: %s\n", PMIx_Error_string(rc));
+        pmix_argv_free(env);
+        return -1;
+    }
+    fflush(stdout);
+    pid = fork();
+    if (0 == pid) {
+        execve(argv[0], argv, env);
+        exit(1);
+    }
+    pmix_argv_free(env);
+    return pid;
+}
+
+int bench_reap(const char *nspace, pid_t *pids, int nprocs)
+{
+    pmix_proc_t proc;
+    volatile int active;
+    int n, status, ret = 0;
+
+    for (n = 0; n < nprocs; n++) {
+        if (pids[n] < 0 || pids[n] != waitpid(pids[n], &status, 0) || !WIFEXITED(status)
+            || 0 != WEXITSTATUS(status)) {
+            ret = 1;
+        }
+        PMIX_LOAD_PROCID(&proc, nspace, n);
+        active = 1;
+        PMIx_server_deregister_client(&proc, bench_opcbfunc, (void *) &active);
+        bench_wait_for(&active);
+    }
+    active = 1;
+    PMIx_server_deregister_nspace(nspace, bench_opcbfunc, (void *) &active);
+    bench_wait_for(&active);
+    return ret;
+}
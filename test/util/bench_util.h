@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Helpers shared by the benchmarks in this directory.
+ */
+
+#ifndef PMIX_TEST_BENCH_UTIL_H
+#define PMIX_TEST_BENCH_UTIL_H
+
+#include "src/include/pmix_config.h"
+#include "include/pmix_server.h"
+
+#include <sys/types.h>
+
+/* the monotonic clock in nanoseconds */
+double bench_now(void);
+
+/* completion callback that clears the int cbdata points to */
+void bench_opcbfunc(pmix_status_t status, void *cbdata);
+
+/* sleep until *active has been cleared */
+void bench_wait_for(volatile int *active);
+
+/* start the server with the given module - or with one that
+ * has no upcalls if module is NULL. Returns nonzero on failure */
+int bench_server_init(pmix_server_module_t *module);
+
+/* register an nspace of nprocs procs, all local to us, and each
+ * of its clients under the given uid/gid. Returns nonzero on failure */
+int bench_register_job(const char *nspace, int nprocs, uid_t uid, gid_t gid);
+
+/* launch argv as the given (registered) client. Returns the
+ * pid of the child, or -1 on failure */
+pid_t bench_spawn(const pmix_proc_t *proc, char **argv);
+
+/* wait for the clients launched for nspace, whose pids are
+ * given in rank order, and deregister them and the nspace.
+ * Returns nonzero if any of them failed */
+int bench_reap(const char *nspace, pid_t *pids, int nprocs);
+
+#endif /* PMIX_TEST_BENCH_UTIL_H */
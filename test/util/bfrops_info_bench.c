@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measures the cost of packing and unpacking an array of pmix_info_t
+ * holding the kinds of values typically found in job-level data -
+ * strings, 32-bit integers, sizes, ranks, procs and statuses. Each
+ * round trip packs the whole array into a fresh buffer and unpacks
+ * it again, and the average cost per info is reported - both as the
+ * library runs it and with every hot type dispatched through the
+ * registry of pack/unpack routines, as it was before those types
+ * were dispatched statically (see pmix_bfrop_pack_type).
+ *
+ * Usage: bfrops_info_bench [ninfo] [iterations]
+ */
+
+#include "src/include/pmix_config.h"
+#include "include/pmix_server.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "src/include/pmix_globals.h"
+#include "src/mca/bfrops/base/base.h"
+
+#include "bench_util.h"
+
+static void load(pmix_info_t *info, size_t ninfo)
+{
+    char key[PMIX_MAX_KEYLEN], str[64];
+    pmix_proc_t proc;
+    pmix_rank_t rank;
+    pmix_status_t status;
+    uint32_t u32;
+    size_t n, sz;
+
+    for (n = 0; n < ninfo; n++) {
+        snprintf(key, sizeof(key), "bench.key.%lu", (unsigned long) n);
+        switch (n % 6) {
+        case 0:
+            snprintf(str, sizeof(str), "node%05lu.cluster.example", (unsigned long) n);
+            PMIX_INFO_LOAD(&info[n], key, str, PMIX_STRING);
+            break;
+        case 1:
+            u32 = n;
+            PMIX_INFO_LOAD(&info[n], key, &u32, PMIX_UINT32);
+            break;
+        case 2:
+            sz = n * 1024;
+            PMIX_INFO_LOAD(&info[n], key, &sz, PMIX_SIZE);
+            break;
+        case 3:
+            rank = n;
+            PMIX_INFO_LOAD(&info[n], key, &rank, PMIX_PROC_RANK);
+            break;
+        case 4:
+            PMIX_LOAD_PROCID(&proc, "bfrops_info_bench", n);
+            PMIX_INFO_LOAD(&info[n], key, &proc, PMIX_PROC);
+            break;
+        default:
+            status = -(int) n;
+            PMIX_INFO_LOAD(&info[n], key, &status, PMIX_STATUS);
+            break;
+        }
+    }
+}
+
+/* the types dispatched statically by pmix_bfrop_pack_type */
+static const pmix_data_type_t hot_types[] = {
+    PMIX_BYTE,   PMIX_INT8,   PMIX_UINT8,  PMIX_INT16,  PMIX_INT32,     PMIX_INT64,
+    PMIX_UINT16, PMIX_UINT32, PMIX_UINT64, PMIX_STRING, PMIX_SIZE,      PMIX_PROC_RANK,
+    PMIX_STATUS, PMIX_PROC,   PMIX_INFO,   PMIX_VALUE};
+#define NHOT (sizeof(hot_types) / sizeof(hot_types[0]))
+
+static pmix_bfrop_internal_pack_fn_t registered_pack[PMIX_DATA_TYPE_MAX];
+static pmix_bfrop_internal_unpack_fn_t registered_unpack[PMIX_DATA_TYPE_MAX];
+
+/* stand-ins for the registered routines. As they are not the base
+ * routines, pmix_bfrop_pack_type finds no match and makes the
+ * indirect call through the registry for every field, as before.
+ * Each adds a direct call to the routine it stands in for, so the
+ * registry numbers slightly overstate the old cost */
+static pmix_status_t registry_pack(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
+                                   const void *src, int32_t num_vals, pmix_data_type_t type)
+{
+    return registered_pack[type](regtypes, buffer, src, num_vals, type);
+}
+
+static pmix_status_t registry_unpack(pmix_pointer_array_t *regtypes, pmix_buffer_t *buffer,
+                                     void *dest, int32_t *num_vals, pmix_data_type_t type)
+{
+    return registered_unpack[type](regtypes, buffer, dest, num_vals, type);
+}
+
+/* swap the stand-ins into the registry of the given module, or
+ * put the registered routines back */
+static int use_registry(pmix_bfrops_module_t *bfrops, bool registry)
+{
+    pmix_bfrops_base_active_module_t *active;
+    pmix_pointer_array_t *regtypes = NULL;
+    pmix_bfrop_type_info_t *tinfo;
+    size_t n;
+
+    PMIX_LIST_FOREACH (active, &pmix_bfrops_globals.actives, pmix_bfrops_base_active_module_t) {
+        if (active->module == bfrops) {
+            regtypes = &active->component->types;
+            break;
+        }
+    }
+    if (NULL == regtypes) {
+        fprintf(stderr, "no registry for the %s module\n", bfrops->version);
+        return 1;
+    }
+    for (n = 0; n < NHOT; n++) {
+        tinfo = (pmix_bfrop_type_info_t *) pmix_pointer_array_get_item(regtypes, hot_types[n]);
+        if (NULL == tinfo) {
+            continue;
+        }
+        if (registry) {
+            registered_pack[hot_types[n]] = tinfo->odti_pack_fn;
+            registered_unpack[hot_types[n]] = tinfo->odti_unpack_fn;
+            tinfo->odti_pack_fn = registry_pack;
+            tinfo->odti_unpack_fn = registry_unpack;
+        } else {
+            tinfo->odti_pack_fn = registered_pack[hot_types[n]];
+            tinfo->odti_unpack_fn = registered_unpack[hot_types[n]];
+        }
+    }
+    return 0;
+}
+
+static bool same(const pmix_value_t *a, const pmix_value_t *b)
+{
+    if (a->type != b->type) {
+        return false;
+    }
+    switch (a->type) {
+    case PMIX_STRING:
+        return 0 == strcmp(a->data.string, b->data.string);
+    case PMIX_UINT32:
+        return a->data.uint32 == b->data.uint32;
+    case PMIX_SIZE:
+        return a->data.size == b->data.size;
+    case PMIX_PROC_RANK:
+        return a->data.rank == b->data.rank;
+    case PMIX_PROC:
+        return PMIX_CHECK_PROCID(a->data.proc, b->data.proc);
+    case PMIX_STATUS:
+        return a->data.status == b->data.status;
+    default:
+        return false;
+    }
+}
+
+/* time iters round trips of the array, adding the ns spent
+ * packing and unpacking to *tpack and *tunpack */
+static int run(pmix_bfrops_module_t *bfrops, pmix_info_t *info, pmix_info_t *out, size_t ninfo,
+               int iters, double *tpack, double *tunpack)
+{
+    pmix_buffer_t buf;
+    pmix_status_t rc;
+    int32_t cnt;
+    double start;
+    size_t n;
+    int i;
+
+    for (i = 0; i < iters; i++) {
+        PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+        PMIX_BFROPS_ASSIGN_TYPE(pmix_globals.mypeer, &buf);
+        start = bench_now();
+        rc = bfrops->pack(&buf, info, ninfo, PMIX_INFO);
+        *tpack += bench_now() - start;
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "pack failed: %s\n", PMIx_Error_string(rc));
+            return 1;
+        }
+        cnt = ninfo;
+        start = bench_now();
+        rc = bfrops->unpack(&buf, out, &cnt, PMIX_INFO);
+        *tunpack += bench_now() - start;
+        if (PMIX_SUCCESS != rc || (size_t) cnt != ninfo) {
+            fprintf(stderr, "unpack failed: %s\n", PMIx_Error_string(rc));
+            return 1;
+        }
+        for (n = 0; n < ninfo; n++) {
+            if (!PMIX_CHECK_KEY(&out[n], info[n].key)
+                || !same(&out[n].value, &info[n].value)) {
+                fprintf(stderr, "info %lu does not match\n", (unsigned long) n);
+                return 1;
+            }
+            PMIX_INFO_DESTRUCT(&out[n]);
+        }
+        PMIX_DESTRUCT(&buf);
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    pmix_bfrops_module_t *bfrops;
+    pmix_info_t *info, *out;
+    size_t ninfo = 10000;
+    int iters = 50, i;
+    static const char *modes[2] = {"static", "registry"};
+    double tpack[2] = {0.0, 0.0}, tunpack[2] = {0.0, 0.0};
+
+    if (1 < argc) {
+        ninfo = strtoul(argv[1], NULL, 10);
+    }
+    if (2 < argc) {
+        iters = strtol(argv[2], NULL, 10);
+    }
+    if (0 != bench_server_init(NULL)) {
+        return 1;
+    }
+    bfrops = pmix_globals.mypeer->nptr->compat.bfrops;
+
+    PMIX_INFO_CREATE(info, ninfo);
+    load(info, ninfo);
+    PMIX_INFO_CREATE(out, ninfo);
+
+    /* alternate the two so both see the same conditions */
+    for (i = 0; i < iters; i++) {
+        if (0 != run(bfrops, info, out, ninfo, 1, &tpack[0], &tunpack[0])
+            || 0 != use_registry(bfrops, true)
+            || 0 != run(bfrops, info, out, ninfo, 1, &tpack[1], &tunpack[1])
+            || 0 != use_registry(bfrops, false)) {
+            return 1;
+        }
+    }
+
+    fprintf(stdout, "%lu infos, %s module\n%10s %12s %12s %12s\n", (unsigned long) ninfo,
+            bfrops->version, "dispatch", "ns/pack", "ns/unpack", "ns/trip");
+    for (i = 0; i < 2; i++) {
+        fprintf(stdout, "%10s %12.1f %12.1f %12.1f\n", modes[i], tpack[i] / iters / ninfo,
+                tunpack[i] / iters / ninfo, (tpack[i] + tunpack[i]) / iters / ninfo);
+    }
+
+    PMIX_INFO_FREE(info, ninfo);
+    free(out);
+    PMIx_server_finalize();
+    return 0;
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measures how fast large arrays of procs and ranks are packed and
+ * unpacked in the regular non-described buffers and in the native
+ * buffers used between a server and a local client built for the
+ * same architecture.
+ *
+ * Usage: bfrops_native_bench [nelems] [iterations]
+ */
+
+#include "src/include/pmix_config.h"
+#include "include/pmix_server.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "src/include/pmix_globals.h"
+#include "src/mca/bfrops/base/base.h"
+
+#include "bench_util.h"
+
+/* pack and unpack the array iters times, returning the
+ * nanoseconds per element for each direction */
+static int run(pmix_bfrop_buffer_type_t type, void *src, void *dst, int32_t nelems,
+               pmix_data_type_t dtype, size_t elsize, int iters, double *pk, double *upk,
+               size_t *nbytes)
+{
+    pmix_bfrops_module_t *bfrops = pmix_globals.mypeer->nptr->compat.bfrops;
+    pmix_buffer_t buf;
+    pmix_status_t rc;
+    double start, tpack = 0.0, tunpack = 0.0;
+    int32_t cnt;
+    int n;
+
+    for (n = 0; n < iters; n++) {
+        PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+        buf.type = type;
+        start = bench_now();
+        rc = bfrops->pack(&buf, src, nelems, dtype);
+        tpack += bench_now() - start;
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "pack failed: %s\n", PMIx_Error_string(rc));
+            return 1;
+        }
+        *nbytes = buf.bytes_used;
+        memset(dst, 0, nelems * elsize);
+        cnt = nelems;
+        start = bench_now();
+        rc = bfrops->unpack(&buf, dst, &cnt, dtype);
+        tunpack += bench_now() - start;
+        if (PMIX_SUCCESS != rc || cnt != nelems) {
+            fprintf(stderr, "unpack failed: %s\n", PMIx_Error_string(rc));
+            return 1;
+        }
+        if (0 != memcmp(src, dst, nelems * elsize)) {
+            fprintf(stderr, "unpacked data does not match\n");
+            return 1;
+        }
+        PMIX_DESTRUCT(&buf);
+    }
+    *pk = tpack / iters / nelems;
+    *upk = tunpack / iters / nelems;
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    static const struct {
+        const char *name;
+        pmix_bfrop_buffer_type_t type;
+    } modes[] = {{"non-described", PMIX_BFROP_BUFFER_NON_DESC},
+                 {"native", PMIX_BFROP_BUFFER_NATIVE}};
+    pmix_proc_t *procs, *procs2;
+    pmix_rank_t *ranks, *ranks2;
+    int32_t nelems = 100000;
+    int iters = 20;
+    double pk, upk;
+    size_t nbytes;
+    int i, m;
+
+    if (1 < argc) {
+        nelems = strtol(argv[1], NULL, 10);
+    }
+    if (2 < argc) {
+        iters = strtol(argv[2], NULL, 10);
+    }
+    if (0 != bench_server_init(NULL)) {
+        return 1;
+    }
+
+    procs = (pmix_proc_t *) calloc(nelems, sizeof(pmix_proc_t));
+    procs2 = (pmix_proc_t *) calloc(nelems, sizeof(pmix_proc_t));
+    ranks = (pmix_rank_t *) calloc(nelems, sizeof(pmix_rank_t));
+    ranks2 = (pmix_rank_t *) calloc(nelems, sizeof(pmix_rank_t));
+    for (i = 0; i < nelems; i++) {
+        PMIX_LOAD_PROCID(&procs[i], "bfrops_native_bench", i);
+        ranks[i] = i;
+    }
+
+    fprintf(stdout, "%d elements, %s module\n%-6s %-14s %10s %10s %12s\n", nelems,
+            pmix_globals.mypeer->nptr->compat.bfrops->version, "type", "buffer", "ns/pack",
+            "ns/unpack", "bytes");
+    for (m = 0; m < 2; m++) {
+        if (0 != run(modes[m].type, procs, procs2, nelems, PMIX_PROC, sizeof(pmix_proc_t), iters,
+                     &pk, &upk, &nbytes)) {
+            return 1;
+        }
+        fprintf(stdout, "%-6s %-14s %10.2f %10.2f %12zu\n", "proc", modes[m].name, pk, upk,
+                nbytes);
+    }
+    for (m = 0; m < 2; m++) {
+        if (0 != run(modes[m].type, ranks, ranks2, nelems, PMIX_PROC_RANK, sizeof(pmix_rank_t),
+                     iters, &pk, &upk, &nbytes)) {
+            return 1;
+        }
+        fprintf(stdout, "%-6s %-14s %10.2f %10.2f %12zu\n", "rank", modes[m].name, pk, upk,
+                nbytes);
+    }
+
+    free(procs);
+    free(procs2);
+    free(ranks);
+    free(ranks2);
+    PMIx_server_finalize();
+    return 0;
+}
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measures packing the job-level data of a large job the way the
+ * server packs it for a client - one kval at a time - both into a
+ * buffer that grows as it goes and into one reserved up front from
+ * the estimated packed size. Reported are the number of times the
+ * buffer grew, the bytes it grew by (all of which were zeroed by
+ * the buffer code before it stopped clearing new space), the space
+ * left allocated and the time taken.
+ *
+ * Usage: bfrops_reserve_bench [nnodes] [ppn] [iterations]
+ */
+
+#include "src/include/pmix_config.h"
+#include "include/pmix_server.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "src/include/pmix_globals.h"
+#include "src/mca/bfrops/base/base.h"
+
+#include "bench_util.h"
+
+/* job-level keys followed by an info array for each node */
+static pmix_info_t *load(int nnodes, int ppn, size_t *ninfo)
+{
+    pmix_info_t *info, *iptr;
+    pmix_data_array_t *darray;
+    char *map, *procs, tmp[64];
+    size_t n = 0, len;
+    uint32_t u32;
+    int i, j;
+
+    *ninfo = 4 + nnodes;
+    PMIX_INFO_CREATE(info, *ninfo);
+
+    PMIX_INFO_LOAD(&info[n++], PMIX_JOBID, "bfrops_reserve_bench", PMIX_STRING);
+    u32 = nnodes * ppn;
+    PMIX_INFO_LOAD(&info[n++], PMIX_JOB_SIZE, &u32, PMIX_UINT32);
+    map = (char *) calloc(nnodes, 16);
+    procs = (char *) calloc(nnodes * ppn, 12);
+    for (i = 0, len = 0; i < nnodes; i++) {
+        len += sprintf(map + len, "%snode%05d", 0 == i ? "" : ",", i);
+    }
+    for (i = 0, len = 0; i < nnodes * ppn; i++) {
+        len += sprintf(procs + len, "%s%d", 0 == i ? "" : (0 == i % ppn ? ";" : ","), i);
+    }
+    PMIX_INFO_LOAD(&info[n++], PMIX_NODE_MAP, map, PMIX_STRING);
+    PMIX_INFO_LOAD(&info[n++], PMIX_PROC_MAP, procs, PMIX_STRING);
+    free(map);
+    free(procs);
+
+    for (i = 0; i < nnodes; i++) {
+        PMIX_DATA_ARRAY_CREATE(darray, 5, PMIX_INFO);
+        iptr = (pmix_info_t *) darray->array;
+        snprintf(tmp, sizeof(tmp), "node%05d", i);
+        PMIX_INFO_LOAD(&iptr[0], PMIX_HOSTNAME, tmp, PMIX_STRING);
+        u32 = i;
+        PMIX_INFO_LOAD(&iptr[1], PMIX_NODEID, &u32, PMIX_UINT32);
+        for (j = 0, len = 0; j < ppn; j++) {
+            len += snprintf(tmp + len, sizeof(tmp) - len, "%s%d", 0 == j ? "" : ",",
+                            i * ppn + j);
+        }
+        PMIX_INFO_LOAD(&iptr[2], PMIX_LOCAL_PEERS, tmp, PMIX_STRING);
+        u32 = ppn;
+        PMIX_INFO_LOAD(&iptr[3], PMIX_LOCAL_SIZE, &u32, PMIX_UINT32);
+        u32 = i * ppn;
+        PMIX_INFO_LOAD(&iptr[4], PMIX_LOCALLDR, &u32, PMIX_PROC_RANK);
+        PMIX_LOAD_KEY(info[n].key, PMIX_NODE_INFO_ARRAY);
+        info[n].value.type = PMIX_DATA_ARRAY;
+        info[n].value.data.darray = darray;
+        ++n;
+    }
+    return info;
+}
+
+int main(int argc, char **argv)
+{
+    pmix_buffer_t buf;
+    pmix_info_t *info;
+    pmix_kval_t kv;
+    pmix_status_t rc;
+    size_t ninfo, n, est, before, grown, allocated, used;
+    int nnodes = 10000, ppn = 8, iters = 10, i, m, growths;
+    double start, elapsed;
+
+    if (1 < argc) {
+        nnodes = strtol(argv[1], NULL, 10);
+    }
+    if (2 < argc) {
+        ppn = strtol(argv[2], NULL, 10);
+    }
+    if (3 < argc) {
+        iters = strtol(argv[3], NULL, 10);
+    }
+    if (0 != bench_server_init(NULL)) {
+        return 1;
+    }
+
+    info = load(nnodes, ppn, &ninfo);
+    PMIX_CONSTRUCT(&kv, pmix_kval_t);
+    est = 0;
+    for (n = 0; n < ninfo; n++) {
+        kv.key = info[n].key;
+        kv.value = &info[n].value;
+        est += pmix_bfrops_base_packed_size(&kv, 1, PMIX_KVAL);
+    }
+
+    fprintf(stdout, "%d nodes, %d procs per node, %s module\n%-9s %9s %12s %12s %12s %9s\n",
+            nnodes, ppn, pmix_globals.mypeer->nptr->compat.bfrops->version, "buffer",
+            "growths", "grown bytes", "allocated", "packed", "ms/pack");
+    for (m = 0; m < 2; m++) {
+        growths = 0;
+        grown = 0;
+        allocated = 0;
+        used = 0;
+        elapsed = 0.0;
+        for (i = 0; i < iters; i++) {
+            PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+            PMIX_BFROPS_ASSIGN_TYPE(pmix_globals.mypeer, &buf);
+            start = bench_now();
+            if (1 == m) {
+                rc = pmix_bfrops_base_reserve(&buf, est);
+                if (PMIX_SUCCESS != rc) {
+                    fprintf(stderr, "reserve failed: %s\n", PMIx_Error_string(rc));
+                    return 1;
+                }
+            }
+            for (n = 0; n < ninfo; n++) {
+                kv.key = info[n].key;
+                kv.value = &info[n].value;
+                before = buf.bytes_allocated;
+                PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &buf, &kv, 1, PMIX_KVAL);
+                if (PMIX_SUCCESS != rc) {
+                    fprintf(stderr, "pack failed: %s\n", PMIx_Error_string(rc));
+                    return 1;
+                }
+                if (buf.bytes_allocated != before) {
+                    ++growths;
+                    grown += buf.bytes_allocated - before;
+                }
+            }
+            elapsed += bench_now() - start;
+            allocated = buf.bytes_allocated;
+            used = buf.bytes_used;
+            PMIX_DESTRUCT(&buf);
+        }
+        fprintf(stdout, "%-9s %9d %12lu %12lu %12lu %9.2f\n", 0 == m ? "growing" : "reserved",
+                growths / iters, (unsigned long) (grown / iters), (unsigned long) allocated,
+                (unsigned long) used, elapsed / iters / 1e6);
+    }
+    fprintf(stdout, "estimated packed size %lu\n", (unsigned long) est);
+
+    kv.key = NULL;
+    kv.value = NULL;
+    PMIX_DESTRUCT(&kv);
+    PMIX_INFO_FREE(info, ninfo);
+    PMIx_server_finalize();
+    return 0;
+}
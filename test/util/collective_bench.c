@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measures the cost of a local proc joining a fence while many
+ * fences over different subsets of the local procs are in
+ * progress. Every proc of a subset calls the fence, each listing
+ * the participants in a different order, and the last one to do
+ * so completes the local part of the fence.
+ *
+ * Usage: collective_bench [nfences] [nmembers]
+ */
+
+#include "src/include/pmix_config.h"
+#include "include/pmix_server.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "src/include/pmix_globals.h"
+#include "src/mca/bfrops/bfrops.h"
+#include "src/server/pmix_server_ops.h"
+
+#include "bench_util.h"
+
+#define BENCH_NSPACE "collective_bench"
+
+static int ncomplete = 0;
+
+/* fences with non-local participants are left in progress
+ * until the round is over */
+static pmix_status_t fence_nb(const pmix_proc_t procs[], size_t nprocs, const pmix_info_t info[],
+                              size_t ninfo, char *data, size_t ndata, pmix_modex_cbfunc_t cbfunc,
+                              void *cbdata)
+{
+    (void) procs;
+    (void) nprocs;
+    (void) info;
+    (void) ninfo;
+    (void) cbfunc;
+    (void) cbdata;
+    free(data);
+    ncomplete++;
+    return PMIX_SUCCESS;
+}
+
+static void modex_cbfunc(pmix_status_t status, const char *data, size_t ndata, void *cbdata,
+                         pmix_release_cbfunc_t relfn, void *relcbdata)
+{
+    (void) status;
+    (void) data;
+    (void) ndata;
+    (void) cbdata;
+    /* a purely local fence is completed right away */
+    ncomplete++;
+    if (NULL != relfn) {
+        relfn(relcbdata);
+    }
+}
+
+typedef struct {
+    pmix_object_t super;
+    pmix_event_t ev;
+    int nfences;
+    int nmembers;
+    double join_ns;
+    volatile int active;
+} fence_caddy_t;
+static PMIX_CLASS_INSTANCE(fence_caddy_t, pmix_object_t, NULL, NULL);
+
+static pmix_namespace_t *nptr = NULL;
+static pmix_peer_t **peers = NULL;
+
+/* have member m of subset f call the fence, listing the
+ * participants starting from itself */
+static void call_fence(int f, int m, int nmembers)
+{
+    pmix_server_caddy_t *cd;
+    pmix_peer_t *peer = peers[f * nmembers + m];
+    pmix_proc_t procs[nmembers];
+    pmix_buffer_t buf;
+    size_t nprocs = nmembers, ninfo = 0;
+    pmix_status_t rc;
+    int n;
+
+    for (n = 0; n < nmembers; n++) {
+        PMIX_LOAD_PROCID(&procs[n], BENCH_NSPACE, f * nmembers + (m + n) % nmembers);
+    }
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    PMIX_BFROPS_PACK(rc, peer, &buf, &nprocs, 1, PMIX_SIZE);
+    if (PMIX_SUCCESS == rc) {
+        PMIX_BFROPS_PACK(rc, peer, &buf, procs, nprocs, PMIX_PROC);
+    }
+    if (PMIX_SUCCESS == rc) {
+        PMIX_BFROPS_PACK(rc, peer, &buf, &ninfo, 1, PMIX_SIZE);
+    }
+    cd = PMIX_NEW(pmix_server_caddy_t);
+    PMIX_RETAIN(peer);
+    cd->peer = peer;
+    if (PMIX_SUCCESS == rc) {
+        rc = pmix_server_fence(cd, &buf, modex_cbfunc, NULL);
+    }
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "fence %d from member %d failed: %s\n", f, m, PMIx_Error_string(rc));
+        exit(1);
+    }
+    PMIX_DESTRUCT(&buf);
+}
+
+static void run_fences(int sd, short args, void *cbdata)
+{
+    fence_caddy_t *cd = (fence_caddy_t *) cbdata;
+    pmix_server_trkr_t *trk, *next;
+    double start;
+    int f, m;
+
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+    /* start all the fences */
+    for (f = 0; f < cd->nfences; f++) {
+        call_fence(f, 0, cd->nmembers);
+    }
+    /* and have everyone else join them */
+    start = bench_now();
+    for (m = 1; m < cd->nmembers; m++) {
+        for (f = 0; f < cd->nfences; f++) {
+            call_fence(f, m, cd->nmembers);
+        }
+    }
+    cd->join_ns = (bench_now() - start) / (cd->nfences * (cd->nmembers - 1));
+
+    PMIX_LIST_FOREACH_SAFE (trk, next, &pmix_server_globals.collectives, pmix_server_trkr_t) {
+        pmix_server_remove_tracker(trk);
+        PMIX_RELEASE(trk);
+    }
+    cd->active = 0;
+}
+
+int main(int argc, char **argv)
+{
+    static const int counts[] = {10, 100, 1000};
+    pmix_server_module_t mymodule;
+    pmix_rank_info_t *info;
+    pmix_nspace_t nspace;
+    fence_caddy_t *cd;
+    int nfences = 1000;
+    int nmembers = 4;
+    int nprocs;
+    int i, n;
+
+    if (1 < argc) {
+        nfences = strtol(argv[1], NULL, 10);
+    }
+    if (2 < argc) {
+        nmembers = strtol(argv[2], NULL, 10);
+    }
+    if (nmembers < 2) {
+        fprintf(stderr, "a fence needs at least 2 members\n");
+        return 1;
+    }
+    memset(&mymodule, 0, sizeof(mymodule));
+    mymodule.fence_nb = fence_nb;
+    if (0 != bench_server_init(&mymodule)) {
+        return 1;
+    }
+
+    /* all procs are local to us */
+    nprocs = nfences * nmembers;
+    PMIX_LOAD_NSPACE(nspace, BENCH_NSPACE);
+    if (0 != bench_register_job(nspace, nprocs, 0, 0)) {
+        return 1;
+    }
+    nptr = pmix_nspace_lookup(BENCH_NSPACE);
+    if (NULL == nptr) {
+        fprintf(stderr, "nspace %s not found\n", BENCH_NSPACE);
+        return 1;
+    }
+    /* the procs never connected, so use our own buffer format */
+    nptr->compat = pmix_globals.mypeer->nptr->compat;
+    peers = (pmix_peer_t **) calloc(nprocs, sizeof(pmix_peer_t *));
+    PMIX_LIST_FOREACH (info, &nptr->ranks, pmix_rank_info_t) {
+        peers[info->pname.rank] = PMIX_NEW(pmix_peer_t);
+        PMIX_RETAIN(info);
+        peers[info->pname.rank]->info = info;
+        PMIX_RETAIN(nptr);
+        peers[info->pname.rank]->nptr = nptr;
+    }
+
+    fprintf(stdout, "%8s %8s %14s\n", "fences", "members", "join ns/call");
+    for (i = 0; i < (int) (sizeof(counts) / sizeof(counts[0])) && counts[i] <= nfences; i++) {
+        ncomplete = 0;
+        cd = PMIX_NEW(fence_caddy_t);
+        cd->nfences = counts[i];
+        cd->nmembers = nmembers;
+        cd->active = 1;
+        pmix_event_assign(&cd->ev, pmix_globals.evbase, -1, EV_WRITE, run_fences, cd);
+        pmix_event_active(&cd->ev, EV_WRITE, 1);
+        bench_wait_for(&cd->active);
+        if (ncomplete != counts[i]) {
+            fprintf(stderr, "%d of %d fences completed locally\n", ncomplete, counts[i]);
+            return 1;
+        }
+        fprintf(stdout, "%8d %8d %14.1f\n", counts[i], nmembers, cd->join_ns);
+        PMIX_RELEASE(cd);
+    }
+
+    for (n = 0; n < nprocs; n++) {
+        PMIX_RELEASE(peers[n]);
+    }
+    free(peers);
+    PMIx_server_finalize();
+    return 0;
+}
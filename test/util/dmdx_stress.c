@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Stresses the server's handling of direct modex requests from
+ * remote servers: posts a large number of requests for the data
+ * of local procs that have not yet committed it, then has each
+ * proc commit and checks that every request is answered exactly
+ * once. Reports the average cost of a commit while the requests
+ * are outstanding.
+ *
+ * Usage: dmdx_stress [nrequests] [nprocs]
+ */
+
+#include "src/include/pmix_config.h"
+#include "include/pmix_server.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "src/include/pmix_globals.h"
+#include "src/mca/bfrops/bfrops.h"
+#include "src/server/pmix_server_ops.h"
+
+#include "bench_util.h"
+
+#define STRESS_NSPACE "dmdx_stress"
+
+static volatile int nreplies = 0;
+static volatile int nerrors = 0;
+static int *replies = NULL;
+
+/* the requests are answered on the progress thread */
+static void dmdx_cbfunc(pmix_status_t status, char *data, size_t sz, void *cbdata)
+{
+    int rank = (int) (intptr_t) cbdata;
+
+    (void) data;
+    (void) sz;
+    if (PMIX_SUCCESS != status) {
+        nerrors++;
+    }
+    replies[rank]++;
+    nreplies++;
+}
+
+typedef struct {
+    pmix_object_t super;
+    pmix_event_t ev;
+    int nprocs;
+    double ns;
+    volatile int active;
+} commit_caddy_t;
+static PMIX_CLASS_INSTANCE(commit_caddy_t, pmix_object_t, NULL, NULL);
+
+/* commit a value from each proc as if it had called PMIx_Commit */
+static void commit_all(int sd, short args, void *cbdata)
+{
+    commit_caddy_t *cd = (commit_caddy_t *) cbdata;
+    pmix_namespace_t *nptr;
+    pmix_rank_info_t *info;
+    pmix_buffer_t buf, blob;
+    pmix_scope_t scope = PMIX_REMOTE;
+    pmix_peer_t *peer;
+    pmix_kval_t kv;
+    pmix_value_t val;
+    pmix_status_t rc;
+    double start;
+
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+    nptr = pmix_nspace_lookup(STRESS_NSPACE);
+    if (NULL == nptr) {
+        fprintf(stderr, "nspace %s not found\n", STRESS_NSPACE);
+        exit(1);
+    }
+    /* the procs never connected, so use our own buffer format */
+    nptr->compat = pmix_globals.mypeer->nptr->compat;
+
+    start = bench_now();
+    PMIX_LIST_FOREACH (info, &nptr->ranks, pmix_rank_info_t) {
+        peer = PMIX_NEW(pmix_peer_t);
+        PMIX_RETAIN(info);
+        peer->info = info;
+        PMIX_RETAIN(nptr);
+        peer->nptr = nptr;
+
+        PMIX_CONSTRUCT(&blob, pmix_buffer_t);
+        PMIX_CONSTRUCT(&kv, pmix_kval_t);
+        kv.key = "stress.endpoint";
+        kv.value = &val;
+        PMIX_VALUE_LOAD(&val, &info->pname.rank, PMIX_UINT32);
+        PMIX_BFROPS_PACK(rc, peer, &blob, &kv, 1, PMIX_KVAL);
+        kv.key = NULL;
+        kv.value = NULL;
+        PMIX_DESTRUCT(&kv);
+        PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+        if (PMIX_SUCCESS == rc) {
+            PMIX_BFROPS_PACK(rc, peer, &buf, &scope, 1, PMIX_SCOPE);
+        }
+        if (PMIX_SUCCESS == rc) {
+            PMIX_BFROPS_PACK(rc, peer, &buf, &blob, 1, PMIX_BUFFER);
+        }
+        if (PMIX_SUCCESS == rc) {
+            rc = pmix_server_commit(peer, &buf);
+        }
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "commit for rank %u failed: %s\n", info->pname.rank,
+                    PMIx_Error_string(rc));
+            exit(1);
+        }
+        PMIX_DESTRUCT(&buf);
+        PMIX_DESTRUCT(&blob);
+        PMIX_RELEASE(peer);
+    }
+    cd->ns = (bench_now() - start) / cd->nprocs;
+    cd->active = 0;
+}
+
+int main(int argc, char **argv)
+{
+    pmix_nspace_t nspace;
+    pmix_proc_t proc;
+    pmix_status_t rc;
+    commit_caddy_t *cd;
+    int nrequests = 100000;
+    int nprocs = 1000;
+    int n;
+
+    if (1 < argc) {
+        nrequests = strtol(argv[1], NULL, 10);
+    }
+    if (2 < argc) {
+        nprocs = strtol(argv[2], NULL, 10);
+    }
+    if (0 != bench_server_init(NULL)) {
+        return 1;
+    }
+    replies = (int *) calloc(nprocs, sizeof(int));
+
+    /* all procs are local to us */
+    PMIX_LOAD_NSPACE(nspace, STRESS_NSPACE);
+    if (0 != bench_register_job(nspace, nprocs, 0, 0)) {
+        return 1;
+    }
+
+    /* none of the procs has committed, so all requests are held */
+    for (n = 0; n < nrequests; n++) {
+        PMIX_LOAD_PROCID(&proc, STRESS_NSPACE, n % nprocs);
+        rc = PMIx_server_dmodex_request(&proc, dmdx_cbfunc, (void *) (intptr_t) (n % nprocs));
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "PMIx_server_dmodex_request failed: %s\n", PMIx_Error_string(rc));
+            return 1;
+        }
+    }
+    while ((size_t) nrequests != *(volatile size_t *) &pmix_server_globals.remote_pnd.size) {
+        struct timespec ts = {0, 100000};
+        nanosleep(&ts, NULL);
+    }
+    if (0 != nreplies) {
+        fprintf(stderr, "%d requests answered before any commit\n", nreplies);
+        return 1;
+    }
+
+    cd = PMIX_NEW(commit_caddy_t);
+    cd->nprocs = nprocs;
+    cd->active = 1;
+    pmix_event_assign(&cd->ev, pmix_globals.evbase, -1, EV_WRITE, commit_all, cd);
+    pmix_event_active(&cd->ev, EV_WRITE, 1);
+    bench_wait_for(&cd->active);
+
+    if (nrequests != nreplies || 0 != nerrors) {
+        fprintf(stderr, "%d of %d requests answered, %d with an error\n", nreplies, nrequests,
+                nerrors);
+        return 1;
+    }
+    for (n = 0; n < nprocs; n++) {
+        if (replies[n] != nrequests / nprocs + (n < nrequests % nprocs ? 1 : 0)) {
+            fprintf(stderr, "rank %d: %d requests answered\n", n, replies[n]);
+            return 1;
+        }
+    }
+    fprintf(stdout, "%d requests on %d procs: %.1f us/commit\n", nrequests, nprocs, cd->ns / 1e3);
+
+    PMIX_RELEASE(cd);
+    free(replies);
+    PMIx_server_finalize();
+    return 0;
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measures the cost of a client probing another proc for keys that
+ * proc never put. Starts a server that launches two clients: rank 1
+ * commits a single key, and rank 0 then repeatedly asks for it and
+ * for a set of keys that don't exist. The gets are marked
+ * PMIX_IMMEDIATE so the server answers a miss at once instead of
+ * waiting for the key to show up. The clients are run once with the
+ * client get cache disabled and once with it enabled, each time in a
+ * fresh nspace, and the average cost of each kind of get is reported.
+ *
+ * Usage: get_cache_bench [nkeys] [nrounds]
+ */
+
+#include "src/include/pmix_config.h"
+#include "include/pmix.h"
+#include "include/pmix_server.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "bench_util.h"
+
+static int client(int nkeys, int nrounds)
+{
+    pmix_proc_t myproc, peer;
+    pmix_value_t value, *val;
+    pmix_info_t info;
+    pmix_status_t rc;
+    char key[PMIX_MAX_KEYLEN];
+    double start, found = 0.0, missing = 0.0;
+    uint32_t u32 = 42;
+    bool flag = true;
+    int r, n;
+
+    rc = PMIx_Init(&myproc, NULL, 0);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "PMIx_Init failed: %s\n", PMIx_Error_string(rc));
+        return 1;
+    }
+    if (1 == myproc.rank) {
+        PMIX_VALUE_LOAD(&value, &u32, PMIX_UINT32);
+        rc = PMIx_Put(PMIX_GLOBAL, "bench.present", &value);
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Commit();
+        }
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "put failed: %s\n", PMIx_Error_string(rc));
+            return 1;
+        }
+    }
+    rc = PMIx_Fence(NULL, 0, NULL, 0);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "PMIx_Fence failed: %s\n", PMIx_Error_string(rc));
+        return 1;
+    }
+
+    if (0 == myproc.rank) {
+        PMIX_LOAD_PROCID(&peer, myproc.nspace, 1);
+        PMIX_INFO_LOAD(&info, PMIX_IMMEDIATE, &flag, PMIX_BOOL);
+        for (r = 0; r < nrounds; r++) {
+            start = bench_now();
+            rc = PMIx_Get(&peer, "bench.present", &info, 1, &val);
+            found += bench_now() - start;
+            if (PMIX_SUCCESS != rc || PMIX_UINT32 != val->type || 42 != val->data.uint32) {
+                fprintf(stderr, "round %d: bench.present not found: %s\n", r,
+                        PMIx_Error_string(rc));
+                return 1;
+            }
+            PMIX_VALUE_RELEASE(val);
+            start = bench_now();
+            for (n = 0; n < nkeys; n++) {
+                snprintf(key, sizeof(key), "bench.missing.%d", n);
+                rc = PMIx_Get(&peer, key, &info, 1, &val);
+                if (PMIX_ERR_NOT_FOUND != rc) {
+                    fprintf(stderr, "round %d: %s returned %s\n", r, key, PMIx_Error_string(rc));
+                    return 1;
+                }
+            }
+            missing += bench_now() - start;
+        }
+        fprintf(stdout, "%-10s %14.1f %14.1f\n", getenv("PMIX_MCA_pmix_client_get_cache_ttl"),
+                found / nrounds / 1e3, missing / ((double) nrounds * nkeys) / 1e3);
+        fflush(stdout);
+    }
+
+    rc = PMIx_Fence(NULL, 0, NULL, 0);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "PMIx_Fence failed: %s\n", PMIx_Error_string(rc));
+        return 1;
+    }
+    PMIx_Finalize(NULL, 0);
+    return 0;
+}
+
+static int run(const char *argv0, const char *ttl, int nkeys, int nrounds)
+{
+    pmix_nspace_t nspace;
+    pmix_proc_t proc;
+    char *client_argv[5], keys[16], rounds[16];
+    pid_t pids[2];
+    int n;
+
+    snprintf(nspace, sizeof(nspace), "get_cache_bench.%s", ttl);
+    if (0 != bench_register_job(nspace, 2, getuid(), getgid())) {
+        return 1;
+    }
+
+    snprintf(keys, sizeof(keys), "%d", nkeys);
+    snprintf(rounds, sizeof(rounds), "%d", nrounds);
+    client_argv[0] = (char *) argv0;
+    client_argv[1] = "--client";
+    client_argv[2] = keys;
+    client_argv[3] = rounds;
+    client_argv[4] = NULL;
+    /* the clients inherit our environment */
+    setenv("PMIX_MCA_pmix_client_get_cache_ttl", ttl, 1);
+    for (n = 0; n < 2; n++) {
+        PMIX_LOAD_PROCID(&proc, nspace, n);
+        pids[n] = bench_spawn(&proc, client_argv);
+    }
+    return bench_reap(nspace, pids, 2);
+}
+
+int main(int argc, char **argv)
+{
+    int nkeys = 16;
+    int nrounds = 100;
+
+    if (3 < argc && 0 == strcmp(argv[1], "--client")) {
+        return client(strtol(argv[2], NULL, 10), strtol(argv[3], NULL, 10));
+    }
+    if (1 < argc) {
+        nkeys = strtol(argv[1], NULL, 10);
+    }
+    if (2 < argc) {
+        nrounds = strtol(argv[2], NULL, 10);
+    }
+
+    if (0 != bench_server_init(NULL)) {
+        return 1;
+    }
+    fprintf(stdout, "%d missing keys x %d rounds\n%-10s %14s %14s\n", nkeys, nrounds, "ttl",
+            "us/found get", "us/missing get");
+    if (0 != run(argv[0], "0", nkeys, nrounds) || 0 != run(argv[0], "60", nkeys, nrounds)) {
+        fprintf(stderr, "client failed\n");
+        PMIx_server_finalize();
+        return 1;
+    }
+    PMIx_server_finalize();
+    return 0;
+}
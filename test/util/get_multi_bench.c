@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measures the cost of gathering one key from every peer. Starts a
+ * server that launches a set of clients, each of which commits an
+ * "endpoint" and, after a fence, fetches the endpoint of every other
+ * client - once with a PMIx_Get per peer and once with a single
+ * PMIx_Get_multi call. Each way is run by a server of its own so
+ * neither finds the data already in the client, and the time rank 0
+ * took to collect all of the endpoints is reported.
+ *
+ * Usage: get_multi_bench [nprocs]
+ */
+
+#include "src/include/pmix_config.h"
+#include "include/pmix.h"
+#include "include/pmix_server.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "bench_util.h"
+
+static int client(int nprocs, bool multi)
+{
+    pmix_proc_t myproc, *procs;
+    pmix_value_t value, **vals;
+    pmix_status_t rc, *status;
+    const char **keys;
+    double start, elapsed;
+    uint64_t u64;
+    int n, npeers = 0;
+
+    rc = PMIx_Init(&myproc, NULL, 0);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "PMIx_Init failed: %s\n", PMIx_Error_string(rc));
+        return 1;
+    }
+    u64 = 1000 + myproc.rank;
+    PMIX_VALUE_LOAD(&value, &u64, PMIX_UINT64);
+    rc = PMIx_Put(PMIX_GLOBAL, "bench.endpoint", &value);
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Commit();
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Fence(NULL, 0, NULL, 0);
+    }
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "publishing the endpoint failed: %s\n", PMIx_Error_string(rc));
+        return 1;
+    }
+
+    procs = (pmix_proc_t *) calloc(nprocs, sizeof(pmix_proc_t));
+    keys = (const char **) calloc(nprocs, sizeof(char *));
+    vals = (pmix_value_t **) calloc(nprocs, sizeof(pmix_value_t *));
+    status = (pmix_status_t *) calloc(nprocs, sizeof(pmix_status_t));
+    for (n = 0; n < nprocs; n++) {
+        if ((pmix_rank_t) n != myproc.rank) {
+            PMIX_LOAD_PROCID(&procs[npeers], myproc.nspace, n);
+            keys[npeers] = "bench.endpoint";
+            ++npeers;
+        }
+    }
+
+    start = bench_now();
+    if (multi) {
+        rc = PMIx_Get_multi(procs, keys, npeers, NULL, 0, vals, status);
+    } else {
+        rc = PMIX_SUCCESS;
+        for (n = 0; n < npeers; n++) {
+            status[n] = PMIx_Get(&procs[n], keys[n], NULL, 0, &vals[n]);
+            if (PMIX_SUCCESS != status[n] && PMIX_SUCCESS == rc) {
+                rc = status[n];
+            }
+        }
+    }
+    elapsed = bench_now() - start;
+
+    for (n = 0; n < npeers; n++) {
+        if (PMIX_SUCCESS != status[n] || NULL == vals[n] || PMIX_UINT64 != vals[n]->type
+            || 1000 + procs[n].rank != vals[n]->data.uint64) {
+            fprintf(stderr, "rank %u: bad endpoint for rank %u: %s\n", myproc.rank,
+                    procs[n].rank, PMIx_Error_string(status[n]));
+            return 1;
+        }
+        PMIX_VALUE_RELEASE(vals[n]);
+    }
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "rank %u: get returned %s\n", myproc.rank, PMIx_Error_string(rc));
+        return 1;
+    }
+    if (0 == myproc.rank) {
+        fprintf(stdout, "%-16s %12.1f %12.2f\n", multi ? "PMIx_Get_multi" : "PMIx_Get",
+                elapsed / 1e3, elapsed / npeers / 1e3);
+        fflush(stdout);
+    }
+    free(procs);
+    free(keys);
+    free(vals);
+    free(status);
+
+    rc = PMIx_Fence(NULL, 0, NULL, 0);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "PMIx_Fence failed: %s\n", PMIx_Error_string(rc));
+        return 1;
+    }
+    PMIx_Finalize(NULL, 0);
+    return 0;
+}
+
+static int run(const char *argv0, int nprocs, bool multi)
+{
+    pmix_nspace_t nspace;
+    pmix_proc_t proc;
+    char *client_argv[5], tmp[16];
+    int n, ret;
+    pid_t *pids;
+
+    PMIX_LOAD_NSPACE(nspace, "get_multi_bench");
+    if (0 != bench_register_job(nspace, nprocs, getuid(), getgid())) {
+        return 1;
+    }
+
+    snprintf(tmp, sizeof(tmp), "%d", nprocs);
+    client_argv[0] = (char *) argv0;
+    client_argv[1] = "--client";
+    client_argv[2] = tmp;
+    client_argv[3] = multi ? "multi" : "single";
+    client_argv[4] = NULL;
+    pids = (pid_t *) calloc(nprocs, sizeof(pid_t));
+    for (n = 0; n < nprocs; n++) {
+        PMIX_LOAD_PROCID(&proc, nspace, n);
+        pids[n] = bench_spawn(&proc, client_argv);
+    }
+    ret = bench_reap(nspace, pids, nprocs);
+    free(pids);
+    return ret;
+}
+
+/* each way of fetching gets a server of its own */
+static int server(const char *argv0, int nprocs, bool multi)
+{
+    int ret;
+
+    if (0 != bench_server_init(NULL)) {
+        return 1;
+    }
+    ret = run(argv0, nprocs, multi);
+    PMIx_server_finalize();
+    return ret;
+}
+
+int main(int argc, char **argv)
+{
+    int nprocs = 16;
+    int n, status;
+    pid_t pid;
+
+    if (3 < argc && 0 == strcmp(argv[1], "--client")) {
+        return client(strtol(argv[2], NULL, 10), 0 == strcmp(argv[3], "multi"));
+    }
+    if (1 < argc) {
+        nprocs = strtol(argv[1], NULL, 10);
+    }
+    if (nprocs < 2) {
+        fprintf(stderr, "need at least 2 procs\n");
+        return 1;
+    }
+
+    fprintf(stdout, "%d procs, one key from each peer\n%-16s %12s %12s\n", nprocs, "",
+            "us/sweep", "us/peer");
+    for (n = 0; n < 2; n++) {
+        fflush(stdout);
+        pid = fork();
+        if (0 == pid) {
+            exit(server(argv[0], nprocs, 1 == n));
+        }
+        if (pid < 0 || pid != waitpid(pid, &status, 0) || !WIFEXITED(status)
+            || 0 != WEXITSTATUS(status)) {
+            fprintf(stderr, "client failed\n");
+            return 1;
+        }
+    }
+    return 0;
+}
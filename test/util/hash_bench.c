@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measures the cost of pmix_hash_store and pmix_hash_fetch as the
+ * number of keys stored for a rank grows.
+ *
+ * Usage: hash_bench [nfetches]
+ */
+
+#include "src/include/pmix_config.h"
+#include "include/pmix_server.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "src/class/pmix_hash_table.h"
+#include "src/include/pmix_globals.h"
+#include "src/util/hash.h"
+
+#include "bench_util.h"
+
+int main(int argc, char **argv)
+{
+    static const int nkeys[] = {10, 30, 100, 300, 1000};
+    pmix_hash_table_t table;
+    pmix_kval_t *kv;
+    pmix_value_t *val;
+    pmix_status_t rc;
+    char key[PMIX_MAX_KEYLEN + 1];
+    double start, store_ns, fetch_ns;
+    int nfetches = 1000000;
+    int i, n, k;
+    uint32_t u32;
+
+    if (1 < argc) {
+        nfetches = strtol(argv[1], NULL, 10);
+    }
+    if (0 != bench_server_init(NULL)) {
+        return 1;
+    }
+
+    fprintf(stdout, "%8s %14s %14s\n", "keys", "store ns/op", "fetch ns/op");
+    for (i = 0; i < (int) (sizeof(nkeys) / sizeof(nkeys[0])); i++) {
+        PMIX_CONSTRUCT(&table, pmix_hash_table_t);
+        pmix_hash_table_init(&table, 256);
+
+        start = bench_now();
+        for (k = 0; k < nkeys[i]; k++) {
+            kv = PMIX_NEW(pmix_kval_t);
+            snprintf(key, sizeof(key), "pmix.bench.key.%d", k);
+            kv->key = strdup(key);
+            u32 = k;
+            PMIX_VALUE_CREATE(kv->value, 1);
+            PMIx_Value_load(kv->value, &u32, PMIX_UINT32);
+            rc = pmix_hash_store(&table, 0, kv);
+            PMIX_RELEASE(kv);
+            if (PMIX_SUCCESS != rc) {
+                fprintf(stderr, "pmix_hash_store failed: %s\n", PMIx_Error_string(rc));
+                return 1;
+            }
+        }
+        store_ns = (bench_now() - start) / nkeys[i];
+
+        start = bench_now();
+        for (n = 0; n < nfetches; n++) {
+            k = (int) (((unsigned) n * 2654435761u) % (unsigned) nkeys[i]);
+            snprintf(key, sizeof(key), "pmix.bench.key.%d", k);
+            rc = pmix_hash_fetch(&table, 0, key, &val);
+            if (PMIX_SUCCESS != rc || (int) val->data.uint32 != k) {
+                fprintf(stderr, "pmix_hash_fetch failed for %s\n", key);
+                return 1;
+            }
+            PMIX_VALUE_RELEASE(val);
+        }
+        fetch_ns = (bench_now() - start) / nfetches;
+
+        fprintf(stdout, "%8d %14.1f %14.1f\n", nkeys[i], store_ns, fetch_ns);
+        pmix_hash_remove_data(&table, 0, NULL);
+        PMIX_DESTRUCT(&table);
+    }
+
+    PMIx_server_finalize();
+    return 0;
+}
@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measures unpacking the job-level data of a large job - the data a
+ * client receives from its server during PMIx_Init - one kval at a
+ * time, both onto the heap and into an arena released in one call,
+ * and then storing it the way the client does. Reported are the
+ * number of allocations made (when the bench can count them) and
+ * the time taken. Every kval unpacked either way is first checked
+ * against the one that was packed.
+ *
+ * Usage: jobinfo_arena_bench [nnodes] [ppn] [iterations]
+ */
+
+#include "src/include/pmix_config.h"
+#include "include/pmix_server.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "src/class/pmix_arena.h"
+#include "src/client/pmix_client_ops.h"
+#include "src/include/pmix_globals.h"
+#include "src/mca/bfrops/base/base.h"
+#include "src/mca/gds/gds.h"
+
+#include "bench_util.h"
+
+#ifdef __GLIBC__
+/* count the allocations made by the library by interposing on the
+ * allocator - glibc provides the real one under these names */
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t nmemb, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+
+static volatile unsigned long nallocs = 0;
+
+PMIX_EXPORT void *malloc(size_t size)
+{
+    ++nallocs;
+    return __libc_malloc(size);
+}
+
+PMIX_EXPORT void *calloc(size_t nmemb, size_t size)
+{
+    ++nallocs;
+    return __libc_calloc(nmemb, size);
+}
+
+PMIX_EXPORT void *realloc(void *ptr, size_t size)
+{
+    ++nallocs;
+    return __libc_realloc(ptr, size);
+}
+#    define COUNTING true
+#else
+static unsigned long nallocs = 0;
+#    define COUNTING false
+#endif
+
+/* job-level keys followed by an info array for each node */
+static pmix_info_t *load(int nnodes, int ppn, size_t *ninfo)
+{
+    pmix_info_t *info, *iptr;
+    pmix_data_array_t *darray;
+    char *map, *procs, tmp[64];
+    size_t n = 0, len;
+    uint32_t u32;
+    int i, j;
+
+    *ninfo = 4 + nnodes;
+    PMIX_INFO_CREATE(info, *ninfo);
+
+    PMIX_INFO_LOAD(&info[n++], PMIX_JOBID, "jobinfo_arena_bench", PMIX_STRING);
+    u32 = nnodes * ppn;
+    PMIX_INFO_LOAD(&info[n++], PMIX_JOB_SIZE, &u32, PMIX_UINT32);
+    map = (char *) calloc(nnodes, 16);
+    procs = (char *) calloc(nnodes * ppn, 12);
+    for (i = 0, len = 0; i < nnodes; i++) {
+        len += sprintf(map + len, "%snode%05d", 0 == i ? "" : ",", i);
+    }
+    for (i = 0, len = 0; i < nnodes * ppn; i++) {
+        len += sprintf(procs + len, "%s%d", 0 == i ? "" : (0 == i % ppn ? ";" : ","), i);
+    }
+    PMIX_INFO_LOAD(&info[n++], PMIX_NODE_MAP, map, PMIX_STRING);
+    PMIX_INFO_LOAD(&info[n++], PMIX_PROC_MAP, procs, PMIX_STRING);
+    free(map);
+    free(procs);
+
+    for (i = 0; i < nnodes; i++) {
+        PMIX_DATA_ARRAY_CREATE(darray, 5, PMIX_INFO);
+        iptr = (pmix_info_t *) darray->array;
+        snprintf(tmp, sizeof(tmp), "node%05d", i);
+        PMIX_INFO_LOAD(&iptr[0], PMIX_HOSTNAME, tmp, PMIX_STRING);
+        u32 = i;
+        PMIX_INFO_LOAD(&iptr[1], PMIX_NODEID, &u32, PMIX_UINT32);
+        for (j = 0, len = 0; j < ppn; j++) {
+            len += snprintf(tmp + len, sizeof(tmp) - len, "%s%d", 0 == j ? "" : ",",
+                            i * ppn + j);
+        }
+        PMIX_INFO_LOAD(&iptr[2], PMIX_LOCAL_PEERS, tmp, PMIX_STRING);
+        u32 = ppn;
+        PMIX_INFO_LOAD(&iptr[3], PMIX_LOCAL_SIZE, &u32, PMIX_UINT32);
+        u32 = i * ppn;
+        PMIX_INFO_LOAD(&iptr[4], PMIX_LOCALLDR, &u32, PMIX_PROC_RANK);
+        PMIX_LOAD_KEY(info[n].key, PMIX_NODE_INFO_ARRAY);
+        info[n].value.type = PMIX_DATA_ARRAY;
+        info[n].value.data.darray = darray;
+        ++n;
+    }
+    return info;
+}
+
+static void report(const char *what, unsigned long allocs, double ms)
+{
+    if (COUNTING) {
+        fprintf(stdout, "%-9s %12lu %9.2f\n", what, allocs, ms);
+    } else {
+        fprintf(stdout, "%-9s %12s %9.2f\n", what, "n/a", ms);
+    }
+}
+
+/* true if an unpacked value matches the one that was packed */
+static bool same(const pmix_value_t *a, const pmix_value_t *b)
+{
+    pmix_info_t *ia, *ib;
+    size_t n;
+
+    if (a->type != b->type) {
+        return false;
+    }
+    switch (a->type) {
+    case PMIX_STRING:
+        return 0 == strcmp(a->data.string, b->data.string);
+    case PMIX_UINT32:
+        return a->data.uint32 == b->data.uint32;
+    case PMIX_PROC_RANK:
+        return a->data.rank == b->data.rank;
+    case PMIX_DATA_ARRAY:
+        if (PMIX_INFO != a->data.darray->type || PMIX_INFO != b->data.darray->type
+            || a->data.darray->size != b->data.darray->size) {
+            return false;
+        }
+        ia = (pmix_info_t *) a->data.darray->array;
+        ib = (pmix_info_t *) b->data.darray->array;
+        for (n = 0; n < a->data.darray->size; n++) {
+            if (!PMIX_CHECK_KEY(&ia[n], ib[n].key) || !same(&ia[n].value, &ib[n].value)) {
+                return false;
+            }
+        }
+        return true;
+    default:
+        return false;
+    }
+}
+
+/* unpack every kval in the buffer, onto the heap or into an arena,
+ * and release each again before the next as the client does. If
+ * info is given, each kval must match the next of its ninfo entries */
+static int unpack_all(pmix_buffer_t *buf, bool arena, const pmix_info_t *info, size_t ninfo)
+{
+    pmix_arena_t a;
+    pmix_kval_t *kv;
+    pmix_status_t rc;
+    int32_t cnt;
+    size_t n = 0;
+
+    if (arena) {
+        PMIX_CONSTRUCT(&a, pmix_arena_t);
+    }
+    while (1) {
+        cnt = 1;
+        if (arena) {
+            kv = PMIX_NEW_TMA(pmix_kval_t, &a.tma);
+            PMIX_BFROPS_UNPACK_TMA(rc, pmix_globals.mypeer, buf, kv, &cnt, PMIX_KVAL, &a.tma);
+        } else {
+            kv = PMIX_NEW(pmix_kval_t);
+            PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buf, kv, &cnt, PMIX_KVAL);
+        }
+        if (PMIX_SUCCESS == rc && NULL != info) {
+            if (ninfo <= n || !PMIX_CHECK_KEY(&info[n], kv->key)
+                || !same(kv->value, &info[n].value)) {
+                fprintf(stderr, "%s unpack: kval %lu does not match\n", arena ? "arena" : "heap",
+                        (unsigned long) n);
+                rc = PMIX_ERR_BAD_PARAM;
+            }
+            ++n;
+        }
+        PMIX_RELEASE(kv);
+        if (PMIX_SUCCESS != rc) {
+            break;
+        }
+        if (arena) {
+            pmix_arena_reset(&a);
+        }
+    }
+    if (arena) {
+        PMIX_DESTRUCT(&a);
+    }
+    if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc) {
+        fprintf(stderr, "unpack failed: %s\n", PMIx_Error_string(rc));
+        return 1;
+    }
+    if (NULL != info && n != ninfo) {
+        fprintf(stderr, "%s unpack: found %lu of %lu kvals\n", arena ? "arena" : "heap",
+                (unsigned long) n, (unsigned long) ninfo);
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    pmix_buffer_t buf;
+    pmix_namespace_t *nptr;
+    pmix_info_t *info;
+    pmix_kval_t kv;
+    pmix_status_t rc;
+    size_t ninfo, n;
+    unsigned long allocs;
+    int nnodes = 10000, ppn = 8, iters = 10, i, m;
+    double start, elapsed;
+    char name[PMIX_MAX_NSLEN + 1];
+
+    if (1 < argc) {
+        nnodes = strtol(argv[1], NULL, 10);
+    }
+    if (2 < argc) {
+        ppn = strtol(argv[2], NULL, 10);
+    }
+    if (3 < argc) {
+        iters = strtol(argv[3], NULL, 10);
+    }
+    if (0 != bench_server_init(NULL)) {
+        return 1;
+    }
+
+    /* pack the job info as the server does for its clients */
+    info = load(nnodes, ppn, &ninfo);
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    PMIX_BFROPS_ASSIGN_TYPE(pmix_globals.mypeer, &buf);
+    PMIX_CONSTRUCT(&kv, pmix_kval_t);
+    for (n = 0; n < ninfo; n++) {
+        kv.key = info[n].key;
+        kv.value = &info[n].value;
+        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &buf, &kv, 1, PMIX_KVAL);
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "pack failed: %s\n", PMIx_Error_string(rc));
+            return 1;
+        }
+    }
+    kv.key = NULL;
+    kv.value = NULL;
+    PMIX_DESTRUCT(&kv);
+
+    /* both ways must give back what was packed */
+    for (m = 0; m < 2; m++) {
+        buf.unpack_ptr = buf.base_ptr;
+        if (0 != unpack_all(&buf, 1 == m, info, ninfo)) {
+            return 1;
+        }
+    }
+    PMIX_INFO_FREE(info, ninfo);
+
+    fprintf(stdout, "%d nodes, %d procs per node, %lu bytes of job info, %s module\n", nnodes,
+            ppn, (unsigned long) buf.bytes_used, pmix_globals.mypeer->nptr->compat.bfrops->version);
+    fprintf(stdout, "%-9s %12s %9s\n", "unpack", "allocs", "ms");
+    for (m = 0; m < 2; m++) {
+        allocs = 0;
+        elapsed = 0.0;
+        for (i = 0; i < iters; i++) {
+            buf.unpack_ptr = buf.base_ptr;
+            allocs -= nallocs;
+            start = bench_now();
+            if (0 != unpack_all(&buf, 1 == m, NULL, 0)) {
+                return 1;
+            }
+            elapsed += bench_now() - start;
+            allocs += nallocs;
+        }
+        report(0 == m ? "heap" : "arena", allocs / iters, elapsed / iters / 1e6);
+    }
+
+    /* store it the way a client does during PMIx_Init - each time
+     * for a new nspace so every store starts from nothing */
+    allocs = 0;
+    elapsed = 0.0;
+    for (i = 0; i < iters; i++) {
+        snprintf(name, sizeof(name), "jobinfo_arena_bench.%d", i);
+        nptr = PMIX_NEW(pmix_namespace_t);
+        nptr->nspace = strdup(name);
+        pmix_nspace_register(nptr);
+        buf.unpack_ptr = buf.base_ptr;
+        allocs -= nallocs;
+        start = bench_now();
+        PMIX_GDS_STORE_JOB_INFO(rc, pmix_client_globals.myserver, name, &buf);
+        elapsed += bench_now() - start;
+        allocs += nallocs;
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "store failed: %s\n", PMIx_Error_string(rc));
+            return 1;
+        }
+    }
+    report("store", allocs / iters, elapsed / iters / 1e6);
+
+    PMIX_DESTRUCT(&buf);
+    PMIx_server_finalize();
+    return 0;
+}
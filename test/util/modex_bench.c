@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measures what compressing the data collected by a fence costs
+ * and saves. Has every local proc commit endpoint data that looks
+ * like a fabric worker address - mostly the same for all procs on
+ * a node - and then fence with data collection. Reports the bytes
+ * handed to the host for the node, and the time taken to assemble
+ * them and to store them on a receiving node, with and without
+ * compression, for a range of procs per node.
+ *
+ * Usage: modex_bench [nrounds] [addrsize]
+ */
+
+#include "src/include/pmix_config.h"
+#include "include/pmix_server.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "src/include/pmix_globals.h"
+#include "src/mca/bfrops/bfrops.h"
+#include "src/mca/gds/gds.h"
+#include "src/server/pmix_server_ops.h"
+
+#include "bench_util.h"
+
+#define BENCH_NSPACE "modex_bench"
+
+static size_t addrsize = 256;
+static double collect_start, collect_ns, store_ns;
+static size_t wire_bytes;
+static int nerrors = 0;
+
+/* the fence is complete on our node - store the data as a
+ * receiving node would */
+static pmix_status_t fence_nb(const pmix_proc_t procs[], size_t nprocs, const pmix_info_t info[],
+                              size_t ninfo, char *data, size_t ndata, pmix_modex_cbfunc_t cbfunc,
+                              void *cbdata)
+{
+    pmix_server_trkr_t *trk = (pmix_server_trkr_t *) cbdata;
+    pmix_server_caddy_t *cd;
+    pmix_buffer_t xfer;
+    pmix_status_t rc;
+    double start;
+
+    (void) procs;
+    (void) nprocs;
+    (void) info;
+    (void) ninfo;
+    (void) cbfunc;
+    collect_ns += bench_now() - collect_start;
+    wire_bytes = ndata;
+
+    cd = (pmix_server_caddy_t *) pmix_list_get_first(&trk->local_cbs);
+    start = bench_now();
+    PMIX_CONSTRUCT(&xfer, pmix_buffer_t);
+    PMIX_LOAD_BUFFER(pmix_globals.mypeer, &xfer, data, ndata);
+    PMIX_GDS_STORE_MODEX(rc, cd->peer->nptr, &xfer, trk);
+    PMIX_DESTRUCT(&xfer);
+    store_ns += bench_now() - start;
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "storing the fence data failed: %s\n", PMIx_Error_string(rc));
+        nerrors++;
+    }
+    return PMIX_SUCCESS;
+}
+
+static void modex_cbfunc(pmix_status_t status, const char *data, size_t ndata, void *cbdata,
+                         pmix_release_cbfunc_t relfn, void *relcbdata)
+{
+    (void) status;
+    (void) data;
+    (void) ndata;
+    (void) cbdata;
+    if (NULL != relfn) {
+        relfn(relcbdata);
+    }
+}
+
+/* most of a worker address describes the node and the fabric,
+ * so only the last few bytes differ between the procs */
+static void endpoint(pmix_rank_t rank, uint8_t *addr)
+{
+    uint32_t seed = 12345;
+    size_t n;
+
+    for (n = 0; n < addrsize; n++) {
+        seed = seed * 1103515245 + 12345;
+        addr[n] = (uint8_t) (seed >> 16);
+    }
+    for (n = 0; n < 16 && n < addrsize; n++) {
+        addr[addrsize - 1 - n] = (uint8_t) ((rank * 2654435761u) >> (n % 4 * 8));
+    }
+}
+
+typedef struct {
+    pmix_object_t super;
+    pmix_event_t ev;
+    pmix_peer_t **peers;
+    int nprocs;
+    int nrounds;
+    volatile int active;
+} bench_caddy_t;
+static PMIX_CLASS_INSTANCE(bench_caddy_t, pmix_object_t, NULL, NULL);
+
+/* commit the endpoint data of each proc as if it had called PMIx_Commit */
+static void commit_all(int sd, short args, void *cbdata)
+{
+    bench_caddy_t *cd = (bench_caddy_t *) cbdata;
+    pmix_buffer_t buf, blob;
+    pmix_scope_t scope = PMIX_REMOTE;
+    pmix_byte_object_t bo;
+    pmix_peer_t *peer;
+    pmix_kval_t kv;
+    pmix_value_t val;
+    pmix_status_t rc;
+    uint8_t *addr;
+    int n;
+
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+    addr = (uint8_t *) malloc(addrsize);
+    for (n = 0; n < cd->nprocs; n++) {
+        peer = cd->peers[n];
+        PMIX_CONSTRUCT(&blob, pmix_buffer_t);
+        PMIX_CONSTRUCT(&kv, pmix_kval_t);
+        kv.value = &val;
+        endpoint(n, addr);
+        bo.bytes = (char *) addr;
+        bo.size = addrsize;
+        kv.key = "bench.worker.address";
+        PMIX_VALUE_LOAD(&val, &bo, PMIX_BYTE_OBJECT);
+        PMIX_BFROPS_PACK(rc, peer, &blob, &kv, 1, PMIX_KVAL);
+        PMIX_VALUE_DESTRUCT(&val);
+        if (PMIX_SUCCESS == rc) {
+            kv.key = "bench.hostname";
+            PMIX_VALUE_LOAD(&val, "node0042.cluster.example", PMIX_STRING);
+            PMIX_BFROPS_PACK(rc, peer, &blob, &kv, 1, PMIX_KVAL);
+            PMIX_VALUE_DESTRUCT(&val);
+        }
+        kv.key = NULL;
+        kv.value = NULL;
+        PMIX_DESTRUCT(&kv);
+        PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+        if (PMIX_SUCCESS == rc) {
+            PMIX_BFROPS_PACK(rc, peer, &buf, &scope, 1, PMIX_SCOPE);
+        }
+        if (PMIX_SUCCESS == rc) {
+            PMIX_BFROPS_PACK(rc, peer, &buf, &blob, 1, PMIX_BUFFER);
+        }
+        if (PMIX_SUCCESS == rc) {
+            rc = pmix_server_commit(peer, &buf);
+        }
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "commit for rank %d failed: %s\n", n, PMIx_Error_string(rc));
+            exit(1);
+        }
+        PMIX_DESTRUCT(&buf);
+        PMIX_DESTRUCT(&blob);
+    }
+    free(addr);
+    cd->active = 0;
+}
+
+/* have every proc enter a fence that collects data */
+static void run_rounds(int sd, short args, void *cbdata)
+{
+    bench_caddy_t *cd = (bench_caddy_t *) cbdata;
+    pmix_server_trkr_t *trk, *next;
+    pmix_server_caddy_t *scd;
+    pmix_buffer_t buf;
+    pmix_proc_t proc;
+    pmix_info_t info;
+    size_t nprocs = 1, ninfo = 1;
+    bool collect = true;
+    pmix_status_t rc;
+    int r, n;
+
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+    PMIX_LOAD_PROCID(&proc, cd->peers[0]->info->pname.nspace, PMIX_RANK_WILDCARD);
+    PMIX_INFO_LOAD(&info, PMIX_COLLECT_DATA, &collect, PMIX_BOOL);
+    for (r = 0; r < cd->nrounds; r++) {
+        for (n = 0; n < cd->nprocs; n++) {
+            PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+            PMIX_BFROPS_PACK(rc, cd->peers[n], &buf, &nprocs, 1, PMIX_SIZE);
+            if (PMIX_SUCCESS == rc) {
+                PMIX_BFROPS_PACK(rc, cd->peers[n], &buf, &proc, 1, PMIX_PROC);
+            }
+            if (PMIX_SUCCESS == rc) {
+                PMIX_BFROPS_PACK(rc, cd->peers[n], &buf, &ninfo, 1, PMIX_SIZE);
+            }
+            if (PMIX_SUCCESS == rc) {
+                PMIX_BFROPS_PACK(rc, cd->peers[n], &buf, &info, 1, PMIX_INFO);
+            }
+            scd = PMIX_NEW(pmix_server_caddy_t);
+            PMIX_RETAIN(cd->peers[n]);
+            scd->peer = cd->peers[n];
+            /* the last one in assembles the data */
+            collect_start = bench_now();
+            if (PMIX_SUCCESS == rc) {
+                rc = pmix_server_fence(scd, &buf, modex_cbfunc, NULL);
+            }
+            if (PMIX_SUCCESS != rc) {
+                fprintf(stderr, "fence from rank %d failed: %s\n", n, PMIx_Error_string(rc));
+                exit(1);
+            }
+            PMIX_DESTRUCT(&buf);
+        }
+        PMIX_LIST_FOREACH_SAFE (trk, next, &pmix_server_globals.collectives, pmix_server_trkr_t) {
+            pmix_server_remove_tracker(trk);
+            PMIX_RELEASE(trk);
+        }
+    }
+    PMIX_INFO_DESTRUCT(&info);
+    cd->active = 0;
+}
+
+static void run(bench_caddy_t *cd, void (*fn)(int, short, void *))
+{
+    cd->active = 1;
+    pmix_event_assign(&cd->ev, pmix_globals.evbase, -1, EV_WRITE, fn, cd);
+    pmix_event_active(&cd->ev, EV_WRITE, 1);
+    bench_wait_for(&cd->active);
+}
+
+/* register a job with all of its procs local to us */
+static pmix_peer_t **setup_job(int nprocs)
+{
+    pmix_namespace_t *nptr;
+    pmix_rank_info_t *info;
+    pmix_nspace_t nspace;
+    pmix_peer_t **peers;
+
+    snprintf(nspace, sizeof(nspace), "%s-%d", BENCH_NSPACE, nprocs);
+    if (0 != bench_register_job(nspace, nprocs, 0, 0)) {
+        exit(1);
+    }
+    nptr = pmix_nspace_lookup(nspace);
+    if (NULL == nptr) {
+        fprintf(stderr, "nspace %s not found\n", nspace);
+        exit(1);
+    }
+    /* the procs never connected, so use our own buffer format */
+    nptr->compat = pmix_globals.mypeer->nptr->compat;
+    peers = (pmix_peer_t **) calloc(nprocs, sizeof(pmix_peer_t *));
+    PMIX_LIST_FOREACH (info, &nptr->ranks, pmix_rank_info_t) {
+        peers[info->pname.rank] = PMIX_NEW(pmix_peer_t);
+        PMIX_RETAIN(info);
+        peers[info->pname.rank]->info = info;
+        PMIX_RETAIN(nptr);
+        peers[info->pname.rank]->nptr = nptr;
+    }
+    return peers;
+}
+
+int main(int argc, char **argv)
+{
+    static const int counts[] = {8, 32, 128, 512};
+    pmix_server_module_t mymodule;
+    bench_caddy_t *cd;
+    size_t bytes[2];
+    double collect[2], store[2];
+    int nrounds = 20;
+    int i, m, n;
+
+    if (1 < argc) {
+        nrounds = strtol(argv[1], NULL, 10);
+    }
+    if (2 < argc) {
+        addrsize = strtoul(argv[2], NULL, 10);
+    }
+    /* the data must go up to the host even though all
+     * the participants are local */
+    setenv("PMIX_MCA_pmix_server_fence_localonly_opt", "0", 1);
+    memset(&mymodule, 0, sizeof(mymodule));
+    mymodule.fence_nb = fence_nb;
+    if (0 != bench_server_init(&mymodule)) {
+        return 1;
+    }
+
+    fprintf(stdout, "%8s %10s %10s %12s %12s %12s %12s %10s\n", "procs", "raw bytes", "zip bytes",
+            "raw pack us", "zip pack us", "raw store us", "zip store us", "added us");
+    for (i = 0; i < (int) (sizeof(counts) / sizeof(counts[0])); i++) {
+        cd = PMIX_NEW(bench_caddy_t);
+        cd->nprocs = counts[i];
+        cd->nrounds = nrounds;
+        cd->peers = setup_job(counts[i]);
+        run(cd, commit_all);
+        for (m = 0; m < 2; m++) {
+            /* set between events, so the progress thread sees it */
+            pmix_server_globals.modex_compress_threshold = m;
+            pmix_server_globals.modex_compress_floor = 0;
+            collect_ns = 0.0;
+            store_ns = 0.0;
+            run(cd, run_rounds);
+            bytes[m] = wire_bytes;
+            collect[m] = collect_ns / nrounds / 1e3;
+            store[m] = store_ns / nrounds / 1e3;
+        }
+        if (0 != nerrors) {
+            return 1;
+        }
+        fprintf(stdout, "%8d %10zu %10zu %12.1f %12.1f %12.1f %12.1f %10.1f\n", counts[i], bytes[0],
+                bytes[1], collect[0], collect[1], store[0], store[1],
+                collect[1] + store[1] - collect[0] - store[0]);
+        for (n = 0; n < counts[i]; n++) {
+            PMIX_RELEASE(cd->peers[n]);
+        }
+        free(cd->peers);
+        PMIX_RELEASE(cd);
+    }
+
+    PMIx_server_finalize();
+    return 0;
+}
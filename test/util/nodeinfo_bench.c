@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measures the cost of retrieving node-level info by hostname
+ * and by nodeid as the number of nodes in a job grows.
+ *
+ * Usage: nodeinfo_bench [nfetches]
+ */
+
+#include "src/include/pmix_config.h"
+#include "include/pmix.h"
+#include "include/pmix_server.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench_util.h"
+
+/* register a job with one proc and the given number of nodes,
+ * each carrying a node-level value */
+static pmix_status_t register_job(const char *nspace, uint32_t nnodes)
+{
+    pmix_info_t *info, *iptr;
+    pmix_data_array_t *darray;
+    volatile int active = 1;
+    char hostname[64];
+    uint32_t n, u32 = 1;
+    pmix_status_t rc;
+
+    PMIX_INFO_CREATE(info, nnodes + 1);
+    PMIX_INFO_LOAD(&info[0], PMIX_JOB_SIZE, &u32, PMIX_UINT32);
+    for (n = 0; n < nnodes; n++) {
+        PMIX_DATA_ARRAY_CREATE(darray, 3, PMIX_INFO);
+        iptr = (pmix_info_t *) darray->array;
+        snprintf(hostname, sizeof(hostname), "node%06u", n);
+        PMIX_INFO_LOAD(&iptr[0], PMIX_HOSTNAME, hostname, PMIX_STRING);
+        PMIX_INFO_LOAD(&iptr[1], PMIX_NODEID, &n, PMIX_UINT32);
+        PMIX_INFO_LOAD(&iptr[2], PMIX_NODE_SIZE, &n, PMIX_UINT32);
+        PMIX_INFO_LOAD(&info[n + 1], PMIX_NODE_INFO_ARRAY, darray, PMIX_DATA_ARRAY);
+        PMIX_DATA_ARRAY_FREE(darray);
+    }
+    rc = PMIx_server_register_nspace(nspace, 0, info, nnodes + 1, bench_opcbfunc, (void *) &active);
+    if (PMIX_SUCCESS == rc) {
+        bench_wait_for(&active);
+    } else if (PMIX_OPERATION_SUCCEEDED == rc) {
+        rc = PMIX_SUCCESS;
+    }
+    PMIX_INFO_FREE(info, nnodes + 1);
+    return rc;
+}
+
+static double time_fetches(const pmix_proc_t *proc, uint32_t nnodes, int nfetches, bool byname)
+{
+    pmix_info_t qual[2];
+    pmix_value_t *val;
+    char hostname[64];
+    double start;
+    uint32_t nid;
+    pmix_status_t rc;
+    int n;
+
+    PMIX_INFO_LOAD(&qual[0], PMIX_NODE_INFO, NULL, PMIX_BOOL);
+    start = bench_now();
+    for (n = 0; n < nfetches; n++) {
+        nid = (uint32_t) (((unsigned) n * 2654435761u) % nnodes);
+        if (byname) {
+            snprintf(hostname, sizeof(hostname), "node%06u", nid);
+            PMIX_INFO_LOAD(&qual[1], PMIX_HOSTNAME, hostname, PMIX_STRING);
+        } else {
+            PMIX_INFO_LOAD(&qual[1], PMIX_NODEID, &nid, PMIX_UINT32);
+        }
+        rc = PMIx_Get(proc, PMIX_NODE_SIZE, qual, 2, &val);
+        PMIX_INFO_DESTRUCT(&qual[1]);
+        if (PMIX_SUCCESS != rc || val->data.uint32 != nid) {
+            fprintf(stderr, "PMIx_Get failed for node %u: %s\n", nid, PMIx_Error_string(rc));
+            exit(1);
+        }
+        PMIX_VALUE_RELEASE(val);
+    }
+    PMIX_INFO_DESTRUCT(&qual[0]);
+    return (bench_now() - start) / nfetches;
+}
+
+int main(int argc, char **argv)
+{
+    static const uint32_t nnodes[] = {1000, 10000, 50000};
+    pmix_proc_t proc;
+    pmix_status_t rc;
+    double byname, byid;
+    int nfetches = 100000;
+    int i;
+
+    if (1 < argc) {
+        nfetches = strtol(argv[1], NULL, 10);
+    }
+    if (0 != bench_server_init(NULL)) {
+        return 1;
+    }
+
+    fprintf(stdout, "%8s %18s %18s\n", "nodes", "by hostname ns/op", "by nodeid ns/op");
+    for (i = 0; i < (int) (sizeof(nnodes) / sizeof(nnodes[0])); i++) {
+        PMIX_LOAD_PROCID(&proc, "nodeinfo_bench", PMIX_RANK_WILDCARD);
+        snprintf(proc.nspace, sizeof(proc.nspace), "nodeinfo_bench.%d", i);
+        rc = register_job(proc.nspace, nnodes[i]);
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "PMIx_server_register_nspace failed: %s\n", PMIx_Error_string(rc));
+            return 1;
+        }
+        byname = time_fetches(&proc, nnodes[i], nfetches, true);
+        byid = time_fetches(&proc, nnodes[i], nfetches, false);
+        fprintf(stdout, "%8u %18.1f %18.1f\n", nnodes[i], byname, byid);
+        PMIx_server_deregister_nspace(proc.nspace, NULL, NULL);
+    }
+
+    PMIx_server_finalize();
+    return 0;
+}
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measures how fast large integer arrays are packed and unpacked
+ * when squashed one value at a time by the active psquash component,
+ * when encoded as group varints by the flex128 component, and when
+ * copied as they are into a native buffer.
+ *
+ * Group varints are turned on here unless the environment says
+ * otherwise. Set PMIX_MCA_psquash_flex128_simd=0 to measure the plain
+ * C decoder, or PMIX_MCA_psquash=native to compare against the native
+ * psquash component (which has no group varints).
+ *
+ * Usage: psquash_gvint_bench [nelems] [iterations]
+ */
+
+#include "src/include/pmix_config.h"
+#include "include/pmix_server.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "src/include/pmix_globals.h"
+#include "src/mca/bfrops/base/base.h"
+#include "src/mca/psquash/psquash.h"
+
+#include "bench_util.h"
+
+/* pack and unpack the array iters times, returning the
+ * nanoseconds per element for each direction */
+static int run(pmix_bfrop_buffer_type_t type, void *src, void *dst, int32_t nelems,
+               pmix_data_type_t dtype, size_t elsize, int iters, double *pk, double *upk,
+               size_t *nbytes)
+{
+    pmix_bfrops_module_t *bfrops = pmix_globals.mypeer->nptr->compat.bfrops;
+    pmix_buffer_t buf;
+    pmix_status_t rc;
+    double start, tpack = 0.0, tunpack = 0.0;
+    int32_t cnt;
+    int n;
+
+    for (n = 0; n < iters; n++) {
+        PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+        buf.type = type;
+        start = bench_now();
+        rc = bfrops->pack(&buf, src, nelems, dtype);
+        tpack += bench_now() - start;
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "pack failed: %s\n", PMIx_Error_string(rc));
+            return 1;
+        }
+        *nbytes = buf.bytes_used;
+        memset(dst, 0, nelems * elsize);
+        cnt = nelems;
+        start = bench_now();
+        rc = bfrops->unpack(&buf, dst, &cnt, dtype);
+        tunpack += bench_now() - start;
+        if (PMIX_SUCCESS != rc || cnt != nelems) {
+            fprintf(stderr, "unpack failed: %s\n", PMIx_Error_string(rc));
+            return 1;
+        }
+        if (0 != memcmp(src, dst, nelems * elsize)) {
+            fprintf(stderr, "unpacked data does not match\n");
+            return 1;
+        }
+        PMIX_DESTRUCT(&buf);
+    }
+    *pk = tpack / iters / nelems;
+    *upk = tunpack / iters / nelems;
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    pmix_psquash_encode_ints_fn_t encode_ints;
+    pmix_psquash_decode_ints_fn_t decode_ints;
+    uint32_t *ranks;
+    int32_t *mixed;
+    uint16_t *shorts;
+    void *dst;
+    int32_t nelems = 100000;
+    int iters = 20;
+    double pk, upk;
+    size_t nbytes;
+    int i, d, m;
+    struct {
+        const char *name;
+        void *data;
+        pmix_data_type_t type;
+        size_t size;
+    } sets[3];
+    const char *modes[] = {"native buffer", "per value", "group varint"};
+
+    if (1 < argc) {
+        nelems = strtol(argv[1], NULL, 10);
+    }
+    if (2 < argc) {
+        iters = strtol(argv[2], NULL, 10);
+    }
+    setenv("PMIX_MCA_psquash_flex128_group_varint", "1", 0);
+    if (0 != bench_server_init(NULL)) {
+        return 1;
+    }
+    encode_ints = pmix_psquash.encode_ints;
+    decode_ints = pmix_psquash.decode_ints;
+
+    /* ranks in order, signed values spread over all lengths, and
+     * small unsigned shorts */
+    ranks = (uint32_t *) calloc(nelems, sizeof(uint32_t));
+    mixed = (int32_t *) calloc(nelems, sizeof(int32_t));
+    shorts = (uint16_t *) calloc(nelems, sizeof(uint16_t));
+    dst = calloc(nelems, sizeof(uint32_t));
+    srand(42);
+    for (i = 0; i < nelems; i++) {
+        ranks[i] = i;
+        mixed[i] = (rand() - RAND_MAX / 2) >> (rand() % 31);
+        shorts[i] = rand() % 1000;
+    }
+    sets[0].name = "rank";
+    sets[0].data = ranks;
+    sets[0].type = PMIX_UINT32;
+    sets[0].size = sizeof(uint32_t);
+    sets[1].name = "int32";
+    sets[1].data = mixed;
+    sets[1].type = PMIX_INT32;
+    sets[1].size = sizeof(int32_t);
+    sets[2].name = "uint16";
+    sets[2].data = shorts;
+    sets[2].type = PMIX_UINT16;
+    sets[2].size = sizeof(uint16_t);
+
+    fprintf(stdout, "%d elements, %s module, psquash %s\n%-7s %-14s %10s %10s %12s\n", nelems,
+            pmix_globals.mypeer->nptr->compat.bfrops->version, pmix_psquash.name, "type",
+            "encoding", "ns/pack", "ns/unpack", "bytes");
+    for (d = 0; d < 3; d++) {
+        for (m = 0; m < 3; m++) {
+            if (2 == m && NULL == encode_ints) {
+                continue;
+            }
+            pmix_psquash.encode_ints = 2 == m ? encode_ints : NULL;
+            pmix_psquash.decode_ints = 2 == m ? decode_ints : NULL;
+            if (0 != run(0 == m ? PMIX_BFROP_BUFFER_NATIVE : PMIX_BFROP_BUFFER_NON_DESC,
+                         sets[d].data, dst, nelems, sets[d].type, sets[d].size, iters, &pk, &upk,
+                         &nbytes)) {
+                return 1;
+            }
+            fprintf(stdout, "%-7s %-14s %10.2f %10.2f %12zu\n", sets[d].name, modes[m], pk, upk,
+                    nbytes);
+        }
+    }
+    pmix_psquash.encode_ints = encode_ints;
+    pmix_psquash.decode_ints = decode_ints;
+
+    free(ranks);
+    free(mixed);
+    free(shorts);
+    free(dst);
+    PMIx_server_finalize();
+    return 0;
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measures the throughput of the PTL send handler when draining
+ * a queue of messages to a peer over a Unix socket pair, with and
+ * without batching queued messages into a single write.
+ *
+ * Usage: ptl_send_bench [nmsgs]
+ */
+
+#include "src/include/pmix_config.h"
+#include "include/pmix_server.h"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "src/include/pmix_globals.h"
+#include "src/mca/ptl/base/base.h"
+
+#include "bench_util.h"
+
+typedef struct {
+    int sd;
+    size_t nbytes;
+} drain_t;
+
+static void *drain(void *arg)
+{
+    drain_t *d = (drain_t *) arg;
+    char buf[65536];
+    ssize_t rc;
+
+    while (0 < d->nbytes) {
+        rc = read(d->sd, buf, sizeof(buf));
+        if (rc <= 0) {
+            break;
+        }
+        d->nbytes -= rc;
+    }
+    return NULL;
+}
+
+/* queue nmsgs messages of the given size to the peer and time
+ * how long it takes the send handler to get them all written */
+static double run(pmix_peer_t *peer, int rsd, size_t msgsize, int nmsgs, int batch)
+{
+    pmix_buffer_t *payload;
+    pmix_ptl_send_t *snd;
+    pthread_t tid;
+    drain_t d;
+    double start;
+    int n;
+
+    payload = PMIX_NEW(pmix_buffer_t);
+    payload->base_ptr = (char *) calloc(1, msgsize);
+    payload->bytes_allocated = msgsize;
+    payload->bytes_used = msgsize;
+    for (n = 0; n < nmsgs; n++) {
+        snd = PMIX_NEW(pmix_ptl_send_t);
+        snd->hdr.tag = htonl(n);
+        snd->hdr.nbytes = htonl((uint32_t) msgsize);
+        PMIX_RETAIN(payload);
+        snd->data = payload;
+        snd->sdptr = (char *) &snd->hdr;
+        snd->sdbytes = sizeof(pmix_ptl_hdr_t);
+        if (NULL == peer->send_msg) {
+            peer->send_msg = snd;
+        } else {
+            pmix_list_append(&peer->send_queue, &snd->super);
+        }
+    }
+    PMIX_RELEASE(payload);
+
+    pmix_ptl_base.max_send_batch = batch;
+    d.sd = rsd;
+    d.nbytes = (size_t) nmsgs * (sizeof(pmix_ptl_hdr_t) + msgsize);
+    pthread_create(&tid, NULL, drain, &d);
+    start = bench_now();
+    while (NULL != peer->send_msg) {
+        pmix_ptl_base_send_handler(peer->sd, 0, peer);
+    }
+    pthread_join(tid, NULL);
+    return (double) nmsgs / ((bench_now() - start) / 1e9);
+}
+
+int main(int argc, char **argv)
+{
+    static const size_t sizes[] = {64, 1024, 16384};
+    pmix_peer_t *peer;
+    double single, batched;
+    int nmsgs = 200000;
+    int sv[2];
+    int i;
+
+    if (1 < argc) {
+        nmsgs = strtol(argv[1], NULL, 10);
+    }
+    if (0 != bench_server_init(NULL)) {
+        return 1;
+    }
+    if (0 != socketpair(AF_UNIX, SOCK_STREAM, 0, sv)) {
+        fprintf(stderr, "socketpair failed\n");
+        return 1;
+    }
+    fcntl(sv[0], F_SETFL, fcntl(sv[0], F_GETFL) | O_NONBLOCK);
+
+    peer = PMIX_NEW(pmix_peer_t);
+    peer->info = PMIX_NEW(pmix_rank_info_t);
+    peer->info->pname.nspace = strdup("ptl_send_bench");
+    peer->info->pname.rank = 0;
+    peer->sd = sv[0];
+
+    fprintf(stdout, "%8s %16s %16s\n", "bytes", "single msgs/s", "batched msgs/s");
+    for (i = 0; i < (int) (sizeof(sizes) / sizeof(sizes[0])); i++) {
+        single = run(peer, sv[1], sizes[i], nmsgs, 1);
+        batched = run(peer, sv[1], sizes[i], nmsgs, PMIX_PTL_MAX_SEND_BATCH);
+        fprintf(stdout, "%8zu %16.0f %16.0f\n", sizes[i], single, batched);
+    }
+
+    peer->sd = -1;
+    PMIX_RELEASE(peer);
+    close(sv[0]);
+    close(sv[1]);
+    PMIx_server_finalize();
+    return 0;
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measures the cost per key of publishing data with PMIx_Put and
+ * PMIx_Commit. Starts a server that launches one client, which puts
+ * batches of keys - one call per key and then all in a single
+ * PMIx_Put_multi call - commits each batch to the server, and
+ * reports the average cost of each phase. The client fails if it
+ * cannot get back the values of the last batch either way put.
+ *
+ * Usage: put_bench [nkeys] [nrounds]
+ */
+
+#include "src/include/pmix_config.h"
+#include "include/pmix.h"
+#include "include/pmix_server.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "bench_util.h"
+
+#define BENCH_NSPACE "put_bench"
+
+static int client(int nkeys, int nrounds)
+{
+    pmix_proc_t myproc;
+    pmix_info_t *info;
+    pmix_value_t *val;
+    pmix_status_t rc;
+    char key[PMIX_MAX_KEYLEN + 1];
+    double start, put[2] = {0.0, 0.0}, commit[2] = {0.0, 0.0};
+    uint64_t u64;
+    int r, n, m;
+
+    rc = PMIx_Init(&myproc, NULL, 0);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "PMIx_Init failed: %s\n", PMIx_Error_string(rc));
+        return 1;
+    }
+    PMIX_INFO_CREATE(info, nkeys);
+    for (r = 0; r < nrounds; r++) {
+        for (m = 0; m < 2; m++) {
+            for (n = 0; n < nkeys; n++) {
+                u64 = (uint64_t) r * nkeys + n;
+                snprintf(info[n].key, PMIX_MAX_KEYLEN, "bench.key.%d.%d", m, n);
+                PMIX_VALUE_LOAD(&info[n].value, &u64, PMIX_UINT64);
+            }
+            start = bench_now();
+            if (0 == m) {
+                for (n = 0; n < nkeys && PMIX_SUCCESS == rc; n++) {
+                    rc = PMIx_Put(PMIX_GLOBAL, info[n].key, &info[n].value);
+                }
+            } else {
+                rc = PMIx_Put_multi(PMIX_GLOBAL, info, nkeys);
+            }
+            put[m] += bench_now() - start;
+            if (PMIX_SUCCESS != rc) {
+                fprintf(stderr, "put failed: %s\n", PMIx_Error_string(rc));
+                return 1;
+            }
+            start = bench_now();
+            rc = PMIx_Commit();
+            commit[m] += bench_now() - start;
+            if (PMIX_SUCCESS != rc) {
+                fprintf(stderr, "PMIx_Commit failed: %s\n", PMIx_Error_string(rc));
+                return 1;
+            }
+        }
+    }
+    PMIX_INFO_FREE(info, nkeys);
+
+    /* both ways must have left the last round's values behind */
+    for (m = 0; m < 2; m++) {
+        for (n = 0; n < nkeys; n++) {
+            snprintf(key, sizeof(key), "bench.key.%d.%d", m, n);
+            rc = PMIx_Get(&myproc, key, NULL, 0, &val);
+            if (PMIX_SUCCESS != rc || PMIX_UINT64 != val->type
+                || (uint64_t) (nrounds - 1) * nkeys + n != val->data.uint64) {
+                fprintf(stderr, "bad value for %s: %s\n", key, PMIx_Error_string(rc));
+                return 1;
+            }
+            PMIX_VALUE_RELEASE(val);
+        }
+    }
+
+    fprintf(stdout, "%d keys x %d rounds (ns/key)\n%-12s %10s %10s %10s\n", nkeys, nrounds, "",
+            "put", "commit", "total");
+    for (m = 0; m < 2; m++) {
+        put[m] /= (double) nrounds * nkeys;
+        commit[m] /= (double) nrounds * nkeys;
+        fprintf(stdout, "%-12s %10.1f %10.1f %10.1f\n", (0 == m) ? "PMIx_Put" : "PMIx_Put_multi",
+                put[m], commit[m], put[m] + commit[m]);
+    }
+    PMIx_Finalize(NULL, 0);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    pmix_nspace_t nspace;
+    pmix_proc_t proc;
+    char *client_argv[5], keys[16], rounds[16];
+    int nkeys = 32;
+    int nrounds = 1000;
+    int ret;
+    pid_t pid;
+
+    if (3 < argc && 0 == strcmp(argv[1], "--client")) {
+        return client(strtol(argv[2], NULL, 10), strtol(argv[3], NULL, 10));
+    }
+    if (1 < argc) {
+        nkeys = strtol(argv[1], NULL, 10);
+    }
+    if (2 < argc) {
+        nrounds = strtol(argv[2], NULL, 10);
+    }
+    if (nkeys < 1 || nrounds < 1) {
+        fprintf(stderr, "need at least one key and one round\n");
+        return 1;
+    }
+
+    if (0 != bench_server_init(NULL)) {
+        return 1;
+    }
+    PMIX_LOAD_NSPACE(nspace, BENCH_NSPACE);
+    if (0 != bench_register_job(nspace, 1, getuid(), getgid())) {
+        return 1;
+    }
+
+    snprintf(keys, sizeof(keys), "%d", nkeys);
+    snprintf(rounds, sizeof(rounds), "%d", nrounds);
+    client_argv[0] = argv[0];
+    client_argv[1] = "--client";
+    client_argv[2] = keys;
+    client_argv[3] = rounds;
+    client_argv[4] = NULL;
+    PMIX_LOAD_PROCID(&proc, nspace, 0);
+    pid = bench_spawn(&proc, client_argv);
+    ret = bench_reap(nspace, &pid, 1);
+    if (0 != ret) {
+        fprintf(stderr, "client failed\n");
+    }
+    PMIx_server_finalize();
+    return ret;
+}
@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Measures the cost and the number of memory allocations of
+ * receiving commit-style messages - a scope followed by a nested
+ * data blob - with and without reuse of receive buffers and
+ * in-place unpacking of the nested blob. Each way is timed first on
+ * the receive path alone, without the socket, and then over a Unix
+ * socket pair. The four ways are run in turn for the given number
+ * of rounds and the fastest round of each is reported, as the time
+ * taken by any one round over the socket depends a good deal on how
+ * the threads are scheduled.
+ *
+ * Usage: recv_bench [nmsgs] [nrounds]
+ */
+
+#include "src/include/pmix_config.h"
+#include "include/pmix_server.h"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "src/include/pmix_globals.h"
+#include "src/mca/bfrops/bfrops.h"
+#include "src/mca/ptl/base/base.h"
+
+#include "bench_util.h"
+
+#define BENCH_TAG 50
+
+#ifdef __GLIBC__
+/* count every allocation made by the process */
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t nmemb, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+
+static volatile long nallocs = 0;
+
+PMIX_EXPORT void *malloc(size_t size)
+{
+    __atomic_add_fetch(&nallocs, 1, __ATOMIC_RELAXED);
+    return __libc_malloc(size);
+}
+
+PMIX_EXPORT void *calloc(size_t nmemb, size_t size)
+{
+    __atomic_add_fetch(&nallocs, 1, __ATOMIC_RELAXED);
+    return __libc_calloc(nmemb, size);
+}
+
+PMIX_EXPORT void *realloc(void *ptr, size_t size)
+{
+    __atomic_add_fetch(&nallocs, 1, __ATOMIC_RELAXED);
+    return __libc_realloc(ptr, size);
+}
+#else
+static volatile long nallocs = 0;
+#endif
+
+static volatile int nrecvd = 0;
+static volatile unsigned blobsum = 0;
+static bool use_view = false;
+
+/* unpack the message the way the server unpacks a commit */
+static void recv_cbfunc(struct pmix_peer_t *peer, pmix_ptl_hdr_t *hdr, pmix_buffer_t *buf,
+                        void *cbdata)
+{
+    pmix_buffer_t b2;
+    pmix_scope_t scope;
+    unsigned sum = 0;
+    int32_t cnt = 1;
+    pmix_status_t rc;
+    bool view = false;
+    size_t n;
+
+    (void) hdr;
+    (void) cbdata;
+    PMIX_BFROPS_UNPACK(rc, peer, buf, &scope, &cnt, PMIX_SCOPE);
+    PMIX_CONSTRUCT(&b2, pmix_buffer_t);
+    cnt = 1;
+    if (use_view) {
+        view = true;
+        PMIX_BFROPS_UNPACK_VIEW(rc, peer, buf, &b2, &cnt, PMIX_BUFFER);
+    } else {
+        PMIX_BFROPS_UNPACK(rc, peer, buf, &b2, &cnt, PMIX_BUFFER);
+    }
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "unpack failed: %s\n", PMIx_Error_string(rc));
+        exit(1);
+    }
+    /* touch the blob as storing it would */
+    for (n = 0; n < b2.bytes_used; n += 64) {
+        sum += (unsigned char) b2.base_ptr[n];
+    }
+    blobsum += sum;
+    if (view) {
+        b2.base_ptr = NULL;
+    }
+    PMIX_DESTRUCT(&b2);
+    __atomic_add_fetch(&nrecvd, 1, __ATOMIC_RELEASE);
+}
+
+typedef struct {
+    int sd;
+    char *msg;
+    size_t size;
+    int nmsgs;
+} feed_t;
+
+static void *feed(void *arg)
+{
+    feed_t *f = (feed_t *) arg;
+    ssize_t rc;
+    size_t sent;
+    int n;
+
+    for (n = 0; n < f->nmsgs; n++) {
+        for (sent = 0; sent < f->size; sent += rc) {
+            rc = write(f->sd, f->msg + sent, f->size - sent);
+            if (rc < 0) {
+                return NULL;
+            }
+        }
+    }
+    return NULL;
+}
+
+/* pack a commit-style message carrying a blob of the given size */
+static void build_body(pmix_buffer_t *body, size_t blobsize)
+{
+    pmix_buffer_t blob;
+    pmix_scope_t scope = PMIX_GLOBAL;
+    pmix_status_t rc;
+
+    PMIX_CONSTRUCT(&blob, pmix_buffer_t);
+    PMIX_BFROPS_ASSIGN_TYPE(pmix_globals.mypeer, &blob);
+    blob.base_ptr = (char *) calloc(1, blobsize);
+    blob.unpack_ptr = blob.base_ptr;
+    blob.pack_ptr = blob.base_ptr + blobsize;
+    blob.bytes_allocated = blob.bytes_used = blobsize;
+    PMIX_CONSTRUCT(body, pmix_buffer_t);
+    PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, body, &scope, 1, PMIX_SCOPE);
+    if (PMIX_SUCCESS == rc) {
+        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, body, &blob, 1, PMIX_BUFFER);
+    }
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "pack failed: %s\n", PMIx_Error_string(rc));
+        exit(1);
+    }
+    PMIX_DESTRUCT(&blob);
+}
+
+/* the work done on the progress thread for each message - getting
+ * a region for the body, filling it, unpacking it and cleaning up -
+ * without the socket and the thread handoff, whose cost varies far
+ * more from one message to the next than any of that work */
+static void run_local(size_t blobsize, int nmsgs, bool reuse, bool view, double *ns,
+                      double *allocs)
+{
+    pmix_buffer_t body, buf;
+    pmix_ptl_hdr_t hdr;
+    long start_allocs;
+    double start;
+    char *data;
+    int n;
+
+    build_body(&body, blobsize);
+    hdr.pindex = 0;
+    hdr.tag = BENCH_TAG;
+    hdr.nbytes = body.bytes_used;
+    pmix_ptl_base.recv_cache_size = reuse ? 16 : 0;
+    use_view = view;
+    start_allocs = nallocs;
+    start = bench_now();
+    for (n = 0; n < nmsgs; n++) {
+        if (reuse) {
+            data = pmix_ptl_base_recv_buffer_get(hdr.nbytes);
+        } else {
+            data = (char *) malloc(hdr.nbytes);
+        }
+        memcpy(data, body.base_ptr, hdr.nbytes);
+        PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+        PMIX_LOAD_BUFFER_NON_DESTRUCT(pmix_globals.mypeer, &buf, data, hdr.nbytes);
+        recv_cbfunc(pmix_globals.mypeer, &hdr, &buf, NULL);
+        if (reuse) {
+            pmix_ptl_base_recv_buffer_return(data, hdr.nbytes);
+            buf.base_ptr = NULL;
+        }
+        PMIX_DESTRUCT(&buf);
+    }
+    *ns = (bench_now() - start) / nmsgs;
+    *allocs = (double) (nallocs - start_allocs) / nmsgs;
+    PMIX_DESTRUCT(&body);
+}
+
+static void run(int wsd, size_t blobsize, int nmsgs, bool reuse, bool view,
+                double *ns, double *allocs)
+{
+    pmix_buffer_t body;
+    pmix_ptl_hdr_t hdr;
+    pthread_t tid;
+    feed_t f;
+    long start_allocs;
+    double start;
+
+    /* build the message once and feed copies of it */
+    build_body(&body, blobsize);
+    hdr.pindex = 0;
+    hdr.tag = htonl(BENCH_TAG);
+    hdr.nbytes = htonl((uint32_t) body.bytes_used);
+    f.size = sizeof(hdr) + body.bytes_used;
+    f.msg = (char *) malloc(f.size);
+    memcpy(f.msg, &hdr, sizeof(hdr));
+    memcpy(f.msg + sizeof(hdr), body.base_ptr, body.bytes_used);
+    f.sd = wsd;
+    f.nmsgs = nmsgs;
+    PMIX_DESTRUCT(&body);
+
+    pmix_ptl_base.recv_cache_size = reuse ? 16 : 0;
+    use_view = view;
+    nrecvd = 0;
+    start_allocs = nallocs;
+    start = bench_now();
+    pthread_create(&tid, NULL, feed, &f);
+    while (__atomic_load_n(&nrecvd, __ATOMIC_ACQUIRE) < nmsgs) {
+        continue;
+    }
+    *ns = (bench_now() - start) / nmsgs;
+    *allocs = (double) (nallocs - start_allocs) / nmsgs;
+    pthread_join(tid, NULL);
+    free(f.msg);
+}
+
+/* report the best of nrounds for each size and way of receiving,
+ * either over the socket or in place of it when wsd is negative */
+static void measure(int wsd, int nmsgs, int nrounds)
+{
+    static const size_t sizes[] = {64, 256, 1024, 2048, 4096, 32768};
+    static const struct {
+        bool reuse;
+        bool view;
+    } modes[] = {{false, false}, {true, false}, {false, true}, {true, true}};
+    double ns[4], allocs[4], t, a;
+    int i, m, r;
+
+    fprintf(stdout, "%s: ns/msg (allocs/msg), best of %d rounds\n%8s %16s %16s %16s %16s\n",
+            (wsd < 0) ? "receive path" : "socket", nrounds, "bytes", "copy", "cache", "view",
+            "cache+view");
+    for (i = 0; i < (int) (sizeof(sizes) / sizeof(sizes[0])); i++) {
+        for (m = 0; m < 4; m++) {
+            ns[m] = -1.0;
+        }
+        for (r = 0; r < nrounds; r++) {
+            for (m = 0; m < 4; m++) {
+                if (wsd < 0) {
+                    run_local(sizes[i], nmsgs, modes[m].reuse, modes[m].view, &t, &a);
+                } else {
+                    run(wsd, sizes[i], nmsgs, modes[m].reuse, modes[m].view, &t, &a);
+                }
+                if (ns[m] < 0.0 || t < ns[m]) {
+                    ns[m] = t;
+                }
+                allocs[m] = a;
+            }
+        }
+        fprintf(stdout, "%8zu", sizes[i]);
+        for (m = 0; m < 4; m++) {
+            fprintf(stdout, " %9.1f (%4.2f)", ns[m], allocs[m]);
+        }
+        fprintf(stdout, "\n");
+    }
+}
+
+int main(int argc, char **argv)
+{
+    pmix_ptl_posted_recv_t *rcv;
+    pmix_peer_t *peer;
+    int nmsgs = 100000;
+    int nrounds = 5;
+    int sv[2];
+
+    if (1 < argc) {
+        nmsgs = strtol(argv[1], NULL, 10);
+    }
+    if (2 < argc) {
+        nrounds = strtol(argv[2], NULL, 10);
+    }
+    if (0 != bench_server_init(NULL)) {
+        return 1;
+    }
+    if (0 != socketpair(AF_UNIX, SOCK_STREAM, 0, sv)) {
+        fprintf(stderr, "socketpair failed\n");
+        return 1;
+    }
+    fcntl(sv[1], F_SETFL, fcntl(sv[1], F_GETFL) | O_NONBLOCK);
+
+    peer = PMIX_NEW(pmix_peer_t);
+    peer->info = PMIX_NEW(pmix_rank_info_t);
+    peer->info->pname.nspace = strdup("recv_bench");
+    peer->info->pname.rank = 0;
+    PMIX_RETAIN(pmix_globals.mypeer->nptr);
+    peer->nptr = pmix_globals.mypeer->nptr;
+    peer->sd = sv[1];
+
+    /* the progress thread delivers the messages to this recv - it
+     * must be ahead of the server's catch-all recv */
+    rcv = PMIX_NEW(pmix_ptl_posted_recv_t);
+    rcv->tag = BENCH_TAG;
+    rcv->cbfunc = recv_cbfunc;
+    pmix_list_prepend(&pmix_ptl_base.posted_recvs, &rcv->super);
+
+    /* receive on the progress thread, as for any connected peer */
+    pmix_event_assign(&peer->recv_event, pmix_globals.evbase, peer->sd, EV_READ | EV_PERSIST,
+                      pmix_ptl_base_recv_handler, peer);
+    pmix_event_add(&peer->recv_event, NULL);
+    peer->recv_ev_active = true;
+
+    /* every message is cached while measuring the cache */
+    pmix_ptl_base.recv_cache_min = 0;
+    measure(-1, nmsgs, nrounds);
+    measure(sv[0], nmsgs, nrounds);
+
+    pmix_event_del(&peer->recv_event);
+    peer->recv_ev_active = false;
+    close(sv[0]);
+    close(sv[1]);
+    PMIx_server_finalize();
+    return 0;
+}
@@ -0,0 +1,393 @@
+/*
+ * Copyright (c) 2022      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Exercises the built-in collective engine used by servers whose
+ * host does not provide fence_nb. Forks a group of servers on the
+ * local host that exchange contributions of increasing size, plus
+ * some barriers, checks that each server gets every contribution
+ * back in server order, and reports the latency of each round.
+ * The rounds are run once with the ring disabled and once with it
+ * used for every size. At the end, the last server leaves and the
+ * others check that their next fence fails rather than hangs.
+ * Meanwhile, a connection that sends fence data without saying
+ * which server it is must be dropped. With more than two servers,
+ * a job is also placed on the even servers only, and fences over
+ * it must complete without the odd ones.
+ *
+ * Usage: server_coll [nservers] [nrounds]
+ */
+
+#include "src/include/pmix_config.h"
+#include "include/pmix_server.h"
+
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "src/include/pmix_globals.h"
+#include "src/mca/ptl/ptl_types.h"
+#include "src/server/pmix_server_ops.h"
+
+#include "bench_util.h"
+
+static const size_t sizes[] = {0, 16, 1024, 65536, 1048576};
+#define NSIZES (int) (sizeof(sizes) / sizeof(sizes[0]))
+
+static int me, nservers, nrounds;
+static bool subset = false; // fence over the job on the even servers
+static pmix_proc_t job;
+
+static char pattern(int rank, size_t n)
+{
+    return (char) ((rank * 131 + n) & 0xff);
+}
+
+typedef struct {
+    pmix_object_t super;
+    pmix_event_t ev;
+    size_t size;
+    bool barrier;
+    char key[32];
+    volatile int active;
+    int bad;
+    bool lost; // a server left - the fence must fail
+} round_caddy_t;
+static PMIX_CLASS_INSTANCE(round_caddy_t, pmix_object_t, NULL, NULL);
+
+/* called on the progress thread */
+static void gathered(pmix_status_t status, const char *data, size_t ndata, void *cbdata,
+                     pmix_release_cbfunc_t relfn, void *relcbdata)
+{
+    round_caddy_t *cd = (round_caddy_t *) cbdata;
+    size_t n, off = 0;
+    int r;
+
+    if (cd->lost) {
+        cd->bad = (PMIX_SUCCESS == status);
+    } else if (PMIX_SUCCESS != status) {
+        fprintf(stderr, "server %d: fence failed: %s\n", me, PMIx_Error_string(status));
+        cd->bad = 1;
+    } else if (cd->barrier) {
+        cd->bad = (0 != ndata);
+    } else if (ndata != cd->size * (subset ? (nservers + 1) / 2 : nservers)) {
+        fprintf(stderr, "server %d: got %zu bytes instead of %zu\n", me, ndata,
+                cd->size * (subset ? (nservers + 1) / 2 : nservers));
+        cd->bad = 1;
+    } else {
+        for (r = 0; r < nservers && !cd->bad; r += subset ? 2 : 1) {
+            for (n = 0; n < cd->size; n++, off++) {
+                if (data[off] != pattern(r, n)) {
+                    fprintf(stderr, "server %d: byte %zu of server %d is wrong\n", me, n, r);
+                    cd->bad = 1;
+                    break;
+                }
+            }
+        }
+    }
+    if (NULL != relfn) {
+        relfn(relcbdata);
+    }
+    cd->active = 0;
+}
+
+static void start_round(int sd, short args, void *cbdata)
+{
+    round_caddy_t *cd = (round_caddy_t *) cbdata;
+    pmix_status_t rc;
+    char *data = NULL;
+    size_t n;
+
+    PMIX_HIDE_UNUSED_PARAMS(sd, args);
+    if (!cd->barrier && 0 < cd->size) {
+        data = (char *) malloc(cd->size);
+        for (n = 0; n < cd->size; n++) {
+            data[n] = pattern(me, n);
+        }
+    }
+    rc = pmix_server_coll_allgather(cd->key, strlen(cd->key), subset ? &job : NULL,
+                                    subset ? 1 : 0, cd->barrier, data,
+                                    cd->barrier ? 0 : cd->size, gathered, cd);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "server %d: allgather failed: %s\n", me, PMIx_Error_string(rc));
+        free(data);
+        cd->bad = 1;
+        cd->active = 0;
+    }
+}
+
+/* run the rounds and return their average latency */
+static double run(const char *key, size_t size, bool barrier, bool lost)
+{
+    struct timespec ts = {0, 1000};
+    round_caddy_t *cd;
+    double start;
+    int n;
+
+    start = bench_now();
+    for (n = 0; n < nrounds; n++) {
+        cd = PMIX_NEW(round_caddy_t);
+        cd->size = size;
+        cd->barrier = barrier;
+        cd->lost = lost;
+        snprintf(cd->key, sizeof(cd->key), "%s", key);
+        cd->active = 1;
+        cd->bad = 0;
+        pmix_event_assign(&cd->ev, pmix_globals.evbase, -1, EV_WRITE, start_round, cd);
+        pmix_event_active(&cd->ev, EV_WRITE, 1);
+        while (cd->active) {
+            nanosleep(&ts, NULL);
+        }
+        if (cd->bad) {
+            if (lost) {
+                fprintf(stderr, "server %d: fence without server %d succeeded\n", me,
+                        nservers - 1);
+            }
+            exit(1);
+        }
+        PMIX_RELEASE(cd);
+    }
+    return (bench_now() - start) / nrounds;
+}
+
+static void registered(pmix_status_t status, void *cbdata)
+{
+    volatile int *active = (volatile int *) cbdata;
+
+    if (PMIX_SUCCESS != status) {
+        fprintf(stderr, "server %d: registering the job failed: %s\n", me,
+                PMIx_Error_string(status));
+        exit(1);
+    }
+    *active = 0;
+}
+
+/* a job with one proc on each of the even servers - the
+ * nodes are named by the addresses of the servers */
+static void register_job(void)
+{
+    volatile int active = 1;
+    char *nodes = NULL, *ranks = NULL, *regex, *ppn, *tmp;
+    pmix_info_t info[3];
+    uint32_t nprocs = 0;
+    int n;
+
+    for (n = 0; n < nservers; n += 2) {
+        if (0 > asprintf(&tmp, "%s%s127.0.0.%d", (NULL == nodes) ? "" : nodes,
+                         (NULL == nodes) ? "" : ",", n + 1)) {
+            exit(1);
+        }
+        free(nodes);
+        nodes = tmp;
+        if (0 > asprintf(&tmp, "%s%s%u", (NULL == ranks) ? "" : ranks,
+                         (NULL == ranks) ? "" : ";", nprocs++)) {
+            exit(1);
+        }
+        free(ranks);
+        ranks = tmp;
+    }
+    PMIx_generate_regex(nodes, &regex);
+    PMIx_generate_ppn(ranks, &ppn);
+    PMIX_INFO_LOAD(&info[0], PMIX_JOB_SIZE, &nprocs, PMIX_UINT32);
+    PMIX_INFO_LOAD(&info[1], PMIX_NODE_MAP, regex, PMIX_REGEX);
+    PMIX_INFO_LOAD(&info[2], PMIX_PROC_MAP, ppn, PMIX_REGEX);
+    free(nodes);
+    free(ranks);
+    free(regex);
+    free(ppn);
+
+    PMIX_LOAD_PROCID(&job, "coll.job", PMIX_RANK_WILDCARD);
+    if (PMIX_SUCCESS
+        != PMIx_server_register_nspace(job.nspace, 0, info, 3, registered, (void *) &active)) {
+        fprintf(stderr, "server %d: cannot register the job\n", me);
+        exit(1);
+    }
+    bench_wait_for(&active);
+    PMIX_INFO_DESTRUCT(&info[0]);
+    PMIX_INFO_DESTRUCT(&info[1]);
+    PMIX_INFO_DESTRUCT(&info[2]);
+}
+
+static int server(const char *addrs, bool ring)
+{
+    char tmp[64];
+    double ns;
+    int i;
+
+    snprintf(tmp, sizeof(tmp), "%d", me);
+    setenv("PMIX_MCA_pmix_server_coll_servers", addrs, 1);
+    setenv("PMIX_MCA_pmix_server_coll_rank", tmp, 1);
+    setenv("PMIX_MCA_pmix_server_coll_ring_threshold", ring ? "1" : "1000000000000", 1);
+    if (0 != bench_server_init(NULL)) {
+        return 1;
+    }
+    if (0 == me) {
+        fprintf(stdout, "%d servers, %s:\n%10s %12s\n", nservers, ring ? "ring" : "log steps",
+                "bytes", "us/fence");
+    }
+    for (i = 0; i < NSIZES; i++) {
+        snprintf(tmp, sizeof(tmp), "size%zu", sizes[i]);
+        /* the first round of a ring only learns the size */
+        (void) run(tmp, sizes[i], false, false);
+        ns = run(tmp, sizes[i], false, false);
+        if (0 == me) {
+            fprintf(stdout, "%10zu %12.1f\n", sizes[i], ns / 1e3);
+            fflush(stdout);
+        }
+    }
+    ns = run("barrier", 0, true, false);
+    if (0 == me) {
+        fprintf(stdout, "%10s %12.1f\n", "barrier", ns / 1e3);
+    }
+    /* the odd servers host none of the job, and
+     * so go straight on to the next fence */
+    if (2 < nservers) {
+        register_job();
+        if (0 == me % 2) {
+            subset = true;
+            ns = run("subset", 16, false, false);
+            if (0 == me) {
+                fprintf(stdout, "%10s %12.1f   (%d servers)\n", "16", ns / 1e3,
+                        (nservers + 1) / 2);
+            }
+            ns = run("subset-barrier", 0, true, false);
+            if (0 == me) {
+                fprintf(stdout, "%10s %12.1f   (%d servers)\n", "barrier", ns / 1e3,
+                        (nservers + 1) / 2);
+            }
+            subset = false;
+        }
+    }
+    /* let everyone finish before the connections go away */
+    (void) run("done", 0, true, false);
+    /* the others must not wait for a server that is gone */
+    if (me < nservers - 1) {
+        nrounds = 1;
+        (void) run("lost", 0, true, true);
+        (void) run("lost", 16, false, true);
+    }
+    PMIx_server_finalize();
+    return 0;
+}
+
+/* send fence data to a server without saying who we are,
+ * and check that it closes the connection */
+static int intrude(struct sockaddr_in *addr)
+{
+    struct timespec ts = {0, 50000000};
+    struct timeval tv = {30, 0};
+    pmix_ptl_hdr_t hdr;
+    char junk[16];
+    int sd, n;
+
+    for (n = 0; n < 100; n++) {
+        sd = socket(AF_INET, SOCK_STREAM, 0);
+        if (0 == connect(sd, (struct sockaddr *) addr, sizeof(*addr))) {
+            break;
+        }
+        close(sd);
+        sd = -1;
+        nanosleep(&ts, NULL);
+    }
+    if (sd < 0) {
+        fprintf(stderr, "cannot connect to server 0\n");
+        return 1;
+    }
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.tag = htonl(PMIX_PTL_TAG_COLL);
+    hdr.nbytes = htonl(sizeof(junk));
+    memset(junk, 0, sizeof(junk));
+    (void) setsockopt(sd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    if (sizeof(hdr) != write(sd, &hdr, sizeof(hdr)) || sizeof(junk) != write(sd, junk, sizeof(junk))
+        || 0 != read(sd, junk, sizeof(junk))) {
+        fprintf(stderr, "server 0 kept a connection that did not say who it is\n");
+        close(sd);
+        return 1;
+    }
+    close(sd);
+    return 0;
+}
+
+/* start a group of servers on ports picked by the kernel */
+static int group(bool ring)
+{
+    struct sockaddr_in addr, first;
+    socklen_t len;
+    char *addrs, *ptr;
+    int *sds, n, status, rc = 0;
+    pid_t pid;
+
+    sds = (int *) calloc(nservers, sizeof(int));
+    addrs = (char *) calloc(nservers, 32);
+    ptr = addrs;
+    for (n = 0; n < nservers; n++) {
+        sds[n] = socket(AF_INET, SOCK_STREAM, 0);
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        /* each server on its own loopback address, so
+         * that it can stand for a node */
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK + n);
+        len = sizeof(addr);
+        if (0 != bind(sds[n], (struct sockaddr *) &addr, len)
+            || 0 != getsockname(sds[n], (struct sockaddr *) &addr, &len)) {
+            fprintf(stderr, "cannot pick a port\n");
+            return 1;
+        }
+        ptr += sprintf(ptr, "%s127.0.0.%d:%d", (0 == n) ? "" : ",", n + 1,
+                       ntohs(addr.sin_port));
+        if (0 == n) {
+            first = addr;
+        }
+    }
+    for (n = 0; n < nservers; n++) {
+        close(sds[n]);
+    }
+    fflush(stdout);
+    for (n = 0; n < nservers; n++) {
+        pid = fork();
+        if (0 == pid) {
+            me = n;
+            exit(server(addrs, ring));
+        }
+    }
+    rc = intrude(&first);
+    for (n = 0; n < nservers; n++) {
+        wait(&status);
+        if (!WIFEXITED(status) || 0 != WEXITSTATUS(status)) {
+            rc = 1;
+        }
+    }
+    free(sds);
+    free(addrs);
+    return rc;
+}
+
+int main(int argc, char **argv)
+{
+    nservers = 8;
+    nrounds = 20;
+    if (1 < argc) {
+        nservers = strtol(argv[1], NULL, 10);
+    }
+    if (2 < argc) {
+        nrounds = strtol(argv[2], NULL, 10);
+    }
+    if (nservers < 2) {
+        fprintf(stderr, "need at least 2 servers\n");
+        return 1;
+    }
+    if (0 != group(false) || 0 != group(true)) {
+        fprintf(stderr, "FAILED\n");
+        return 1;
+    }
+    return 0;
+}